@@ -39,8 +39,12 @@
 
 #include "hdf5.h"
 
+#include <algorithm>
+
 #include <QtCore/QtDebug>
 
+#include "H5Support/QH5Lite.h"
+
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/EbsdSetGetMacros.h"
 
@@ -75,6 +79,13 @@ class EbsdLib_EXPORT EbsdImporter
      */
     EBSD_VIRTUAL_INSTANCE_PROPERTY(bool, Cancel)
 
+    /**
+     * @brief The deflate level (1-9) used for the data arrays of each slice. The
+     * arrays are stored as shuffled, chunked data sets. A value of 0 writes contiguous,
+     * uncompressed data sets.
+     */
+    EBSD_VIRTUAL_INSTANCE_PROPERTY(int, CompressionLevel)
+
     /**
      * @brief Either prints a message or sends the message to the User Interface
      * @param message The message to print
@@ -105,6 +116,24 @@ class EbsdLib_EXPORT EbsdImporter
      */
     virtual int importFile(hid_t fileId, int64_t index, const QString& ebsd) = 0;
 
+    /**
+     * @brief Parses the EBSD file into memory without touching any HDF5 file. Different
+     * importer instances may parse files concurrently.
+     * @param ebsdFile The raw data file from the manufacturere (.ang, .ctf)
+     * @return Error code
+     */
+    virtual int parseFile(const QString& ebsdFile) = 0;
+
+    /**
+     * @brief Writes the data of the file given to the last parseFile() call into the HDF5 file.
+     * HDF5 calls must not be made concurrently so this method should only ever be called
+     * from one thread at a time.
+     * @param fileId HDF5 fileId of an open HDF5 file that the data will be stored into
+     * @param index The integer index value of this EBSD data file
+     * @return Error code
+     */
+    virtual int writeParsedFile(hid_t fileId, int64_t index) = 0;
+
     /**
      * @brief Returns the dimensions for the EBSD Data set
      * @param x Number of X Voxels (out)
@@ -136,10 +165,60 @@ class EbsdLib_EXPORT EbsdImporter
     EbsdImporter()
     : m_ErrorCode(0)
     , m_Cancel(false)
+    , m_CompressionLevel(0)
     {
       m_PipelineMessage = "";
     }
 
+    /**
+     * @brief Writes a 1D data array for a slice, honoring the CompressionLevel property.
+     * @param gid The HDF5 group to write into
+     * @param name The name of the data set
+     * @param numElements The number of values to write
+     * @param data The values
+     * @return Error code
+     */
+    template <typename T> herr_t writeDataArray(hid_t gid, const QString& name, hsize_t numElements, T* data)
+    {
+      int32_t rank = 1;
+      hsize_t dims[1] = {numElements};
+      if(m_CompressionLevel <= 0 || numElements == 0)
+      {
+        return QH5Lite::writePointerDataset(gid, name, rank, dims, data);
+      }
+
+      // 64K values per chunk keeps a chunk in the HDF5 chunk cache while still compressing well
+      hsize_t chunkDims[1] = {std::min<hsize_t>(numElements, 65536)};
+      hid_t dataType = QH5Lite::HDFTypeForPrimitive(data[0]);
+      hid_t dataspaceId = H5Screate_simple(rank, dims, nullptr);
+      hid_t plistId = H5Pcreate(H5P_DATASET_CREATE);
+      herr_t err = H5Pset_chunk(plistId, rank, chunkDims);
+      if(err >= 0)
+      {
+        err = H5Pset_shuffle(plistId);
+      }
+      if(err >= 0)
+      {
+        err = H5Pset_deflate(plistId, static_cast<unsigned>(std::min(m_CompressionLevel, 9)));
+      }
+      if(err >= 0)
+      {
+        hid_t datasetId = H5Dcreate2(gid, name.toLatin1().data(), dataType, dataspaceId, H5P_DEFAULT, plistId, H5P_DEFAULT);
+        if(datasetId >= 0)
+        {
+          err = H5Dwrite(datasetId, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+          H5Dclose(datasetId);
+        }
+        else
+        {
+          err = -1;
+        }
+      }
+      H5Pclose(plistId);
+      H5Sclose(dataspaceId);
+      return err;
+    }
+
   public:
     EbsdImporter(const EbsdImporter&) = delete;   // Copy Constructor Not Implemented
     EbsdImporter(EbsdImporter&&) = delete;        // Move Constructor Not Implemented
@@ -85,7 +85,7 @@ using namespace H5Support_NAMESPACE;
   {                                                                                                                                                                                                    \
     if(nullptr != dataPtr)                                                                                                                                                                             \
     {                                                                                                                                                                                                  \
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);                                                                                                                               \
+      err = writeDataArray(gid, key, dims[0], dataPtr);                                                                                                                                                \
       if(err < 0)                                                                                                                                                                                      \
       {                                                                                                                                                                                                \
         QString ss = QObject::tr("H5CtfImporter Error: Could not write Ctf Data array for '%1' to the HDF5 file with data set name '%2'\n").arg(key, key);                                             \
@@ -137,6 +137,19 @@ int H5CtfImporter::numberOfSlicesImported()
 //
 // -----------------------------------------------------------------------------
 int H5CtfImporter::importFile(hid_t fileId, int64_t z, const QString& ctfFile)
+{
+  int err = parseFile(ctfFile);
+  if(err < 0)
+  {
+    return err;
+  }
+  return writeParsedFile(fileId, z);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::parseFile(const QString& ctfFile)
 {
   herr_t err = -1;
   setCancel(false);
@@ -144,7 +157,8 @@ int H5CtfImporter::importFile(hid_t fileId, int64_t z, const QString& ctfFile)
   setPipelineMessage("");
 
   //  std::cout << "H5CtfImporter: Importing " << ctfFile << std::endl;
-  CtfReader reader;
+  m_Reader = std::make_shared<CtfReader>();
+  CtfReader& reader = *m_Reader;
   reader.setFileName(ctfFile);
 
   // Now actually read the file
@@ -178,10 +192,27 @@ int H5CtfImporter::importFile(hid_t fileId, int64_t z, const QString& ctfFile)
     setPipelineMessage(ss);
     setErrorCode(err);
     progressMessage(ss, 100);
+    m_Reader.reset();
 
+    return -1;
+  }
+  return 0;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::writeParsedFile(hid_t fileId, int64_t z)
+{
+  herr_t err = -1;
+  if(nullptr == m_Reader.get())
+  {
+    QString ss = QObject::tr("H5CtfImporter Error: No .ctf file has been read for Z index %1").arg(z);
+    setPipelineMessage(ss);
+    setErrorCode(-800);
     return -1;
   }
+  CtfReader& reader = *m_Reader;
 
   // Write the fileversion attribute if it does not exist
   {
@@ -324,7 +355,6 @@ int H5CtfImporter::writeSliceData(hid_t fileId, CtfReader& reader, int z, int ac
     return -1;
   }
 
-  int32_t rank = 1;
   hsize_t dims[1] =
   { static_cast<hsize_t> (reader.getXCells() * reader.getYCells()) };
 
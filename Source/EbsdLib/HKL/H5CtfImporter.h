@@ -37,6 +37,8 @@
 
 #include "hdf5.h"
 
+#include <memory>
+
 #include <QtCore/QVector>
 #include <QtCore/QString>
 
@@ -73,6 +75,19 @@ class EbsdLib_EXPORT H5CtfImporter : public EbsdImporter
      */
     int importFile(hid_t fileId, int64_t index, const QString& angFile) override;
 
+    /**
+     * @brief Reads the .ctf file into memory. No HDF5 calls are made.
+     * @param ctfFile The absolute path to the input .ctf file
+     */
+    int parseFile(const QString& ctfFile) override;
+
+    /**
+     * @brief Writes every slice read by the last call to parseFile() into the HDF5 file
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param index The slice index of the first slice in the file
+     */
+    int writeParsedFile(hid_t fileId, int64_t index) override;
+
     /**
      * @brief Writes the phase data into the HDF5 file
      * @param reader Valid AngReader instance
@@ -122,6 +137,7 @@ class EbsdLib_EXPORT H5CtfImporter : public EbsdImporter
     float zRes = 1.0f;
     int m_NumSlicesImported = 1;
     int m_FileVersion = Ebsd::H5Aztec::FileVersion;
+    std::shared_ptr<CtfReader> m_Reader;
 
   public:
     H5CtfImporter(const H5CtfImporter&) = delete;  // Copy Constructor Not Implemented
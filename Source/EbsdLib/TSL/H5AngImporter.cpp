@@ -100,7 +100,7 @@ H5AngImporter::~H5AngImporter() = default;
   {\
     m_msgType* dataPtr = reader.get##prpty##Pointer();\
     if (nullptr != dataPtr) {\
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);\
+      err = writeDataArray(gid, key, dims[0], dataPtr);\
       if (err < 0) {\
         ss.string()->clear();\
         ss << "H5AngImporter Error: Could not write Ang Data array for '" << key\
@@ -142,6 +142,19 @@ int H5AngImporter::numberOfSlicesImported()
 //
 // -----------------------------------------------------------------------------
 int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
+{
+  int err = parseFile(angFile);
+  if(err < 0)
+  {
+    return err;
+  }
+  return writeParsedFile(fileId, z);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::parseFile(const QString& angFile)
 {
   herr_t err = -1;
   setCancel(false);
@@ -151,7 +164,8 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
   QTextStream ss(&streamBuf);
 
   //  std::cout << "H5AngImporter: Importing " << angFile;
-  AngReader reader;
+  m_Reader = std::make_shared<AngReader>();
+  AngReader& reader = *m_Reader;
   reader.setFileName(angFile);
 
   // Now actually read the file
@@ -192,8 +206,28 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
 
     setErrorCode(err);
     progressMessage(*(ss.string()), 100);
+    m_Reader.reset();
+    return -1;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::writeParsedFile(hid_t fileId, int64_t z)
+{
+  herr_t err = -1;
+  QString streamBuf;
+  QTextStream ss(&streamBuf);
+  if(nullptr == m_Reader.get())
+  {
+    ss << "H5AngImporter Error: No .ang file has been read for Z index " << z;
+    setPipelineMessage(*(ss.string()));
+    setErrorCode(-800);
     return -1;
   }
+  AngReader& reader = *m_Reader;
 
   // Write the file Version number to the file
   {
@@ -277,7 +311,7 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
 
   QString angCompleteHeader = reader.getOriginalHeader();
   err = QH5Lite::writeStringDataset(gid, Ebsd::H5OIM::OriginalHeader, angCompleteHeader);
-  err = QH5Lite::writeStringDataset(gid, Ebsd::H5OIM::OriginalFile, angFile);
+  err = QH5Lite::writeStringDataset(gid, Ebsd::H5OIM::OriginalFile, reader.getFileName());
 
   // Close the "Header" group
   err = H5Gclose(gid);
@@ -296,7 +330,6 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
     return -1;
   }
 
-  int32_t rank = 1;
   hsize_t dims[1] = { static_cast<hsize_t>(reader.getNumEvenCols() * reader.getNumRows() ) };
 
   WRITE_ANG_DATA_ARRAY(reader, float, gid, Phi1, Ebsd::Ang::Phi1);
@@ -42,6 +42,7 @@
 
 #include "hdf5.h"
 
+#include <memory>
 #include <vector>
 #include <QtCore/QString>
 
@@ -76,6 +77,19 @@ class EbsdLib_EXPORT H5AngImporter : public EbsdImporter
      */
     int importFile(hid_t fileId, int64_t index, const QString& angFile) override;
 
+    /**
+     * @brief Reads the .ang file into memory. No HDF5 calls are made.
+     * @param angFile The absolute path to the input .ang file
+     */
+    int parseFile(const QString& angFile) override;
+
+    /**
+     * @brief Writes the data read by the last call to parseFile() into the HDF5 file
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param index The slice index for the file
+     */
+    int writeParsedFile(hid_t fileId, int64_t index) override;
+
     /**
      * @brief Writes the phase data into the HDF5 file
      * @param reader Valid AngReader instance
@@ -129,6 +143,7 @@ class EbsdLib_EXPORT H5AngImporter : public EbsdImporter
     float xRes;
     float yRes;
     int   m_FileVersion;
+    std::shared_ptr<AngReader> m_Reader;
 
   public:
     H5AngImporter(const H5AngImporter&) = delete;  // Copy Constructor Not Implemented
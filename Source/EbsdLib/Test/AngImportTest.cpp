@@ -44,10 +44,12 @@
 #if EbsdLib_HDF5_SUPPORT
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
+#include "H5Support/QH5Utilities.h"
 #endif
 
 #include "EbsdLib/TSL/AngReader.h"
 #include "EbsdLib/TSL/H5AngImporter.h"
+#include "EbsdLib/TSL/H5AngReader.h"
 
 #include "UnitTestSupport.hpp"
 
@@ -166,6 +168,72 @@ public:
     DREAM3D_REQUIRED(ptr[159], ==, 12.56637f)
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCompressedImport()
+  {
+    // Parse and write in two steps with compressed data sets and make sure the data reads back unchanged
+    hid_t fileId = QH5Utilities::createFile(UnitTest::AngImportTest::H5EbsdOutputFile);
+    DREAM3D_REQUIRE(fileId > 0)
+    EbsdImporter::Pointer importer = H5AngImporter::New();
+    importer->setCompressionLevel(6);
+    int err = importer->parseFile(UnitTest::AngImportTest::TestFile1);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = importer->writeParsedFile(fileId, 0);
+    DREAM3D_REQUIRED(err, >=, 0)
+    err = QH5Utilities::closeFile(fileId);
+
+    // The per slice arrays must be stored chunked, shuffled and deflated
+    fileId = QH5Utilities::openFile(UnitTest::AngImportTest::H5EbsdOutputFile, true);
+    DREAM3D_REQUIRE(fileId > 0)
+    QString dsetPath = QString("0/") + Ebsd::H5OIM::Data + "/" + Ebsd::Ang::Phi1;
+    hid_t datasetId = H5Dopen(fileId, dsetPath.toLatin1().data(), H5P_DEFAULT);
+    DREAM3D_REQUIRE(datasetId > 0)
+    hid_t plistId = H5Dget_create_plist(datasetId);
+    DREAM3D_REQUIRE(plistId > 0)
+    DREAM3D_REQUIRED(H5Pget_layout(plistId), ==, H5D_CHUNKED)
+    bool hasShuffle = false;
+    bool hasDeflate = false;
+    int numFilters = H5Pget_nfilters(plistId);
+    for(int i = 0; i < numFilters; i++)
+    {
+      unsigned int flags = 0;
+      size_t numValues = 0;
+      H5Z_filter_t filter = H5Pget_filter2(plistId, static_cast<unsigned>(i), &flags, &numValues, nullptr, 0, nullptr, nullptr);
+      hasShuffle = hasShuffle || (filter == H5Z_FILTER_SHUFFLE);
+      hasDeflate = hasDeflate || (filter == H5Z_FILTER_DEFLATE);
+    }
+    DREAM3D_REQUIRE(hasShuffle)
+    DREAM3D_REQUIRE(hasDeflate)
+    H5Pclose(plistId);
+    H5Dclose(datasetId);
+    err = QH5Utilities::closeFile(fileId);
+
+    AngReader reader;
+    reader.setFileName(UnitTest::AngImportTest::TestFile1);
+    err = reader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    H5AngReader::Pointer h5Reader = H5AngReader::New();
+    h5Reader->setFileName(UnitTest::AngImportTest::H5EbsdOutputFile);
+    h5Reader->setHDF5Path("0");
+    err = h5Reader->readFile();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    size_t numElements = reader.getNumberOfElements();
+    DREAM3D_REQUIRED(h5Reader->getNumberOfElements(), ==, numElements)
+    float* phi1 = reader.getPhi1Pointer();
+    float* h5Phi1 = h5Reader->getPhi1Pointer();
+    int* phases = reader.getPhaseDataPointer();
+    int* h5Phases = h5Reader->getPhaseDataPointer();
+    for(size_t i = 0; i < numElements; i++)
+    {
+      DREAM3D_REQUIRED(h5Phi1[i], ==, phi1[i])
+      DREAM3D_REQUIRED(h5Phases[i], ==, phases[i])
+    }
+  }
+
   void operator()()
   {
     int err = EXIT_SUCCESS;
@@ -177,6 +245,7 @@ public:
     DREAM3D_REGISTER_TEST(TestMissingGrid())
     DREAM3D_REGISTER_TEST(TestShortFile())
     DREAM3D_REGISTER_TEST(TestNormalFile())
+    DREAM3D_REGISTER_TEST(TestCompressedImport())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 
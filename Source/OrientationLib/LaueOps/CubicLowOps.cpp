@@ -54,6 +54,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 #include "OrientationLib/Utilities/ComputeStereographicProjection.h"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 namespace Detail
 {
@@ -785,7 +786,7 @@ void CubicLowOps::generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatAr
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("CubicLowOps"));
   bool doParallel = true;
 #endif
 
@@ -1102,7 +1103,7 @@ QVector<UInt8ArrayType::Pointer> CubicLowOps::generatePoleFigure(PoleFigureConfi
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("CubicLowOps"));
   bool doParallel = true;
 
   if(doParallel)
@@ -53,6 +53,7 @@
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/Utilities/ComputeStereographicProjection.h"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 namespace Detail
 {
@@ -1349,6 +1350,79 @@ void CubicOps::getF7(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F7)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getSlipSystemTable(QuatF& q, float LD[3], SlipSystemTable& table)
+{
+  float g[3][3];
+  float directionComponent = 0, planeComponent = 0, schmidFactor = 0;
+
+  FOrientArrayType om(9);
+  FOrientTransformsType::qu2om(FOrientArrayType(q), om);
+  om.toGMatrix(g);
+  MatrixMath::Transpose3x3(g, g);
+
+  table.numSlipSystems = 12;
+  table.maxSlipSystem = 0;
+  table.maxSchmidFactor = 0.0f;
+  table.maxDirectionComponent = 0.0f;
+  for(int i = 0; i < 12; i++)
+  {
+    float* hkl = table.directions[i];
+    float* uvw = table.planes[i];
+    MatrixMath::Multiply3x3with3x1(g, CubicSlipDirections[i], hkl);
+    MatrixMath::Multiply3x3with3x1(g, CubicSlipPlanes[i], uvw);
+    MatrixMath::Normalize3x1(hkl);
+    MatrixMath::Normalize3x1(uvw);
+    directionComponent = std::fabs(GeometryMath::CosThetaBetweenVectors(LD, uvw));
+    planeComponent = std::fabs(GeometryMath::CosThetaBetweenVectors(LD, hkl));
+    schmidFactor = directionComponent * planeComponent;
+    if(schmidFactor > table.maxSchmidFactor)
+    {
+      table.maxSlipSystem = i;
+      table.maxSchmidFactor = schmidFactor;
+      table.maxDirectionComponent = directionComponent;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getSlipTransmissionMetrics(const SlipSystemTable& table1, const SlipSystemTable& table2, float& mPrime, float& F1, float& F1spt, float& F7)
+{
+  mPrime = 0.0f;
+  F1 = 0.0f;
+  F1spt = 0.0f;
+  F7 = 0.0f;
+  if(table1.numSlipSystems != 12 || table2.numSlipSystems != 12)
+  {
+    return;
+  }
+
+  const float* hkl1 = table1.directions[table1.maxSlipSystem];
+  const float* uvw1 = table1.planes[table1.maxSlipSystem];
+  float planeMisalignment = std::fabs(GeometryMath::CosThetaBetweenVectors(hkl1, table2.directions[table2.maxSlipSystem]));
+  float directionMisalignment = std::fabs(GeometryMath::CosThetaBetweenVectors(uvw1, table2.planes[table2.maxSlipSystem]));
+  mPrime = planeMisalignment * directionMisalignment;
+
+  // The F metrics are only defined once a slip system with a non zero Schmid factor was found
+  if(table1.maxSchmidFactor <= 0.0f)
+  {
+    return;
+  }
+  float totalDirectionMisalignment = 0, totalPlaneMisalignment = 0;
+  for(int j = 0; j < 12; j++)
+  {
+    totalDirectionMisalignment += std::fabs(GeometryMath::CosThetaBetweenVectors(uvw1, table2.planes[j]));
+    totalPlaneMisalignment += std::fabs(GeometryMath::CosThetaBetweenVectors(hkl1, table2.directions[j]));
+  }
+  F1 = table1.maxSchmidFactor * table1.maxDirectionComponent * totalDirectionMisalignment;
+  F1spt = table1.maxSchmidFactor * table1.maxDirectionComponent * totalDirectionMisalignment * totalPlaneMisalignment;
+  F7 = table1.maxDirectionComponent * table1.maxDirectionComponent * totalDirectionMisalignment;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1508,14 +1582,14 @@ void CubicOps::generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatArray
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("CubicOps"));
   bool doParallel = true;
 #endif
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, nOrientations),
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nOrientations, ParallelExecutionContext::Instance()->getGrainSize("CubicOps")),
                       Detail::CubicHigh::GenerateSphereCoordsImpl(eulers, xyz001, xyz011, xyz111), tbb::auto_partitioner());
   }
   else
@@ -1831,7 +1905,7 @@ QVector<UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfigur
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("CubicOps"));
   bool doParallel = true;
 
   if(doParallel)
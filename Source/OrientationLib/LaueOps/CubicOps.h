@@ -117,6 +117,8 @@ class OrientationLib_EXPORT CubicOps : public LaueOps
     virtual void getF1(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F1);
     virtual void getF1spt(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F1spt);
     virtual void getF7(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F7);
+    virtual void getSlipSystemTable(QuatF& q, float LD[3], SlipSystemTable& table);
+    virtual void getSlipTransmissionMetrics(const SlipSystemTable& table1, const SlipSystemTable& table2, float& mPrime, float& F1, float& F1spt, float& F7);
 
 
     virtual void generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatArrayType* c1, FloatArrayType* c2, FloatArrayType* c3);
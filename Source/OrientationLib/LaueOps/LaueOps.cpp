@@ -433,3 +433,25 @@ size_t LaueOps::getRandomSymmetryOperatorIndex(int numSymOps)
   size_t symOp = distribution(generator); // Random remaining position.
   return symOp;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::getSlipSystemTable(QuatF& q, float LD[3], SlipSystemTable& table)
+{
+  table.numSlipSystems = 0;
+  table.maxSlipSystem = 0;
+  table.maxSchmidFactor = 0.0f;
+  table.maxDirectionComponent = 0.0f;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::getSlipTransmissionMetrics(const SlipSystemTable& table1, const SlipSystemTable& table2, float& mPrime, float& F1, float& F1spt, float& F7)
+{
+  mPrime = 0.0f;
+  F1 = 0.0f;
+  F1spt = 0.0f;
+  F7 = 0.0f;
+}
@@ -152,6 +152,38 @@ class OrientationLib_EXPORT LaueOps
     virtual void getF1spt(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F1spt) = 0;
     virtual void getF7(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F7) = 0;
 
+    /**
+     * @brief The SlipSystemTable struct holds the slip directions and slip plane normals of one orientation
+     * rotated into the sample frame, together with the slip system that has the highest Schmid factor for a
+     * given loading direction. Building it once per feature lets the slip transmission metrics be evaluated
+     * for every neighbor pair without repeating the per slip system rotations.
+     */
+    struct SlipSystemTable
+    {
+      int numSlipSystems = 0;
+      float directions[12][3];
+      float planes[12][3];
+      int maxSlipSystem = 0;
+      float maxSchmidFactor = 0.0f;
+      float maxDirectionComponent = 0.0f;
+    };
+
+    /**
+     * @brief getSlipSystemTable Rotates the slip systems of this Laue class by q and finds the slip system with the
+     * highest Schmid factor for the loading direction LD. The default implementation leaves the table empty.
+     * @param q Orientation of the feature
+     * @param LD Loading direction in the sample frame
+     * @param table [output] The rotated slip systems
+     */
+    virtual void getSlipSystemTable(QuatF& q, float LD[3], SlipSystemTable& table);
+
+    /**
+     * @brief getSlipTransmissionMetrics Computes mPrime, F1, F1spt and F7 (using the maximum Schmid factor slip system
+     * of the first feature) from two tables built by getSlipSystemTable with the same loading direction. The results
+     * match getmPrime, getF1, getF1spt and getF7 with maxSF set to true. The default implementation sets all four to 0.
+     */
+    virtual void getSlipTransmissionMetrics(const SlipSystemTable& table1, const SlipSystemTable& table2, float& mPrime, float& F1, float& F1spt, float& F7);
+
 
     virtual void generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatArrayType* c1, FloatArrayType* c2, FloatArrayType* c3) = 0;
 
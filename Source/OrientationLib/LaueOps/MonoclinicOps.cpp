@@ -52,6 +52,7 @@
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/Utilities/ComputeStereographicProjection.h"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 
 namespace Detail
@@ -593,7 +594,7 @@ void MonoclinicOps::generateSphereCoordsFromEulers(FloatArrayType* eulers, Float
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("MonoclinicOps"));
   bool doParallel = true;
 #endif
 
@@ -779,7 +780,7 @@ QVector<UInt8ArrayType::Pointer> MonoclinicOps::generatePoleFigure(PoleFigureCon
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("MonoclinicOps"));
   bool doParallel = true;
 
   if(doParallel)
@@ -31,12 +31,22 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SO3Sampler.h"
 
+#include <algorithm>
+#include <cstring>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/ArrayHelpers.hpp"
 
 #include "OrientationLib/OrientationLibConstants.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 
 
@@ -103,6 +113,81 @@ static const int FZoarray[32] = { NoAxisOrder,NoAxisOrder,TwoFoldAxisOrder,TwoFo
                                   SixFoldAxisOrder,SixFoldAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder};
 
 
+/**
+ * @brief The SampleRFZImpl class tests the grid points of a range of x planes of the cubochoric grid.
+ * Without an output array it only records how many points of each plane lie inside the fundamental zone;
+ * with one it writes the Rodrigues vectors of those points starting at each plane's offset.
+ */
+class SampleRFZImpl
+{
+public:
+  SampleRFZImpl(SO3Sampler* sampler, int nsteps, int32_t fzType, int32_t fzOrder, size_t* planeCounts, const size_t* planeOffsets, double* rodrigues)
+  : m_Sampler(sampler)
+  , m_NSteps(nsteps)
+  , m_FZtype(fzType)
+  , m_FZorder(fzOrder)
+  , m_PlaneCounts(planeCounts)
+  , m_PlaneOffsets(planeOffsets)
+  , m_Rodrigues(rodrigues)
+  {
+  }
+  virtual ~SampleRFZImpl() = default;
+
+  void compute(int start, int end) const
+  {
+    typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+
+    const double delta = (0.50 * LPs::ap) / static_cast<double>(m_NSteps);
+    // Reuse the same containers for every grid point in this range
+    DOrientArrayType cu(3);
+    DOrientArrayType rod(4);
+
+    for(int plane = start; plane < end; plane++)
+    {
+      cu[0] = static_cast<double>(plane - m_NSteps) * delta;
+      double* out = (nullptr == m_Rodrigues) ? nullptr : m_Rodrigues + 4 * m_PlaneOffsets[plane];
+      size_t count = 0;
+      for(int j = -m_NSteps; j < m_NSteps; j++)
+      {
+        cu[1] = static_cast<double>(j) * delta;
+        for(int k = -m_NSteps; k < m_NSteps; k++)
+        {
+          cu[2] = static_cast<double>(k) * delta;
+          OrientationTransformsType::cu2ro(cu, rod);
+          if(m_Sampler->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+          {
+            if(nullptr != out)
+            {
+              ::memcpy(out + 4 * count, rod.data(), 4 * sizeof(double));
+            }
+            count++;
+          }
+        }
+      }
+      if(nullptr == m_Rodrigues)
+      {
+        m_PlaneCounts[plane] = count;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  SO3Sampler* m_Sampler;
+  int m_NSteps;
+  int32_t m_FZtype;
+  int32_t m_FZorder;
+  size_t* m_PlaneCounts;
+  const size_t* m_PlaneOffsets;
+  double* m_Rodrigues;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -340,27 +425,19 @@ bool SO3Sampler::insideDihedralFZ(double* rod, int order)
 bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 {
   bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = rod[0] * rod[3];
-  r[1] = rod[1] * rod[3];
-  r[2] = rod[2] * rod[3];
+  // This is called for every grid point during sampling so keep it free of heap allocations
+  const double r[3] = {fabs(rod[0] * rod[3]), fabs(rod[1] * rod[3]), fabs(rod[2] * rod[3])};
   const double r1 = 1.0;
 
   // primary cube planes (only needed for octahedral case)
   if (ot == OctahedralType) {
-
-    typedef OrientationTransforms<std::vector<double>, double> OrientationTransformsType;
-
-    // std::vector<double> absR = OrientationTransformsType::OMHelperType::absValue(r);
-    // double maxVal = OrientationTransformsType::OMHelperType::maxval(absR);
-    c1 = OrientationTransformsType::OMHelperType::maxval(OrientationTransformsType::OMHelperType::absValue(r)) <= LPs::BP[3];
-
+    c1 = std::max(r[0], std::max(r[1], r[2])) <= LPs::BP[3];
   } else {
     c1 = true;
   }
 
   // octahedral truncation planes, both for tetrahedral and octahedral point groups
-  c2 = ((fabs(r[0])+fabs(r[1])+fabs(r[2])) <= r1);
+  c2 = ((r[0] + r[1] + r[2]) <= r1);
 
   // if both c1 and c2, then the point is inside
   if (c1 && c2) { res = true;}
@@ -423,50 +500,79 @@ bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 //--------------------------------------------------------------------------
 SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZ(int nsteps,int pgnum)
 {
+  OrientationListArrayType FZlist;
 
-  double                        x, y, z, delta;
-  OrientationListArrayType              FZlist;
-  int32_t                 FZtype, FZorder;
+  std::vector<double> rodrigues;
+  size_t count = SampleRFZ(nsteps, pgnum, rodrigues);
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType rod(4);
+    ::memcpy(rod.data(), rodrigues.data() + 4 * i, 4 * sizeof(double));
+    FZlist.push_back(rod);
+  }
 
-  // step size for sampling of grid; total number of samples = (2*nsteps+1)**3
-  delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
+  return FZlist;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::SampleRFZ(int nsteps, int pgnum, std::vector<double>& rodrigues)
+{
   // determine which function we should call for this point group symmetry
-  FZtype = FZtarray[pgnum-1];
-  FZorder = FZoarray[pgnum-1];
-  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+  int32_t FZtype = FZtarray[pgnum - 1];
+  int32_t FZorder = FZoarray[pgnum - 1];
 
   // loop over the cube of volume pi^2; note that we do not want to include
   // the opposite edges/facets of the cube, to avoid double counting rotations
   // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-  for(int i = -nsteps; i < nsteps; i++)
+  // The x planes run from -nsteps to nsteps - 1 and are counted first so that
+  // every plane knows where its points go in the output.
+  int numPlanes = 2 * nsteps;
+  std::vector<size_t> planeCounts(numPlanes, 0);
+  std::vector<size_t> planeOffsets(numPlanes, 0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("SO3Sampler"));
+  bool doParallel = true;
+#endif
+
+  SampleRFZImpl counter(this, nsteps, FZtype, FZorder, planeCounts.data(), nullptr, nullptr);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    x = static_cast<double>(i) * delta;
-
-    for(int j = -nsteps; j < nsteps; j++)
-    {
-      y = static_cast<double>(j) * delta;
-
-      for (int k = -nsteps; k < nsteps; k++)
-      {
-        z = static_cast<double>(k) * delta;
+    tbb::parallel_for(tbb::blocked_range<int>(0, numPlanes, 1), counter, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    counter.compute(0, numPlanes);
+  }
 
-        // convert to Rodrigues representation
-        DOrientArrayType cu(x, y, z);
-        DOrientArrayType rod(4);
-        OrientationTransformsType::cu2ro(cu, rod);
+  size_t count = 0;
+  for(int plane = 0; plane < numPlanes; plane++)
+  {
+    planeOffsets[plane] = count;
+    count += planeCounts[plane];
+  }
 
-        // If insideFZ=true, then add this point to the linked list FZlist and keep
-        // track of how many points there are on this list
-        bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-        if (b)
-        {
-          FZlist.push_back(rod);
-        }
+  rodrigues.resize(4 * count);
+  if(count == 0)
+  {
+    return count;
+  }
 
-      }
-    }
+  SampleRFZImpl sampler(this, nsteps, FZtype, FZorder, planeCounts.data(), planeOffsets.data(), rodrigues.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<int>(0, numPlanes, 1), sampler, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    sampler.compute(0, numPlanes);
   }
 
-  return FZlist;
+  return count;
 }
@@ -31,7 +31,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
-
+#include <list>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
@@ -61,6 +62,18 @@ class OrientationLib_EXPORT SO3Sampler
     // sampler routine
     OrientationListArrayType SampleRFZ(int nsteps,int pgnum);
 
+    /**
+     * @brief SampleRFZ Samples the same cubochoric grid as the list based overload but writes the
+     * accepted points into a flat array of 4 component Rodrigues vectors. The x planes of the grid are
+     * first counted and then filled in parallel, each plane writing into its own pre-counted slot, so the
+     * points come out in the same order as the serial loop.
+     * @param nsteps number of steps along the semi-edge of the cubochoric grid
+     * @param pgnum point group number (1-32)
+     * @param rodrigues Receives 4 values per grid point inside the fundamental zone
+     * @return The number of grid points inside the fundamental zone
+     */
+    size_t SampleRFZ(int nsteps, int pgnum, std::vector<double>& rodrigues);
+
     /**
      * @brief IsinsideFZ
      * @param rod
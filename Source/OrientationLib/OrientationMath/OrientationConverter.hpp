@@ -48,6 +48,7 @@
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -394,7 +395,7 @@ class ConvertRepresentation
   typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
   output->initializeWithZeros(); /* Intialize the array with Zeros */\
   T* outPtr = output->getPointer(0);\
-  tbb::task_scheduler_init init;\
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));\
   tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples),\
   ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());\
   this->setOutputData(output);
@@ -527,7 +528,7 @@ class EulerConverter : public OrientationConverter<T>
       int inStride = input->getNumberOfComponents();
       
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
+      tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));
       bool doParallel = true;
 #endif
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -716,7 +717,7 @@ class OrientationMatrixConverter : public OrientationConverter<T>
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
+      tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));
       bool doParallel = true;
 #endif
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -883,7 +884,7 @@ class QuaternionConverter : public OrientationConverter<T>
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
+      tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));
       bool doParallel = true;
 #endif
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -1044,7 +1045,7 @@ class AxisAngleConverter : public OrientationConverter<T>
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
+      tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));
       bool doParallel = true;
 #endif
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -1209,7 +1210,7 @@ class RodriguesConverter : public OrientationConverter<T>
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
+      tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));
       bool doParallel = true;
 #endif
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -1375,7 +1376,7 @@ class HomochoricConverter : public OrientationConverter<T>
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
+      tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));
       bool doParallel = true;
 #endif
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -1542,7 +1543,7 @@ class CubochoricConverter : public OrientationConverter<T>
       size_t nTuples = input->getNumberOfTuples();
       int inStride = input->getNumberOfComponents();
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
+      tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("OrientationConverter"));
       bool doParallel = true;
 #endif
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
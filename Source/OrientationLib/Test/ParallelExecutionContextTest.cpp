@@ -0,0 +1,104 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
+class ParallelExecutionContextTest
+{
+public:
+  ParallelExecutionContextTest() = default;
+  virtual ~ParallelExecutionContextTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestThreadCaps()
+  {
+    ParallelExecutionContext* context = ParallelExecutionContext::Instance();
+    int oldMaxThreads = context->getMaxThreads();
+
+    // Nothing configured lets TBB pick the number of threads
+    context->setMaxThreads(0);
+    context->setThreadCap("ParallelExecutionContextTest", 0);
+    DREAM3D_REQUIRE_EQUAL(context->getNumberOfThreads("ParallelExecutionContextTest"), -1)
+
+    // The cap is used when there is no pool size, otherwise the smaller of the two
+    context->setThreadCap("ParallelExecutionContextTest", 3);
+    DREAM3D_REQUIRE_EQUAL(context->getThreadCap("ParallelExecutionContextTest"), 3)
+    DREAM3D_REQUIRE_EQUAL(context->getNumberOfThreads("ParallelExecutionContextTest"), 3)
+    context->setMaxThreads(2);
+    DREAM3D_REQUIRE_EQUAL(context->getNumberOfThreads("ParallelExecutionContextTest"), 2)
+    DREAM3D_REQUIRE_EQUAL(context->getNumberOfThreads("SomeOtherClass"), 2)
+
+    // The resolved count never reports automatic
+    DREAM3D_REQUIRE_EQUAL(context->getThreadCount("ParallelExecutionContextTest"), 2)
+    context->setMaxThreads(0);
+    DREAM3D_REQUIRE_EQUAL(context->getThreadCount("ParallelExecutionContextTest"), 3)
+
+    context->setThreadCap("ParallelExecutionContextTest", 0);
+    DREAM3D_REQUIRE_EQUAL(context->getThreadCap("ParallelExecutionContextTest"), 0)
+    DREAM3D_REQUIRE(context->getThreadCount("ParallelExecutionContextTest") >= 1)
+    context->setMaxThreads(oldMaxThreads);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestGrainSizes()
+  {
+    ParallelExecutionContext* context = ParallelExecutionContext::Instance();
+    DREAM3D_REQUIRE_EQUAL(context->getGrainSize("ParallelExecutionContextTest"), 1)
+    DREAM3D_REQUIRE_EQUAL(context->getGrainSize("ParallelExecutionContextTest", 64), 64)
+    context->setGrainSize("ParallelExecutionContextTest", 4096);
+    DREAM3D_REQUIRE_EQUAL(context->getGrainSize("ParallelExecutionContextTest", 64), 4096)
+    context->setGrainSize("ParallelExecutionContextTest", 0);
+    DREAM3D_REQUIRE_EQUAL(context->getGrainSize("ParallelExecutionContextTest", 64), 64)
+  }
+
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestThreadCaps())
+    DREAM3D_REGISTER_TEST(TestGrainSizes())
+  }
+
+public:
+  ParallelExecutionContextTest(const ParallelExecutionContextTest&) = delete;            // Copy Constructor Not Implemented
+  ParallelExecutionContextTest(ParallelExecutionContextTest&&) = delete;                 // Move Constructor Not Implemented
+  ParallelExecutionContextTest& operator=(const ParallelExecutionContextTest&) = delete; // Copy Assignment Not Implemented
+  ParallelExecutionContextTest& operator=(ParallelExecutionContextTest&&) = delete;      // Move Assignment Not Implemented
+};
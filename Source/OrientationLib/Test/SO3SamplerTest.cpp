@@ -75,6 +75,71 @@ public:
     DREAM3D_REQUIRE_EQUAL(333227, orientations.size());
   }
 
+  // -----------------------------------------------------------------------------
+  // The serial loop over the cubochoric grid that SampleRFZ used before it counted and filled the points plane by
+  // plane in parallel. It is kept here as an independent reference for the sampler.
+  // -----------------------------------------------------------------------------
+  std::vector<double> ReferenceSampleRFZ(SO3Sampler::Pointer sampler, int nsteps, int FZtype, int FZorder)
+  {
+    std::vector<double> rodrigues;
+    double delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+    for(int i = -nsteps; i < nsteps; i++)
+    {
+      double x = static_cast<double>(i) * delta;
+      for(int j = -nsteps; j < nsteps; j++)
+      {
+        double y = static_cast<double>(j) * delta;
+        for(int k = -nsteps; k < nsteps; k++)
+        {
+          double z = static_cast<double>(k) * delta;
+          DOrientArrayType cu(x, y, z);
+          DOrientArrayType rod(4);
+          OrientationTransformsType::cu2ro(cu, rod);
+          if(sampler->IsinsideFZ(rod.data(), FZtype, FZorder))
+          {
+            rodrigues.insert(rodrigues.end(), rod.data(), rod.data() + 4);
+          }
+        }
+      }
+    }
+    return rodrigues;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SampleRFZReferenceTest()
+  {
+    // Point group number, fundamental zone type and order of the primary rotation axis, as in the tables of
+    // SO3Sampler.cpp: 0 anorthic, 1 cyclic, 2 dihedral, 3 tetrahedral, 4 octahedral
+    const int pointGroups[][3] = {{1, 0, 0}, {3, 1, 2}, {6, 2, 2}, {9, 1, 4}, {12, 2, 4}, {16, 1, 3}, {18, 2, 3}, {21, 1, 6}, {24, 2, 6}, {28, 3, 0}, {30, 4, 0}, {32, 4, 0}};
+
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+    for(int nsteps : {1, 7, 12})
+    {
+      for(const int* pg : pointGroups)
+      {
+        std::vector<double> reference = ReferenceSampleRFZ(sampler, nsteps, pg[1], pg[2]);
+        std::vector<double> rodrigues;
+        size_t count = sampler->SampleRFZ(nsteps, pg[0], rodrigues);
+        DREAM3D_REQUIRE_EQUAL(4 * count, reference.size())
+        DREAM3D_REQUIRE_EQUAL(4 * count, rodrigues.size())
+        for(size_t i = 0; i < reference.size(); i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(rodrigues[i], reference[i])
+        }
+      }
+    }
+
+    // Without any symmetry every grid point is kept
+    std::vector<double> rodrigues;
+    DREAM3D_REQUIRE_EQUAL(sampler->SampleRFZ(10, 1, rodrigues), 8000)
+    DREAM3D_REQUIRE_EQUAL(sampler->SampleRFZ(10, 2, rodrigues), 8000)
+
+    // The cubic m-3m zone of 10 steps keeps the stored point count
+    DREAM3D_REQUIRE_EQUAL(sampler->SampleRFZ(10, 32, rodrigues), 361)
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -133,6 +198,7 @@ public:
     DREAM3D_REGISTER_TEST(InsideCubicFZTest())
     DREAM3D_REGISTER_TEST(TestPyramid())
     DREAM3D_REGISTER_TEST(SO3CountTest())
+    DREAM3D_REGISTER_TEST(SampleRFZReferenceTest())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 
@@ -0,0 +1,174 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/LaueOps/CubicOps.h"
+#include "OrientationLib/LaueOps/HexagonalOps.h"
+
+class SlipTransmissionMetricsTest
+{
+public:
+  SlipTransmissionMetricsTest() = default;
+  virtual ~SlipTransmissionMetricsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QuatF randomQuaternion(std::mt19937& generator)
+  {
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    QuatF q = QuaternionMathF::New(distribution(generator), distribution(generator), distribution(generator), distribution(generator));
+    QuaternionMathF::UnitQuaternion(q);
+    return q;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void requireClose(float value, float expected)
+  {
+    DREAM3D_REQUIRE(std::fabs(value - expected) <= 1.0E-4f * std::max(1.0f, std::fabs(expected)))
+  }
+
+  // -----------------------------------------------------------------------------
+  // The tables built once per orientation must give the same metrics as the per pair functions
+  // -----------------------------------------------------------------------------
+  void TestCubicTablesMatchPairMetrics()
+  {
+    CubicOps::Pointer ops = CubicOps::New();
+    std::mt19937 generator(5489u);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+
+    for(int32_t ld = 0; ld < 4; ld++)
+    {
+      // The sample Z axis used by FindSlipTransmissionMetrics, then random unit loading directions
+      float LD[3] = {0.0f, 0.0f, 1.0f};
+      if(ld > 0)
+      {
+        LD[0] = distribution(generator);
+        LD[1] = distribution(generator);
+        LD[2] = distribution(generator);
+        MatrixMath::Normalize3x1(LD);
+      }
+
+      for(int32_t pair = 0; pair < 250; pair++)
+      {
+        QuatF q1 = randomQuaternion(generator);
+        QuatF q2 = randomQuaternion(generator);
+        // Every tenth pair compares an orientation with itself
+        if(pair % 10 == 0)
+        {
+          QuaternionMathF::Copy(q1, q2);
+        }
+
+        LaueOps::SlipSystemTable table1;
+        LaueOps::SlipSystemTable table2;
+        ops->getSlipSystemTable(q1, LD, table1);
+        ops->getSlipSystemTable(q2, LD, table2);
+        DREAM3D_REQUIRE_EQUAL(table1.numSlipSystems, 12)
+        DREAM3D_REQUIRE_EQUAL(table2.numSlipSystems, 12)
+
+        float mPrime = 0.0f, F1 = 0.0f, F1spt = 0.0f, F7 = 0.0f;
+        ops->getSlipTransmissionMetrics(table1, table2, mPrime, F1, F1spt, F7);
+
+        float expected = 0.0f;
+        ops->getmPrime(q1, q2, LD, expected);
+        requireClose(mPrime, expected);
+        ops->getF1(q1, q2, LD, true, expected);
+        requireClose(F1, expected);
+        ops->getF1spt(q1, q2, LD, true, expected);
+        requireClose(F1spt, expected);
+        ops->getF7(q1, q2, LD, true, expected);
+        requireClose(F7, expected);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Laue classes without slip systems leave the table empty and report 0 for every metric
+  // -----------------------------------------------------------------------------
+  void TestNonCubicMetricsAreZero()
+  {
+    HexagonalOps::Pointer ops = HexagonalOps::New();
+    std::mt19937 generator(5489u);
+    float LD[3] = {0.0f, 0.0f, 1.0f};
+    QuatF q1 = randomQuaternion(generator);
+    QuatF q2 = randomQuaternion(generator);
+
+    LaueOps::SlipSystemTable table1;
+    LaueOps::SlipSystemTable table2;
+    ops->getSlipSystemTable(q1, LD, table1);
+    ops->getSlipSystemTable(q2, LD, table2);
+    DREAM3D_REQUIRE_EQUAL(table1.numSlipSystems, 0)
+    DREAM3D_REQUIRE_EQUAL(table2.numSlipSystems, 0)
+
+    float mPrime = 1.0f, F1 = 1.0f, F1spt = 1.0f, F7 = 1.0f;
+    ops->getSlipTransmissionMetrics(table1, table2, mPrime, F1, F1spt, F7);
+    DREAM3D_REQUIRE_EQUAL(mPrime, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(F1, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(F1spt, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(F7, 0.0f)
+
+    // A cubic table paired with an empty one has nothing to compare either
+    CubicOps::Pointer cubicOps = CubicOps::New();
+    LaueOps::SlipSystemTable cubicTable;
+    cubicOps->getSlipSystemTable(q1, LD, cubicTable);
+    cubicOps->getSlipTransmissionMetrics(cubicTable, table2, mPrime, F1, F1spt, F7);
+    DREAM3D_REQUIRE_EQUAL(mPrime, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(F1, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(F1spt, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(F7, 0.0f)
+  }
+
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestCubicTablesMatchPairMetrics())
+    DREAM3D_REGISTER_TEST(TestNonCubicMetricsAreZero())
+  }
+
+public:
+  SlipTransmissionMetricsTest(const SlipTransmissionMetricsTest&) = delete;            // Copy Constructor Not Implemented
+  SlipTransmissionMetricsTest(SlipTransmissionMetricsTest&&) = delete;                 // Move Constructor Not Implemented
+  SlipTransmissionMetricsTest& operator=(const SlipTransmissionMetricsTest&) = delete; // Copy Assignment Not Implemented
+  SlipTransmissionMetricsTest& operator=(SlipTransmissionMetricsTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,9 +35,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <QtCore/QString>
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -51,6 +59,7 @@
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 /**
  * @class Texture Texture.h AIM/Common/Texture.h
@@ -86,124 +95,9 @@ public:
   */
   template <typename T> static void CalculateCubicODFData(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, bool normalize, T* odf, size_t numEntries)
   {
-    CubicOps ops;
-    Int32ArrayType::Pointer textureBins = Int32ArrayType::CreateArray(numEntries, "TextureBins");
-    int32_t* TextureBins = textureBins->getPointer(0);
-
-    float addweight = 0;
-    float totaladdweight = 0;
-    float totalweight = float(ops.getODFSize());
-    int bin, addbin;
-    int bin1, bin2, bin3;
-    int addbin1, addbin2, addbin3;
-    float dist, fraction;
-
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-      FOrientArrayType rod(4);
-      OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-
-      rod = ops.getODFFZRod(rod);
-      bin = ops.getOdfBin(rod);
-      TextureBins[i] = static_cast<int>(bin);
-    }
-
-    for(int i = 0; i < ops.getODFSize(); i++)
-    {
-      odf[i] = 0;
-    }
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      bin = TextureBins[i];
-      bin1 = bin % 18;
-      bin2 = (bin / 18) % 18;
-      bin3 = bin / (18 * 18);
-      for(int j = -sigmas[i]; j <= sigmas[i]; j++)
-      {
-        int jsqrd = j * j;
-        for(int k = -sigmas[i]; k <= sigmas[i]; k++)
-        {
-          int ksqrd = k * k;
-          for(int l = -sigmas[i]; l <= sigmas[i]; l++)
-          {
-            int lsqrd = l * l;
-            addbin1 = bin1 + int(j);
-            addbin2 = bin2 + int(k);
-            addbin3 = bin3 + int(l);
-            // if(addbin1 < 0) addbin1 = addbin1 + 18;
-            // if(addbin1 >= 18) addbin1 = addbin1 - 18;
-            // if(addbin2 < 0) addbin2 = addbin2 + 18;
-            // if(addbin2 >= 18) addbin2 = addbin2 - 18;
-            // if(addbin3 < 0) addbin3 = addbin3 + 18;
-            // if(addbin3 >= 18) addbin3 = addbin3 - 18;
-            int good = 1;
-            if(addbin1 < 0)
-            {
-              good = 0;
-            }
-            if(addbin1 >= 18)
-            {
-              good = 0;
-            }
-            if(addbin2 < 0)
-            {
-              good = 0;
-            }
-            if(addbin2 >= 18)
-            {
-              good = 0;
-            }
-            if(addbin3 < 0)
-            {
-              good = 0;
-            }
-            if(addbin3 >= 18)
-            {
-              good = 0;
-            }
-            addbin = (addbin3 * 18 * 18) + (addbin2 * 18) + (addbin1);
-            dist = powf((jsqrd + ksqrd + lsqrd), 0.5);
-            fraction = 1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i])));
-            if(dist <= int(sigmas[i]) && good == 1)
-            {
-              addweight = (weights[i] * fraction);
-              if(sigmas[i] == 0.0)
-              {
-                addweight = weights[i];
-              }
-              odf[addbin] = odf[addbin] + addweight;
-              totaladdweight = totaladdweight + addweight;
-            }
-          }
-        }
-      }
-    }
-    if(totaladdweight > totalweight)
-    {
-      float scale = (totaladdweight / totalweight);
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / scale;
-      }
-    }
-    else
-    {
-      float remainingweight = totalweight - totaladdweight;
-      float background = remainingweight / static_cast<float>(ops.getODFSize());
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] += background;
-      }
-    }
-    if(normalize == true)
-    {
-      // Normalize the odf
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / totalweight;
-      }
-    }
+    // The fixed grid CubicOps::getOdfBin() bins into
+    const int32_t binDims[3] = {18, 18, 18};
+    CalculateODFData<T, CubicOps>(e1s, e2s, e3s, weights, sigmas, normalize, odf, numEntries, binDims);
   }
 
   /**
@@ -224,123 +118,9 @@ public:
   */
   template <typename T> static void CalculateHexODFData(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, bool normalize, T* odf, size_t numEntries)
   {
-    HexagonalOps hexOps;
-    Int32ArrayType::Pointer textureBins = Int32ArrayType::CreateArray(numEntries, "TextureBins");
-    int32_t* TextureBins = textureBins->getPointer(0);
-    float addweight = 0;
-    float totaladdweight = 0;
-    float totalweight = float(hexOps.getODFSize());
-    int bin, addbin;
-    int bin1, bin2, bin3;
-    int addbin1, addbin2, addbin3;
-    float dist, fraction;
-    HexagonalOps ops;
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-      FOrientArrayType rod(4);
-      OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-
-      rod = ops.getODFFZRod(rod);
-      bin = ops.getOdfBin(rod);
-      TextureBins[i] = static_cast<int>(bin);
-    }
-
-    for(int i = 0; i < hexOps.getODFSize(); i++)
-    {
-      odf[i] = 0;
-    }
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      bin = TextureBins[i];
-      bin1 = bin % 36;
-      bin2 = (bin / 36) % 36;
-      bin3 = bin / (36 * 36);
-      for(int j = -sigmas[i]; j <= sigmas[i]; j++)
-      {
-        int jsqrd = j * j;
-        for(int k = -sigmas[i]; k <= sigmas[i]; k++)
-        {
-          int ksqrd = k * k;
-          for(int l = -sigmas[i]; l <= sigmas[i]; l++)
-          {
-            int lsqrd = l * l;
-            addbin1 = bin1 + int(j);
-            addbin2 = bin2 + int(k);
-            addbin3 = bin3 + int(l);
-            // if(addbin1 < 0) addbin1 = addbin1 + 36;
-            // if(addbin1 >= 36) addbin1 = addbin1 - 36;
-            // if(addbin2 < 0) addbin2 = addbin2 + 36;
-            // if(addbin2 >= 36) addbin2 = addbin2 - 36;
-            // if(addbin3 < 0) addbin3 = addbin3 + 12;
-            // if(addbin3 >= 12) addbin3 = addbin3 - 12;
-            int good = 1;
-            if(addbin1 < 0)
-            {
-              good = 0;
-            }
-            if(addbin1 >= 36)
-            {
-              good = 0;
-            }
-            if(addbin2 < 0)
-            {
-              good = 0;
-            }
-            if(addbin2 >= 36)
-            {
-              good = 0;
-            }
-            if(addbin3 < 0)
-            {
-              good = 0;
-            }
-            if(addbin3 >= 12)
-            {
-              good = 0;
-            }
-            addbin = (addbin3 * 36 * 36) + (addbin2 * 36) + (addbin1);
-            dist = powf((jsqrd + ksqrd + lsqrd), 0.5);
-            fraction = 1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i])));
-            if(dist <= int(sigmas[i]) && good == 1)
-            {
-              addweight = (weights[i] * fraction);
-              if(sigmas[i] == 0.0)
-              {
-                addweight = weights[i];
-              }
-              odf[addbin] = odf[addbin] + addweight;
-              totaladdweight = totaladdweight + addweight;
-            }
-          }
-        }
-      }
-    }
-    if(totaladdweight > totalweight)
-    {
-      float scale = (totaladdweight / totalweight);
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / scale;
-      }
-    }
-    else
-    {
-      float remainingweight = totalweight - totaladdweight;
-      float background = remainingweight / static_cast<float>(ops.getODFSize());
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] += background;
-      }
-    }
-    if(normalize == true)
-    {
-      // Normalize the odf
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / totalweight;
-      }
-    }
+    // The fixed grid HexagonalOps::getOdfBin() bins into
+    const int32_t binDims[3] = {36, 36, 12};
+    CalculateODFData<T, HexagonalOps>(e1s, e2s, e3s, weights, sigmas, normalize, odf, numEntries, binDims);
   }
 
   /**
@@ -361,123 +141,9 @@ public:
   */
   template <typename T> static void CalculateOrthoRhombicODFData(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, bool normalize, T* odf, size_t numEntries)
   {
-    OrthoRhombicOps ops;
-    SIMPL_RANDOMNG_NEW()
-    Int32ArrayType::Pointer textureBins = Int32ArrayType::CreateArray(numEntries, "TextureBins");
-    int32_t* TextureBins = textureBins->getPointer(0);
-    float addweight = 0;
-    float totaladdweight = 0;
-    float totalweight = float(ops.getODFSize());
-    int bin, addbin;
-    int bin1, bin2, bin3;
-    int addbin1, addbin2, addbin3;
-    float dist, fraction;
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-      FOrientArrayType rod(4);
-      OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-
-      rod = ops.getODFFZRod(rod);
-      bin = ops.getOdfBin(rod);
-      TextureBins[i] = static_cast<int>(bin);
-    }
-
-    for(int i = 0; i < ops.getODFSize(); i++)
-    {
-      odf[i] = 0;
-    }
-    for(size_t i = 0; i < numEntries; i++)
-    {
-      bin = TextureBins[i];
-      bin1 = bin % 36;
-      bin2 = (bin / 36) % 36;
-      bin3 = bin / (36 * 36);
-      for(int j = -sigmas[i]; j <= sigmas[i]; j++)
-      {
-        int jsqrd = j * j;
-        for(int k = -sigmas[i]; k <= sigmas[i]; k++)
-        {
-          int ksqrd = k * k;
-          for(int l = -sigmas[i]; l <= sigmas[i]; l++)
-          {
-            int lsqrd = l * l;
-            addbin1 = bin1 + int(j);
-            addbin2 = bin2 + int(k);
-            addbin3 = bin3 + int(l);
-            // if (addbin1 < 0) addbin1 = addbin1 + 36;
-            // if (addbin1 >= 36) addbin1 = addbin1 - 36;
-            // if (addbin2 < 0) addbin2 = addbin2 + 36;
-            // if (addbin2 >= 36) addbin2 = addbin2 - 36;
-            // if (addbin3 < 0) addbin3 = addbin3 + 36;
-            // if (addbin3 >= 36) addbin3 = addbin3 - 36;
-            int good = 1;
-            if(addbin1 < 0)
-            {
-              good = 0;
-            }
-            if(addbin1 >= 36)
-            {
-              good = 0;
-            }
-            if(addbin2 < 0)
-            {
-              good = 0;
-            }
-            if(addbin2 >= 36)
-            {
-              good = 0;
-            }
-            if(addbin3 < 0)
-            {
-              good = 0;
-            }
-            if(addbin3 >= 36)
-            {
-              good = 0;
-            }
-            addbin = (addbin3 * 36 * 36) + (addbin2 * 36) + (addbin1);
-            dist = sqrtf(jsqrd + ksqrd + lsqrd);
-            fraction = 1.0 - (float(dist / int(sigmas[i])) * float(dist / int(sigmas[i])));
-            if(dist <= int(sigmas[i]) && good == 1)
-            {
-              addweight = (weights[i] * fraction);
-              if(sigmas[i] == 0.0)
-              {
-                addweight = weights[i];
-              }
-              odf[addbin] = odf[addbin] + addweight;
-              totaladdweight = totaladdweight + addweight;
-            }
-          }
-        }
-      }
-    }
-    if(totaladdweight > totalweight)
-    {
-      float scale = (totaladdweight / totalweight);
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / scale;
-      }
-    }
-    else
-    {
-      float remainingweight = totalweight - totaladdweight;
-      float background = remainingweight / static_cast<float>(ops.getODFSize());
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] += background;
-      }
-    }
-    if(normalize == true)
-    {
-      // Normalize the odf
-      for(int i = 0; i < ops.getODFSize(); i++)
-      {
-        odf[i] = odf[i] / totalweight;
-      }
-    }
+    // The fixed grid OrthoRhombicOps::getOdfBin() bins into
+    const int32_t binDims[3] = {36, 36, 36};
+    CalculateODFData<T, OrthoRhombicOps>(e1s, e2s, e3s, weights, sigmas, normalize, odf, numEntries, binDims);
   }
 
   /**
@@ -505,9 +171,17 @@ public:
     int choose1, choose2;
     QuatF q1;
     QuatF q2;
-    float totaldensity;
     float n1, n2, n3;
-    float random1, random2, density;
+    float random1, random2;
+
+    // Running sum of the ODF so each random draw is a binary search instead of a scan of every bin
+    std::vector<float> cumulativeDensity(odfsize, 0.0f);
+    float totaldensity = 0.0f;
+    for(int j = 0; j < odfsize; j++)
+    {
+      totaldensity = totaldensity + odf[j];
+      cumulativeDensity[j] = totaldensity;
+    }
 
     for(int i = 0; i < mdfsize; i++)
     {
@@ -536,20 +210,16 @@ public:
       choose1 = 0;
       choose2 = 0;
 
-      totaldensity = 0;
-      for(int j = 0; j < odfsize; j++)
+      // The first bin whose cumulative density exceeds the random value is the bin that was picked
+      std::vector<float>::const_iterator pick1 = std::upper_bound(cumulativeDensity.cbegin(), cumulativeDensity.cend(), random1);
+      if(pick1 != cumulativeDensity.cend())
       {
-        density = odf[j];
-        float d = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random1 >= d && random1 < totaldensity)
-        {
-          choose1 = static_cast<int>(j);
-        }
-        if(random2 >= d && random2 < totaldensity)
-        {
-          choose2 = static_cast<int>(j);
-        }
+        choose1 = static_cast<int>(pick1 - cumulativeDensity.cbegin());
+      }
+      std::vector<float>::const_iterator pick2 = std::upper_bound(cumulativeDensity.cbegin(), cumulativeDensity.cend(), random2);
+      if(pick2 != cumulativeDensity.cend())
+      {
+        choose2 = static_cast<int>(pick2 - cumulativeDensity.cbegin());
       }
 
       FOrientArrayType eu = orientationOps.determineEulerAngles(m_Seed, choose1);
@@ -593,6 +263,242 @@ protected:
   {
   }
 
+  /**
+   * @brief Entries are only split across threads when each thread gets at least this many
+   */
+  static const size_t k_MinODFEntriesPerChunk = 64;
+
+  /**
+   * @brief CalculateODFData spreads each weight over the bins within sigma bins of the bin that
+   * holds its orientation, scaled by 1 - (d/sigma)^2. Bins that fall outside of the grid are
+   * dropped. The remaining weight is spread evenly over the whole ODF as a background. The bin
+   * resolution is not a choice: binDims must be the fixed grid that LaueOpsType::getOdfBin()
+   * bins into, which is why only the per Laue class builders above call this.
+   * @param e1s The first euler angles
+   * @param e2s The second euler angles
+   * @param e3s The third euler angles
+   * @param weights Array of weights values.
+   * @param sigmas Array of sigma values (in bins).
+   * @param normalize Should the ODF data be normalized by the totalWeight value
+   * before returning.
+   * @param odf (OUT) The ODF data that is generated from this function. This must hold ops.getODFSize() values.
+   * @param numEntries The number of entries of Angle/Weight/Sigmas
+   * @param binDims The number of bins along each of the 3 axes of the getOdfBin() grid
+   */
+  template <typename T, class LaueOpsType>
+  static void CalculateODFData(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, bool normalize, T* odf, size_t numEntries, const int32_t binDims[3])
+  {
+    LaueOpsType ops;
+    const int odfSize = ops.getODFSize();
+    float totalweight = float(odfSize);
+
+    for(int i = 0; i < odfSize; i++)
+    {
+      odf[i] = 0;
+    }
+
+    // Each chunk of entries spreads its kernels into its own grid. The grids are summed in chunk
+    // order so the result does not depend on how the chunks were scheduled.
+    size_t numChunks = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("Texture"));
+    bool doParallel = true;
+    numChunks = static_cast<size_t>(ParallelExecutionContext::Instance()->getThreadCount("Texture"));
+#endif
+    numChunks = std::max(static_cast<size_t>(1), std::min(numChunks, numEntries / k_MinODFEntriesPerChunk));
+    size_t chunkSize = (numEntries + numChunks - 1) / numChunks;
+
+    std::vector<std::vector<T>> grids(numChunks);
+    std::vector<float> addedWeights(numChunks, 0.0f);
+    ODFKernelSpreader<T, LaueOpsType> spreader(e1s, e2s, e3s, weights, sigmas, numEntries, chunkSize, binDims, odfSize, odf, grids, addedWeights);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel && numChunks > 1)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), spreader, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      spreader.spread(0, numChunks);
+    }
+
+    float totaladdweight = 0.0f;
+    for(size_t c = 0; c < numChunks; c++)
+    {
+      totaladdweight = totaladdweight + addedWeights[c];
+      if(c == 0)
+      {
+        continue; // The first chunk writes directly into the ODF
+      }
+      const T* grid = grids[c].data();
+      for(int i = 0; i < odfSize; i++)
+      {
+        odf[i] += grid[i];
+      }
+    }
+
+    if(totaladdweight > totalweight)
+    {
+      float scale = (totaladdweight / totalweight);
+      for(int i = 0; i < odfSize; i++)
+      {
+        odf[i] = odf[i] / scale;
+      }
+    }
+    else
+    {
+      float remainingweight = totalweight - totaladdweight;
+      float background = remainingweight / static_cast<float>(odfSize);
+      for(int i = 0; i < odfSize; i++)
+      {
+        odf[i] += background;
+      }
+    }
+    if(normalize == true)
+    {
+      // Normalize the odf
+      for(int i = 0; i < odfSize; i++)
+      {
+        odf[i] = odf[i] / totalweight;
+      }
+    }
+  }
+
+  /**
+   * @brief The ODFKernelSpreader class bins a chunk of weighted orientations and spreads each of them
+   * over the neighboring ODF bins. The kernel weights only depend on the squared bin distance so they
+   * are tabulated once per sigma, and the kernel extents are clipped to the grid up front instead of
+   * testing every bin.
+   */
+  template <typename T, class LaueOpsType> class ODFKernelSpreader
+  {
+  public:
+    ODFKernelSpreader(T* e1s, T* e2s, T* e3s, T* weights, T* sigmas, size_t numEntries, size_t chunkSize, const int32_t* binDims, int odfSize, T* odf, std::vector<std::vector<T>>& grids,
+                      std::vector<float>& addedWeights)
+    : m_E1s(e1s)
+    , m_E2s(e2s)
+    , m_E3s(e3s)
+    , m_Weights(weights)
+    , m_Sigmas(sigmas)
+    , m_NumEntries(numEntries)
+    , m_ChunkSize(chunkSize)
+    , m_BinDims(binDims)
+    , m_OdfSize(odfSize)
+    , m_Odf(odf)
+    , m_Grids(grids)
+    , m_AddedWeights(addedWeights)
+    {
+    }
+    virtual ~ODFKernelSpreader() = default;
+
+    void spread(size_t start, size_t end) const
+    {
+      LaueOpsType ops;
+      std::vector<T> kernel;
+      int kernelSigma = -1;
+      const int32_t dim0 = m_BinDims[0];
+      const int32_t dim1 = m_BinDims[1];
+      const int32_t dim2 = m_BinDims[2];
+
+      for(size_t c = start; c < end; c++)
+      {
+        T* odf = m_Odf;
+        if(c > 0)
+        {
+          m_Grids[c].assign(m_OdfSize, static_cast<T>(0));
+          odf = m_Grids[c].data();
+        }
+        float totaladdweight = 0.0f;
+        size_t entryEnd = std::min(m_NumEntries, (c + 1) * m_ChunkSize);
+        for(size_t i = c * m_ChunkSize; i < entryEnd; i++)
+        {
+          if(m_Sigmas[i] < 0)
+          {
+            continue;
+          }
+          FOrientArrayType eu(m_E1s[i], m_E2s[i], m_E3s[i]);
+          FOrientArrayType rod(4);
+          OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
+          rod = ops.getODFFZRod(rod);
+          int32_t bin = ops.getOdfBin(rod);
+
+          int32_t sigma = static_cast<int32_t>(m_Sigmas[i]);
+          if(sigma == 0)
+          {
+            odf[bin] = odf[bin] + m_Weights[i];
+            totaladdweight = totaladdweight + m_Weights[i];
+            continue;
+          }
+          int32_t sigmaSqrd = sigma * sigma;
+          if(sigma != kernelSigma)
+          {
+            kernel.resize(sigmaSqrd + 1);
+            for(int32_t d = 0; d <= sigmaSqrd; d++)
+            {
+              kernel[d] = static_cast<T>(1.0 - static_cast<double>(d) / static_cast<double>(sigmaSqrd));
+            }
+            kernelSigma = sigma;
+          }
+
+          int32_t bin1 = bin % dim0;
+          int32_t bin2 = (bin / dim0) % dim1;
+          int32_t bin3 = bin / (dim0 * dim1);
+          int32_t jMin = std::max(-sigma, -bin1);
+          int32_t jMax = std::min(sigma, dim0 - 1 - bin1);
+          int32_t kMin = std::max(-sigma, -bin2);
+          int32_t kMax = std::min(sigma, dim1 - 1 - bin2);
+          int32_t lMin = std::max(-sigma, -bin3);
+          int32_t lMax = std::min(sigma, dim2 - 1 - bin3);
+          for(int32_t l = lMin; l <= lMax; l++)
+          {
+            int32_t lsqrd = l * l;
+            for(int32_t k = kMin; k <= kMax; k++)
+            {
+              int32_t klsqrd = k * k + lsqrd;
+              if(klsqrd > sigmaSqrd)
+              {
+                continue;
+              }
+              T* row = odf + ((bin3 + l) * dim0 * dim1) + ((bin2 + k) * dim0) + bin1;
+              for(int32_t j = jMin; j <= jMax; j++)
+              {
+                int32_t distSqrd = j * j + klsqrd;
+                if(distSqrd <= sigmaSqrd)
+                {
+                  T addweight = m_Weights[i] * kernel[distSqrd];
+                  row[j] = row[j] + addweight;
+                  totaladdweight = totaladdweight + addweight;
+                }
+              }
+            }
+          }
+        }
+        m_AddedWeights[c] = totaladdweight;
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      spread(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    T* m_E1s = nullptr;
+    T* m_E2s = nullptr;
+    T* m_E3s = nullptr;
+    T* m_Weights = nullptr;
+    T* m_Sigmas = nullptr;
+    size_t m_NumEntries = 0;
+    size_t m_ChunkSize = 0;
+    const int32_t* m_BinDims = nullptr;
+    int m_OdfSize = 0;
+    T* m_Odf = nullptr;
+    std::vector<std::vector<T>>& m_Grids;
+    std::vector<float>& m_AddedWeights;
+  };
+
 private:
   Texture(const Texture&);        // Copy Constructor Not Implemented
   void operator=(const Texture&); // Move assignment Not Implemented
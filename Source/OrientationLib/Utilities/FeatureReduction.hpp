@@ -0,0 +1,232 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
+/**
+ * @brief The FeatureReductionPartialsImpl class runs the cell functor over a range of chunks of cells.
+ * Each chunk owns its own table so no two threads ever write the same value.
+ */
+template <typename T, typename CellFunctor> class FeatureReductionPartialsImpl
+{
+public:
+  FeatureReductionPartialsImpl(const CellFunctor& addCell, size_t numCells, size_t chunkSize, std::vector<std::vector<T>>& partials, const T& identity)
+  : m_AddCell(addCell)
+  , m_NumCells(numCells)
+  , m_ChunkSize(chunkSize)
+  , m_Partials(partials)
+  , m_Identity(identity)
+  {
+  }
+  virtual ~FeatureReductionPartialsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      std::vector<T>& table = m_Partials[chunk];
+      std::fill(table.begin(), table.end(), m_Identity);
+      size_t cellEnd = std::min((chunk + 1) * m_ChunkSize, m_NumCells);
+      for(size_t cell = chunk * m_ChunkSize; cell < cellEnd; cell++)
+      {
+        m_AddCell(cell, table.data());
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const CellFunctor& m_AddCell;
+  size_t m_NumCells = 0;
+  size_t m_ChunkSize = 1;
+  std::vector<std::vector<T>>& m_Partials;
+  T m_Identity;
+};
+
+/**
+ * @brief The FeatureReductionMergeImpl class merges the chunk tables of a range of values, always in
+ * chunk order, into the output
+ */
+template <typename T, typename MergeFunctor> class FeatureReductionMergeImpl
+{
+public:
+  FeatureReductionMergeImpl(const std::vector<std::vector<T>>& partials, const MergeFunctor& merge, T* output)
+  : m_Partials(partials)
+  , m_Merge(merge)
+  , m_Output(output)
+  {
+  }
+  virtual ~FeatureReductionMergeImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      T value = m_Partials[0][i];
+      for(size_t chunk = 1; chunk < m_Partials.size(); chunk++)
+      {
+        value = m_Merge(value, m_Partials[chunk][i]);
+      }
+      m_Output[i] = value;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<std::vector<T>>& m_Partials;
+  const MergeFunctor& m_Merge;
+  T* m_Output = nullptr;
+};
+
+/**
+ * @brief The FeatureReduction namespace groups the cells of a volume by feature (or the features by
+ * ensemble) in parallel. The cells are split into contiguous chunks, each chunk is reduced into its
+ * own table of values with the cell functor, and the tables are merged value by value in chunk order.
+ * The chunk boundaries only depend on the number of cells and values and on the configured grain size,
+ * never on the number of threads or the scheduling, so floating point results are the same on every
+ * machine and thread count, with or without TBB.
+ *
+ * The cell functor is called as addCell(cell, table) and adds the cell into the table, usually at
+ * table[featureId * numComponents + component]. The cells of a chunk are visited in increasing order.
+ */
+namespace FeatureReduction
+{
+/**
+ * @brief The most chunks the cells are split into. It is fixed, rather than taken from the thread count,
+ * so that the order in which values are added does not change from one machine to the next.
+ */
+static const size_t k_MaxChunks = 16;
+
+/**
+ * @brief Reduces the cells [0, numCells) into output, which holds numValues values. Every table starts
+ * from identity and the tables are combined with merge(a, b). className selects the thread count and
+ * grain size (the minimum number of cells per chunk) from the ParallelExecutionContext.
+ */
+template <typename T, typename CellFunctor, typename MergeFunctor>
+void Reduce(const QString& className, size_t numCells, size_t numValues, const T& identity, const CellFunctor& addCell, const MergeFunctor& merge, T* output)
+{
+  size_t numChunks = k_MaxChunks;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads(className));
+  bool doParallel = true;
+#endif
+  // Do not let the tables outgrow the cells they reduce
+  size_t grainSize = ParallelExecutionContext::Instance()->getGrainSize(className, 4096);
+  numChunks = std::min(numChunks, std::max(numCells / std::max(grainSize, static_cast<size_t>(1)), static_cast<size_t>(1)));
+  numChunks = std::min(numChunks, std::max(numCells / std::max(numValues, static_cast<size_t>(1)), static_cast<size_t>(1)));
+
+  if(numChunks <= 1)
+  {
+    std::fill(output, output + numValues, identity);
+    for(size_t cell = 0; cell < numCells; cell++)
+    {
+      addCell(cell, output);
+    }
+    return;
+  }
+
+  size_t chunkSize = (numCells + numChunks - 1) / numChunks;
+  numChunks = (numCells + chunkSize - 1) / chunkSize;
+  std::vector<std::vector<T>> partials(numChunks, std::vector<T>(numValues, identity));
+
+  FeatureReductionPartialsImpl<T, CellFunctor> partialsImpl(addCell, numCells, chunkSize, partials, identity);
+  FeatureReductionMergeImpl<T, MergeFunctor> mergeImpl(partials, merge, output);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), partialsImpl, tbb::simple_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numValues), mergeImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    partialsImpl.compute(0, numChunks);
+    mergeImpl.compute(0, numValues);
+  }
+}
+
+/**
+ * @brief Sums the cells [0, numCells) into output, which holds numValues values starting from zero
+ */
+template <typename T, typename CellFunctor> void Sum(const QString& className, size_t numCells, size_t numValues, const CellFunctor& addCell, T* output)
+{
+  Reduce(className, numCells, numValues, static_cast<T>(0), addCell, std::plus<T>(), output);
+}
+
+/**
+ * @brief Sums the cells of an image of dimensions dims into output, which holds numValues values starting
+ * from zero. The voxel functor is called as addVoxel(cell, x, y, z, table) with the cell index and its
+ * column, row and plane, so the filters that need the voxel position (centroids, moments) reduce the
+ * volume the same way as the ones that only count cells. A 2D image is passed as {xPoints, yPoints, 1}.
+ */
+template <typename T, typename VoxelFunctor> void SumImage(const QString& className, const size_t dims[3], size_t numValues, const VoxelFunctor& addVoxel, T* output)
+{
+  const size_t xPoints = dims[0];
+  const size_t yPoints = dims[1];
+  const size_t sliceSize = xPoints * yPoints;
+  auto addCell = [&](size_t cell, T* table) {
+    size_t z = cell / sliceSize;
+    size_t rem = cell - z * sliceSize;
+    size_t y = rem / xPoints;
+    addVoxel(cell, rem - y * xPoints, y, z, table);
+  };
+  Sum(className, sliceSize * dims[2], numValues, addCell, output);
+}
+} // namespace FeatureReduction
@@ -0,0 +1,372 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ParallelExecutionContext.h"
+
+#include <cstdlib>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStringList>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/atomic.h>
+#include <tbb/task_scheduler_init.h>
+#include <tbb/task_scheduler_observer.h>
+#include <tbb/tbb_stddef.h>
+#if TBB_INTERFACE_VERSION >= 11000
+#include <tbb/global_control.h>
+#define ORIENTATIONLIB_HAS_TBB_GLOBAL_CONTROL
+#endif
+#endif
+
+namespace
+{
+const int k_AutomaticThreads = -1;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+/**
+ * @brief The PinningObserver class pins every TBB worker thread that joins the pool to one of the cores in the
+ * affinity mask the process started with (taskset, cgroups), round robin. The master thread that runs the
+ * pipeline is never pinned, and each worker gets its previous affinity back when it leaves the pool.
+ */
+class PinningObserver : public tbb::task_scheduler_observer
+{
+public:
+  PinningObserver()
+  {
+    m_NextCore = 0;
+#if defined(__linux__)
+    cpu_set_t processSet;
+    CPU_ZERO(&processSet);
+    if(sched_getaffinity(0, sizeof(cpu_set_t), &processSet) == 0)
+    {
+      for(int core = 0; core < CPU_SETSIZE; core++)
+      {
+        if(CPU_ISSET(core, &processSet))
+        {
+          m_Cores.push_back(core);
+        }
+      }
+    }
+#endif
+  }
+  ~PinningObserver() override = default;
+
+  void on_scheduler_entry(bool isWorker) override
+  {
+#if defined(__linux__)
+    if(!isWorker || m_Cores.empty())
+    {
+      return;
+    }
+    ThreadAffinity& affinity = CurrentThreadAffinity();
+    if(affinity.pinned || pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &affinity.previous) != 0)
+    {
+      return;
+    }
+    unsigned int next = m_NextCore.fetch_and_increment();
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(m_Cores[next % m_Cores.size()], &cpuSet);
+    affinity.pinned = (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0);
+#endif
+  }
+
+  void on_scheduler_exit(bool isWorker) override
+  {
+#if defined(__linux__)
+    if(!isWorker)
+    {
+      return;
+    }
+    ThreadAffinity& affinity = CurrentThreadAffinity();
+    if(affinity.pinned)
+    {
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &affinity.previous);
+      affinity.pinned = false;
+    }
+#endif
+  }
+
+private:
+#if defined(__linux__)
+  struct ThreadAffinity
+  {
+    bool pinned = false;
+    cpu_set_t previous;
+  };
+
+  static ThreadAffinity& CurrentThreadAffinity()
+  {
+    static thread_local ThreadAffinity affinity;
+    return affinity;
+  }
+
+  std::vector<int> m_Cores;
+#endif
+  tbb::atomic<unsigned int> m_NextCore;
+};
+#endif
+
+/**
+ * @brief Parses a "Name:value,Name:value" list into the map, skipping malformed entries
+ */
+template <typename T> void ParseClassValues(const QString& text, std::map<QString, T>& values)
+{
+  QStringList entries = text.split(',', QString::SkipEmptyParts);
+  for(const QString& entry : entries)
+  {
+    QStringList tokens = entry.split(':');
+    if(tokens.size() != 2)
+    {
+      continue;
+    }
+    bool ok = false;
+    qlonglong value = tokens[1].trimmed().toLongLong(&ok);
+    if(ok && value > 0)
+    {
+      values[tokens[0].trimmed()] = static_cast<T>(value);
+    }
+  }
+}
+} // namespace
+
+class ParallelExecutionContext::Internals
+{
+public:
+#ifdef ORIENTATIONLIB_HAS_TBB_GLOBAL_CONTROL
+  std::unique_ptr<tbb::global_control> m_GlobalControl;
+#endif
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  std::unique_ptr<PinningObserver> m_PinningObserver;
+#endif
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelExecutionContext::ParallelExecutionContext()
+: m_Internals(new Internals)
+{
+  readEnvironment();
+  applyPoolSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelExecutionContext::~ParallelExecutionContext() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelExecutionContext* ParallelExecutionContext::Instance()
+{
+  static ParallelExecutionContext instance;
+  return &instance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelExecutionContext::readEnvironment()
+{
+  QString numThreads = QString::fromLocal8Bit(qgetenv("DREAM3D_NUM_THREADS"));
+  if(!numThreads.isEmpty())
+  {
+    m_MaxThreads = numThreads.toInt();
+  }
+  ParseClassValues(QString::fromLocal8Bit(qgetenv("DREAM3D_THREAD_CAPS")), m_ThreadCaps);
+  ParseClassValues(QString::fromLocal8Bit(qgetenv("DREAM3D_GRAIN_SIZES")), m_GrainSizes);
+  m_PinThreads = (qgetenv("DREAM3D_PIN_THREADS") == "1");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelExecutionContext::applyPoolSettings()
+{
+#ifdef ORIENTATIONLIB_HAS_TBB_GLOBAL_CONTROL
+  m_Internals->m_GlobalControl.reset();
+  if(m_MaxThreads > 0)
+  {
+    m_Internals->m_GlobalControl.reset(new tbb::global_control(tbb::global_control::max_allowed_parallelism, static_cast<size_t>(m_MaxThreads)));
+  }
+#endif
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(m_PinThreads && nullptr == m_Internals->m_PinningObserver)
+  {
+    m_Internals->m_PinningObserver.reset(new PinningObserver);
+    m_Internals->m_PinningObserver->observe(true);
+  }
+  else if(!m_PinThreads && nullptr != m_Internals->m_PinningObserver)
+  {
+    m_Internals->m_PinningObserver->observe(false);
+    m_Internals->m_PinningObserver.reset();
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelExecutionContext::setMaxThreads(int maxThreads)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_MaxThreads = maxThreads;
+  applyPoolSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParallelExecutionContext::getMaxThreads() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_MaxThreads;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelExecutionContext::setThreadCap(const QString& className, int threads)
+{
+  QMutexLocker locker(&m_Mutex);
+  if(threads <= 0)
+  {
+    m_ThreadCaps.erase(className);
+    return;
+  }
+  m_ThreadCaps[className] = threads;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParallelExecutionContext::getThreadCap(const QString& className) const
+{
+  QMutexLocker locker(&m_Mutex);
+  auto iter = m_ThreadCaps.find(className);
+  if(iter == m_ThreadCaps.end())
+  {
+    return 0;
+  }
+  return iter->second;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelExecutionContext::setGrainSize(const QString& className, size_t grainSize)
+{
+  QMutexLocker locker(&m_Mutex);
+  if(grainSize == 0)
+  {
+    m_GrainSizes.erase(className);
+    return;
+  }
+  m_GrainSizes[className] = grainSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ParallelExecutionContext::getGrainSize(const QString& className, size_t defaultGrainSize) const
+{
+  QMutexLocker locker(&m_Mutex);
+  auto iter = m_GrainSizes.find(className);
+  if(iter == m_GrainSizes.end())
+  {
+    return defaultGrainSize;
+  }
+  return iter->second;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParallelExecutionContext::getNumberOfThreads(const QString& className) const
+{
+  QMutexLocker locker(&m_Mutex);
+  int threads = m_MaxThreads;
+  auto iter = m_ThreadCaps.find(className);
+  if(iter != m_ThreadCaps.end() && (threads <= 0 || iter->second < threads))
+  {
+    threads = iter->second;
+  }
+  if(threads <= 0)
+  {
+    return k_AutomaticThreads;
+  }
+  return threads;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParallelExecutionContext::getThreadCount(const QString& className) const
+{
+  int threads = getNumberOfThreads(className);
+  if(threads > 0)
+  {
+    return threads;
+  }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  return tbb::task_scheduler_init::default_num_threads();
+#else
+  return 1;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelExecutionContext::setPinThreads(bool pinThreads)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_PinThreads = pinThreads;
+  applyPoolSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParallelExecutionContext::getPinThreads() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_PinThreads;
+}
@@ -0,0 +1,141 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/OrientationLib.h"
+
+/**
+ * @brief The ParallelExecutionContext class holds the process wide settings that every TBB based
+ * algorithm uses to size its parallel work. Filters and the LaueOps classes ask it for the number of
+ * threads they may use (getNumberOfThreads) and for the grain size of their blocked ranges
+ * (getGrainSize), both looked up by the name of the calling class.
+ *
+ * The settings come from the environment the first time Instance() is called and may be changed
+ * from code afterwards:
+ * @li DREAM3D_NUM_THREADS Total number of worker threads shared by every pipeline in the process
+ * @li DREAM3D_THREAD_CAPS Per class thread caps, e.g. "FindGBCD:4,SampleSurfaceMesh:2"
+ * @li DREAM3D_GRAIN_SIZES Per class grain sizes, e.g. "CubicOps:4096,FindShapes:256"
+ * @li DREAM3D_PIN_THREADS If set to 1, each TBB worker thread is pinned to one core of the process affinity
+ *     mask (Linux only). The thread that runs the pipeline is left alone.
+ *
+ * When TBB provides tbb::global_control the total number of threads is applied to the one TBB worker
+ * pool, so several pipelines running side by side share it instead of each creating a full set of
+ * threads.
+ */
+class OrientationLib_EXPORT ParallelExecutionContext
+{
+public:
+  /**
+   * @brief Returns the singleton instance, creating and configuring it on the first call
+   */
+  static ParallelExecutionContext* Instance();
+
+  virtual ~ParallelExecutionContext();
+
+  /**
+   * @brief Sets the total number of threads of the shared pool. A value <= 0 uses every core.
+   */
+  void setMaxThreads(int maxThreads);
+  int getMaxThreads() const;
+
+  /**
+   * @brief Caps the number of threads the named class may use. A value <= 0 removes the cap.
+   */
+  void setThreadCap(const QString& className, int threads);
+  int getThreadCap(const QString& className) const;
+
+  /**
+   * @brief Sets the grain size used for the blocked ranges of the named class. A value of 0 removes it.
+   */
+  void setGrainSize(const QString& className, size_t grainSize);
+
+  /**
+   * @brief Returns the grain size for the named class or defaultGrainSize if none was configured
+   */
+  size_t getGrainSize(const QString& className, size_t defaultGrainSize = 1) const;
+
+  /**
+   * @brief Returns the number of threads the named class should initialize TBB with: the smaller of
+   * its cap and the pool size, or tbb::task_scheduler_init::automatic if neither is set.
+   */
+  int getNumberOfThreads(const QString& className) const;
+
+  /**
+   * @brief Returns the number of threads the named class will actually run with: getNumberOfThreads, or the
+   * number of cores TBB would use when that is automatic. Use it to size per thread buffers and slabs.
+   */
+  int getThreadCount(const QString& className) const;
+
+  /**
+   * @brief Pins each TBB worker thread to one core of the process affinity mask while it is in the pool and
+   * restores its previous affinity when it leaves. The master thread is never pinned. Only supported on Linux.
+   */
+  void setPinThreads(bool pinThreads);
+  bool getPinThreads() const;
+
+protected:
+  ParallelExecutionContext();
+
+  /**
+   * @brief Reads the settings from the environment variables listed above
+   */
+  void readEnvironment();
+
+  /**
+   * @brief Applies the pool size and the pinning observer to TBB
+   */
+  void applyPoolSettings();
+
+private:
+  mutable QMutex m_Mutex;
+  int m_MaxThreads = 0;
+  bool m_PinThreads = false;
+  std::map<QString, int> m_ThreadCaps;
+  std::map<QString, size_t> m_GrainSizes;
+
+  class Internals;
+  std::unique_ptr<Internals> m_Internals;
+
+public:
+  ParallelExecutionContext(const ParallelExecutionContext&) = delete;            // Copy Constructor Not Implemented
+  ParallelExecutionContext(ParallelExecutionContext&&) = delete;                 // Move Constructor Not Implemented
+  ParallelExecutionContext& operator=(const ParallelExecutionContext&) = delete; // Copy Assignment Not Implemented
+  ParallelExecutionContext& operator=(ParallelExecutionContext&&) = delete;      // Move Assignment Not Implemented
+};
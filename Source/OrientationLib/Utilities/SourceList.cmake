@@ -45,6 +45,8 @@ set(OrientationLib_Utilities_HDRS
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjection3D.hpp
   ${OrientationLib_SOURCE_DIR}/Utilities/ComputeStereographicProjection.h
   ${OrientationLib_SOURCE_DIR}/Utilities/LambertUtilities.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/ParallelExecutionContext.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/FeatureReduction.hpp
 )
 
 set(OrientationLib_Utilities_SRCS
@@ -54,6 +56,7 @@ set(OrientationLib_Utilities_SRCS
   ${OrientationLib_SOURCE_DIR}/Utilities/PoleFigureData.cpp
   ${OrientationLib_SOURCE_DIR}/Utilities/ComputeStereographicProjection.cpp
   ${OrientationLib_SOURCE_DIR}/Utilities/LambertUtilities.cpp
+  ${OrientationLib_SOURCE_DIR}/Utilities/ParallelExecutionContext.cpp
 )
 # QT5_WRAP_CPP( OrientationLib_Generated_MOC_SRCS ${OrientationLib_Utilities_MOC_HDRS} )
 set_source_files_properties( ${OrientationLib_Generated_MOC_SRCS} PROPERTIES HEADER_FILE_ONLY TRUE)
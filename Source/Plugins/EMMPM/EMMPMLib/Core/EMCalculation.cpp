@@ -47,6 +47,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SIMPLib/Messages/GenericErrorMessage.h"
 #include "SIMPLib/Messages/GenericWarningMessage.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
 #include "EMMPMLib/Core/EMMPM_Constants.h"
@@ -130,7 +132,7 @@ EMCalculation::~EMCalculation() = default;
 void EMCalculation::execute()
 {
 #if EMMPM_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("EMCalculation"));
 //  int threads = init.default_num_threads();
 //   std::cout << "TBB Thread Count: " << threads << std::endl;
 #endif
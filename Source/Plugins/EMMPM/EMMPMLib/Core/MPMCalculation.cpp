@@ -53,6 +53,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <random>
 #include <chrono>
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPMLib/Common/EMTime.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
@@ -436,7 +438,7 @@ void MPMCalculation::execute()
     data->inside_mpm_loop = 1;
 
 #if EMMPM_USE_PARALLEL_ALGORITHMS
-    tbb::task_scheduler_init init;
+    tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("MPMCalculation"));
     int threads = tbb::task_scheduler_init::default_num_threads();
 #if USE_TBB_TASK_GROUP
     std::shared_ptr<tbb::task_group> g(new tbb::task_group);
@@ -43,6 +43,8 @@
 #include <sstream>
 #include <string>
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "EMMPMLib/Common/EMMPMInputParser.h"
 #include "EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPMLib/Common/EMTime.h"
@@ -145,7 +147,7 @@ int main(int argc, char* argv[])
 //  unsigned long long int millis = EMMPM_getMilliSeconds();
 
 #if defined(EMMPM_USE_PARALLEL_ALGORITHMS)
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("EMMPM"));
   std::cout << "Default Number of Threads: " << init.default_num_threads() << std::endl;
 #endif
 
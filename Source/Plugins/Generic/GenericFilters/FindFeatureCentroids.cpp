@@ -36,6 +36,7 @@
 #include "FindFeatureCentroids.h"
 
 #include <array>
+#include <vector>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -44,6 +45,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/FeatureReduction.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -153,51 +156,45 @@ void FindFeatureCentroids::find_centroids()
   ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
   size_t totalFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
+  size_t dims[3] = {imageGeom->getXPoints(), imageGeom->getYPoints(), imageGeom->getZPoints()};
 
-  QVector<size_t> dims(1, 4);
-  FloatArrayType::Pointer m_FeatureCentersPtr = FloatArrayType::CreateArray(totalFeatures, dims, "_INTERNAL_USE_ONLY_Centroids");
-  m_FeatureCentersPtr->initializeWithZeros();
-  float* featurecenters = m_FeatureCentersPtr->getPointer(0);
-
-  size_t xPoints = imageGeom->getXPoints();
-  size_t yPoints = imageGeom->getYPoints();
-  size_t zPoints = imageGeom->getZPoints();
-
-  FloatVec3Type spacing(0.0f, 0.0f, 0.0f);
-  imageGeom->getSpacing(spacing);
-  FloatVec3Type origin(0.0f, 0.0f, 0.0f);
-  imageGeom->getOrigin(origin);
-
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
+  // The cell coordinates only depend on the column, row and plane, so look them up once per axis
+  std::vector<float> axisCoords[3] = {std::vector<float>(dims[0]), std::vector<float>(dims[1]), std::vector<float>(dims[2])};
+  std::array<float, 3> coords = {{0.0f, 0.0f, 0.0f}};
+  for(size_t axis = 0; axis < 3; axis++)
   {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    for(size_t i = 0; i < dims[axis]; i++)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        featurecenters[gnum * 4 + 0]++;
-        std::array<float, 3> coords = {{0.0f, 0.0f, 0.0f}};
-        imageGeom->getCoords(k, j, i, coords.data());
-        featurecenters[gnum * 4 + 1] = featurecenters[gnum * 4 + 1] + coords[0];
-        featurecenters[gnum * 4 + 2] = featurecenters[gnum * 4 + 2] + coords[1];
-        featurecenters[gnum * 4 + 3] = featurecenters[gnum * 4 + 3] + coords[2];
-      }
+      size_t ijk[3] = {0, 0, 0};
+      ijk[axis] = i;
+      imageGeom->getCoords(ijk[0], ijk[1], ijk[2], coords.data());
+      axisCoords[axis][i] = coords[axis];
     }
   }
+
+  // Each feature sums its voxel count and the coordinates of its voxels
+  std::vector<double> featurecenters(totalFeatures * 4, 0.0);
+  int32_t* featureIds = m_FeatureIds;
+  const float* xCoords = axisCoords[0].data();
+  const float* yCoords = axisCoords[1].data();
+  const float* zCoords = axisCoords[2].data();
+  FeatureReduction::SumImage<double>("FindFeatureCentroids", dims, totalFeatures * 4,
+                                     [=](size_t cell, size_t x, size_t y, size_t z, double* table) {
+                                       double* center = table + featureIds[cell] * 4;
+                                       center[0] += 1.0;
+                                       center[1] += xCoords[x];
+                                       center[2] += yCoords[y];
+                                       center[3] += zCoords[z];
+                                     },
+                                     featurecenters.data());
+
   for(size_t i = 0; i < totalFeatures; i++)
   {
-    if(featurecenters[i * 4 + 0] > 0.0f)
+    if(featurecenters[i * 4 + 0] > 0.0)
     {
-      featurecenters[i * 4 + 1] = featurecenters[i * 4 + 1] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 2] = featurecenters[i * 4 + 2] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 3] = featurecenters[i * 4 + 3] / featurecenters[i * 4 + 0];
-      m_Centroids[3 * i] = featurecenters[i * 4 + 1];
-      m_Centroids[3 * i + 1] = featurecenters[i * 4 + 2];
-      m_Centroids[3 * i + 2] = featurecenters[i * 4 + 3];
+      m_Centroids[3 * i] = static_cast<float>(featurecenters[i * 4 + 1] / featurecenters[i * 4 + 0]);
+      m_Centroids[3 * i + 1] = static_cast<float>(featurecenters[i * 4 + 2] / featurecenters[i * 4 + 0]);
+      m_Centroids[3 * i + 2] = static_cast<float>(featurecenters[i * 4 + 3] / featurecenters[i * 4 + 0]);
     }
   }
 }
@@ -35,6 +35,10 @@
 
 #include "FindFeaturePhases.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -42,6 +46,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "OrientationLib/Utilities/FeatureReduction.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -179,33 +185,59 @@ void FindFeaturePhases::execute()
   }
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  int32_t* featureIds = m_FeatureIds;
+  int32_t* cellPhases = m_CellPhases;
 
-  int32_t gnum = 0;
-  QMap<int32_t, int32_t> featureMap;
-
-  QMap<int32_t, int32_t> warningMap;
-
-  for(size_t i = 0; i < totalPoints; i++)
+  // The first and last element of every feature; the phase of the last one is copied into the feature
+  // and every element that disagrees with the first one is reported
+  struct ElementRange
   {
-    gnum = m_FeatureIds[i];
-    if(!featureMap.contains(gnum))
+    int64_t first;
+    int64_t last;
+  };
+  const ElementRange emptyRange = {std::numeric_limits<int64_t>::max(), -1};
+  std::vector<ElementRange> ranges(totalFeatures, emptyRange);
+  FeatureReduction::Reduce<ElementRange>("FindFeaturePhases", totalPoints, totalFeatures, emptyRange,
+                                         [=](size_t i, ElementRange* table) {
+                                           ElementRange& range = table[featureIds[i]];
+                                           range.first = std::min(range.first, static_cast<int64_t>(i));
+                                           range.last = static_cast<int64_t>(i);
+                                         },
+                                         [](const ElementRange& a, const ElementRange& b) {
+                                           ElementRange range = {std::min(a.first, b.first), std::max(a.last, b.last)};
+                                           return range;
+                                         },
+                                         ranges.data());
+
+  std::vector<int32_t> firstPhases(totalFeatures, 0);
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    if(ranges[i].last >= 0)
     {
-      featureMap.insert(gnum, m_CellPhases[i]);
+      firstPhases[i] = m_CellPhases[ranges[i].first];
+      m_FeaturePhases[i] = m_CellPhases[ranges[i].last];
     }
-    int32_t curPhaseVal = featureMap.value(gnum);
+  }
+
+  std::vector<int32_t> mismatches(totalFeatures, 0);
+  const int32_t* firstPhasesPtr = firstPhases.data();
+  FeatureReduction::Sum<int32_t>("FindFeaturePhases", totalPoints, totalFeatures,
+                                 [=](size_t i, int32_t* table) {
+                                   if(cellPhases[i] != firstPhasesPtr[featureIds[i]])
+                                   {
+                                     table[featureIds[i]]++;
+                                   }
+                                 },
+                                 mismatches.data());
 
-    if(curPhaseVal != m_CellPhases[i])
+  QMap<int32_t, int32_t> warningMap;
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    if(mismatches[i] > 0)
     {
-      if(!warningMap.contains(gnum))
-      {
-        warningMap[gnum] = 1;
-      }
-      else
-      {
-        warningMap[gnum]++;
-      }
+      warningMap[static_cast<int32_t>(i)] = mismatches[i];
     }
-    m_FeaturePhases[gnum] = m_CellPhases[i];
   }
 
   if(!warningMap.empty())
@@ -38,6 +38,10 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
@@ -47,7 +51,10 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BlockReader.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -314,8 +321,9 @@ void DxReader::execute()
     return;
   }
 
+  // The file is opened without text translation so the block reader can reposition it by byte count
   m_InStream.setFileName(getInputFile());
-  if(!m_InStream.open(QIODevice::ReadOnly | QIODevice::Text))
+  if(!m_InStream.open(QIODevice::ReadOnly))
   {
     QString ss = QObject::tr("Error opening input file '%1'").arg(getInputFile());
     setErrorCondition(-100, ss);
@@ -449,10 +457,6 @@ int32_t DxReader::readFile()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getVolumeDataContainerName());
 
-  bool finished_header = true;
-  bool finished_data = false;
-  size_t index = 0;
-
   // Resize the Cell Attribute Matrix based on the number of points about to be read.
   QVector<size_t> tDims(3, 0);
   tDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
@@ -467,62 +471,27 @@ int32_t DxReader::readFile()
     return -1;
   }
 
-  bool ok = false;
-  QByteArray buf = m_InStream.readLine();
-
-  size_t xIdx = 0, yIdx = 0, zIdx = 0;
-  size_t count = 0;
-
-  while(buf.size() > 0 && !m_InStream.atEnd())
-  {
-    // Get the remaining lines of the header and ignore
-    buf = buf.simplified();
-    QList<QByteArray> tokens = buf.split(' ');
-
-    size_t total = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-    if(count == total || (finished_header && !tokens.empty() && tokens[0] == "attribute"))
-    {
-      finished_data = true;
-    }
-
-    if(finished_header && !finished_data)
-    {
-      qint32 size = tokens.size();
-      for(qint32 in_spins = 0; in_spins < size; in_spins++)
-      {
-        int32_t fId = tokens[in_spins].toInt(&ok, 10);
-        count++;
-        index = (zIdx * tDims[0] * tDims[1]) + (tDims[0] * yIdx) + xIdx;
-
-        m_FeatureIds[index] = fId;
-
-        zIdx++; // Increment zIdx and then check all the indices and wrap back to zero if needed.
-
-        if(zIdx == tDims[2])
-        {
-          zIdx = 0;
-          yIdx++;
-        }
-
-        if(yIdx == tDims[1])
-        {
-          yIdx = 0;
-          xIdx++;
-        }
-
-        if(xIdx == tDims[0])
-        {
-          xIdx = 0;
-          Q_ASSERT(count == total);
-        }
-      }
-    }
-    buf = m_InStream.readLine();
-  }
-
-  if(count != static_cast<size_t>(m->getGeometryAs<ImageGeom>()->getNumberOfElements()))
+  // The values are listed with Z changing fastest, so each one is scattered to its X fastest index as it is parsed
+  size_t total = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+  size_t nx = tDims[0];
+  size_t ny = tDims[1];
+  size_t nz = tDims[2];
+  int32_t* featureIds = m_FeatureIds;
+  auto storeFeatureId = [featureIds, nx, ny, nz](size_t n, int32_t fId) {
+    size_t zIdx = n % nz;
+    size_t yIdx = (n / nz) % ny;
+    size_t xIdx = n / (nz * ny);
+    featureIds[(zIdx * nx * ny) + (nx * yIdx) + xIdx] = fId;
+  };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("DxReader"));
+#endif
+  size_t count = BlockReader::ReadAsciiValues<int32_t>(m_InStream, total, storeFeatureId);
+
+  if(count != total)
   {
-    QString ss = QObject::tr("Data size does not match header dimensions\t%1\t%2").arg(index).arg(m->getGeometryAs<ImageGeom>()->getNumberOfElements());
+    QString ss = QObject::tr("Data size does not match header dimensions\t%1\t%2").arg(count).arg(total);
     setErrorCondition(-495, ss);
     m_InStream.close();
     return getErrorCode();
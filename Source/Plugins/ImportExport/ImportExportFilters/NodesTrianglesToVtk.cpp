@@ -47,6 +47,7 @@
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -242,29 +243,31 @@ void NodesTrianglesToVtk::execute()
   int nodeKind = 0;
   float pos[3] = {0.0f, 0.0f, 0.0f};
 
-  size_t totalWritten = 0;
   size_t nread = 0;
-  // Write the POINTS data (Vertex)
-  for(int i = 0; i < nNodes; i++)
+  // Write the POINTS data (Vertex). The positions are gathered first and then written in a few large blocks.
   {
-    nread = fscanf(nodesFile, "%d %d %f %f %f", &nodeId, &nodeKind, pos, pos + 1, pos + 2); // Read one set of positions from the nodes file
-    if(nread != 5)
-    {
-      break;
-    }
-    if(m_WriteBinaryFile)
+    std::vector<float> positions;
+    positions.reserve(static_cast<size_t>(nNodes) * 3);
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(int i = 0; i < nNodes; i++)
     {
-      SIMPLib::Endian::FromSystemToBig::convert(pos[0]);
-      SIMPLib::Endian::FromSystemToBig::convert(pos[1]);
-      SIMPLib::Endian::FromSystemToBig::convert(pos[2]);
-      totalWritten = fwrite(pos, sizeof(float), 3, vtkFile);
-      if(totalWritten != sizeof(float) * 3)
+      nread = fscanf(nodesFile, "%d %d %f %f %f", &nodeId, &nodeKind, pos, pos + 1, pos + 2); // Read one set of positions from the nodes file
+      if(nread != 5)
+      {
+        break;
+      }
+      if(m_WriteBinaryFile)
       {
+        positions.insert(positions.end(), pos, pos + 3);
+      }
+      else
+      {
+        text.printf("%f %f %f\n", pos[0], pos[1], pos[2]); // Write the positions to the output file
       }
     }
-    else
+    if(m_WriteBinaryFile)
     {
-      fprintf(vtkFile, "%f %f %f\n", pos[0], pos[1], pos[2]); // Write the positions to the output file
+      BinaryBlockWriter::WriteArray<float>(vtkFile, positions.data(), positions.size(), BinaryBlockWriter::ByteOrder::BigEndian);
     }
   }
   fclose(nodesFile);
@@ -282,36 +285,38 @@ void NodesTrianglesToVtk::execute()
   }
   // Write the CELLS Data
   fprintf(vtkFile, "POLYGONS %d %d\n", triangleCount, (triangleCount * 4));
-  for(int i = 0; i < nTriangles; i++)
   {
-    // Read from the Input Triangles Temp File
-    nread = fscanf(triFile, "%d %d %d %d %d %d %d %d %d", tData, tData + 1, tData + 2, tData + 3, tData + 4, tData + 5, tData + 6, tData + 7, tData + 8);
-    if(m_WriteBinaryFile)
+    std::vector<int32_t> polygons;
+    polygons.reserve(static_cast<size_t>(triangleCount) * 4);
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(int i = 0; i < nTriangles; i++)
     {
-      tData[0] = 3; // Push on the total number of entries for this entry
-      SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[1]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[2]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[3]);
-      fwrite(tData, sizeof(int), 4, vtkFile);
-      if(!m_WriteConformalMesh)
+      // Read from the Input Triangles Temp File
+      nread = fscanf(triFile, "%d %d %d %d %d %d %d %d %d", tData, tData + 1, tData + 2, tData + 3, tData + 4, tData + 5, tData + 6, tData + 7, tData + 8);
+      if(m_WriteBinaryFile)
       {
-        tData[0] = tData[1];
-        tData[1] = tData[3];
-        tData[3] = tData[0];
-        tData[0] = 3;
-        SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-        fwrite(tData, sizeof(int), 4, vtkFile);
+        // Push on the total number of entries for this entry, then the flipped copy for a non-conformal mesh
+        int32_t polygon[4] = {3, tData[1], tData[2], tData[3]};
+        polygons.insert(polygons.end(), polygon, polygon + 4);
+        if(!m_WriteConformalMesh)
+        {
+          int32_t flipped[4] = {3, tData[3], tData[2], tData[1]};
+          polygons.insert(polygons.end(), flipped, flipped + 4);
+        }
       }
-    }
-    else
-    {
-      fprintf(vtkFile, "3 %d %d %d\n", tData[1], tData[2], tData[3]);
-      if(!m_WriteConformalMesh)
+      else
       {
-        fprintf(vtkFile, "3 %d %d %d\n", tData[3], tData[2], tData[1]);
+        text.printf("3 %d %d %d\n", tData[1], tData[2], tData[3]);
+        if(!m_WriteConformalMesh)
+        {
+          text.printf("3 %d %d %d\n", tData[3], tData[2], tData[1]);
+        }
       }
     }
+    if(m_WriteBinaryFile)
+    {
+      BinaryBlockWriter::WriteArray<int32_t>(vtkFile, polygons.data(), polygons.size(), BinaryBlockWriter::ByteOrder::BigEndian);
+    }
   }
   fclose(triFile);
 
@@ -380,7 +385,6 @@ int NodesTrianglesToVtk::writeBinaryPointData(const QString& NodesFile, FILE* vt
   int nodeId = 0;
   int nodeKind = 0;
   float pos[3] = {0.0f, 0.0f, 0.0f};
-  int swapped;
   int nread = 0;
   FILE* nodesFile = fopen(NodesFile.toLatin1().data(), "rb");
   fprintf(vtkFile, "\n");
@@ -396,14 +400,11 @@ int NodesTrianglesToVtk::writeBinaryPointData(const QString& NodesFile, FILE* vt
     {
       break;
     }
-    swapped = nodeKind;
-    SIMPLib::Endian::FromSystemToBig::convert(swapped);
-
-    data[i] = swapped;
+    data[i] = nodeKind;
   }
-  int totalWritten = fwrite(&(data.front()), sizeof(int), nNodes, vtkFile);
+  bool ok = BinaryBlockWriter::WriteArray<int>(vtkFile, data.data(), data.size(), BinaryBlockWriter::ByteOrder::BigEndian);
   fclose(nodesFile);
-  if(totalWritten != nNodes)
+  if(!ok)
   {
     return -1;
   }
@@ -427,6 +428,7 @@ int NodesTrianglesToVtk::writeASCIIPointData(const QString& NodesFile, FILE* vtk
   fprintf(vtkFile, "SCALARS Node_Type int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
   fscanf(nodesFile, "%d", &nodeId); // Read the number of nodes
+  BinaryBlockWriter::TextBlockWriter text(vtkFile);
   for(int i = 0; i < nNodes; i++)
   {
     nread = fscanf(nodesFile, "%d %d %f %f %f", &nodeId, &nodeKind, pos, pos + 1, pos + 2); // Read one set of positions from the nodes file
@@ -434,8 +436,9 @@ int NodesTrianglesToVtk::writeASCIIPointData(const QString& NodesFile, FILE* vtk
     {
       break;
     }
-    fprintf(vtkFile, "%d\n", nodeKind); // Write the Node Kind to the output file
+    text.printf("%d\n", nodeKind); // Write the Node Kind to the output file
   }
+  text.flush();
 
   // Close the input files
   fclose(nodesFile);
@@ -482,20 +485,16 @@ int NodesTrianglesToVtk::writeBinaryCellData(const QString& TrianglesFile, FILE*
     {
       return -1;
     }
-    SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
     tri_ids[i * offset] = tData[0];
-    SIMPLib::Endian::FromSystemToBig::convert(tData[7]);
     cell_data[i * offset] = tData[7];
     if(!conformalMesh)
     {
-      SIMPLib::Endian::FromSystemToBig::convert(tData[8]);
       cell_data[i * offset + 1] = tData[8];
       tri_ids[i * offset + 1] = tData[0];
     }
   }
 
-  int totalWritten = fwrite(&(cell_data.front()), sizeof(int), triangleCount, vtkFile);
-  if(totalWritten != triangleCount)
+  if(!BinaryBlockWriter::WriteArray<int>(vtkFile, cell_data.data(), cell_data.size(), BinaryBlockWriter::ByteOrder::BigEndian))
   {
     return -1;
   }
@@ -505,8 +504,7 @@ int NodesTrianglesToVtk::writeBinaryCellData(const QString& TrianglesFile, FILE*
   fprintf(vtkFile, "SCALARS TriangleID int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  totalWritten = fwrite(&(tri_ids.front()), sizeof(int), triangleCount, vtkFile);
-  if(totalWritten != triangleCount)
+  if(!BinaryBlockWriter::WriteArray<int>(vtkFile, tri_ids.data(), tri_ids.size(), BinaryBlockWriter::ByteOrder::BigEndian))
   {
     return -1;
   }
@@ -538,6 +536,7 @@ int NodesTrianglesToVtk::writeASCIICellData(const QString& TrianglesFile, FILE*
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
   int tData[9];
+  BinaryBlockWriter::TextBlockWriter text(vtkFile);
   for(int i = 0; i < nTriangles; i++)
   {
     nread = fscanf(triFile, "%d %d %d %d %d %d %d %d %d", tData, tData + 1, tData + 2, tData + 3, tData + 4, tData + 5, tData + 6, tData + 7, tData + 8);
@@ -545,10 +544,10 @@ int NodesTrianglesToVtk::writeASCIICellData(const QString& TrianglesFile, FILE*
     {
       return -1;
     }
-    fprintf(vtkFile, "%d\n", tData[7]);
+    text.printf("%d\n", tData[7]);
     if(!conformalMesh)
     {
-      fprintf(vtkFile, "%d\n", tData[8]);
+      text.printf("%d\n", tData[8]);
     }
   }
   fclose(triFile);
@@ -38,6 +38,10 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
@@ -47,7 +51,10 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BlockReader.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 #define BUF_SIZE 1024
@@ -308,7 +315,8 @@ void PhReader::execute()
     return;
   }
 
-  m_InStream = fopen(getInputFile().toLatin1().data(), "r");
+  // Opened in binary mode so the block reader can reposition the stream by byte count
+  m_InStream = fopen(getInputFile().toLatin1().data(), "rb");
   if(m_InStream == nullptr)
   {
     QString ss = QObject::tr("Error opening input file '%1'").arg(getInputFile());
@@ -388,15 +396,15 @@ int32_t PhReader::readFile()
   m->getAttributeMatrix(getCellAttributeMatrixName())->resizeAttributeArrays(tDims);
   updateCellInstancePointers();
 
-  for(size_t n = 0; n < totalPoints; ++n)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("PhReader"));
+#endif
+  if(BlockReader::ReadAsciiValues<int32_t>(m_InStream, totalPoints, m_FeatureIds) != totalPoints)
   {
-    if(fscanf(m_InStream, "%d", m_FeatureIds + n) == 0)
-    {
-      fclose(m_InStream);
-      m_InStream = nullptr;
-      setErrorCondition(-48040, "Error reading Ph data");
-      return getErrorCode();
-    }
+    fclose(m_InStream);
+    m_InStream = nullptr;
+    setErrorCondition(-48040, "Error reading Ph data");
+    return getErrorCode();
   }
 
   // Now set the Spacing and Origin that the user provided on the GUI or as parameters
@@ -35,25 +35,36 @@
 
 #include "ReadStlFile.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
+#include <tbb/parallel_sort.h>
 #include <tbb/task_scheduler_init.h>
 #endif
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
 #define STL_HEADER_LENGTH 80
+#define STL_TRIANGLE_LENGTH 50
 
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -65,54 +76,98 @@ enum createdPathID : RenameDataPath::DataID_t
 };
 
 /**
- * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
+ * @brief The VertexWeldGrid class orders vertex indices by the cell of a grid anchored at the bounding box minimum
+ * that they fall into, and by index within a cell. The cells are as large as the weld tolerance, so two vertices
+ * within the tolerance of each other always fall into the same or into neighboring cells. With a zero tolerance
+ * vertices are ordered by their exact coordinates instead, so identical vertices end up next to each other.
  */
-class FindUniqueIdsImpl
+class VertexWeldGrid
 {
 public:
-  FindUniqueIdsImpl(SharedVertexList::Pointer vertex, QVector<QVector<size_t>> nodesInBin, int64_t* uniqueIds)
+  using CellKey = std::array<int64_t, 3>;
+
+  VertexWeldGrid(const float* vertex, float tolerance, float minX, float minY, float minZ)
   : m_Vertex(vertex)
-  , m_NodesInBin(nodesInBin)
-  , m_UniqueIds(uniqueIds)
+  , m_InvTolerance(tolerance > 0.0f ? 1.0 / static_cast<double>(tolerance) : 0.0)
   {
+    m_Origin[0] = minX;
+    m_Origin[1] = minY;
+    m_Origin[2] = minZ;
   }
 
-  void convert(size_t start, size_t end) const
+  int32_t compareKeys(int64_t a, int64_t b) const
   {
-    float* verts = m_Vertex->getPointer(0);
-    for(size_t i = start; i < end; i++)
+    for(int32_t c = 0; c < 3; c++)
     {
-      for(int32_t j = 0; j < m_NodesInBin[i].size(); j++)
+      if(m_InvTolerance > 0.0)
       {
-        size_t node1 = m_NodesInBin[i][j];
-        if(m_UniqueIds[node1] == node1)
+        int64_t cellA = cell(a, c);
+        int64_t cellB = cell(b, c);
+        if(cellA != cellB)
         {
-          for(int32_t k = j + 1; k < m_NodesInBin[i].size(); k++)
-          {
-            size_t node2 = m_NodesInBin[i][k];
-            if(verts[node1 * 3] == verts[node2 * 3] && verts[node1 * 3 + 1] == verts[node2 * 3 + 1] && verts[node1 * 3 + 2] == verts[node2 * 3 + 2])
-            {
-              m_UniqueIds[node2] = node1;
-            }
-          }
+          return cellA < cellB ? -1 : 1;
         }
       }
+      else if(m_Vertex[a * 3 + c] != m_Vertex[b * 3 + c])
+      {
+        return m_Vertex[a * 3 + c] < m_Vertex[b * 3 + c] ? -1 : 1;
+      }
     }
+    return 0;
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  bool operator()(int64_t a, int64_t b) const
   {
-    convert(r.begin(), r.end());
+    int32_t cmp = compareKeys(a, b);
+    return cmp == 0 ? a < b : cmp < 0;
   }
-#endif
+
+  CellKey cellKey(int64_t v) const
+  {
+    return {{cell(v, 0), cell(v, 1), cell(v, 2)}};
+  }
+
+  int32_t compareCell(int64_t v, const CellKey& key) const
+  {
+    for(int32_t c = 0; c < 3; c++)
+    {
+      int64_t cellV = cell(v, c);
+      if(cellV != key[c])
+      {
+        return cellV < key[c] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
 private:
-  SharedVertexList::Pointer m_Vertex;
-  QVector<QVector<size_t>> m_NodesInBin;
-  int64_t* m_UniqueIds;
+  const float* m_Vertex;
+  double m_InvTolerance;
+  float m_Origin[3];
+
+  int64_t cell(int64_t v, int32_t c) const
+  {
+    // Clamping keeps tiny tolerances from overflowing the cell index. Nearby vertices still land in the same or in
+    // neighboring cells, and the distance check sorts out the rest.
+    const double k_MaxCell = 4503599627370496.0; // 2^52
+    double index = std::floor((static_cast<double>(m_Vertex[v * 3 + c]) - m_Origin[c]) * m_InvTolerance);
+    return static_cast<int64_t>(std::max(-k_MaxCell, std::min(index, k_MaxCell)));
+  }
 };
 
+/**
+ * @brief FindWeldRoot Returns the smallest vertex index of the weld group of v, halving the path on the way
+ */
+static int64_t FindWeldRoot(std::vector<int64_t>& parent, int64_t v)
+{
+  while(parent[v] != v)
+  {
+    parent[v] = parent[parent[v]];
+    v = parent[v];
+  }
+  return v;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -121,6 +176,7 @@ ReadStlFile::ReadStlFile()
 , m_FaceAttributeMatrixName(SIMPL::Defaults::FaceAttributeMatrixName)
 , m_StlFilePath("")
 , m_FaceNormalsArrayName(SIMPL::FaceData::SurfaceMeshFaceNormals)
+, m_WeldTolerance(0.0f)
 , m_minXcoord(std::numeric_limits<float>::max())
 , m_maxXcoord(-std::numeric_limits<float>::max())
 , m_minYcoord(std::numeric_limits<float>::max())
@@ -143,6 +199,7 @@ void ReadStlFile::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("STL File", StlFilePath, FilterParameter::Parameter, ReadStlFile, "*.stl", "STL File"));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Vertex Weld Tolerance", WeldTolerance, FilterParameter::Parameter, ReadStlFile));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", SurfaceMeshDataContainerName, FilterParameter::CreatedArray, ReadStlFile));
   parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_STRING_FP("Face Attribute Matrix", FaceAttributeMatrixName, FilterParameter::CreatedArray, ReadStlFile));
@@ -160,6 +217,7 @@ void ReadStlFile::readFilterParameters(AbstractFilterParametersReader* reader, i
   setFaceAttributeMatrixName(reader->readString("FaceAttributeMatrixName", getFaceAttributeMatrixName()));
   setSurfaceMeshDataContainerName(reader->readDataArrayPath("SurfaceMeshDataContainerName", getSurfaceMeshDataContainerName()));
   setFaceNormalsArrayName(reader->readString("FaceNormalsArrayName", getFaceNormalsArrayName()));
+  setWeldTolerance(reader->readValue("WeldTolerance", getWeldTolerance()));
   reader->closeFilterGroup();
 }
 
@@ -206,6 +264,11 @@ void ReadStlFile::dataCheck()
     setErrorCondition(-1003, "The input file must be set");
   }
 
+  if(m_WeldTolerance < 0.0f)
+  {
+    setErrorCondition(-1005, "The vertex weld tolerance must be zero or positive");
+  }
+
   // Create a SufaceMesh Data Container with Faces, Vertices, Feature Labels and optionally Phase labels
   DataContainer::Pointer sm = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getSurfaceMeshDataContainerName(), DataContainerID);
   if(getErrorCode() < 0)
@@ -257,6 +320,10 @@ void ReadStlFile::execute()
   }
 
   readFile();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
   eliminate_duplicate_nodes();
 
   clearErrorCode();
@@ -301,6 +368,24 @@ void ReadStlFile::readFile()
   // Read the number of triangles in the file.
   fread(&triCount, sizeof(int32_t), 1, f);
 
+  // ASCII files start with "solid", but so do the headers of some binary writers. Only
+  // treat the file as ASCII when its size does not match the binary layout.
+  qint64 binarySize = STL_HEADER_LENGTH + sizeof(int32_t) + static_cast<qint64>(triCount) * STL_TRIANGLE_LENGTH;
+  if(headerArray.trimmed().startsWith("solid") && QFileInfo(m_StlFilePath).size() != binarySize)
+  {
+    fclose(f);
+    readAsciiFile();
+    return;
+  }
+
+  if(triCount < 0)
+  {
+    fclose(f);
+    QString ss = QString("The STL file reports an invalid number of triangles (%1)").arg(triCount);
+    setErrorCondition(-1004, ss);
+    return;
+  }
+
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triCount);
   triangleGeom->resizeVertexList(triCount * 3);
@@ -312,108 +397,179 @@ void ReadStlFile::readFile()
   sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
   updateFaceInstancePointers();
 
-  // Read the triangles
+  // Read the triangles a block at a time and parse them out of memory instead of
+  // issuing several small freads for every triangle.
   static const size_t k_StlElementCount = 12;
-  float v[k_StlElementCount];
-  unsigned short attr;
-  for(int32_t t = 0; t < triCount; ++t)
-  {
-    fread(reinterpret_cast<void*>(v), sizeof(float), k_StlElementCount, f); // Read the Triangle
-
-    fread(reinterpret_cast<void*>(&attr), sizeof(unsigned short), 1, f); // Read the Triangle Attribute Data length
-    if(attr > 0 && !magicsFile)
-    {
-      std::vector<unsigned char> buffer(attr);                       // Allocate a buffer for the STL attribute data to be placed into
-      fread(reinterpret_cast<void*>(&(buffer.front())), attr, 1, f); // Read the bytes into the buffer so that we can skip it.
-    }
-    if(v[3] < m_minXcoord)
-    {
-      m_minXcoord = v[3];
-    }
-    if(v[3] > m_maxXcoord)
-    {
-      m_maxXcoord = v[3];
-    }
-    if(v[4] < m_minYcoord)
-    {
-      m_minYcoord = v[4];
-    }
-    if(v[4] > m_maxYcoord)
-    {
-      m_maxYcoord = v[4];
-    }
-    if(v[5] < m_minZcoord)
-    {
-      m_minZcoord = v[5];
-    }
-    if(v[5] > m_maxZcoord)
-    {
-      m_maxZcoord = v[5];
-    }
-    if(v[6] < m_minXcoord)
-    {
-      m_minXcoord = v[6];
-    }
-    if(v[6] > m_maxXcoord)
+  static const size_t k_TrianglesPerBlock = 65536;
+  std::vector<char> buffer(STL_TRIANGLE_LENGTH * k_TrianglesPerBlock);
+  size_t bufferEnd = 0;
+  size_t cursor = 0;
+  // Makes sure at least 'needed' unread bytes are in the buffer, returns false at the end of the file
+  auto fillBuffer = [&](size_t needed) -> bool {
+    if(bufferEnd - cursor >= needed)
     {
-      m_maxXcoord = v[6];
+      return true;
     }
-    if(v[7] < m_minYcoord)
+    ::memmove(buffer.data(), buffer.data() + cursor, bufferEnd - cursor);
+    bufferEnd -= cursor;
+    cursor = 0;
+    if(needed > buffer.size())
     {
-      m_minYcoord = v[7];
+      buffer.resize(needed);
     }
-    if(v[7] > m_maxYcoord)
-    {
-      m_maxYcoord = v[7];
-    }
-    if(v[8] < m_minZcoord)
-    {
-      m_minZcoord = v[8];
-    }
-    if(v[8] > m_maxZcoord)
+    bufferEnd += fread(buffer.data() + bufferEnd, 1, buffer.size() - bufferEnd, f);
+    return bufferEnd >= needed;
+  };
+
+  float v[k_StlElementCount];
+  uint16_t attr = 0;
+  for(int32_t t = 0; t < triCount; ++t)
+  {
+    if(!fillBuffer(STL_TRIANGLE_LENGTH))
     {
-      m_maxZcoord = v[8];
+      fclose(f);
+      QString ss = QString("The STL file ended after %1 of %2 triangles").arg(t).arg(triCount);
+      setErrorCondition(-1004, ss);
+      return;
     }
-    if(v[9] < m_minXcoord)
+    ::memcpy(v, buffer.data() + cursor, sizeof(v));                   // Read the Triangle
+    ::memcpy(&attr, buffer.data() + cursor + sizeof(v), sizeof(attr)); // Read the Triangle Attribute Data length
+    cursor += STL_TRIANGLE_LENGTH;
+    if(attr > 0 && !magicsFile)
     {
-      m_minXcoord = v[9];
+      // Skip over the STL attribute data
+      if(!fillBuffer(attr))
+      {
+        fclose(f);
+        QString ss = QString("The STL file ended inside the attribute data of triangle %1").arg(t);
+        setErrorCondition(-1004, ss);
+        return;
+      }
+      cursor += attr;
     }
-    if(v[9] > m_maxXcoord)
+
+    for(size_t n = 0; n < 3; n++)
     {
-      m_maxXcoord = v[9];
+      const float* p = v + 3 + 3 * n;
+      m_minXcoord = std::min(m_minXcoord, p[0]);
+      m_maxXcoord = std::max(m_maxXcoord, p[0]);
+      m_minYcoord = std::min(m_minYcoord, p[1]);
+      m_maxYcoord = std::max(m_maxYcoord, p[1]);
+      m_minZcoord = std::min(m_minZcoord, p[2]);
+      m_maxZcoord = std::max(m_maxZcoord, p[2]);
     }
-    if(v[10] < m_minYcoord)
+    m_FaceNormals[3 * t + 0] = static_cast<double>(v[0]);
+    m_FaceNormals[3 * t + 1] = static_cast<double>(v[1]);
+    m_FaceNormals[3 * t + 2] = static_cast<double>(v[2]);
+    ::memcpy(nodes + 9 * static_cast<size_t>(t), v + 3, 9 * sizeof(float));
+    triangles[t * 3] = 3 * t + 0;
+    triangles[t * 3 + 1] = 3 * t + 1;
+    triangles[t * 3 + 2] = 3 * t + 2;
+  }
+
+  fclose(f);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadStlFile::readAsciiFile()
+{
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshDataContainerName);
+
+  QFile file(m_StlFilePath);
+  if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    setErrorCondition(-1003, "Error opening STL file");
+    return;
+  }
+
+  // The number of facets is not stored in an ASCII file so collect them first
+  std::vector<float> normals;
+  std::vector<float> vertices;
+  float normal[3] = {0.0f, 0.0f, 0.0f};
+  int32_t facetVertices = 0;
+  int64_t lineNum = 0;
+  bool ok = true;
+  while(!file.atEnd())
+  {
+    lineNum++;
+    QList<QByteArray> tokens = file.readLine().simplified().split(' ');
+    const QByteArray& keyword = tokens[0];
+    if(keyword == "facet")
     {
-      m_minYcoord = v[10];
+      // facet normal nx ny nz
+      ok = tokens.size() >= 5;
+      for(int32_t c = 0; c < 3 && ok; c++)
+      {
+        normal[c] = tokens[c + 2].toFloat(&ok);
+      }
+      facetVertices = 0;
     }
-    if(v[10] > m_maxYcoord)
+    else if(keyword == "vertex")
     {
-      m_maxYcoord = v[10];
+      // vertex x y z
+      ok = tokens.size() >= 4;
+      for(int32_t c = 0; c < 3 && ok; c++)
+      {
+        vertices.push_back(tokens[c + 1].toFloat(&ok));
+      }
+      facetVertices++;
     }
-    if(v[11] < m_minZcoord)
+    else if(keyword == "endfacet")
     {
-      m_minZcoord = v[11];
+      if(facetVertices != 3)
+      {
+        QString ss = QString("The facet ending at line %1 of the ASCII STL file does not have exactly 3 vertices").arg(lineNum);
+        setErrorCondition(-1006, ss);
+        return;
+      }
+      normals.insert(normals.end(), normal, normal + 3);
     }
-    if(v[11] > m_maxZcoord)
+
+    if(!ok)
     {
-      m_maxZcoord = v[11];
+      QString ss = QString("Error parsing line %1 of the ASCII STL file").arg(lineNum);
+      setErrorCondition(-1007, ss);
+      return;
     }
-    m_FaceNormals[3 * t + 0] = static_cast<double>(v[0]);
-    m_FaceNormals[3 * t + 1] = static_cast<double>(v[1]);
-    m_FaceNormals[3 * t + 2] = static_cast<double>(v[2]);
-    nodes[3 * (3 * t + 0) + 0] = v[3];
-    nodes[3 * (3 * t + 0) + 1] = v[4];
-    nodes[3 * (3 * t + 0) + 2] = v[5];
-    nodes[3 * (3 * t + 1) + 0] = v[6];
-    nodes[3 * (3 * t + 1) + 1] = v[7];
-    nodes[3 * (3 * t + 1) + 2] = v[8];
-    nodes[3 * (3 * t + 2) + 0] = v[9];
-    nodes[3 * (3 * t + 2) + 1] = v[10];
-    nodes[3 * (3 * t + 2) + 2] = v[11];
+  }
+
+  size_t triCount = normals.size() / 3;
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  triangleGeom->resizeTriList(triCount);
+  triangleGeom->resizeVertexList(triCount * 3);
+  float* nodes = triangleGeom->getVertexPointer(0);
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+
+  // Resize the triangle attribute matrix to hold the normals and update the normals pointer
+  QVector<size_t> tDims(1, triCount);
+  sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFaceInstancePointers();
+
+  for(size_t t = 0; t < triCount; t++)
+  {
+    m_FaceNormals[3 * t + 0] = static_cast<double>(normals[3 * t + 0]);
+    m_FaceNormals[3 * t + 1] = static_cast<double>(normals[3 * t + 1]);
+    m_FaceNormals[3 * t + 2] = static_cast<double>(normals[3 * t + 2]);
     triangles[t * 3] = 3 * t + 0;
     triangles[t * 3 + 1] = 3 * t + 1;
     triangles[t * 3 + 2] = 3 * t + 2;
   }
+  for(size_t n = 0; n < triCount * 3; n++)
+  {
+    const float* p = vertices.data() + 3 * n;
+    m_minXcoord = std::min(m_minXcoord, p[0]);
+    m_maxXcoord = std::max(m_maxXcoord, p[0]);
+    m_minYcoord = std::min(m_minYcoord, p[1]);
+    m_maxYcoord = std::max(m_maxYcoord, p[1]);
+    m_minZcoord = std::min(m_minZcoord, p[2]);
+    m_maxZcoord = std::max(m_maxZcoord, p[2]);
+  }
+  if(triCount > 0)
+  {
+    ::memcpy(nodes, vertices.data(), triCount * 9 * sizeof(float));
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -433,68 +589,112 @@ void ReadStlFile::eliminate_duplicate_nodes()
   {
     nNodes = static_cast<size_t>(nNodes_);
   }
-  float stepX = (m_maxXcoord - m_minXcoord) / 100.0f;
-  float stepY = (m_maxYcoord - m_minYcoord) / 100.0f;
-  float stepZ = (m_maxZcoord - m_minZcoord) / 100.0f;
-
-  QVector<QVector<size_t>> nodesInBin(100 * 100 * 100);
-
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
-  for(size_t i = 0; i < nNodes; i++)
+  if(nNodes == 0)
   {
-    xBin = static_cast<int32_t>((vertex[i * 3] - m_minXcoord) / stepX);
-    yBin = static_cast<int32_t>((vertex[i * 3 + 1] - m_minYcoord) / stepY);
-    zBin = static_cast<int32_t>((vertex[i * 3 + 2] - m_minZcoord) / stepZ);
-    if(xBin == 100)
-    {
-      xBin = 99;
-    }
-    if(yBin == 100)
-    {
-      yBin = 99;
-    }
-    if(zBin == 100)
-    {
-      zBin = 99;
-    }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
+    return;
   }
 
-  // Create array to hold unique node numbers
-  Int64ArrayType::Pointer uniqueIdsPtr = Int64ArrayType::CreateArray(nNodes, "uniqueIds");
-  int64_t* uniqueIds = uniqueIdsPtr->getPointer(0);
-  for(int64_t i = 0; i < nNodes_; i++)
-  {
-    uniqueIds[i] = i;
-  }
+  // Sort the vertex indices by cell so that the candidates for welding become neighbors. Unlike a fixed
+  // bin grid this does not degrade when most of the vertices sit in a small part of the mesh.
+  std::vector<int64_t> order(nNodes);
+  std::iota(order.begin(), order.end(), 0);
+  VertexWeldGrid weldGrid(vertex, m_WeldTolerance, m_minXcoord, m_minYcoord, m_minZcoord);
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("ReadStlFile"));
   bool doParallel = true;
 #endif
 
-// Parallel algorithm to find duplicate nodes
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, 100 * 100 * 100), FindUniqueIdsImpl(triangleGeom->getVertices(), nodesInBin, uniqueIds), tbb::auto_partitioner());
+    tbb::parallel_sort(order.begin(), order.end(), weldGrid);
   }
   else
 #endif
   {
-    FindUniqueIdsImpl serial(triangleGeom->getVertices(), nodesInBin, uniqueIds);
-    serial.convert(0, 100 * 100 * 100);
+    std::sort(order.begin(), order.end(), weldGrid);
+  }
+
+  // Each vertex points at the first (lowest index) vertex of the group it is welded into
+  Int64ArrayType::Pointer uniqueIdsPtr = Int64ArrayType::CreateArray(nNodes, "uniqueIds");
+  int64_t* uniqueIds = uniqueIdsPtr->getPointer(0);
+  if(m_WeldTolerance > 0.0f)
+  {
+    // Join every pair of vertices within the tolerance of each other. The pairs are only searched for in the 27
+    // cells around each vertex, and welding is transitive, so a chain of close vertices becomes one vertex.
+    std::vector<int64_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    const double toleranceSq = static_cast<double>(m_WeldTolerance) * static_cast<double>(m_WeldTolerance);
+    auto keyAfterVertex = [&weldGrid](const VertexWeldGrid::CellKey& key, int64_t v) { return weldGrid.compareCell(v, key) > 0; };
+    auto vertexBeforeKey = [&weldGrid](int64_t v, const VertexWeldGrid::CellKey& key) { return weldGrid.compareCell(v, key) < 0; };
+    for(size_t v = 0; v < nNodes; v++)
+    {
+      const float* p = vertex + v * 3;
+      VertexWeldGrid::CellKey key = weldGrid.cellKey(static_cast<int64_t>(v));
+      for(int64_t dx = -1; dx <= 1; dx++)
+      {
+        for(int64_t dy = -1; dy <= 1; dy++)
+        {
+          // The three cells along z are contiguous in the sort order
+          VertexWeldGrid::CellKey first = {{key[0] + dx, key[1] + dy, key[2] - 1}};
+          VertexWeldGrid::CellKey last = {{key[0] + dx, key[1] + dy, key[2] + 1}};
+          auto begin = std::lower_bound(order.begin(), order.end(), first, vertexBeforeKey);
+          auto end = std::upper_bound(begin, order.end(), last, keyAfterVertex);
+          for(auto it = begin; it != end; ++it)
+          {
+            // Every pair is seen from both of its vertices, so only check it from the higher index
+            int64_t u = *it;
+            if(u >= static_cast<int64_t>(v))
+            {
+              continue;
+            }
+            const float* q = vertex + u * 3;
+            double distSq = 0.0;
+            for(int32_t c = 0; c < 3; c++)
+            {
+              double d = static_cast<double>(p[c]) - static_cast<double>(q[c]);
+              distSq += d * d;
+            }
+            if(distSq <= toleranceSq)
+            {
+              int64_t rootU = FindWeldRoot(parent, u);
+              int64_t rootV = FindWeldRoot(parent, static_cast<int64_t>(v));
+              parent[std::max(rootU, rootV)] = std::min(rootU, rootV);
+            }
+          }
+        }
+      }
+    }
+    for(size_t n = 0; n < nNodes; n++)
+    {
+      uniqueIds[n] = FindWeldRoot(parent, static_cast<int64_t>(n));
+    }
+  }
+  else
+  {
+    int64_t groupFirst = order[0];
+    for(size_t n = 0; n < nNodes; n++)
+    {
+      if(weldGrid.compareKeys(groupFirst, order[n]) != 0)
+      {
+        groupFirst = order[n];
+      }
+      uniqueIds[order[n]] = groupFirst;
+    }
   }
 
-  // renumber the unique nodes
+  // renumber the unique nodes and move them to their unique Id; the first vertex of
+  // each group keeps its coordinates
   int64_t uniqueCount = 0;
   for(size_t i = 0; i < nNodes; i++)
   {
     if(uniqueIds[i] == static_cast<int64_t>(i))
     {
       uniqueIds[i] = uniqueCount;
+      vertex[uniqueCount * 3] = vertex[i * 3];
+      vertex[uniqueCount * 3 + 1] = vertex[i * 3 + 1];
+      vertex[uniqueCount * 3 + 2] = vertex[i * 3 + 2];
       uniqueCount++;
     }
     else
@@ -502,14 +702,6 @@ void ReadStlFile::eliminate_duplicate_nodes()
       uniqueIds[i] = uniqueIds[uniqueIds[i]];
     }
   }
-
-  // Move nodes to unique Id and then resize nodes array
-  for(size_t i = 0; i < nNodes; i++)
-  {
-    vertex[uniqueIds[i] * 3] = vertex[i * 3];
-    vertex[uniqueIds[i] * 3 + 1] = vertex[i * 3 + 1];
-    vertex[uniqueIds[i] * 3 + 2] = vertex[i * 3 + 2];
-  }
   triangleGeom->resizeVertexList(uniqueCount);
 
   // Update the triangle nodes to reflect the unique ids
@@ -52,6 +52,7 @@ class ImportExport_EXPORT ReadStlFile : public AbstractFilter
   PYB11_PROPERTY(QString FaceAttributeMatrixName READ getFaceAttributeMatrixName WRITE setFaceAttributeMatrixName)
   PYB11_PROPERTY(QString StlFilePath READ getStlFilePath WRITE setStlFilePath)
   PYB11_PROPERTY(QString FaceNormalsArrayName READ getFaceNormalsArrayName WRITE setFaceNormalsArrayName)
+  PYB11_PROPERTY(float WeldTolerance READ getWeldTolerance WRITE setWeldTolerance)
 public:
   SIMPL_SHARED_POINTERS(ReadStlFile)
   SIMPL_FILTER_NEW_MACRO(ReadStlFile)
@@ -71,6 +72,9 @@ public:
   SIMPL_FILTER_PARAMETER(QString, FaceNormalsArrayName)
   Q_PROPERTY(QString FaceNormalsArrayName READ getFaceNormalsArrayName WRITE setFaceNormalsArrayName)
 
+  SIMPL_FILTER_PARAMETER(float, WeldTolerance)
+  Q_PROPERTY(float WeldTolerance READ getWeldTolerance WRITE setWeldTolerance)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -191,6 +195,11 @@ private:
    */
   void readFile();
 
+  /**
+   * @brief readAsciiFile Reads an ASCII (solid ... endsolid) .stl file
+   */
+  void readAsciiFile();
+
   /**
    * @brief eliminate_duplicate_nodes Removes duplicate nodes to ensure the
    * created vertex list is shared
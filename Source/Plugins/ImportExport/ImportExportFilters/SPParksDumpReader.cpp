@@ -35,6 +35,9 @@
 
 #include "SPParksDumpReader.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <QtCore/QFileInfo>
 
 #include "SIMPLib/Common/Constants.h"
@@ -43,12 +46,20 @@
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BlockReader.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -60,6 +71,107 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+/**
+ * @brief The SPParksSiteParser class parses one site line of a dump file into the cell given by its x, y and z
+ * columns. Site lines are independent of each other, so the block reader calls it from several threads at once.
+ */
+class SPParksSiteParser
+{
+public:
+  SPParksSiteParser(ImageGeom* geom, const std::vector<int32_t*>& intColumns, const std::vector<float*>& floatColumns, int64_t xCol, int64_t yCol, int64_t zCol, int32_t oneBase)
+  : m_Geom(geom)
+  , m_IntColumns(intColumns)
+  , m_FloatColumns(floatColumns)
+  , m_NumColumns(static_cast<int64_t>(intColumns.size()))
+  , m_OneBase(oneBase)
+  {
+    m_CoordColumns[0] = xCol;
+    m_CoordColumns[1] = yCol;
+    m_CoordColumns[2] = zCol;
+  }
+  virtual ~SPParksSiteParser() = default;
+
+  bool operator()(size_t lineIndex, const char* begin, const char* end) const
+  {
+    (void)lineIndex;
+    // First walk: the lattice position decides which cell receives the values of this line
+    float coords[3] = {0.0f, 0.0f, 0.0f};
+    int64_t col = 0;
+    for(const char* p = SkipSpaces(begin, end); p < end && col < m_NumColumns; p = SkipSpaces(p, end), col++)
+    {
+      const char* tokenEnd = BlockReader::SkipToken<BlockReader::SpaceDelimiter>(p, end);
+      for(int32_t i = 0; i < 3; i++)
+      {
+        if(col == m_CoordColumns[i])
+        {
+          int32_t idx = 0;
+          if(!BlockReader::ParseToken<int32_t>(p, tokenEnd, idx))
+          {
+            return false;
+          }
+          coords[i] = static_cast<float>(idx - m_OneBase);
+        }
+      }
+      p = tokenEnd;
+    }
+    if(col < m_NumColumns)
+    {
+      return false;
+    }
+
+    size_t offset = std::numeric_limits<size_t>::max();
+    if(m_Geom->computeCellIndex(coords, offset) != ImageGeom::ErrorType::NoError)
+    {
+      return false;
+    }
+
+    // Second walk: store the remaining columns. Commas are accepted as decimal separators, and the floats are parsed
+    // in the "C" locale whatever the locale of the application is.
+    char token[64];
+    col = 0;
+    for(const char* p = SkipSpaces(begin, end); col < m_NumColumns; p = SkipSpaces(p, end), col++)
+    {
+      const char* tokenEnd = BlockReader::SkipToken<BlockReader::SpaceDelimiter>(p, end);
+      if(nullptr != m_IntColumns[col])
+      {
+        if(!BlockReader::ParseToken<int32_t>(p, tokenEnd, m_IntColumns[col][offset]))
+        {
+          return false;
+        }
+      }
+      else if(nullptr != m_FloatColumns[col])
+      {
+        size_t length = static_cast<size_t>(tokenEnd - p);
+        if(length >= sizeof(token))
+        {
+          return false;
+        }
+        std::replace_copy(p, tokenEnd, token, ',', '.');
+        token[length] = '\0';
+        if(!BlockReader::ParseToken<float>(token, token + length, m_FloatColumns[col][offset]))
+        {
+          return false;
+        }
+      }
+      p = tokenEnd;
+    }
+    return true;
+  }
+
+private:
+  ImageGeom* m_Geom;
+  const std::vector<int32_t*>& m_IntColumns;
+  const std::vector<float*>& m_FloatColumns;
+  int64_t m_CoordColumns[3];
+  int64_t m_NumColumns;
+  int32_t m_OneBase;
+
+  static const char* SkipSpaces(const char* p, const char* end)
+  {
+    return BlockReader::SkipDelimiters<BlockReader::SpaceDelimiter>(p, end);
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -68,6 +180,7 @@ SPParksDumpReader::SPParksDumpReader()
 , m_CellAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
 , m_InputFile("")
 , m_OneBasedArrays(false)
+, m_TimeStepIndex(0)
 , m_FeatureIdsArrayName(SIMPL::CellData::FeatureIds)
 {
   m_Origin[0] = 0.0f;
@@ -97,6 +210,7 @@ void SPParksDumpReader::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Spacing", Spacing, FilterParameter::Parameter, SPParksDumpReader));
 
   parameters.push_back(SIMPL_NEW_BOOL_FP("One Based Arrays", OneBasedArrays, FilterParameter::Parameter, SPParksDumpReader));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Time Step Index", TimeStepIndex, FilterParameter::Parameter, SPParksDumpReader));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", VolumeDataContainerName, FilterParameter::CreatedArray, SPParksDumpReader));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_STRING_FP("Cell Attribute Matrix", CellAttributeMatrixName, FilterParameter::CreatedArray, SPParksDumpReader));
@@ -117,6 +231,7 @@ void SPParksDumpReader::readFilterParameters(AbstractFilterParametersReader* rea
   setOrigin(reader->readFloatVec3("Origin", getOrigin()));
   setSpacing(reader->readFloatVec3("Spacing", getSpacing()));
   setOneBasedArrays(reader->readValue("OneBasedArrays", getOneBasedArrays()));
+  setTimeStepIndex(reader->readValue("TimeStepIndex", getTimeStepIndex()));
   reader->closeFilterGroup();
 }
 
@@ -191,11 +306,15 @@ void SPParksDumpReader::dataCheck()
     // We need to read the header of the input file to get the dimensions
     m_InStream.setFileName(getInputFile());
 
-    if(!m_InStream.open(QIODevice::ReadOnly | QIODevice::Text))
+    if(!m_InStream.open(QIODevice::ReadOnly))
     {
       QString msg = QObject::tr("Input SPParks file could not be opened: %1").arg(getInputFile());
       setErrorCondition(-102, msg);
     }
+    else if(seekTimeStep() < 0)
+    {
+      m_InStream.close();
+    }
     else
     {
       int32_t error = readHeader();
@@ -238,7 +357,17 @@ void SPParksDumpReader::execute()
   }
 
   m_InStream.setFileName(getInputFile());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("SPParksDumpReader"));
+#endif
+
   m_InStream.open(QFile::ReadOnly);
+  err = seekTimeStep();
+  if(err < 0)
+  {
+    m_InStream.close();
+    return;
+  }
 
   err = readHeader();
   if(err < 0)
@@ -254,6 +383,91 @@ void SPParksDumpReader::execute()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t SPParksDumpReader::indexTimeSteps()
+{
+  QFileInfo fi(getInputFile());
+  if(m_IndexedFile == fi.absoluteFilePath() && m_IndexedLastModified == fi.lastModified())
+  {
+    return 0;
+  }
+  m_TimeStepOffsets.clear();
+  m_IndexedFile.clear();
+
+  // Scan the file in large blocks for the marker at the start of a line. The tail of the previous block is kept in
+  // front of each new block so a marker cut by the block boundary is still found, and only matches that reach into
+  // the new bytes are counted so none is recorded twice.
+  const QByteArray marker("ITEM: TIMESTEP");
+  QByteArray block;
+  qint64 blockStart = 0;
+  if(!m_InStream.seek(0))
+  {
+    return -109;
+  }
+  while(true)
+  {
+    QByteArray bytes = m_InStream.read(BlockReader::k_BlockBytes);
+    if(bytes.isEmpty())
+    {
+      break;
+    }
+    int32_t tailSize = block.size();
+    block.append(bytes);
+    for(int32_t pos = block.indexOf(marker); pos >= 0; pos = block.indexOf(marker, pos + 1))
+    {
+      if(pos + marker.size() <= tailSize)
+      {
+        continue;
+      }
+      if((blockStart + pos == 0) || (pos > 0 && block.at(pos - 1) == '\n'))
+      {
+        m_TimeStepOffsets.push_back(blockStart + pos);
+      }
+    }
+    int32_t keep = std::min(block.size(), marker.size());
+    blockStart += block.size() - keep;
+    block = block.right(keep);
+  }
+
+  m_IndexedFile = fi.absoluteFilePath();
+  m_IndexedLastModified = fi.lastModified();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t SPParksDumpReader::seekTimeStep()
+{
+  // The first time step starts the file, so the index is only needed to reach a later one
+  qint64 offset = 0;
+  if(getTimeStepIndex() != 0)
+  {
+    if(indexTimeSteps() < 0)
+    {
+      QString msg = QObject::tr("Error occurred trying to index the time steps of the input file");
+      setErrorCondition(-109, msg);
+      return getErrorCode();
+    }
+    if(getTimeStepIndex() < 0 || static_cast<size_t>(getTimeStepIndex()) >= m_TimeStepOffsets.size())
+    {
+      QString msg = QObject::tr("Time Step Index %1 is out of range. The input file holds %2 time steps").arg(getTimeStepIndex()).arg(m_TimeStepOffsets.size());
+      setErrorCondition(-108, msg);
+      return getErrorCode();
+    }
+    offset = m_TimeStepOffsets[getTimeStepIndex()];
+  }
+  if(!m_InStream.seek(offset))
+  {
+    QString msg = QObject::tr("Unable to move to time step %1 of the input file").arg(getTimeStepIndex());
+    setErrorCondition(-109, msg);
+    return getErrorCode();
+  }
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -411,6 +625,9 @@ int32_t SPParksDumpReader::readFile()
   int64_t zCol = 0;
   qint32 size = tokens.size();
   bool didAllocate = false;
+  // Destination of each site column; x, y, z and id only place the site and are not stored
+  std::vector<int32_t*> intColumns(size > 2 ? size - 2 : 0, nullptr);
+  std::vector<float*> floatColumns(intColumns.size(), nullptr);
   for(qint32 i = 2; i < size; ++i)
   {
     QString name = QString::fromLatin1(tokens[i]);
@@ -445,6 +662,7 @@ int32_t SPParksDumpReader::readFile()
       {
         ::memset(dparser->getVoidPointer(), 0xAB, sizeof(int32_t) * totalPoints);
         m_NamePointerMap.insert(name, dparser);
+        intColumns[i - 2] = static_cast<int32_t*>(dparser->getVoidPointer());
       }
     }
     else if(Ebsd::Float == pType)
@@ -454,6 +672,7 @@ int32_t SPParksDumpReader::readFile()
       {
         ::memset(dparser->getVoidPointer(), 0xAB, sizeof(float) * totalPoints);
         m_NamePointerMap.insert(name, dparser);
+        floatColumns[i - 2] = static_cast<float*>(dparser->getVoidPointer());
       }
     }
     else
@@ -471,26 +690,19 @@ int32_t SPParksDumpReader::readFile()
     }
   }
 
-  // Now loop over all the points in the file. This could get REALLY slow if the file gets large.
-  // Thank goodness we all like to save text files
-  for(size_t n = 0; n < totalPoints; ++n)
+  int32_t oneBase = 0;
+  if(getOneBasedArrays())
   {
-    buf = m_InStream.readLine(); // Read the line into a QByteArray including the newline
-    buf = buf.trimmed();         // Remove leading and trailing whitespace
-
-    if(m_InStream.atEnd() && buf.isEmpty()) // We have to have read to the end of the file AND the buffer is empty
-    {
-      // otherwise we read EXACTLY the last line and we still need to parse the line.
-      break;
-    }
-    parseDataLine(buf, tDims, xCol, yCol, zCol, n + 9);
-    if(getErrorCode() < 0)
-    {
-      break;
-    }
+    oneBase = 1;
   }
-  if(getErrorCode() < 0)
+
+  // The site lines are cut into chunks that are parsed in parallel, each line going straight to its cell
+  SPParksSiteParser siteParser(m_CachedGeometry, intColumns, floatColumns, xCol, yCol, zCol, oneBase);
+  size_t numLines = BlockReader::ReadAsciiLines(m_InStream, totalPoints, siteParser);
+  if(numLines < totalPoints)
   {
+    QString msg = QObject::tr("Error reading site %1 of %2 in the time step. The line is missing, has too few columns, could not be parsed or lies outside of the box").arg(numLines + 1).arg(totalPoints);
+    setErrorCondition(-48100, msg);
     return getErrorCode();
   }
 
@@ -517,80 +729,6 @@ int32_t SPParksDumpReader::readFile()
   return 0;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void SPParksDumpReader::parseDataLine(QByteArray& line, QVector<size_t> dims, int64_t xCol, int64_t yCol, int64_t zCol, size_t lineNum)
-{
-  // Filter the line to convert European command style decimals to US/UK style points
-  for(qint32 c = 0; c < line.size(); ++c)
-  {
-    if(line.at(c) == ',')
-    {
-      line[c] = '.';
-    }
-  }
-
-  int64_t xIdx = 0, yIdx = 0, zIdx = 0;
-  bool ok = false;
-  QList<QByteArray> tokens = line.split(' ');
-
-  int32_t oneBase = 0;
-  if(getOneBasedArrays())
-  {
-    oneBase = 1;
-  }
-
-  xIdx = tokens[xCol].toInt(&ok) - oneBase;
-  yIdx = tokens[yCol].toInt(&ok) - oneBase;
-  zIdx = tokens[zCol].toInt(&ok) - oneBase;
-
-  float coords[3] = {static_cast<float>(xIdx), static_cast<float>(yIdx), static_cast<float>(zIdx)};
-  // Calculate the offset into the actual array based on the x, y & z values from the data line we just read
-  // size_t offset = static_cast<size_t>((dims[1] * dims[0] * zIdx) + (dims[0] * yIdx) + xIdx);
-  size_t offset = std::numeric_limits<size_t>::max();
-  ImageGeom::ErrorType err = m_CachedGeometry->computeCellIndex(coords, offset);
-  if(err != ImageGeom::ErrorType::NoError)
-  {
-    QString msg;
-    QTextStream ss(&msg);
-    ss << "The calculated offset into the data array " << offset << " is larger "
-       << " than the total number of elements " << m_CachedGeometry->getNumberOfElements() << " in the array."
-       << "Line Number: " << lineNum << " Content\"" << line << "\"\n";
-    setErrorCondition(-48100, msg);
-    return;
-  }
-
-  QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
-  while(iter.hasNext())
-  {
-    iter.next();
-    DataParser::Pointer dparser = iter.value();
-    // Make sure we dont' parse the x, y, z or id columns since they are pretty much useless data. At some point
-    // if the SPParks users actually wanted to read in the matching XYZ lattice site for the data then actually
-    // parsing and storing the data _may_ be of interest to them
-    if(dparser->getColumnName().compare("x") == 0 || dparser->getColumnName().compare("y") == 0 || dparser->getColumnName().compare("z") == 0 || dparser->getColumnName().compare("id") == 0)
-    {
-      continue;
-    }
-    if(offset < dparser->getSize())
-    {
-      dparser->parse(tokens[dparser->getColumnIndex()], offset);
-    }
-    else
-    {
-      QString msg;
-      QTextStream ss(&msg);
-      ss << "The calculated offset into the data array " << offset << " is larger "
-         << " than the total number of elements " << dparser->getSize() << " in the array."
-         << "The content of the current line is\"\n"
-         << line << "\"\n";
-      setErrorCondition(-48100, msg);
-      return;
-    }
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,6 +35,9 @@
 
 #pragma once
 
+#include <vector>
+
+#include <QtCore/QDateTime>
 #include <QtCore/QFile>
 
 // Needed for AxisAngle_t
@@ -65,6 +68,7 @@ class ImportExport_EXPORT SPParksDumpReader : public FileReader
   PYB11_PROPERTY(FloatVec3Type Origin READ getOrigin WRITE setOrigin)
   PYB11_PROPERTY(FloatVec3Type Spacing READ getSpacing WRITE setSpacing)
   PYB11_PROPERTY(bool OneBasedArrays READ getOneBasedArrays WRITE setOneBasedArrays)
+  PYB11_PROPERTY(int TimeStepIndex READ getTimeStepIndex WRITE setTimeStepIndex)
   PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
 
 public:
@@ -92,6 +96,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, OneBasedArrays)
   Q_PROPERTY(bool OneBasedArrays READ getOneBasedArrays WRITE setOneBasedArrays)
 
+  SIMPL_FILTER_PARAMETER(int, TimeStepIndex)
+  Q_PROPERTY(int TimeStepIndex READ getTimeStepIndex WRITE setTimeStepIndex)
+
   SIMPL_FILTER_PARAMETER(QString, FeatureIdsArrayName)
   Q_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
 
@@ -203,21 +210,27 @@ protected:
   int32_t getTypeSize(const QString& featureName);
 
   /**
-   * @brief parseDataLine Reads a line of data from the .dump file
-   * @param line Line of data to read
-   * @param dims Dimensional offset
-   * @param xCol X coordinate
-   * @param yCol Y coordinate
-   * @param zCol Z coordinate
-   * @param lineNum
+   * @brief indexTimeSteps Records the byte offset of every ITEM: TIMESTEP block in the input file. The index is
+   * kept until the file name or its modification time changes, so repeated preflights do not rescan the file.
+   * @return Error code
+   */
+  int32_t indexTimeSteps();
+
+  /**
+   * @brief seekTimeStep Positions the opened input file at the start of the selected time step
+   * @return Error code
    */
-  void parseDataLine(QByteArray& line, QVector<size_t> dims, int64_t xCol, int64_t yCol, int64_t zCol, size_t lineNum);
+  int32_t seekTimeStep();
 
 private:
   QFile m_InStream;
   QMap<QString, DataParser::Pointer> m_NamePointerMap;
   ImageGeom* m_CachedGeometry = nullptr;
 
+  std::vector<qint64> m_TimeStepOffsets;
+  QString m_IndexedFile;
+  QDateTime m_IndexedLastModified;
+
 public:
   SPParksDumpReader(const SPParksDumpReader&) = delete;            // Copy Constructor Not Implemented
   SPParksDumpReader(SPParksDumpReader&&) = delete;                 // Move Constructor Not Implemented
@@ -35,6 +35,13 @@
 
 #include "SurfaceMeshToNonconformalVtk.h"
 
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -48,7 +55,10 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -238,6 +248,10 @@ void SurfaceMeshToNonconformalVtk::execute()
   }
   ScopedFileMonitor vtkFileMonitor(vtkFile);
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("SurfaceMeshToNonconformalVtk"));
+#endif
+
   notifyStatusMessage("Writing Vertex Data ....");
 
   fprintf(vtkFile, "# vtk DataFile Version 2.0\n");
@@ -268,136 +282,75 @@ void SurfaceMeshToNonconformalVtk::execute()
 
   fprintf(vtkFile, "POINTS %d float\n", numberWrittenNodes);
 
-  float pos[3] = {0.0f, 0.0f, 0.0f};
-
-  size_t totalWritten = 0;
-
-  // Write the POINTS data (Vertex)
-  for(int i = 0; i < numNodes; i++)
+  std::vector<int64_t> writtenNodes;
+  writtenNodes.reserve(numberWrittenNodes);
+  for(int64_t i = 0; i < numNodes; i++)
   {
     if(m_SurfaceMeshNodeType[i] > 0)
     {
-      pos[0] = static_cast<float>(nodes[i * 3]);
-      pos[1] = static_cast<float>(nodes[i * 3 + 1]);
-      pos[2] = static_cast<float>(nodes[i * 3 + 2]);
+      writtenNodes.push_back(i);
+    }
+  }
 
-      if(m_WriteBinaryFile)
-      {
-        SIMPLib::Endian::FromSystemToBig::convert(pos[0]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[1]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[2]);
-        totalWritten = fwrite(pos, sizeof(float), 3, vtkFile);
-        if(totalWritten != 3)
-        {
-        }
-      }
-      else
-      {
-        fprintf(vtkFile, "%f %f %f\n", pos[0], pos[1], pos[2]); // Write the positions to the output file
-      }
+  // Write the POINTS data (Vertex)
+  if(m_WriteBinaryFile)
+  {
+    BinaryBlockWriter::WriteRecords<float>(vtkFile, writtenNodes.size(), 3, BinaryBlockWriter::ByteOrder::BigEndian, [&](size_t r, float* out) {
+      const float* pos = nodes + writtenNodes[r] * 3;
+      out[0] = pos[0];
+      out[1] = pos[1];
+      out[2] = pos[2];
+    });
+  }
+  else
+  {
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(const int64_t& i : writtenNodes)
+    {
+      text.printf("%f %f %f\n", nodes[i * 3], nodes[i * 3 + 1], nodes[i * 3 + 2]); // Write the positions to the output file
     }
   }
 
   // Write the triangle indices into the vtk File
   notifyStatusMessage("Writing Faces ....");
 
-  int tData[4];
-
-  // Store all the unique Spins
-  QMap<int32_t, int32_t> featureTriangleCount;
-  for(int i = 0; i < numTriangles; i++)
+  // Every triangle is written once for each of its two labels, grouped by feature id in increasing order and by
+  // triangle index within a feature. The cell index c = triangle * 2 + side is also the index of that side's label,
+  // so sorting the cells on (label, c) produces the order in one pass instead of rescanning all triangles per feature.
+  std::vector<int64_t> cellOrder(numTriangles * 2);
+  for(int64_t c = 0; c < numTriangles * 2; c++)
   {
-    if(featureTriangleCount.find(m_SurfaceMeshFaceLabels[i * 2]) == featureTriangleCount.end())
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2]] = 1;
-    }
-    else
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2]]++;
-    }
-    if(featureTriangleCount.find(m_SurfaceMeshFaceLabels[i * 2 + 1]) == featureTriangleCount.end())
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2 + 1]] = 1;
-    }
-    else
-    {
-      featureTriangleCount[m_SurfaceMeshFaceLabels[i * 2 + 1]]++;
-    }
+    cellOrder[c] = c;
   }
+  const int32_t* faceLabels = m_SurfaceMeshFaceLabels;
+  auto cellLess = [faceLabels](int64_t a, int64_t b) { return faceLabels[a] < faceLabels[b] || (faceLabels[a] == faceLabels[b] && a < b); };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(cellOrder.begin(), cellOrder.end(), cellLess);
+#else
+  std::sort(cellOrder.begin(), cellOrder.end(), cellLess);
+#endif
 
-  // Write the POLYGONS
+  // Write the POLYGONS. Cells coming from the second label have their winding flipped.
   fprintf(vtkFile, "\nPOLYGONS %lld %lld\n", (long long int)(numTriangles * 2), (long long int)(numTriangles * 2 * 4));
-
-  size_t totalCells = 0;
-  // Loop over all the features
-  for(QMap<int32_t, int32_t>::iterator featureIter = featureTriangleCount.begin(); featureIter != featureTriangleCount.end(); ++featureIter)
+  if(m_WriteBinaryFile)
   {
-    totalCells += featureIter.value();
+    BinaryBlockWriter::WriteRecords<int32_t>(vtkFile, cellOrder.size(), 4, BinaryBlockWriter::ByteOrder::BigEndian, [&](size_t r, int32_t* tData) {
+      int64_t j = cellOrder[r] / 2;
+      bool flip = (cellOrder[r] % 2) == 1;
+      tData[0] = 3; // Push on the total number of entries for this entry
+      tData[1] = static_cast<int32_t>(triangles[j * 3 + (flip ? 2 : 0)]);
+      tData[2] = static_cast<int32_t>(triangles[j * 3 + 1]);
+      tData[3] = static_cast<int32_t>(triangles[j * 3 + (flip ? 0 : 2)]);
+    });
   }
-  Q_ASSERT(totalCells == (size_t)(numTriangles * 2));
-
-  // Loop over all the features
-  for(QMap<int32_t, int32_t>::iterator featureIter = featureTriangleCount.begin(); featureIter != featureTriangleCount.end(); ++featureIter)
+  else
   {
-    int32_t gid = featureIter.key();             // The current Feature Id
-    int32_t numTriToWrite = featureIter.value(); // The number of triangles for this feature
-    uint8_t doWrite = 0;
-
-    // Loop over all the triangles looking for the current feature id
-    // this is probably sub-optimal as if we have 1000 features we are going to loop 1000 times but this will use the
-    // least amount of memory. We could run a filter to group the triangles by feature but then we would need an
-    // additional amount of memory equal to 3X the memory used for the triangle list because every triangle will be listed
-    // twice. We could get some slightly better performance if we buffered 4K worth of data then wrote out that data
-    // in one chunk versus what we are doing here.
-    for(int j = 0; j < numTriangles; j++)
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(const int64_t& c : cellOrder)
     {
-      doWrite = 0;
-
-      if(m_SurfaceMeshFaceLabels[j * 2] == gid)
-      {
-        doWrite = 1;
-      }
-      else if(m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-      {
-        doWrite = 2;
-      } // We need to flip the winding of the triangle
-      if(doWrite == 0)
-      {
-        continue;
-      } // Labels in the triangle did match the current feature id.
-
-      if(doWrite == 1)
-      {
-        tData[0] = 3; // Push on the total number of entries for this entry
-        tData[1] = triangles[j * 3];
-        tData[2] = triangles[j * 3 + 1];
-        tData[3] = triangles[j * 3 + 2];
-      }
-      else
-      {
-        tData[0] = 3; // Push on the total number of entries for this entry
-        tData[1] = triangles[j * 3 + 2];
-        tData[2] = triangles[j * 3 + 1];
-        tData[3] = triangles[j * 3];
-      }
-      if(m_WriteBinaryFile)
-      {
-
-        SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-        SIMPLib::Endian::FromSystemToBig::convert(tData[1]); // Index of Vertex 0
-        SIMPLib::Endian::FromSystemToBig::convert(tData[2]); // Index of Vertex 1
-        SIMPLib::Endian::FromSystemToBig::convert(tData[3]); // Index of Vertex 2
-        fwrite(tData, sizeof(int), 4, vtkFile);
-      }
-      else
-      {
-        fprintf(vtkFile, "3 %d %d %d\n", tData[1], tData[2], tData[3]);
-      }
-      numTriToWrite--;
-    }
-    if(numTriToWrite != 0)
-    {
-      qDebug() << "Not enough triangles written: " << gid << "::" << numTriToWrite << " Total Triangles to Write " << featureIter.value();
+      int64_t j = c / 2;
+      bool flip = (c % 2) == 1;
+      text.printf("3 %d %d %d\n", static_cast<int32_t>(triangles[j * 3 + (flip ? 2 : 0)]), static_cast<int32_t>(triangles[j * 3 + 1]), static_cast<int32_t>(triangles[j * 3 + (flip ? 0 : 2)]));
     }
   }
 
@@ -405,7 +358,7 @@ void SurfaceMeshToNonconformalVtk::execute()
   int err = writePointData(vtkFile);
 
   // Write the CELL_DATA section
-  err = writeCellData(vtkFile, featureTriangleCount);
+  err = writeCellData(vtkFile, cellOrder);
 
   fprintf(vtkFile, "\n");
 
@@ -427,24 +380,18 @@ void writePointScalarData(DataContainer::Pointer dc, const QString& vertexAttrib
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
+    if(writeBinaryData)
+    {
+      BinaryBlockWriter::WriteArray<T>(vtkFile, m, nT, BinaryBlockWriter::ByteOrder::BigEndian);
+      return;
+    }
     for(int i = 0; i < nT; ++i)
     {
-      T swapped = 0x00;
-      if(writeBinaryData)
+      ss = QString::number(m[i]) + " ";
+      fprintf(vtkFile, "%s ", ss.toLatin1().data());
+      // if (i%50 == 0)
       {
-        swapped = static_cast<T>(m[i]);
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(T), 1, vtkFile);
-      }
-      else
-      {
-
-        ss = QString::number(m[i]) + " ";
-        fprintf(vtkFile, "%s ", ss.toLatin1().data());
-        // if (i%50 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+        fprintf(vtkFile, "\n");
       }
     }
   }
@@ -465,33 +412,19 @@ void writePointVectorData(DataContainer::Pointer dc, const QString& vertexAttrib
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "%s %s %s\n", vtkAttributeType.toLatin1().data(), dataName.toLatin1().data(), dataType.toLatin1().data());
+    if(writeBinaryData)
+    {
+      BinaryBlockWriter::WriteArray<T>(vtkFile, m, static_cast<size_t>(nT) * 3, BinaryBlockWriter::ByteOrder::BigEndian);
+      return;
+    }
     for(int i = 0; i < nT; ++i)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
-      {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-      }
-      else
+      ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
+      fprintf(vtkFile, "%s ", buf.toLatin1().data());
+      buf.clear();
+      // if (i%50 == 0)
       {
-
-        ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
-        fprintf(vtkFile, "%s ", buf.toLatin1().data());
-        buf.clear();
-        // if (i%50 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+        fprintf(vtkFile, "\n");
       }
     }
   }
@@ -535,19 +468,28 @@ int SurfaceMeshToNonconformalVtk::writePointData(FILE* vtkFile)
   fprintf(vtkFile, "SCALARS Node_Type char 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  for(int i = 0; i < numNodes; ++i)
+  if(m_WriteBinaryFile)
   {
-    if(m_SurfaceMeshNodeType[i] > 0)
+    // 1 byte Char values so there is nothing to swap; only the compaction is needed
+    std::vector<int8_t> nodeTypes;
+    nodeTypes.reserve(nNodes);
+    for(int64_t i = 0; i < numNodes; ++i)
     {
-      if(m_WriteBinaryFile)
+      if(m_SurfaceMeshNodeType[i] > 0)
       {
-        // swapped = m_SurfaceMeshNodeType[i];
-        // SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(m_SurfaceMeshNodeType + i, sizeof(char), 1, vtkFile);
+        nodeTypes.push_back(m_SurfaceMeshNodeType[i]);
       }
-      else
+    }
+    BinaryBlockWriter::WriteArray<int8_t>(vtkFile, nodeTypes.data(), nodeTypes.size(), BinaryBlockWriter::ByteOrder::BigEndian);
+  }
+  else
+  {
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(int64_t i = 0; i < numNodes; ++i)
+    {
+      if(m_SurfaceMeshNodeType[i] > 0)
       {
-        fprintf(vtkFile, "%d ", m_SurfaceMeshNodeType[i]);
+        text.printf("%d ", m_SurfaceMeshNodeType[i]);
       }
     }
   }
@@ -578,64 +520,30 @@ int SurfaceMeshToNonconformalVtk::writePointData(FILE* vtkFile)
 
 template <typename T>
 void writeCellScalarData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, FILE* vtkFile,
-                         QMap<int32_t, int32_t>& featureIds, int32_t* m_SurfaceMeshFaceLabels)
+                         const std::vector<int64_t>& cellOrder)
 {
-  TriangleGeom::Pointer triangleGeom = dc->getGeometryAs<TriangleGeom>();
-
-  int64_t numTriangles = triangleGeom->getNumberOfTris();
   IDataArray::Pointer data = dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName);
 
-  QString ss;
   if(nullptr != data.get())
   {
-    int32_t totalCellsWritten = 0;
-
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s 1\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
-    // Loop over all the features
-    for(QMap<int32_t, int32_t>::iterator featureIter = featureIds.begin(); featureIter != featureIds.end(); ++featureIter)
+    // The value is negated on the cells that come from the triangle's second label
+    if(writeBinaryData)
     {
-      int32_t gid = featureIter.key();   // The current Feature Id
-      size_t size = featureIter.value(); // The number of triangles for this feature id
-      std::vector<T> buffer(size, 0);
-      totalCellsWritten += size;
-      size_t index = 0;
-
-      for(int j = 0; j < numTriangles; j++)
-      {
-        if(m_SurfaceMeshFaceLabels[j * 2] != gid && m_SurfaceMeshFaceLabels[j * 2 + 1] != gid)
-        {
-          continue;
-        }
-        // Get the data
-        T s0 = static_cast<T>(m[j]);
-        if(m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-        {
-          s0 = s0 * -1;
-        }
-
-        // Write the values to the buffer after an Endian swap.
-        if(writeBinaryData)
-        {
-          SIMPLib::Endian::FromSystemToBig::convert(s0);
-          buffer[index] = s0;
-          ++index;
-        }
-        else
-        {
-
-          ss = QString::number(s0);
-          fprintf(vtkFile, "%s\n", ss.toLatin1().data());
-        }
-      }
-
-      // Write the Buffer
-      if(writeBinaryData)
-      {
-        fwrite(&(buffer.front()), sizeof(T), size, vtkFile);
-      }
+      BinaryBlockWriter::WriteRecords<T>(vtkFile, cellOrder.size(), 1, BinaryBlockWriter::ByteOrder::BigEndian, [&](size_t r, T* out) {
+        int64_t c = cellOrder[r];
+        out[0] = (c % 2) == 1 ? static_cast<T>(m[c / 2] * -1) : static_cast<T>(m[c / 2]);
+      });
+      return;
+    }
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(const int64_t& c : cellOrder)
+    {
+      T s0 = (c % 2) == 1 ? static_cast<T>(m[c / 2] * -1) : static_cast<T>(m[c / 2]);
+      text.printf("%s\n", QString::number(s0).toLatin1().data());
     }
   }
 }
@@ -645,76 +553,35 @@ void writeCellScalarData(DataContainer::Pointer dc, const QString& faceAttribute
 // -----------------------------------------------------------------------------
 template <typename T>
 void writeCellNormalData(DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, const QString& dataType, bool writeBinaryData, FILE* vtkFile,
-                         QMap<int32_t, int32_t>& featureIds, int32_t* m_SurfaceMeshFaceLabels)
+                         const std::vector<int64_t>& cellOrder)
 {
-  TriangleGeom::Pointer triangleGeom = dc->getGeometryAs<TriangleGeom>();
-
-  int64_t numTriangles = triangleGeom->getNumberOfTris();
   IDataArray::Pointer data = dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName);
   QString buf;
   QTextStream ss(&buf);
   if(nullptr != data.get())
   {
-    int32_t totalCellsWritten = 0;
-
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "NORMALS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
-    // Loop over all the features
-    for(QMap<int32_t, int32_t>::iterator featureIter = featureIds.begin(); featureIter != featureIds.end(); ++featureIter)
+    // Flip the normal on the cells that come from the triangle's second label
+    if(writeBinaryData)
     {
-      int32_t gid = featureIter.key();   // The current Feature Id
-      size_t size = featureIter.value(); // The number of triangles for this feature id
-      std::vector<T> buffer(size * 3, 0);
-      totalCellsWritten += size * 3;
-      size_t index = 0;
-
-      for(int j = 0; j < numTriangles; j++)
-      {
-        if(m_SurfaceMeshFaceLabels[j * 2] != gid && m_SurfaceMeshFaceLabels[j * 2 + 1] != gid)
-        {
-          continue;
-        }
-        // Get the data
-        T s0 = static_cast<T>(m[j * 3 + 0]);
-        T s1 = static_cast<T>(m[j * 3 + 1]);
-        T s2 = static_cast<T>(m[j * 3 + 2]);
-        // Flip the normal if needed because the current feature id is assigned to the triangle.labels[1]
-        if(m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-        {
-          s0 *= -1.0;
-          s1 *= -1.0;
-          s2 *= -1.0;
-        }
-        // Write the values to the buffer after an Endian swap.
-        if(writeBinaryData)
-        {
-          SIMPLib::Endian::FromSystemToBig::convert(s0);
-          buffer[index] = s0;
-          ++index;
-
-          SIMPLib::Endian::FromSystemToBig::convert(s1);
-          buffer[index] = s1;
-          ++index;
-
-          SIMPLib::Endian::FromSystemToBig::convert(s2);
-          buffer[index] = s2;
-          ++index;
-        }
-        else
-        {
-
-          ss << s0 << " " << s1 << " " << s2;
-          fprintf(vtkFile, "%s\n", buf.toLatin1().data());
-          buf.clear();
-        }
-      }
-
-      // Write the Buffer
-      if(writeBinaryData)
-      {
-        fwrite(&(buffer.front()), sizeof(T), size * 3, vtkFile);
-      }
+      BinaryBlockWriter::WriteRecords<T>(vtkFile, cellOrder.size(), 3, BinaryBlockWriter::ByteOrder::BigEndian, [&](size_t r, T* out) {
+        int64_t c = cellOrder[r];
+        T sign = (c % 2) == 1 ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+        out[0] = m[(c / 2) * 3 + 0] * sign;
+        out[1] = m[(c / 2) * 3 + 1] * sign;
+        out[2] = m[(c / 2) * 3 + 2] * sign;
+      });
+      return;
+    }
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(const int64_t& c : cellOrder)
+    {
+      T sign = (c % 2) == 1 ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+      ss << m[(c / 2) * 3 + 0] * sign << " " << m[(c / 2) * 3 + 1] * sign << " " << m[(c / 2) * 3 + 2] * sign;
+      text.printf("%s\n", buf.toLatin1().data());
+      buf.clear();
     }
   }
 }
@@ -772,7 +639,7 @@ void writeCellVectorData(DataContainer::Pointer dc, const QString& faceAttribute
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, QMap<int32_t, int32_t>& featureIds)
+int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, const std::vector<int64_t>& cellOrder)
 {
   int err = 0;
   if(nullptr == vtkFile)
@@ -786,56 +653,25 @@ int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, QMap<int32_t, int
   TriangleGeom::Pointer triangleGeom = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName())->getGeometryAs<TriangleGeom>();
   int64_t numTriangles = triangleGeom->getNumberOfTris();
 
-  int swapped;
-
   // This is like a "section header"
   fprintf(vtkFile, "\n");
   fprintf(vtkFile, "CELL_DATA %lld\n", (long long int)(numTriangles * 2));
 
-  int32_t totalCellsWritten = 0;
-
-  // Write the FeatureId Data to the file
+  // Write the FeatureId Data to the file. Each cell carries the label it was grouped under.
   fprintf(vtkFile, "SCALARS FeatureID int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
-
-  // Loop over all the features
-  for(QMap<int32_t, int32_t>::iterator featureIter = featureIds.begin(); featureIter != featureIds.end(); ++featureIter)
-  {
-    int32_t gid = featureIter.key();   // The current Feature Id
-    size_t size = featureIter.value(); // The number of triangles for this feature id
-    std::vector<int32_t> buffer(size, 0);
-    totalCellsWritten += size;
-
-    // Endian Swap our current feature Id since we are going to write it a bunch of times.
-    swapped = gid;
-    SIMPLib::Endian::FromSystemToBig::convert(swapped);
-    size_t index = 0;
-
-    // Loop over all the triangles looking for the current feature id
-    // this is probably sub-optimal as if we have 1000 features we are going to loop 1000 times but this will use the
-    // least amount of memory. We could run a filter to group the triangles by feature but then we would need an
-    // additional amount of memory equal to 3X the memory used for the triangle list because every triangle will be listed
-    // twice. We could get some slightly better performance if we buffered 4K worth of data then wrote out that data
-    // in one chunk versus what we are doing here.
-    for(int j = 0; j < numTriangles; j++)
-    {
-      if(m_SurfaceMeshFaceLabels[j * 2] == gid || m_SurfaceMeshFaceLabels[j * 2 + 1] == gid)
-      {
-        if(m_WriteBinaryFile)
-        {
-          buffer[index] = swapped;
-          ++index;
-        }
-        else
-        {
-          fprintf(vtkFile, "%d\n", gid);
-        }
-      }
-    }
-    // Write the Buffer
-    if(m_WriteBinaryFile)
+  const int32_t* faceLabels = m_SurfaceMeshFaceLabels;
+  if(m_WriteBinaryFile)
+  {
+    BinaryBlockWriter::WriteRecords<int32_t>(vtkFile, cellOrder.size(), 1, BinaryBlockWriter::ByteOrder::BigEndian,
+                                             [&](size_t r, int32_t* out) { out[0] = faceLabels[cellOrder[r]]; });
+  }
+  else
+  {
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(const int64_t& c : cellOrder)
     {
-      fwrite(&(buffer.front()), sizeof(int32_t), size, vtkFile);
+      text.printf("%d\n", faceLabels[c]);
     }
   }
 #if 0
@@ -865,21 +701,21 @@ int SurfaceMeshToNonconformalVtk::writeCellData(FILE* vtkFile, QMap<int32_t, int
   QString attrMatName = m_SurfaceMeshFaceLabelsArrayPath.getAttributeMatrixName();
 
   notifyStatusMessage("Writing Face Normals...");
-  writeCellNormalData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellNormalData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, "double", m_WriteBinaryFile, vtkFile, cellOrder);
 
   notifyStatusMessage("Writing Principal Curvature 1");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, "double", m_WriteBinaryFile, vtkFile, cellOrder);
   notifyStatusMessage("Writing Principal Curvature 2");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, "double", m_WriteBinaryFile, vtkFile, cellOrder);
 
   notifyStatusMessage("Writing Feature Face Id");
-  writeCellScalarData<int32_t>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, "int", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<int32_t>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, "int", m_WriteBinaryFile, vtkFile, cellOrder);
 
   notifyStatusMessage("Writing Gaussian Curvature");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, "double", m_WriteBinaryFile, vtkFile, cellOrder);
 
   notifyStatusMessage("Writing Mean Curvature");
-  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, "double", m_WriteBinaryFile, vtkFile, featureIds, m_SurfaceMeshFaceLabels);
+  writeCellScalarData<double>(sm, attrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, "double", m_WriteBinaryFile, vtkFile, cellOrder);
 #if 0
   writeCellVectorData<double>(sm, attrMatName, SIMPL::CellData::SurfaceMeshPrincipalDirection1,
                               "double", m_WriteBinaryFile, "VECTORS", vtkFile, nT);
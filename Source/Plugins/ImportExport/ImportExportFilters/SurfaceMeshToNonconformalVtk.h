@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <QtCore/QString>
 
 #include "SIMPLib/Common/Constants.h"
@@ -179,7 +181,7 @@ protected:
    */
   void initialize();
 
-  int writeCellData(FILE* vtkFile, QMap<int32_t, int32_t>& featureIds);
+  int writeCellData(FILE* vtkFile, const std::vector<int64_t>& cellOrder);
 
   int writePointData(FILE* vtkFile);
 
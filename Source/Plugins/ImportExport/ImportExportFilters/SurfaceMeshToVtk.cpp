@@ -35,6 +35,12 @@
 
 #include "SurfaceMeshToVtk.h"
 
+#include <functional>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -49,7 +55,10 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -285,6 +294,21 @@ void SurfaceMeshToVtk::execute()
   }
   ScopedFileMonitor vtkFileMonitor(vtkFile);
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("SurfaceMeshToVtk"));
+#endif
+
+  // A .vtp file is written as VTK XML PolyData with the arrays appended as raw binary in system byte order
+  if(fi.suffix().compare("vtp", Qt::CaseInsensitive) == 0)
+  {
+    if(writeXmlAppendedFile(vtkFile) < 0)
+    {
+      QString ss = QObject::tr("Error writing file '%1'").arg(getOutputVtkFile());
+      setErrorCondition(-18543, ss);
+    }
+    return;
+  }
+
   fprintf(vtkFile, "# vtk DataFile Version 2.0\n");
   fprintf(vtkFile, "Data set from DREAM.3D Surface Meshing Module\n");
   if(m_WriteBinaryFile)
@@ -309,76 +333,72 @@ void SurfaceMeshToVtk::execute()
 
   fprintf(vtkFile, "POINTS %d float\n", numberWrittenumNodes);
 
-  float pos[3] = {0.0f, 0.0f, 0.0f};
-
-  size_t totalWritten = 0;
-
-  // Write the POINTS data (Vertex)
-  for(int i = 0; i < numNodes; i++)
+  // The points are written in vertex order, skipping the vertices whose node type is not positive
+  std::vector<int64_t> writtenNodes;
+  writtenNodes.reserve(numberWrittenumNodes);
+  for(int64_t i = 0; i < numNodes; i++)
   {
     if(m_SurfaceMeshNodeType[i] > 0)
     {
-      pos[0] = static_cast<float>(nodes[i * 3]);
-      pos[1] = static_cast<float>(nodes[i * 3 + 1]);
-      pos[2] = static_cast<float>(nodes[i * 3 + 2]);
+      writtenNodes.push_back(i);
+    }
+  }
 
-      if(m_WriteBinaryFile)
-      {
-        SIMPLib::Endian::FromSystemToBig::convert(pos[0]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[1]);
-        SIMPLib::Endian::FromSystemToBig::convert(pos[2]);
-        totalWritten = fwrite(pos, sizeof(float), 3, vtkFile);
-        if(totalWritten != sizeof(float) * 3)
-        {
-        }
-      }
-      else
-      {
-        fprintf(vtkFile, "%f %f %f\n", pos[0], pos[1], pos[2]); // Write the positions to the output file
-      }
+  // Write the POINTS data (Vertex)
+  if(m_WriteBinaryFile)
+  {
+    BinaryBlockWriter::WriteRecords<float>(vtkFile, writtenNodes.size(), 3, BinaryBlockWriter::ByteOrder::BigEndian, [&](size_t r, float* out) {
+      const float* pos = nodes + writtenNodes[r] * 3;
+      out[0] = pos[0];
+      out[1] = pos[1];
+      out[2] = pos[2];
+    });
+  }
+  else
+  {
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(const int64_t& i : writtenNodes)
+    {
+      text.printf("%f %f %f\n", nodes[i * 3], nodes[i * 3 + 1], nodes[i * 3 + 2]); // Write the positions to the output file
     }
   }
 
-  int tData[4];
   int triangleCount = numTriangles;
-  //  int tn1, tn2, tn3;
   if(!m_WriteConformalMesh)
   {
     triangleCount = numTriangles * 2;
   }
-  // Write the POLYGONS
+  // Write the POLYGONS. A non conformal mesh writes every triangle a second time with the opposite winding.
   fprintf(vtkFile, "\nPOLYGONS %d %d\n", triangleCount, (triangleCount * 4));
-  for(int j = 0; j < numTriangles; j++)
+  if(m_WriteBinaryFile)
   {
-    //  Triangle& t = triangles[j];
-    tData[1] = triangles[j * 3];
-    tData[2] = triangles[j * 3 + 1];
-    tData[3] = triangles[j * 3 + 2];
-
-    if(m_WriteBinaryFile)
-    {
+    size_t valuesPerRecord = m_WriteConformalMesh ? 4 : 8;
+    BinaryBlockWriter::WriteRecords<int32_t>(vtkFile, numTriangles, valuesPerRecord, BinaryBlockWriter::ByteOrder::BigEndian, [&](size_t j, int32_t* tData) {
       tData[0] = 3; // Push on the total number of entries for this entry
-      SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-      SIMPLib::Endian::FromSystemToBig::convert(tData[1]); // Index of Vertex 0
-      SIMPLib::Endian::FromSystemToBig::convert(tData[2]); // Index of Vertex 1
-      SIMPLib::Endian::FromSystemToBig::convert(tData[3]); // Index of Vertex 2
-      fwrite(tData, sizeof(int), 4, vtkFile);
-      if(!m_WriteConformalMesh)
+      tData[1] = static_cast<int32_t>(triangles[j * 3]);
+      tData[2] = static_cast<int32_t>(triangles[j * 3 + 1]);
+      tData[3] = static_cast<int32_t>(triangles[j * 3 + 2]);
+      if(valuesPerRecord == 8)
       {
-        tData[0] = tData[1];
-        tData[1] = tData[3];
-        tData[3] = tData[0];
-        tData[0] = 3;
-        SIMPLib::Endian::FromSystemToBig::convert(tData[0]);
-        fwrite(tData, sizeof(int), 4, vtkFile);
+        tData[4] = 3;
+        tData[5] = tData[3];
+        tData[6] = tData[2];
+        tData[7] = tData[1];
       }
-    }
-    else
+    });
+  }
+  else
+  {
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(int64_t j = 0; j < numTriangles; j++)
     {
-      fprintf(vtkFile, "3 %d %d %d\n", tData[1], tData[2], tData[3]);
+      int32_t t0 = static_cast<int32_t>(triangles[j * 3]);
+      int32_t t1 = static_cast<int32_t>(triangles[j * 3 + 1]);
+      int32_t t2 = static_cast<int32_t>(triangles[j * 3 + 2]);
+      text.printf("3 %d %d %d\n", t0, t1, t2);
       if(!m_WriteConformalMesh)
       {
-        fprintf(vtkFile, "3 %d %d %d\n", tData[3], tData[2], tData[1]);
+        text.printf("3 %d %d %d\n", t2, t1, t0);
       }
     }
   }
@@ -409,24 +429,18 @@ void writePointScalarData(DataContainer::Pointer dc, const QString& vertexAttrib
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
+    if(writeBinaryData)
+    {
+      BinaryBlockWriter::WriteArray<T>(vtkFile, m, nT, BinaryBlockWriter::ByteOrder::BigEndian);
+      return;
+    }
     for(int i = 0; i < nT; ++i)
     {
-      T swapped = 0x00;
-      if(writeBinaryData)
+      ss = QString::number(m[i]) + " ";
+      fprintf(vtkFile, "%s ", ss.toLatin1().data());
+      // if (i%50 == 0)
       {
-        swapped = static_cast<T>(m[i]);
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(T), 1, vtkFile);
-      }
-      else
-      {
-
-        ss = QString::number(m[i]) + " ";
-        fprintf(vtkFile, "%s ", ss.toLatin1().data());
-        // if (i%50 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+        fprintf(vtkFile, "\n");
       }
     }
   }
@@ -446,32 +460,18 @@ void writePointVectorData(DataContainer::Pointer dc, const QString& vertexAttrib
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "%s %s %s\n", vtkAttributeType.toLatin1().data(), dataName.toLatin1().data(), dataType.toLatin1().data());
+    if(writeBinaryData)
+    {
+      BinaryBlockWriter::WriteArray<T>(vtkFile, m, static_cast<size_t>(nT) * 3, BinaryBlockWriter::ByteOrder::BigEndian);
+      return;
+    }
     for(int i = 0; i < nT; ++i)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
-      {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-      }
-      else
+      ss = QString::number(m[i * 3 + 0]) + " " + QString::number(m[i * 3 + 1]) + " " + QString::number(m[i * 3 + 2]) + " ";
+      fprintf(vtkFile, "%s ", ss.toLatin1().data());
+      // if (i%50 == 0)
       {
-
-        ss = QString::number(m[i * 3 + 0]) + " " + QString::number(m[i * 3 + 1]) + " " + QString::number(m[i * 3 + 2]) + " ";
-        fprintf(vtkFile, "%s ", ss.toLatin1().data());
-        // if (i%50 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+        fprintf(vtkFile, "\n");
       }
     }
   }
@@ -509,19 +509,28 @@ int SurfaceMeshToVtk::writePointData(FILE* vtkFile)
   fprintf(vtkFile, "SCALARS Node_Type char 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
 
-  for(int i = 0; i < numNodes; ++i)
+  if(m_WriteBinaryFile)
   {
-    if(m_SurfaceMeshNodeType[i] > 0)
+    // 1 byte Char values so there is nothing to swap; only the compaction is needed
+    std::vector<int8_t> nodeTypes;
+    nodeTypes.reserve(numberWrittenumNodes);
+    for(int64_t i = 0; i < numNodes; ++i)
     {
-      if(m_WriteBinaryFile)
+      if(m_SurfaceMeshNodeType[i] > 0)
       {
-        // Normally, we would byte swap to big endian but since we are only writing
-        // 1 byte Char values, nothing to swap.
-        fwrite(m_SurfaceMeshNodeType + i, sizeof(char), 1, vtkFile);
+        nodeTypes.push_back(m_SurfaceMeshNodeType[i]);
       }
-      else
+    }
+    BinaryBlockWriter::WriteArray<int8_t>(vtkFile, nodeTypes.data(), nodeTypes.size(), BinaryBlockWriter::ByteOrder::BigEndian);
+  }
+  else
+  {
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(int64_t i = 0; i < numNodes; ++i)
+    {
+      if(m_SurfaceMeshNodeType[i] > 0)
       {
-        fprintf(vtkFile, "%d ", m_SurfaceMeshNodeType[i]);
+        text.printf("%d ", m_SurfaceMeshNodeType[i]);
       }
     }
   }
@@ -564,33 +573,33 @@ void writeCellScalarData(DataContainer::Pointer dc, const QString& faceAttribute
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "SCALARS %s %s 1\n", dataName.toLatin1().data(), dataType.toLatin1().data());
     fprintf(vtkFile, "LOOKUP_TABLE default\n");
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T swapped = 0x00;
-      if(writeBinaryData)
+      if(writeConformalMesh)
       {
-        swapped = static_cast<T>(m[i]);
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(T), 1, vtkFile);
-        if(!writeConformalMesh)
-        {
-          fwrite(&swapped, sizeof(T), 1, vtkFile);
-        }
+        BinaryBlockWriter::WriteArray<T>(vtkFile, m, nT, BinaryBlockWriter::ByteOrder::BigEndian);
       }
       else
       {
-
+        BinaryBlockWriter::WriteRecords<T>(vtkFile, nT, 2, BinaryBlockWriter::ByteOrder::BigEndian, [m](size_t i, T* out) {
+          out[0] = m[i];
+          out[1] = m[i];
+        });
+      }
+      return;
+    }
+    for(int i = 0; i < nT; ++i)
+    {
+      ss << m[i] << " ";
+      if(!writeConformalMesh)
+      {
         ss << m[i] << " ";
-        if(!writeConformalMesh)
-        {
-          ss << m[i] << " ";
-        }
-        fprintf(vtkFile, "%s", buf.toLatin1().data());
-        buf.clear();
-        if(i % 50 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+      }
+      fprintf(vtkFile, "%s", buf.toLatin1().data());
+      buf.clear();
+      if(i % 50 == 0)
+      {
+        fprintf(vtkFile, "\n");
       }
     }
   }
@@ -611,42 +620,34 @@ void writeCellVectorData(DataContainer::Pointer dc, const QString& faceAttribute
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "%s %s %s\n", vtkAttributeType.toLatin1().data(), dataName.toLatin1().data(), dataType.toLatin1().data());
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
+      if(writeConformalMesh)
       {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s2, sizeof(T), 1, vtkFile);
-        if(!writeConformalMesh)
-        {
-          fwrite(&s0, sizeof(T), 1, vtkFile);
-          fwrite(&s1, sizeof(T), 1, vtkFile);
-          fwrite(&s2, sizeof(T), 1, vtkFile);
-        }
+        BinaryBlockWriter::WriteArray<T>(vtkFile, m, static_cast<size_t>(nT) * 3, BinaryBlockWriter::ByteOrder::BigEndian);
       }
       else
+      {
+        BinaryBlockWriter::WriteRecords<T>(vtkFile, nT, 6, BinaryBlockWriter::ByteOrder::BigEndian, [m](size_t i, T* out) {
+          out[0] = out[3] = m[i * 3 + 0];
+          out[1] = out[4] = m[i * 3 + 1];
+          out[2] = out[5] = m[i * 3 + 2];
+        });
+      }
+      return;
+    }
+    for(int i = 0; i < nT; ++i)
+    {
+      ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
+      if(!writeConformalMesh)
       {
         ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
-        if(!writeConformalMesh)
-        {
-          ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
-        }
-        fprintf(vtkFile, "%s ", buf.toLatin1().data());
-        buf.clear();
-        if(i % 25 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+      }
+      fprintf(vtkFile, "%s ", buf.toLatin1().data());
+      buf.clear();
+      if(i % 25 == 0)
+      {
+        fprintf(vtkFile, "\n");
       }
     }
   }
@@ -667,49 +668,38 @@ void writeCellNormalData(DataContainer::Pointer dc, const QString& faceAttribute
     T* m = reinterpret_cast<T*>(data->getVoidPointer(0));
     fprintf(vtkFile, "\n");
     fprintf(vtkFile, "NORMALS %s %s\n", dataName.toLatin1().data(), dataType.toLatin1().data());
-    for(int i = 0; i < nT; ++i)
+    if(writeBinaryData)
     {
-      T s0 = 0x00;
-      T s1 = 0x00;
-      T s2 = 0x00;
-      if(writeBinaryData)
+      if(writeConformalMesh)
       {
-        s0 = static_cast<T>(m[i * 3 + 0]);
-        s1 = static_cast<T>(m[i * 3 + 1]);
-        s2 = static_cast<T>(m[i * 3 + 2]);
-        SIMPLib::Endian::FromSystemToBig::convert(s0);
-        SIMPLib::Endian::FromSystemToBig::convert(s1);
-        SIMPLib::Endian::FromSystemToBig::convert(s2);
-        fwrite(&s0, sizeof(T), 1, vtkFile);
-        fwrite(&s1, sizeof(T), 1, vtkFile);
-        fwrite(&s2, sizeof(T), 1, vtkFile);
-        if(!writeConformalMesh)
-        {
-          s0 = static_cast<T>(m[i * 3 + 0]) * -1.0;
-          s1 = static_cast<T>(m[i * 3 + 1]) * -1.0;
-          s2 = static_cast<T>(m[i * 3 + 2]) * -1.0;
-          SIMPLib::Endian::FromSystemToBig::convert(s0);
-          SIMPLib::Endian::FromSystemToBig::convert(s1);
-          SIMPLib::Endian::FromSystemToBig::convert(s2);
-          fwrite(&s0, sizeof(T), 1, vtkFile);
-          fwrite(&s1, sizeof(T), 1, vtkFile);
-          fwrite(&s2, sizeof(T), 1, vtkFile);
-        }
+        BinaryBlockWriter::WriteArray<T>(vtkFile, m, static_cast<size_t>(nT) * 3, BinaryBlockWriter::ByteOrder::BigEndian);
       }
       else
       {
-
-        ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
-        if(!writeConformalMesh)
-        {
-          ss << -1.0 * m[i * 3 + 0] << " " << -1.0 * m[i * 3 + 1] << " " << -1.0 * m[i * 3 + 2] << " ";
-        }
-        fprintf(vtkFile, "%s ", buf.toLatin1().data());
-        buf.clear();
-        if(i % 50 == 0)
-        {
-          fprintf(vtkFile, "\n");
-        }
+        // The flipped copy of each triangle carries the negated normal
+        BinaryBlockWriter::WriteRecords<T>(vtkFile, nT, 6, BinaryBlockWriter::ByteOrder::BigEndian, [m](size_t i, T* out) {
+          out[0] = m[i * 3 + 0];
+          out[1] = m[i * 3 + 1];
+          out[2] = m[i * 3 + 2];
+          out[3] = static_cast<T>(m[i * 3 + 0] * -1.0);
+          out[4] = static_cast<T>(m[i * 3 + 1] * -1.0);
+          out[5] = static_cast<T>(m[i * 3 + 2] * -1.0);
+        });
+      }
+      return;
+    }
+    for(int i = 0; i < nT; ++i)
+    {
+      ss << m[i * 3 + 0] << " " << m[i * 3 + 1] << " " << m[i * 3 + 2] << " ";
+      if(!writeConformalMesh)
+      {
+        ss << -1.0 * m[i * 3 + 0] << " " << -1.0 * m[i * 3 + 1] << " " << -1.0 * m[i * 3 + 2] << " ";
+      }
+      fprintf(vtkFile, "%s ", buf.toLatin1().data());
+      buf.clear();
+      if(i % 50 == 0)
+      {
+        fprintf(vtkFile, "\n");
       }
     }
   }
@@ -734,7 +724,6 @@ int SurfaceMeshToVtk::writeCellData(FILE* vtkFile)
   int64_t nT = triangleGeom->getNumberOfTris();
 
   int numTriangles = nT;
-  int swapped;
   if(!m_WriteConformalMesh)
   {
     numTriangles = nT * 2;
@@ -744,64 +733,32 @@ int SurfaceMeshToVtk::writeCellData(FILE* vtkFile)
   fprintf(vtkFile, "\n");
   fprintf(vtkFile, "CELL_DATA %d\n", numTriangles);
 
-  // Write the FeatureId Data to the file
+  // Write the FeatureId Data to the file. The flipped copy of a non conformal triangle takes the second label.
   fprintf(vtkFile, "SCALARS FeatureID int 1\n");
   fprintf(vtkFile, "LOOKUP_TABLE default\n");
-  for(int i = 0; i < nT; ++i)
+  if(m_WriteBinaryFile)
   {
-    // FaceArray::Face_t& t = triangles[i]; // Get the current Node
-
-    if(m_WriteBinaryFile)
+    if(m_WriteConformalMesh)
     {
-      swapped = m_SurfaceMeshFaceLabels[i * 2];
-      SIMPLib::Endian::FromSystemToBig::convert(swapped);
-      fwrite(&swapped, sizeof(int), 1, vtkFile);
-      if(!m_WriteConformalMesh)
-      {
-        swapped = m_SurfaceMeshFaceLabels[i * 2 + 1];
-        SIMPLib::Endian::FromSystemToBig::convert(swapped);
-        fwrite(&swapped, sizeof(int), 1, vtkFile);
-      }
+      BinaryBlockWriter::WriteRecords<int32_t>(vtkFile, nT, 1, BinaryBlockWriter::ByteOrder::BigEndian, [this](size_t i, int32_t* out) { out[0] = m_SurfaceMeshFaceLabels[i * 2]; });
     }
     else
     {
-      fprintf(vtkFile, "%d\n", m_SurfaceMeshFaceLabels[i * 2]);
-      if(!m_WriteConformalMesh)
-      {
-        fprintf(vtkFile, "%d\n", m_SurfaceMeshFaceLabels[i * 2 + 1]);
-      }
+      BinaryBlockWriter::WriteArray<int32_t>(vtkFile, m_SurfaceMeshFaceLabels, nT * 2, BinaryBlockWriter::ByteOrder::BigEndian);
     }
   }
-
-#if 0
-  // Write the Original Triangle ID Data to the file
-  fprintf(vtkFile, "\n");
-  fprintf(vtkFile, "SCALARS TriangleID int 1\n");
-  fprintf(vtkFile, "LOOKUP_TABLE default\n");
-  for(int i = 0; i < nT; ++i)
+  else
   {
-    //Triangle& t = triangles[i]; // Get the current Node
-
-    if(m_WriteBinaryFile == true)
+    BinaryBlockWriter::TextBlockWriter text(vtkFile);
+    for(int64_t i = 0; i < nT; ++i)
     {
-      swapped = i;
-      SIMPLib::Endian::FromSystemToBig::convert(swapped);
-      fwrite(&swapped, sizeof(int), 1, vtkFile);
-      if(false == m_WriteConformalMesh)
-      {
-        fwrite(&swapped, sizeof(int), 1, vtkFile);
-      }
-    }
-    else
-    {
-      fprintf(vtkFile, "%d\n", i);
-      if(false == m_WriteConformalMesh)
+      text.printf("%d\n", m_SurfaceMeshFaceLabels[i * 2]);
+      if(!m_WriteConformalMesh)
       {
-        fprintf(vtkFile, "%d\n", i);
+        text.printf("%d\n", m_SurfaceMeshFaceLabels[i * 2 + 1]);
       }
     }
   }
-#endif
 
   QString attrMatName = m_SurfaceMeshFaceLabelsArrayPath.getAttributeMatrixName();
 
@@ -826,6 +783,206 @@ int SurfaceMeshToVtk::writeCellData(FILE* vtkFile)
   return err;
 }
 
+namespace
+{
+/**
+ * @brief One data array of a VTK XML file whose bytes go into the appended data section
+ */
+struct XmlAppendedArray
+{
+  QString section;
+  QString name;
+  QString type;
+  int numComps;
+  uint64_t numBytes;
+  std::function<bool(FILE*)> write;
+};
+
+template <typename T> QString VtkXmlTypeName();
+template <> QString VtkXmlTypeName<int8_t>()
+{
+  return "Int8";
+}
+template <> QString VtkXmlTypeName<int32_t>()
+{
+  return "Int32";
+}
+template <> QString VtkXmlTypeName<int64_t>()
+{
+  return "Int64";
+}
+template <> QString VtkXmlTypeName<float>()
+{
+  return "Float32";
+}
+template <> QString VtkXmlTypeName<double>()
+{
+  return "Float64";
+}
+
+/**
+ * @brief AddXmlArray Queues a contiguous array that is written straight from memory
+ */
+template <typename T> void AddXmlArray(std::vector<XmlAppendedArray>& arrays, const QString& section, const QString& name, int numComps, const T* data, size_t numValues)
+{
+  XmlAppendedArray array = {section, name, VtkXmlTypeName<T>(), numComps, numValues * sizeof(T), nullptr};
+  array.write = [data, numValues](FILE* f) { return BinaryBlockWriter::WriteArray<T>(f, data, numValues, BinaryBlockWriter::ByteOrder::Native); };
+  arrays.push_back(array);
+}
+
+/**
+ * @brief AddXmlFaceArray Queues a face array, repeating each tuple for the flipped copy of a non conformal
+ * triangle. Normals are negated on the flipped copy.
+ */
+template <typename T>
+void AddXmlFaceArray(std::vector<XmlAppendedArray>& arrays, DataContainer::Pointer dc, const QString& faceAttributeMatrixName, const QString& dataName, int numComps, bool writeConformalMesh,
+                     bool negateFlipped, size_t nT)
+{
+  typename DataArray<T>::Pointer data = std::dynamic_pointer_cast<DataArray<T>>(dc->getAttributeMatrix(faceAttributeMatrixName)->getAttributeArray(dataName));
+  if(nullptr == data.get() || data->getNumberOfComponents() != numComps)
+  {
+    return;
+  }
+  const T* m = data->getPointer(0);
+  if(writeConformalMesh)
+  {
+    AddXmlArray<T>(arrays, "CellData", dataName, numComps, m, nT * numComps);
+    return;
+  }
+  XmlAppendedArray array = {"CellData", dataName, VtkXmlTypeName<T>(), numComps, nT * 2 * numComps * sizeof(T), nullptr};
+  array.write = [m, numComps, negateFlipped, nT](FILE* f) {
+    return BinaryBlockWriter::WriteRecords<T>(f, nT, numComps * 2, BinaryBlockWriter::ByteOrder::Native, [=](size_t i, T* out) {
+      for(int c = 0; c < numComps; c++)
+      {
+        out[c] = m[i * numComps + c];
+        out[numComps + c] = negateFlipped ? static_cast<T>(m[i * numComps + c] * -1.0) : m[i * numComps + c];
+      }
+    });
+  };
+  arrays.push_back(array);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SurfaceMeshToVtk::writeXmlAppendedFile(FILE* vtkFile)
+{
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshFaceLabelsArrayPath.getDataContainerName());
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  const float* nodes = triangleGeom->getVertexPointer(0);
+  const int64_t* triangles = triangleGeom->getTriPointer(0);
+  size_t numNodes = triangleGeom->getNumberOfVertices();
+  size_t nT = triangleGeom->getNumberOfTris();
+  size_t numPolys = m_WriteConformalMesh ? nT : nT * 2;
+  const int32_t* faceLabels = m_SurfaceMeshFaceLabels;
+
+  // Every vertex is written so the connectivity can index the geometry's vertex list directly
+  std::vector<XmlAppendedArray> arrays;
+  QString vertexAttrMatName = m_SurfaceMeshNodeTypeArrayPath.getAttributeMatrixName();
+  AddXmlArray<int8_t>(arrays, "PointData", "Node_Type", 1, m_SurfaceMeshNodeType, numNodes);
+  QStringList pointArrayNames = {"Principal_Direction_1", "Principal_Direction_2", "Principal_Curvature_1", "Principal_Curvature_2", SIMPL::VertexData::SurfaceMeshNodeNormals};
+  for(const QString& name : pointArrayNames)
+  {
+    DoubleArrayType::Pointer data = std::dynamic_pointer_cast<DoubleArrayType>(sm->getAttributeMatrix(vertexAttrMatName)->getAttributeArray(name));
+    if(nullptr != data.get())
+    {
+      AddXmlArray<double>(arrays, "PointData", name, data->getNumberOfComponents(), data->getPointer(0), numNodes * data->getNumberOfComponents());
+    }
+  }
+
+  if(m_WriteConformalMesh)
+  {
+    XmlAppendedArray featureIds = {"CellData", "FeatureID", "Int32", 1, nT * sizeof(int32_t), nullptr};
+    featureIds.write = [faceLabels, nT](FILE* f) {
+      return BinaryBlockWriter::WriteRecords<int32_t>(f, nT, 1, BinaryBlockWriter::ByteOrder::Native, [faceLabels](size_t i, int32_t* out) { out[0] = faceLabels[i * 2]; });
+    };
+    arrays.push_back(featureIds);
+  }
+  else
+  {
+    AddXmlArray<int32_t>(arrays, "CellData", "FeatureID", 1, faceLabels, nT * 2);
+  }
+  QString faceAttrMatName = m_SurfaceMeshFaceLabelsArrayPath.getAttributeMatrixName();
+  AddXmlFaceArray<int32_t>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshFeatureFaceId, 1, m_WriteConformalMesh, false, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature1, 1, m_WriteConformalMesh, false, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalCurvature2, 1, m_WriteConformalMesh, false, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection1, 3, m_WriteConformalMesh, false, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshPrincipalDirection2, 3, m_WriteConformalMesh, false, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshGaussianCurvatures, 1, m_WriteConformalMesh, false, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshMeanCurvatures, 1, m_WriteConformalMesh, false, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, SIMPL::FaceData::SurfaceMeshFaceNormals, 3, m_WriteConformalMesh, true, nT);
+  AddXmlFaceArray<double>(arrays, sm, faceAttrMatName, "Goldfeather_Triangle_Normals", 3, m_WriteConformalMesh, true, nT);
+
+  AddXmlArray<float>(arrays, "Points", "Points", 3, nodes, numNodes * 3);
+  if(m_WriteConformalMesh)
+  {
+    AddXmlArray<int64_t>(arrays, "Polys", "connectivity", 1, triangles, nT * 3);
+  }
+  else
+  {
+    XmlAppendedArray connectivity = {"Polys", "connectivity", "Int64", 1, nT * 6 * sizeof(int64_t), nullptr};
+    connectivity.write = [triangles, nT](FILE* f) {
+      return BinaryBlockWriter::WriteRecords<int64_t>(f, nT, 6, BinaryBlockWriter::ByteOrder::Native, [triangles](size_t i, int64_t* out) {
+        out[0] = out[5] = triangles[i * 3];
+        out[1] = out[4] = triangles[i * 3 + 1];
+        out[2] = out[3] = triangles[i * 3 + 2];
+      });
+    };
+    arrays.push_back(connectivity);
+  }
+  XmlAppendedArray offsets = {"Polys", "offsets", "Int64", 1, numPolys * sizeof(int64_t), nullptr};
+  offsets.write = [numPolys](FILE* f) {
+    return BinaryBlockWriter::WriteRecords<int64_t>(f, numPolys, 1, BinaryBlockWriter::ByteOrder::Native, [](size_t i, int64_t* out) { out[0] = static_cast<int64_t>(i + 1) * 3; });
+  };
+  arrays.push_back(offsets);
+
+  // Each appended block is a UInt64 byte count followed by the raw values
+  std::vector<uint64_t> arrayOffsets(arrays.size(), 0);
+  for(size_t a = 1; a < arrays.size(); a++)
+  {
+    arrayOffsets[a] = arrayOffsets[a - 1] + sizeof(uint64_t) + arrays[a - 1].numBytes;
+  }
+
+  fprintf(vtkFile, "<?xml version=\"1.0\"?>\n");
+#ifdef CMP_WORDS_BIGENDIAN
+  fprintf(vtkFile, "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"BigEndian\" header_type=\"UInt64\">\n");
+#else
+  fprintf(vtkFile, "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n");
+#endif
+  fprintf(vtkFile, "  <PolyData>\n");
+  fprintf(vtkFile, "    <Piece NumberOfPoints=\"%llu\" NumberOfVerts=\"0\" NumberOfLines=\"0\" NumberOfStrips=\"0\" NumberOfPolys=\"%llu\">\n", static_cast<unsigned long long>(numNodes),
+          static_cast<unsigned long long>(numPolys));
+  QStringList sections = {"PointData", "CellData", "Points", "Polys"};
+  for(const QString& section : sections)
+  {
+    fprintf(vtkFile, "      <%s>\n", section.toLatin1().data());
+    for(size_t a = 0; a < arrays.size(); a++)
+    {
+      if(arrays[a].section != section)
+      {
+        continue;
+      }
+      fprintf(vtkFile, "        <DataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"%d\" format=\"appended\" offset=\"%llu\"/>\n", arrays[a].type.toLatin1().data(), arrays[a].name.toLatin1().data(),
+              arrays[a].numComps, static_cast<unsigned long long>(arrayOffsets[a]));
+    }
+    fprintf(vtkFile, "      </%s>\n", section.toLatin1().data());
+  }
+  fprintf(vtkFile, "    </Piece>\n");
+  fprintf(vtkFile, "  </PolyData>\n");
+  fprintf(vtkFile, "  <AppendedData encoding=\"raw\">\n   _");
+  for(XmlAppendedArray& array : arrays)
+  {
+    if(fwrite(&array.numBytes, sizeof(uint64_t), 1, vtkFile) != 1 || !array.write(vtkFile))
+    {
+      return -1;
+    }
+  }
+  fprintf(vtkFile, "\n  </AppendedData>\n");
+  fprintf(vtkFile, "</VTKFile>\n");
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
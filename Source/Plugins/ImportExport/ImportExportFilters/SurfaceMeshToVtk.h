@@ -206,6 +206,13 @@ protected:
    */
   int writePointData(FILE* vtkFile);
 
+  /**
+   * @brief writeXmlAppendedFile Writes the mesh and its arrays as a VTK XML PolyData file with appended raw binary data
+   * @param vtkFile
+   * @return
+   */
+  int writeXmlAppendedFile(FILE* vtkFile);
+
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
   DEFINE_DATAARRAY_VARIABLE(int8_t, SurfaceMeshNodeType)
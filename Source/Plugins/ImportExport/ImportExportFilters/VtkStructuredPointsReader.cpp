@@ -34,10 +34,16 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 #include "VtkStructuredPointsReader.h"
+
+#include <algorithm>
 #include <fstream>
 
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
@@ -47,7 +53,10 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BlockReader.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 #define vtkErrorMacro(msg) std::cout msg
@@ -256,6 +265,9 @@ void VtkStructuredPointsReader::execute()
   // the filter is preflighting then the filter will just gather all the scalar
   // and vector data set names and number of tuples from the file. If the filter
   // is executing then the file data will be read into the data arrays
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("VtkStructuredPointsReader"));
+#endif
   dataCheck();
 
 }
@@ -326,87 +338,13 @@ template <typename T> int32_t skipVolume(std::istream& in, bool binary, size_t t
       return -1;
     }
   }
-  else
+  else if(BlockReader::SkipAsciiValues(in, totalSize) != totalSize)
   {
-    T tmp;
-    for(size_t z = 0; z < totalSize; ++z)
-    {
-      in >> tmp;
-    }
+    return -1;
   }
   return err;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -------------------------------------------------------------------------
-template <typename T> int32_t vtkReadBinaryData(std::istream& in, T* data, int32_t numTuples, int32_t numComp)
-{
-  if(numTuples == 0 || numComp == 0)
-  {
-    // nothing to read here.
-    return 1;
-  }
-
-  size_t numBytesToRead = static_cast<size_t>(numTuples) * static_cast<size_t>(numComp) * sizeof(T);
-  size_t numRead = 0;
-  // Cast our pointer to a pointer that std::istream will take
-  char* chunkptr = reinterpret_cast<char*>(data);
-
-  numRead = 0;
-  // Now start reading the data in chunks if needed.
-  size_t chunkSize = DEFAULT_BLOCKSIZE;
-  // Sanity check the chunk size to make sure it is not any larger than the chunk of data we are about to read
-  if(numBytesToRead < DEFAULT_BLOCKSIZE)
-  {
-    chunkSize = numBytesToRead;
-  }
-
-  size_t master_counter = 0;
-  size_t bytes_read = 0;
-
-  // Now chunk through the file reading up chunks of data that can actually be
-  // read in a single read. DEFAULT_BLOCKSIZE will control this.
-  while(true)
-  {
-    in.read(chunkptr, chunkSize);
-    bytes_read = in.gcount();
-
-    chunkptr = chunkptr + bytes_read;
-    master_counter += bytes_read;
-
-    if(numBytesToRead - master_counter < chunkSize)
-    {
-      chunkSize = numBytesToRead - master_counter;
-    }
-    if(master_counter >= numBytesToRead)
-    {
-      break;
-    }
-    if(in.good())
-    {
-      // std::cout << "all data read successfully." << in.gcount() << std::endl;
-    }
-
-    if((in.rdstate() & std::ifstream::failbit) != 0)
-    {
-      std::cout << "FAIL " << in.gcount() << " could be read. Needed " << chunkSize << " total bytes read = " << master_counter << std::endl;
-      return -12020;
-    }
-    if((in.rdstate() & std::ifstream::eofbit) != 0)
-    {
-      std::cout << "EOF " << in.gcount() << " could be read. Needed " << chunkSize << " total bytes read = " << master_counter << std::endl;
-      return -12021;
-    }
-    if((in.rdstate() & std::ifstream::badbit) != 0)
-    {
-      std::cout << "BAD " << in.gcount() << " could be read. Needed " << chunkSize << " total bytes read = " << master_counter << std::endl;
-      return -12021;
-    }
-  }
-  return 0;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -418,34 +356,32 @@ template <typename T> int32_t readDataChunk(AttributeMatrix::Pointer attrMat, st
   QVector<size_t> cDims(1, scalarNumComp);
 
   typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(tDims, cDims, scalarName, !inPreflight);
-  data->initializeWithZeros();
   attrMat->insertOrAssign(data);
   if(inPreflight)
   {
     return skipVolume<T>(in, binary, numTuples * scalarNumComp);
   }
 
+  // Every value is overwritten below, so the array is only zeroed when the file turns out to be short
+  size_t totalSize = numTuples * scalarNumComp;
   if(binary)
   {
-    int32_t err = vtkReadBinaryData<T>(in, data->getPointer(0), numTuples, scalarNumComp);
-    if(err < 0)
+    // Legacy VTK binary files are always big endian
+    if(!BlockReader::ReadBinaryValues<T>(in, data->getPointer(0), totalSize, BlockReader::ByteOrder::BigEndian))
     {
+      data->initializeWithZeros();
       std::cout << "Error Reading Binary Data '" << scalarName.toStdString() << "' " << attrMat->getName().toStdString() << " numTuples = " << numTuples << std::endl;
-      return err;
-    }
-    if(BIGENDIAN == 0)
-    {
-      data->byteSwapElements();
+      return -12020;
     }
   }
   else
   {
-    T value = static_cast<T>(0.0);
-    size_t totalSize = numTuples * scalarNumComp;
-    for(size_t i = 0; i < totalSize; ++i)
+    size_t numRead = BlockReader::ReadAsciiValues<T>(in, totalSize, data->getPointer(0));
+    if(numRead != totalSize)
     {
-      in >> value;
-      data->setValue(i, value);
+      std::fill(data->getPointer(0) + numRead, data->getPointer(0) + totalSize, static_cast<T>(0));
+      std::cout << "Error Reading ASCII Data '" << scalarName.toStdString() << "' " << attrMat->getName().toStdString() << " values read = " << numRead << std::endl;
+      return -12022;
     }
   }
 
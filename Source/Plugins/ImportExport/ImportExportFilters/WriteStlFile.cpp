@@ -35,6 +35,14 @@
 
 #include "WriteStlFile.h"
 
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -46,7 +54,10 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include <QtCore/QDir>
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "ImportExport/ImportExportConstants.h"
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.hpp"
 #include "ImportExport/ImportExportVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -203,7 +214,6 @@ void WriteStlFile::preflight()
 // -----------------------------------------------------------------------------
 void WriteStlFile::execute()
 {
-  int32_t err = 0;
   clearErrorCode();
   clearWarningCode();
   dataCheck();
@@ -234,53 +244,62 @@ void WriteStlFile::execute()
     return;
   }
 
-  // Store all the unique Spins
-  QMap<int32_t, int32_t> uniqueGrainIdtoPhase;
-  if(m_GroupByPhase)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("WriteStlFile"));
+#endif
+
+  // Every triangle is written into the file of each of its two labels. The cell index c = triangle * 2 + side is
+  // also the index of that side's label and phase, so sorting the cells on (label, c) groups the triangles of each
+  // feature in one pass instead of rescanning every triangle once per feature. A triangle with the same label on
+  // both sides is only written once, with its forward winding.
+  const int32_t* faceLabels = m_SurfaceMeshFaceLabels;
+  std::vector<int64_t> cellOrder;
+  cellOrder.reserve(nTriangles * 2);
+  for(int64_t c = 0; c < nTriangles * 2; c++)
   {
-    for(int64_t i = 0; i < nTriangles; i++)
+    if((c % 2) == 1 && faceLabels[c] == faceLabels[c - 1])
     {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], m_SurfaceMeshFacePhases[i * 2]);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], m_SurfaceMeshFacePhases[i * 2 + 1]);
+      continue;
     }
+    cellOrder.push_back(c);
   }
-  else
-  {
-    for(int64_t i = 0; i < nTriangles; i++)
-    {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], 0);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], 0);
-    }
-  }
-
-  unsigned char data[50];
-  float* normal = reinterpret_cast<float*>(data);
-  float* vert1 = reinterpret_cast<float*>(data + 12);
-  float* vert2 = reinterpret_cast<float*>(data + 24);
-  float* vert3 = reinterpret_cast<float*>(data + 36);
-  uint16_t* attrByteCount = reinterpret_cast<uint16_t*>(data + 48);
-  *attrByteCount = 0;
-
-  size_t totalWritten = 0;
-  float u[3] = {0.0f, 0.0f, 0.0f}, w[3] = {0.0f, 0.0f, 0.0f};
-  float length = 0.0f;
-
-  int32_t spin = 0;
-  int32_t triCount = 0;
+  auto cellLess = [faceLabels](int64_t a, int64_t b) { return faceLabels[a] < faceLabels[b] || (faceLabels[a] == faceLabels[b] && a < b); };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(cellOrder.begin(), cellOrder.end(), cellLess);
+#else
+  std::sort(cellOrder.begin(), cellOrder.end(), cellLess);
+#endif
 
   // Loop over the unique Spins
-  for(QMap<int32_t, int32_t>::iterator spinIter = uniqueGrainIdtoPhase.begin(); spinIter != uniqueGrainIdtoPhase.end(); ++spinIter)
+  size_t groupStart = 0;
+  while(groupStart < cellOrder.size())
   {
-    spin = spinIter.key();
+    int32_t spin = faceLabels[cellOrder[groupStart]];
+    size_t groupEnd = groupStart + 1;
+    while(groupEnd < cellOrder.size() && faceLabels[cellOrder[groupEnd]] == spin)
+    {
+      groupEnd++;
+    }
+    const int64_t* cells = cellOrder.data() + groupStart;
+    int32_t triCount = static_cast<int32_t>(groupEnd - groupStart);
+    // The last cell of the feature decides its phase
+    int32_t phase = m_GroupByPhase ? m_SurfaceMeshFacePhases[cellOrder[groupEnd - 1]] : 0;
+    groupStart = groupEnd;
 
     // Generate the output file name
     QString filename = getOutputStlDirectory() + "/" + getOutputStlPrefix();
     if(m_GroupByPhase)
     {
-      filename = filename + QString("Ensemble_") + QString::number(spinIter.value()) + QString("_");
+      filename = filename + QString("Ensemble_") + QString::number(phase) + QString("_");
     }
     filename = filename + QString("Feature_") + QString::number(spin) + ".stl";
     FILE* f = fopen(filename.toLatin1().data(), "wb");
+    if(nullptr == f)
+    {
+      QString ss = QObject::tr("Error creating STL file '%1'").arg(filename);
+      setErrorCondition(-1200, ss);
+      return;
+    }
     {
       QString ss = QObject::tr("Writing STL for Feature Id %1").arg(spin);
       notifyStatusMessage(ss);
@@ -289,79 +308,58 @@ void WriteStlFile::execute()
     QString header = "DREAM3D Generated For Feature ID " + QString::number(spin);
     if(m_GroupByPhase)
     {
-      header = header + " Phase " + QString::number(spinIter.value());
+      header = header + " Phase " + QString::number(phase);
     }
-    err = writeHeader(f, header, 0);
-    if(err < 0)
-    {
-    }
-    triCount = 0; // Reset this to Zero. Increment for every triangle written
+    // The triangle count is known up front so the header is complete without seeking back
+    writeHeader(f, header, triCount);
 
-    // Loop over all the triangles for this spin
-    for(int64_t t = 0; t < nTriangles; ++t)
-    {
-      // Get the true indices of the 3 nodes
+    // Each 50 byte record holds the normal, the 3 vertices and a zero attribute byte count
+    bool ok = BinaryBlockWriter::WriteRecords<uint8_t>(f, triCount, 50, BinaryBlockWriter::ByteOrder::Native, [&](size_t r, uint8_t* data) {
+      int64_t t = cells[r] / 2;
+      // Get the true indices of the 3 nodes. The second label's triangles are written with backward spin.
       int64_t nId0 = triangles[t * 3];
       int64_t nId1 = triangles[t * 3 + 1];
       int64_t nId2 = triangles[t * 3 + 2];
-
-      vert1[0] = static_cast<float>(nodes[nId0 * 3]);
-      vert1[1] = static_cast<float>(nodes[nId0 * 3 + 1]);
-      vert1[2] = static_cast<float>(nodes[nId0 * 3 + 2]);
-
-      if(m_SurfaceMeshFaceLabels[t * 2] == spin)
+      if((cells[r] % 2) == 1)
       {
-        // winding = 0; // 0 = Write it using forward spin
+        std::swap(nId1, nId2);
       }
-      else if(m_SurfaceMeshFaceLabels[t * 2 + 1] == spin)
-      {
-        // winding = 1; // Write it using backward spin
-        // Switch the 2 node indices
-        int64_t temp = nId1;
-        nId1 = nId2;
-        nId2 = temp;
-      }
-      else
+
+      float values[12];
+      float* normal = values;
+      float* vert1 = values + 3;
+      float* vert2 = values + 6;
+      float* vert3 = values + 9;
+      for(size_t k = 0; k < 3; k++)
       {
-        continue; // We do not match either spin so move to the next triangle
+        vert1[k] = static_cast<float>(nodes[nId0 * 3 + k]);
+        vert2[k] = static_cast<float>(nodes[nId1 * 3 + k]);
+        vert3[k] = static_cast<float>(nodes[nId2 * 3 + k]);
       }
 
-      vert2[0] = static_cast<float>(nodes[nId1 * 3]);
-      vert2[1] = static_cast<float>(nodes[nId1 * 3 + 1]);
-      vert2[2] = static_cast<float>(nodes[nId1 * 3 + 2]);
-
-      vert3[0] = static_cast<float>(nodes[nId2 * 3]);
-      vert3[1] = static_cast<float>(nodes[nId2 * 3 + 1]);
-      vert3[2] = static_cast<float>(nodes[nId2 * 3 + 2]);
-
       // Compute the normal
-      u[0] = vert2[0] - vert1[0];
-      u[1] = vert2[1] - vert1[1];
-      u[2] = vert2[2] - vert1[2];
-
-      w[0] = vert3[0] - vert1[0];
-      w[1] = vert3[1] - vert1[1];
-      w[2] = vert3[2] - vert1[2];
-
+      float u[3] = {vert2[0] - vert1[0], vert2[1] - vert1[1], vert2[2] - vert1[2]};
+      float w[3] = {vert3[0] - vert1[0], vert3[1] - vert1[1], vert3[2] - vert1[2]};
       normal[0] = u[1] * w[2] - u[2] * w[1];
       normal[1] = u[2] * w[0] - u[0] * w[2];
       normal[2] = u[0] * w[1] - u[1] * w[0];
 
-      length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
       normal[0] = normal[0] / length;
       normal[1] = normal[1] / length;
       normal[2] = normal[2] / length;
 
-      totalWritten = fwrite(data, 1, 50, f);
-      if(totalWritten != 50)
-      {
-        QString ss = QObject::tr("Error Writing STL File. Not enough elements written for Feature Id %1. Wrote %2 of 50.").arg(spin).arg(totalWritten);
-        setErrorCondition(-1201, ss);
-      }
-      triCount++;
-    }
+      ::memcpy(data, values, 48);
+      data[48] = 0;
+      data[49] = 0;
+    });
     fclose(f);
-    err = writeNumTrianglesToFile(filename, triCount);
+    if(!ok)
+    {
+      QString ss = QObject::tr("Error Writing STL File. Not all triangles were written for Feature Id %1.").arg(spin);
+      setErrorCondition(-1201, ss);
+      return;
+    }
   }
 
   clearErrorCode();
@@ -393,22 +391,6 @@ int32_t WriteStlFile::writeHeader(FILE* f, const QString& header, int32_t triCou
   return 0;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeNumTrianglesToFile(const QString& filename, int32_t triCount)
-{
-  // We need to update the number of triangles in the file
-  int32_t err = 0;
-
-  FILE* out = fopen(filename.toLatin1().data(), "r+b");
-  fseek(out, 80L, SEEK_SET);
-  fwrite(reinterpret_cast<char*>(&triCount), 1, 4, out);
-  fclose(out);
-
-  return err;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
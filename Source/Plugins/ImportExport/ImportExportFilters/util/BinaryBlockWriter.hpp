@@ -0,0 +1,298 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The BinaryBlockWriter namespace writes large binary sections of a file in a few big fwrite calls. Records
+ * are generated into a block sized buffer, converted to the requested byte order in place and then written out
+ * as one chunk, so exporting a mesh no longer costs a library call and a swap per value.
+ */
+namespace BinaryBlockWriter
+{
+enum class ByteOrder
+{
+  BigEndian,
+  LittleEndian,
+  Native
+};
+
+static const size_t k_BlockBytes = 4 * 1024 * 1024;
+static const size_t k_ParallelRecords = 16384;
+
+/**
+ * @brief NeedsSwap Returns whether values in system byte order must be swapped to end up in the given order
+ */
+inline bool NeedsSwap(ByteOrder order)
+{
+#ifdef CMP_WORDS_BIGENDIAN
+  return order == ByteOrder::LittleEndian;
+#else
+  return order == ByteOrder::BigEndian;
+#endif
+}
+
+inline uint8_t SwapBytes(uint8_t v)
+{
+  return v;
+}
+
+inline uint16_t SwapBytes(uint16_t v)
+{
+  return static_cast<uint16_t>((v >> 8) | (v << 8));
+}
+
+inline uint32_t SwapBytes(uint32_t v)
+{
+  return ((v & 0x000000FFu) << 24) | ((v & 0x0000FF00u) << 8) | ((v & 0x00FF0000u) >> 8) | ((v & 0xFF000000u) >> 24);
+}
+
+inline uint64_t SwapBytes(uint64_t v)
+{
+  return (static_cast<uint64_t>(SwapBytes(static_cast<uint32_t>(v))) << 32) | static_cast<uint64_t>(SwapBytes(static_cast<uint32_t>(v >> 32)));
+}
+
+template <size_t N> struct UnsignedOfSize;
+template <> struct UnsignedOfSize<1>
+{
+  typedef uint8_t Type;
+};
+template <> struct UnsignedOfSize<2>
+{
+  typedef uint16_t Type;
+};
+template <> struct UnsignedOfSize<4>
+{
+  typedef uint32_t Type;
+};
+template <> struct UnsignedOfSize<8>
+{
+  typedef uint64_t Type;
+};
+
+/**
+ * @brief SwapBlock Reverses the bytes of every value in a contiguous block. The loop is written over plain
+ * unsigned integers so the compiler can turn it into vector byte shuffles.
+ */
+template <typename T> void SwapBlock(T* values, size_t count)
+{
+  typedef typename UnsignedOfSize<sizeof(T)>::Type UnsignedType;
+  for(size_t i = 0; i < count; i++)
+  {
+    UnsignedType u;
+    ::memcpy(&u, values + i, sizeof(T));
+    u = SwapBytes(u);
+    ::memcpy(values + i, &u, sizeof(T));
+  }
+}
+
+/**
+ * @brief The FillRecordsImpl class generates a range of records into the block buffer and swaps their bytes
+ */
+template <typename T, typename FillFunctor> class FillRecordsImpl
+{
+public:
+  FillRecordsImpl(const FillFunctor& fill, T* block, size_t firstRecord, size_t valuesPerRecord, bool swap)
+  : m_Fill(fill)
+  , m_Block(block)
+  , m_FirstRecord(firstRecord)
+  , m_ValuesPerRecord(valuesPerRecord)
+  , m_Swap(swap)
+  {
+  }
+  virtual ~FillRecordsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t r = start; r < end; r++)
+    {
+      m_Fill(m_FirstRecord + r, m_Block + r * m_ValuesPerRecord);
+    }
+    if(m_Swap)
+    {
+      SwapBlock(m_Block + start * m_ValuesPerRecord, (end - start) * m_ValuesPerRecord);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const FillFunctor& m_Fill;
+  T* m_Block;
+  size_t m_FirstRecord;
+  size_t m_ValuesPerRecord;
+  bool m_Swap;
+};
+
+/**
+ * @brief WriteRecords Writes numRecords records of valuesPerRecord values each. The fill functor is called as
+ * fill(recordIndex, T* out) and must write the record's values in system byte order; it may be called from
+ * several threads at once.
+ * @return true when every record was written
+ */
+template <typename T, typename FillFunctor> bool WriteRecords(FILE* f, size_t numRecords, size_t valuesPerRecord, ByteOrder order, const FillFunctor& fill)
+{
+  if(numRecords == 0 || valuesPerRecord == 0)
+  {
+    return true;
+  }
+  size_t recordBytes = sizeof(T) * valuesPerRecord;
+  size_t recordsPerBlock = std::max(static_cast<size_t>(1), k_BlockBytes / recordBytes);
+  std::vector<T> block(std::min(recordsPerBlock, numRecords) * valuesPerRecord);
+  bool swap = NeedsSwap(order);
+
+  for(size_t start = 0; start < numRecords; start += recordsPerBlock)
+  {
+    size_t count = std::min(recordsPerBlock, numRecords - start);
+    FillRecordsImpl<T, FillFunctor> impl(fill, block.data(), start, valuesPerRecord, swap);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(count >= k_ParallelRecords)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, count), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.compute(0, count);
+    }
+    if(fwrite(block.data(), recordBytes, count, f) != count)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief WriteArray Writes a contiguous array in the requested byte order. Arrays that need no swap go straight to fwrite.
+ * @return true when every value was written
+ */
+template <typename T> bool WriteArray(FILE* f, const T* values, size_t count, ByteOrder order)
+{
+  if(!NeedsSwap(order) || sizeof(T) == 1)
+  {
+    return fwrite(values, sizeof(T), count, f) == count;
+  }
+  return WriteRecords<T>(f, count, 1, order, [values](size_t r, T* out) { *out = values[r]; });
+}
+
+/**
+ * @brief The TextBlockWriter class collects formatted ASCII output in a large buffer and hands it to fwrite in
+ * chunks. Everything is flushed when the object goes out of scope, so it can be scoped around one section of a
+ * file that is otherwise written with fprintf.
+ */
+class TextBlockWriter
+{
+public:
+  TextBlockWriter(FILE* f)
+  : m_File(f)
+  {
+    m_Buffer.reserve(k_BlockBytes + 1024);
+  }
+  virtual ~TextBlockWriter()
+  {
+    flush();
+  }
+
+  /**
+   * @brief printf Appends printf style formatted text to the buffer
+   */
+  void printf(const char* format, ...)
+  {
+    size_t used = m_Buffer.size();
+    m_Buffer.resize(used + 256);
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(m_Buffer.data() + used, 256, format, args);
+    va_end(args);
+    if(n < 0)
+    {
+      m_Buffer.resize(used);
+      return;
+    }
+    if(n >= 256)
+    {
+      m_Buffer.resize(used + n + 1);
+      va_start(args, format);
+      vsnprintf(m_Buffer.data() + used, n + 1, format, args);
+      va_end(args);
+    }
+    m_Buffer.resize(used + n);
+    if(m_Buffer.size() >= k_BlockBytes)
+    {
+      flush();
+    }
+  }
+
+  /**
+   * @brief flush Writes out everything collected so far
+   * @return true when all bytes were written
+   */
+  bool flush()
+  {
+    bool ok = m_Buffer.empty() || fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File) == m_Buffer.size();
+    m_Buffer.clear();
+    return ok;
+  }
+
+private:
+  FILE* m_File;
+  std::vector<char> m_Buffer;
+
+  TextBlockWriter(const TextBlockWriter&); // Copy Constructor Not Implemented
+  void operator=(const TextBlockWriter&);  // Move assignment Not Implemented
+};
+} // namespace BinaryBlockWriter
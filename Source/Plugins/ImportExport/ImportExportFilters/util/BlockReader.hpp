@@ -0,0 +1,529 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <locale.h>
+#include <type_traits>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include <QtCore/QIODevice>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "ImportExport/ImportExportFilters/util/BinaryBlockWriter.hpp"
+
+/**
+ * @brief The BlockReader namespace is the reading counterpart of BinaryBlockWriter. Data sections are pulled from
+ * the file in large blocks; ASCII blocks are cut at whitespace or line ends into chunks that are parsed in parallel,
+ * and binary sections are read straight into the destination array and byte swapped in place. The functions work on
+ * a FILE*, a std::istream or a QIODevice that is positioned at the start of the values, and leave it positioned
+ * right after the last value that was consumed so that the caller can keep reading the rest of the file.
+ */
+namespace BlockReader
+{
+using ByteOrder = BinaryBlockWriter::ByteOrder;
+
+static const size_t k_BlockBytes = 16 * 1024 * 1024;
+static const size_t k_ChunkBytes = 256 * 1024;
+static const size_t k_ParallelValues = 65536;
+
+inline size_t ReadBytes(FILE* f, char* buffer, size_t numBytes)
+{
+  return fread(buffer, 1, numBytes, f);
+}
+
+inline size_t ReadBytes(std::istream& in, char* buffer, size_t numBytes)
+{
+  in.read(buffer, static_cast<std::streamsize>(numBytes));
+  return static_cast<size_t>(in.gcount());
+}
+
+inline size_t ReadBytes(QIODevice& device, char* buffer, size_t numBytes)
+{
+  qint64 numRead = device.read(buffer, static_cast<qint64>(numBytes));
+  return numRead < 0 ? 0 : static_cast<size_t>(numRead);
+}
+
+/**
+ * @brief Unread Moves the read position back by the given number of bytes, which never exceeds one block
+ */
+inline bool Unread(FILE* f, size_t numBytes)
+{
+  return numBytes == 0 || fseek(f, -static_cast<long>(numBytes), SEEK_CUR) == 0;
+}
+
+inline bool Unread(std::istream& in, size_t numBytes)
+{
+  in.clear();
+  in.seekg(-static_cast<std::streamoff>(numBytes), std::ios_base::cur);
+  return !in.fail();
+}
+
+inline bool Unread(QIODevice& device, size_t numBytes)
+{
+  return device.seek(device.pos() - static_cast<qint64>(numBytes));
+}
+
+inline bool IsSpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief The SpaceDelimiter struct splits a block into whitespace separated values
+ */
+struct SpaceDelimiter
+{
+  static bool IsDelimiter(char c)
+  {
+    return IsSpace(c);
+  }
+};
+
+/**
+ * @brief The LineDelimiter struct splits a block into lines. A line handed out may still end in '\r'.
+ */
+struct LineDelimiter
+{
+  static bool IsDelimiter(char c)
+  {
+    return c == '\n';
+  }
+};
+
+/**
+ * @brief SkipToken Returns the position of the first delimiter at or after p
+ */
+template <typename Delimiter> const char* SkipToken(const char* p, const char* end)
+{
+  while(p < end && !Delimiter::IsDelimiter(*p))
+  {
+    p++;
+  }
+  return p;
+}
+
+template <typename Delimiter> const char* SkipDelimiters(const char* p, const char* end)
+{
+  while(p < end && Delimiter::IsDelimiter(*p))
+  {
+    p++;
+  }
+  return p;
+}
+
+/**
+ * @brief StringToDouble Works like strtod but always in the "C" locale, so a comma decimal locale set by the
+ * application (de_DE, fr_FR, ...) does not change how the '.' of the values in a file is read
+ */
+#ifdef _MSC_VER
+inline double StringToDouble(const char* str, char** stop)
+{
+  static _locale_t cLocale = _create_locale(LC_NUMERIC, "C");
+  return _strtod_l(str, stop, cLocale);
+}
+#else
+inline double StringToDouble(const char* str, char** stop)
+{
+  static locale_t cLocale = newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+  return strtod_l(str, stop, cLocale);
+}
+#endif
+
+/**
+ * @brief ParseToken Converts the whitespace delimited token [begin, end) to a value. Integers are parsed by hand;
+ * floating point values go through StringToDouble, which stops at the whitespace that ends every token in a chunk.
+ * @return true when the whole token was a number
+ */
+template <typename T> bool ParseToken(const char* begin, const char* end, T& value, std::true_type /* isIntegral */)
+{
+  const char* p = begin;
+  bool negative = false;
+  if(p < end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    p++;
+  }
+  if(p == end)
+  {
+    return false;
+  }
+  uint64_t v = 0;
+  for(; p < end; p++)
+  {
+    uint32_t digit = static_cast<uint32_t>(*p - '0');
+    if(digit > 9)
+    {
+      return false;
+    }
+    v = v * 10 + digit;
+  }
+  value = negative ? static_cast<T>(0 - v) : static_cast<T>(v);
+  return true;
+}
+
+template <typename T> bool ParseToken(const char* begin, const char* end, T& value, std::false_type /* isIntegral */)
+{
+  char* stop = nullptr;
+  double v = StringToDouble(begin, &stop);
+  if(stop != end)
+  {
+    return false;
+  }
+  value = static_cast<T>(v);
+  return true;
+}
+
+template <typename T> bool ParseToken(const char* begin, const char* end, T& value)
+{
+  return ParseToken<T>(begin, end, value, typename std::is_integral<T>::type());
+}
+
+/**
+ * @brief The ScanChunksImpl class works on a block that has been cut into delimiter aligned chunks. Without a
+ * token functor it counts the tokens of each chunk. With one it hands the tokens of each chunk, up to the number
+ * still wanted, to handle(tokenIndex, begin, end) and stops a chunk early when the functor returns false.
+ */
+template <typename Delimiter, typename TokenFunctor> class ScanChunksImpl
+{
+public:
+  ScanChunksImpl(const char* buffer, const size_t* chunkBounds, const size_t* chunkOffsets, size_t* chunkCounts, const TokenFunctor* handle, size_t firstToken, size_t limit)
+  : m_Buffer(buffer)
+  , m_ChunkBounds(chunkBounds)
+  , m_ChunkOffsets(chunkOffsets)
+  , m_ChunkCounts(chunkCounts)
+  , m_Handle(handle)
+  , m_FirstToken(firstToken)
+  , m_Limit(limit)
+  {
+  }
+  virtual ~ScanChunksImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      const char* p = m_Buffer + m_ChunkBounds[c];
+      const char* chunkEnd = m_Buffer + m_ChunkBounds[c + 1];
+      size_t count = 0;
+      if(nullptr == m_Handle)
+      {
+        for(p = SkipDelimiters<Delimiter>(p, chunkEnd); p < chunkEnd; p = SkipDelimiters<Delimiter>(p, chunkEnd))
+        {
+          p = SkipToken<Delimiter>(p, chunkEnd);
+          count++;
+        }
+      }
+      else if(m_ChunkOffsets[c] < m_Limit)
+      {
+        // On a malformed token the count stops short, which the caller reports as the tokens handled so far
+        size_t wanted = std::min(m_ChunkCounts[c], m_Limit - m_ChunkOffsets[c]);
+        for(p = SkipDelimiters<Delimiter>(p, chunkEnd); count < wanted; p = SkipDelimiters<Delimiter>(p, chunkEnd))
+        {
+          const char* tokenEnd = SkipToken<Delimiter>(p, chunkEnd);
+          if(!(*m_Handle)(m_FirstToken + m_ChunkOffsets[c] + count, p, tokenEnd))
+          {
+            break;
+          }
+          count++;
+          p = tokenEnd;
+        }
+      }
+      m_ChunkCounts[c] = count;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Buffer;
+  const size_t* m_ChunkBounds;
+  const size_t* m_ChunkOffsets;
+  size_t* m_ChunkCounts;
+  const TokenFunctor* m_Handle;
+  size_t m_FirstToken;
+  size_t m_Limit;
+};
+
+template <typename Delimiter, typename TokenFunctor> void ScanChunks(const ScanChunksImpl<Delimiter, TokenFunctor>& impl, size_t numChunks)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(numChunks > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.compute(0, numChunks);
+  }
+}
+
+/**
+ * @brief ScanTokens Reads up to count delimited tokens. Each block is scanned twice: a parallel pass counts the
+ * tokens of every chunk, so each chunk knows the index of its first token, and a second parallel pass hands them
+ * to the token functor. A null functor only counts, which skips the tokens. Runs of delimiters never produce empty
+ * tokens. The source is left just after the last token. A token longer than blockBytes ends the scan.
+ * @return Number of tokens consumed, which is less than count on a short file or when the functor rejects a token
+ */
+template <typename Delimiter, typename Source, typename TokenFunctor> size_t ScanTokens(Source& source, size_t count, const TokenFunctor* handle, size_t blockBytes = k_BlockBytes)
+{
+  std::vector<char> buffer(blockBytes + 1);
+  std::vector<size_t> chunkBounds;
+  std::vector<size_t> chunkOffsets;
+  std::vector<size_t> chunkCounts;
+  size_t carry = 0;
+  size_t done = 0;
+
+  while(done < count)
+  {
+    size_t numRead = ReadBytes(source, buffer.data() + carry, blockBytes - carry);
+    bool atEnd = (carry + numRead < blockBytes);
+    size_t length = carry + numRead;
+    if(length == 0)
+    {
+      break;
+    }
+
+    // Only whole tokens are scanned; a token cut by the end of the block is carried over to the next one
+    size_t cut = length;
+    if(!atEnd)
+    {
+      while(cut > 0 && !Delimiter::IsDelimiter(buffer[cut - 1]))
+      {
+        cut--;
+      }
+      if(cut == 0)
+      {
+        break;
+      }
+    }
+    char saved = buffer[cut];
+    buffer[cut] = '\0';
+
+    chunkBounds.assign(1, 0);
+    while(chunkBounds.back() < cut)
+    {
+      size_t next = std::min(chunkBounds.back() + k_ChunkBytes, cut);
+      next = SkipToken<Delimiter>(buffer.data() + next, buffer.data() + cut) - buffer.data();
+      chunkBounds.push_back(next);
+    }
+    size_t numChunks = chunkBounds.size() - 1;
+
+    chunkCounts.assign(numChunks, 0);
+    chunkOffsets.assign(numChunks + 1, 0);
+    ScanChunks(ScanChunksImpl<Delimiter, TokenFunctor>(buffer.data(), chunkBounds.data(), chunkOffsets.data(), chunkCounts.data(), nullptr, done, 0), numChunks);
+    for(size_t c = 0; c < numChunks; c++)
+    {
+      chunkOffsets[c + 1] = chunkOffsets[c] + chunkCounts[c];
+    }
+    size_t limit = count - done;
+    size_t numTokens = std::min(chunkOffsets[numChunks], limit);
+
+    if(nullptr != handle)
+    {
+      std::vector<size_t> expected(chunkCounts);
+      ScanChunks(ScanChunksImpl<Delimiter, TokenFunctor>(buffer.data(), chunkBounds.data(), chunkOffsets.data(), chunkCounts.data(), handle, done, limit), numChunks);
+      for(size_t c = 0; c < numChunks && chunkOffsets[c] < limit; c++)
+      {
+        if(chunkCounts[c] < std::min(expected[c], limit - chunkOffsets[c]))
+        {
+          return done + chunkOffsets[c] + chunkCounts[c];
+        }
+      }
+    }
+
+    if(chunkOffsets[numChunks] >= limit)
+    {
+      // Find the end of the last wanted token and hand everything after it back to the source
+      size_t c = std::upper_bound(chunkOffsets.begin(), chunkOffsets.end(), limit - 1) - chunkOffsets.begin() - 1;
+      const char* p = buffer.data() + chunkBounds[c];
+      const char* chunkEnd = buffer.data() + chunkBounds[c + 1];
+      for(size_t i = chunkOffsets[c]; i < limit; i++)
+      {
+        p = SkipToken<Delimiter>(SkipDelimiters<Delimiter>(p, chunkEnd), chunkEnd);
+      }
+      buffer[cut] = saved;
+      Unread(source, length - static_cast<size_t>(p - buffer.data()));
+      return done + numTokens;
+    }
+
+    done += numTokens;
+    buffer[cut] = saved;
+    carry = length - cut;
+    std::copy(buffer.begin() + cut, buffer.begin() + length, buffer.begin());
+    if(atEnd)
+    {
+      break;
+    }
+  }
+  return done;
+}
+
+/**
+ * @brief ReadAsciiValues Parses count values and passes each one to store(valueIndex, value); the functor may be
+ * called from several threads at once. This is the entry point for files that do not store values in array order.
+ * @return Number of values read
+ */
+template <typename T, typename Source, typename StoreFunctor> size_t ReadAsciiValues(Source& source, size_t count, const StoreFunctor& store, size_t blockBytes = k_BlockBytes)
+{
+  auto handle = [&store](size_t i, const char* begin, const char* end) {
+    T value = static_cast<T>(0);
+    if(!ParseToken<T>(begin, end, value))
+    {
+      return false;
+    }
+    store(i, value);
+    return true;
+  };
+  return ScanTokens<SpaceDelimiter>(source, count, &handle, blockBytes);
+}
+
+/**
+ * @brief ReadAsciiValues Parses count values straight into the destination array
+ * @return Number of values read
+ */
+template <typename T, typename Source> size_t ReadAsciiValues(Source& source, size_t count, T* values, size_t blockBytes = k_BlockBytes)
+{
+  return ReadAsciiValues<T>(source, count, [values](size_t i, T value) { values[i] = value; }, blockBytes);
+}
+
+/**
+ * @brief SkipAsciiValues Moves past count values without converting them
+ * @return Number of values skipped
+ */
+template <typename Source> size_t SkipAsciiValues(Source& source, size_t count, size_t blockBytes = k_BlockBytes)
+{
+  typedef bool (*NoHandler)(size_t, const char*, const char*);
+  return ScanTokens<SpaceDelimiter, Source, NoHandler>(source, count, nullptr, blockBytes);
+}
+
+/**
+ * @brief ReadAsciiLines Hands count non empty lines to parseLine(lineIndex, begin, end), which returns false to
+ * reject a line. The functor may be called from several threads at once, so each line must be self contained.
+ * @return Number of lines read
+ */
+template <typename Source, typename LineFunctor> size_t ReadAsciiLines(Source& source, size_t count, const LineFunctor& parseLine, size_t blockBytes = k_BlockBytes)
+{
+  return ScanTokens<LineDelimiter>(source, count, &parseLine, blockBytes);
+}
+
+/**
+ * @brief The SwapValuesImpl class byte swaps a range of a contiguous array
+ */
+template <typename T> class SwapValuesImpl
+{
+public:
+  SwapValuesImpl(T* values)
+  : m_Values(values)
+  {
+  }
+  virtual ~SwapValuesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    BinaryBlockWriter::SwapBlock(m_Values + start, end - start);
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  T* m_Values;
+};
+
+/**
+ * @brief ReadBinaryValues Reads count values stored in the given byte order directly into the destination array
+ * and converts them to system byte order
+ * @return true when every value was read
+ */
+template <typename T, typename Source> bool ReadBinaryValues(Source& source, T* values, size_t count, ByteOrder order)
+{
+  char* ptr = reinterpret_cast<char*>(values);
+  size_t remaining = count * sizeof(T);
+  while(remaining > 0)
+  {
+    size_t numBytes = std::min(remaining, 4 * k_BlockBytes);
+    if(ReadBytes(source, ptr, numBytes) != numBytes)
+    {
+      return false;
+    }
+    ptr += numBytes;
+    remaining -= numBytes;
+  }
+
+  if(sizeof(T) > 1 && BinaryBlockWriter::NeedsSwap(order))
+  {
+    SwapValuesImpl<T> impl(values);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(count >= k_ParallelValues)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, count, k_ParallelValues), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.compute(0, count);
+    }
+  }
+  return true;
+}
+} // namespace BlockReader
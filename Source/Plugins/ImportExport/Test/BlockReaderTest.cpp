@@ -0,0 +1,308 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <clocale>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/util/BlockReader.hpp"
+
+#include "ImportExportTestFileLocations.h"
+
+class BlockReaderTest
+{
+public:
+  BlockReaderTest() = default;
+  virtual ~BlockReaderTest() = default;
+
+  SIMPL_TYPE_MACRO(BlockReaderTest)
+
+  // Small enough that a few hundred values cross dozens of block boundaries, and cut tokens and lines in the middle
+  static const size_t k_SmallBlock = 61;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::BlockReaderTest::TestFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  static QByteArray ReadRest(FILE* f)
+  {
+    QByteArray rest;
+    char buffer[256];
+    size_t numRead = 0;
+    while((numRead = fread(buffer, 1, sizeof(buffer), f)) > 0)
+    {
+      rest.append(buffer, static_cast<int>(numRead));
+    }
+    return rest;
+  }
+
+  static QByteArray ReadRest(std::istream& in)
+  {
+    std::string rest((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return QByteArray(rest.data(), static_cast<int>(rest.size()));
+  }
+
+  static QByteArray ReadRest(QIODevice& device)
+  {
+    return device.readAll();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void writeTestFile(const QByteArray& contents)
+  {
+    QFile file(UnitTest::BlockReaderTest::TestFile);
+    DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::WriteOnly), true)
+    DREAM3D_REQUIRE_EQUAL(file.write(contents), contents.size())
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  // Reads the values and then checks that the source was left right after the last value, so that everything
+  // after it (the trailer) is still there to be read
+  // -----------------------------------------------------------------------------
+  template <typename T, typename Source> void checkValues(Source& source, const std::vector<T>& expected, const QByteArray& trailer, size_t blockBytes)
+  {
+    std::vector<T> values(expected.size(), static_cast<T>(0));
+    size_t numRead = BlockReader::ReadAsciiValues<T>(source, expected.size(), values.data(), blockBytes);
+    DREAM3D_REQUIRE_EQUAL(numRead, expected.size())
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(values[i], expected[i])
+    }
+    QByteArray rest = ReadRest(source);
+    DREAM3D_REQUIRE(rest == trailer)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs checkValues on a FILE*, a std::istream and a QIODevice opened on the same file
+  // -----------------------------------------------------------------------------
+  template <typename T> void checkAllSources(const QByteArray& contents, const std::vector<T>& expected, const QByteArray& trailer, size_t blockBytes)
+  {
+    writeTestFile(contents);
+    std::string fileName = UnitTest::BlockReaderTest::TestFile.toStdString();
+
+    FILE* f = fopen(fileName.c_str(), "rb");
+    DREAM3D_REQUIRE(nullptr != f)
+    checkValues<T>(f, expected, trailer, blockBytes);
+    fclose(f);
+
+    std::ifstream in(fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+    DREAM3D_REQUIRE(in.is_open())
+    checkValues<T>(in, expected, trailer, blockBytes);
+    in.close();
+
+    QFile file(UnitTest::BlockReaderTest::TestFile);
+    DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::ReadOnly), true)
+    checkValues<T>(file, expected, trailer, blockBytes);
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestIntegersAcrossBlocks()
+  {
+    QByteArray contents;
+    std::vector<int32_t> expected;
+    const char* separators[3] = {" ", "\n", " \t "};
+    for(int32_t i = 0; i < 500; i++)
+    {
+      int32_t value = (i * 7919) % 200003 - 100000;
+      expected.push_back(value);
+      contents.append(QByteArray::number(value));
+      contents.append(separators[i % 3]);
+    }
+    contents.chop(static_cast<int>(strlen(separators[499 % 3])));
+    QByteArray trailer("\nLOOKUP_TABLE default\n1 2 3\n");
+    contents.append(trailer);
+
+    checkAllSources<int32_t>(contents, expected, trailer, k_SmallBlock);
+    checkAllSources<int32_t>(contents, expected, trailer, BlockReader::k_BlockBytes);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFloatsInCommaLocale()
+  {
+    // The values are multiples of 1/8, so the text and the float compare exactly. The text is built before the
+    // locale is changed so it always uses '.'.
+    QByteArray contents;
+    std::vector<float> expected;
+    for(int32_t i = 0; i < 400; i++)
+    {
+      float value = static_cast<float>(i - 200) * 0.125f;
+      expected.push_back(value);
+      char token[32];
+      snprintf(token, sizeof(token), (i % 5 == 0) ? "%.6e " : "%.3f ", static_cast<double>(value));
+      contents.append(token);
+    }
+    contents.chop(1);
+    QByteArray trailer(" END\n");
+    contents.append(trailer);
+
+    // Use a comma decimal locale when one is installed; the values must not depend on it
+    std::string previous = setlocale(LC_NUMERIC, nullptr);
+    const char* commaLocales[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German", "French"};
+    for(const char* name : commaLocales)
+    {
+      if(nullptr != setlocale(LC_NUMERIC, name))
+      {
+        break;
+      }
+    }
+
+    checkAllSources<float>(contents, expected, trailer, k_SmallBlock);
+    checkAllSources<float>(contents, expected, trailer, BlockReader::k_BlockBytes);
+
+    setlocale(LC_NUMERIC, previous.c_str());
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSkipAndLinesAcrossBlocks()
+  {
+    QByteArray contents;
+    for(int32_t i = 0; i < 300; i++)
+    {
+      contents.append(QByteArray::number(i)).append((i < 299) ? ' ' : '\n');
+    }
+    std::vector<QByteArray> expectedLines;
+    for(int32_t i = 0; i < 100; i++)
+    {
+      QByteArray line = QByteArray::number(i) + " " + QByteArray::number(i * i) + " site";
+      expectedLines.push_back(line);
+      contents.append(line).append((i % 2 == 0) ? "\n" : "\r\n");
+    }
+    QByteArray trailer("ITEM: TIMESTEP\n");
+    contents.append(trailer);
+
+    std::istringstream in(std::string(contents.data(), static_cast<size_t>(contents.size())));
+    size_t numSkipped = BlockReader::SkipAsciiValues(in, 300, k_SmallBlock);
+    DREAM3D_REQUIRE_EQUAL(numSkipped, 300)
+
+    std::vector<QByteArray> lines(expectedLines.size());
+    auto parseLine = [&lines](size_t i, const char* begin, const char* end) {
+      lines[i] = QByteArray(begin, static_cast<int>(end - begin));
+      if(lines[i].endsWith('\r'))
+      {
+        lines[i].chop(1);
+      }
+      return true;
+    };
+    size_t numLines = BlockReader::ReadAsciiLines(in, expectedLines.size(), parseLine, k_SmallBlock);
+    DREAM3D_REQUIRE_EQUAL(numLines, expectedLines.size())
+    for(size_t i = 0; i < expectedLines.size(); i++)
+    {
+      DREAM3D_REQUIRE(lines[i] == expectedLines[i])
+    }
+    QByteArray rest = ReadRest(in);
+    DREAM3D_REQUIRE(rest == QByteArray("\n") + trailer)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDefaultBlockSize()
+  {
+    // Slightly more than one default block, so the carry and the Unread of the real block size are exercised
+    size_t numValues = BlockReader::k_BlockBytes / 8 + 100000;
+    std::string contents;
+    contents.reserve(numValues * 8 + 16);
+    std::vector<int32_t> expected(numValues);
+    char token[16];
+    for(size_t i = 0; i < numValues; i++)
+    {
+      expected[i] = static_cast<int32_t>((i * 2654435761u) % 10000000);
+      snprintf(token, sizeof(token), "%d ", expected[i]);
+      contents.append(token);
+    }
+    contents.append("END\n");
+
+    std::istringstream in(contents);
+    std::string().swap(contents);
+    checkValues<int32_t>(in, expected, QByteArray(" END\n"), BlockReader::k_BlockBytes);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestIntegersAcrossBlocks())
+    DREAM3D_REGISTER_TEST(TestFloatsInCommaLocale())
+    DREAM3D_REGISTER_TEST(TestSkipAndLinesAcrossBlocks())
+    DREAM3D_REGISTER_TEST(TestDefaultBlockSize())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  BlockReaderTest(const BlockReaderTest&) = delete;            // Copy Constructor Not Implemented
+  BlockReaderTest(BlockReaderTest&&) = delete;                 // Move Constructor Not Implemented
+  BlockReaderTest& operator=(const BlockReaderTest&) = delete; // Copy Assignment Not Implemented
+  BlockReaderTest& operator=(BlockReaderTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,329 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ImportExportTestFileLocations.h"
+
+class ReadStlFileTest
+{
+public:
+  ReadStlFileTest() = default;
+  virtual ~ReadStlFileTest() = default;
+
+  SIMPL_TYPE_MACRO(ReadStlFileTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::ReadStlFileTest::BinaryFile);
+    QFile::remove(UnitTest::ReadStlFileTest::AsciiFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the ReadStlFile Filter from the FilterManager
+    QString filtName = "ReadStlFile";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The ImportExportTest Requires the use of the " << filtName.toStdString() << " filter which is found in the ImportExport Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Eight separate triangles, 9 coordinates each, with the weld test pairs at the first vertex of two triangles:
+  //  - B and B' of triangles 0 and 1 are 0.004 apart
+  //  - C is shared exactly by triangles 0 and 1
+  //  - E and F of triangles 2 and 3 are 2e-6 apart on both sides of the x = 0.5 border of the 0.01 weld cells
+  //  - K and K' of triangles 4 and 5 are 0.02 apart
+  //  - L and L' of triangles 6 and 7 fall into the same 0.01 weld cell but are 0.017 apart
+  // -----------------------------------------------------------------------------
+  std::vector<float> createTriangles()
+  {
+    return {
+        0.0f,      0.0f,    0.0f,    1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, // A B C
+        1.004f,    0.0f,    0.0f,    0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, // B' C D
+        0.499999f, 2.0f,    0.0f,    0.0f, 3.0f, 0.0f, 0.0f, 2.0f, 0.0f, // E
+        0.500001f, 2.0f,    0.0f,    1.0f, 3.0f, 0.0f, 1.0f, 2.0f, 0.0f, // F
+        2.0f,      0.0f,    0.0f,    2.0f, 1.0f, 0.0f, 3.0f, 0.0f, 0.0f, // K
+        2.02f,     0.0f,    0.0f,    2.02f, 1.0f, 0.0f, 3.02f, 0.0f, 0.0f, // K'
+        3.1001f,   3.1001f, 3.1001f, 4.0f, 4.0f, 4.0f, 4.0f, 5.0f, 4.0f, // L
+        3.1099f,   3.1099f, 3.1099f, 5.0f, 4.0f, 4.0f, 5.0f, 5.0f, 4.0f  // L'
+    };
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  float normalComponent(size_t t, size_t c)
+  {
+    // Any value will do as the reader does not recompute the normals
+    return 0.125f * static_cast<float>(t) - 0.25f * static_cast<float>(c);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void writeBinaryFile(const std::vector<float>& vertices)
+  {
+    QByteArray contents(80, '\0');
+    contents.replace(0, 22, "ReadStlFileTest binary");
+    int32_t triCount = static_cast<int32_t>(vertices.size() / 9);
+    contents.append(reinterpret_cast<const char*>(&triCount), sizeof(triCount));
+    for(int32_t t = 0; t < triCount; t++)
+    {
+      float values[12];
+      for(size_t c = 0; c < 3; c++)
+      {
+        values[c] = normalComponent(t, c);
+      }
+      ::memcpy(values + 3, vertices.data() + 9 * t, 9 * sizeof(float));
+      uint16_t attr = 0;
+      contents.append(reinterpret_cast<const char*>(values), sizeof(values));
+      contents.append(reinterpret_cast<const char*>(&attr), sizeof(attr));
+    }
+    writeFile(UnitTest::ReadStlFileTest::BinaryFile, contents);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void writeAsciiFile(const std::vector<float>& vertices)
+  {
+    // 9 significant digits write every float so that it reads back to the same value
+    QByteArray contents("solid ReadStlFileTest\n");
+    size_t triCount = vertices.size() / 9;
+    for(size_t t = 0; t < triCount; t++)
+    {
+      contents.append("  facet normal");
+      for(size_t c = 0; c < 3; c++)
+      {
+        contents.append(" ").append(QByteArray::number(normalComponent(t, c), 'g', 9));
+      }
+      contents.append("\n    outer loop\n");
+      for(size_t n = 0; n < 3; n++)
+      {
+        contents.append("      vertex");
+        for(size_t c = 0; c < 3; c++)
+        {
+          contents.append(" ").append(QByteArray::number(vertices[9 * t + 3 * n + c], 'g', 9));
+        }
+        contents.append("\n");
+      }
+      contents.append("    endloop\n  endfacet\n");
+    }
+    contents.append("endsolid ReadStlFileTest\n");
+    writeFile(UnitTest::ReadStlFileTest::AsciiFile, contents);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void writeFile(const QString& fileName, const QByteArray& contents)
+  {
+    QFile file(fileName);
+    DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::WriteOnly), true);
+    DREAM3D_REQUIRE_EQUAL(file.write(contents), contents.size());
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainer::Pointer readFile(const QString& fileName, float weldTolerance)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("ReadStlFile");
+    DREAM3D_REQUIRE(nullptr != filterFactory.get());
+    AbstractFilter::Pointer reader = filterFactory->create();
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    bool propWasSet = reader->setProperty("StlFilePath", fileName);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    propWasSet = reader->setProperty("WeldTolerance", weldTolerance);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    reader->setDataContainerArray(dca);
+    reader->execute();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), 0);
+
+    DataContainer::Pointer sm = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    DREAM3D_REQUIRED_PTR(sm.get(), !=, nullptr);
+    return sm;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DoubleArrayType::Pointer faceNormals(const DataContainer::Pointer& sm)
+  {
+    DoubleArrayType::Pointer normals = sm->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals);
+    DREAM3D_REQUIRED_PTR(normals.get(), !=, nullptr);
+    return normals;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAsciiMatchesBinary()
+  {
+    std::vector<float> vertices = createTriangles();
+    writeBinaryFile(vertices);
+    writeAsciiFile(vertices);
+
+    for(float weldTolerance : {0.0f, 0.01f})
+    {
+      TriangleGeom::Pointer binaryGeom = readFile(UnitTest::ReadStlFileTest::BinaryFile, weldTolerance)->getGeometryAs<TriangleGeom>();
+      DataContainer::Pointer ascii = readFile(UnitTest::ReadStlFileTest::AsciiFile, weldTolerance);
+      TriangleGeom::Pointer asciiGeom = ascii->getGeometryAs<TriangleGeom>();
+
+      size_t numTris = static_cast<size_t>(asciiGeom->getNumberOfTris());
+      DREAM3D_REQUIRE_EQUAL(numTris, vertices.size() / 9);
+      DREAM3D_REQUIRE_EQUAL(asciiGeom->getNumberOfTris(), binaryGeom->getNumberOfTris());
+      DREAM3D_REQUIRE_EQUAL(asciiGeom->getNumberOfVertices(), binaryGeom->getNumberOfVertices());
+      for(size_t i = 0; i < numTris * 3; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(asciiGeom->getTriPointer(0)[i], binaryGeom->getTriPointer(0)[i]);
+      }
+      for(size_t i = 0; i < static_cast<size_t>(asciiGeom->getNumberOfVertices()) * 3; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(asciiGeom->getVertexPointer(0)[i], binaryGeom->getVertexPointer(0)[i]);
+      }
+
+      DoubleArrayType::Pointer normals = faceNormals(ascii);
+      DREAM3D_REQUIRE_EQUAL(normals->getNumberOfTuples(), numTris);
+      for(size_t t = 0; t < numTris; t++)
+      {
+        for(size_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(normals->getComponent(t, c), static_cast<double>(normalComponent(t, c)));
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestWeldTolerance()
+  {
+    std::vector<float> vertices = createTriangles();
+    writeBinaryFile(vertices);
+
+    // Exact welding only joins the copies of C
+    TriangleGeom::Pointer geom = readFile(UnitTest::ReadStlFileTest::BinaryFile, 0.0f)->getGeometryAs<TriangleGeom>();
+    int64_t* tris = geom->getTriPointer(0);
+    DREAM3D_REQUIRE_EQUAL(geom->getNumberOfVertices(), 23);
+    DREAM3D_REQUIRE_EQUAL(tris[2], tris[4]);
+    DREAM3D_REQUIRE(tris[1] != tris[3]);
+    DREAM3D_REQUIRE(tris[6] != tris[9]);
+
+    // Welding within 0.01 also joins B and B', and E and F across the cell border
+    geom = readFile(UnitTest::ReadStlFileTest::BinaryFile, 0.01f)->getGeometryAs<TriangleGeom>();
+    tris = geom->getTriPointer(0);
+    float* verts = geom->getVertexPointer(0);
+    DREAM3D_REQUIRE_EQUAL(geom->getNumberOfVertices(), 21);
+    DREAM3D_REQUIRE_EQUAL(tris[2], tris[4]);
+    DREAM3D_REQUIRE_EQUAL(tris[1], tris[3]);
+    DREAM3D_REQUIRE_EQUAL(tris[6], tris[9]);
+    // K and K' are farther apart than the tolerance, and so are L and L' although they share a cell
+    DREAM3D_REQUIRE(tris[12] != tris[15]);
+    DREAM3D_REQUIRE(tris[18] != tris[21]);
+
+    // A welded vertex keeps the coordinates of its first copy in the file
+    DREAM3D_REQUIRE_EQUAL(verts[tris[1] * 3], 1.0f);
+    DREAM3D_REQUIRE_EQUAL(verts[tris[6] * 3], 0.499999f);
+    for(size_t t = 0; t < vertices.size() / 9; t++)
+    {
+      for(size_t n = 0; n < 3; n++)
+      {
+        for(size_t c = 0; c < 3; c++)
+        {
+          float distance = std::fabs(verts[tris[3 * t + n] * 3 + c] - vertices[9 * t + 3 * n + c]);
+          DREAM3D_REQUIRE(distance <= 0.01f);
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestAsciiMatchesBinary());
+    DREAM3D_REGISTER_TEST(TestWeldTolerance());
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles());
+  }
+
+public:
+  ReadStlFileTest(const ReadStlFileTest&) = delete;            // Copy Constructor Not Implemented
+  ReadStlFileTest(ReadStlFileTest&&) = delete;                 // Move Constructor Not Implemented
+  ReadStlFileTest& operator=(const ReadStlFileTest&) = delete; // Copy Assignment Not Implemented
+  ReadStlFileTest& operator=(ReadStlFileTest&&) = delete;      // Move Assignment Not Implemented
+};
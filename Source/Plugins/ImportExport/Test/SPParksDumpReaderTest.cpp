@@ -0,0 +1,282 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <clocale>
+#include <string>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/util/BlockReader.hpp"
+
+#include "ImportExportTestFileLocations.h"
+
+class SPParksDumpReaderTest
+{
+public:
+  SPParksDumpReaderTest() = default;
+  virtual ~SPParksDumpReaderTest() = default;
+
+  SIMPL_TYPE_MACRO(SPParksDumpReaderTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::SPParksDumpReaderTest::TestFile);
+    QFile::remove(UnitTest::SPParksDumpReaderTest::LargeTestFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the SPParksDumpReader Filter from the FilterManager
+    QString filtName = "SPParksDumpReader";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The ImportExportTest Requires the use of the " << filtName.toStdString() << " filter which is found in the ImportExport Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The site of cell i of time step s has the type s * 1000 + i and the energy s + 0.25 * i. The sites are written
+  // in reverse cell order so that every line has to be placed by its x, y and z columns.
+  // -----------------------------------------------------------------------------
+  QByteArray createTimeStep(int32_t step, int32_t nx, int32_t ny, int32_t nz, int32_t lineWidth, int32_t numWideLines)
+  {
+    QByteArray contents;
+    int32_t numSites = nx * ny * nz;
+    contents.append("ITEM: TIMESTEP\n");
+    contents.append(QByteArray::number(step * 10)).append(" ").append(QByteArray::number(step * 10.5, 'f', 1)).append("\n");
+    contents.append("ITEM: NUMBER OF ATOMS\n");
+    contents.append(QByteArray::number(numSites)).append("\n");
+    contents.append("ITEM: BOX BOUNDS\n");
+    contents.append("0 ").append(QByteArray::number(nx)).append("\n");
+    contents.append("0 ").append(QByteArray::number(ny)).append("\n");
+    contents.append("0 ").append(QByteArray::number(nz)).append("\n");
+    contents.append("ITEM: ATOMS id type x y z energy\n");
+    for(int32_t i = numSites - 1; i >= 0; i--)
+    {
+      int32_t x = i % nx;
+      int32_t y = (i / nx) % ny;
+      int32_t z = i / (nx * ny);
+      QByteArray line = QByteArray::number(numSites - i) + " " + QByteArray::number(step * 1000 + i) + " " + QByteArray::number(x) + " " + QByteArray::number(y) + " " + QByteArray::number(z) +
+                        " " + QByteArray::number(step + 0.25 * i, 'f', 2);
+      // Optional padding so a test can place the next time step exactly
+      int32_t width = (numSites - 1 - i < numWideLines) ? lineWidth + 1 : lineWidth;
+      if(line.size() < width - 1)
+      {
+        line.append(QByteArray(width - 1 - line.size(), ' '));
+      }
+      contents.append(line).append("\n");
+    }
+    return contents;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void writeFile(const QString& fileName, const QByteArray& contents)
+  {
+    QFile file(fileName);
+    DREAM3D_REQUIRE_EQUAL(file.open(QIODevice::WriteOnly), true);
+    DREAM3D_REQUIRE_EQUAL(file.write(contents), contents.size());
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createReader(const QString& fileName, int32_t timeStepIndex, const DataContainerArray::Pointer& dca)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("SPParksDumpReader");
+    DREAM3D_REQUIRE(nullptr != filterFactory.get());
+    AbstractFilter::Pointer reader = filterFactory->create();
+
+    bool propWasSet = reader->setProperty("InputFile", fileName);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    propWasSet = reader->setProperty("TimeStepIndex", timeStepIndex);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    reader->setDataContainerArray(dca);
+    return reader;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void checkTimeStep(const QString& fileName, int32_t timeStepIndex, int32_t step, size_t nx, size_t ny, size_t nz)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    AbstractFilter::Pointer reader = createReader(fileName, timeStepIndex, dca);
+    reader->execute();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), 0);
+
+    DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    DREAM3D_REQUIRED_PTR(m.get(), !=, nullptr);
+    size_t dims[3] = {0, 0, 0};
+    std::tie(dims[0], dims[1], dims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], nx);
+    DREAM3D_REQUIRE_EQUAL(dims[1], ny);
+    DREAM3D_REQUIRE_EQUAL(dims[2], nz);
+
+    Int32ArrayType::Pointer featureIds = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    DREAM3D_REQUIRED_PTR(featureIds.get(), !=, nullptr);
+    DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), nx * ny * nz);
+    for(size_t i = 0; i < nx * ny * nz; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), step * 1000 + static_cast<int32_t>(i));
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestTimeSteps()
+  {
+    QByteArray contents = createTimeStep(0, 4, 3, 2, 0, 0);
+    contents.append(createTimeStep(1, 5, 2, 3, 0, 0));
+    contents.append(createTimeStep(2, 3, 3, 3, 0, 0));
+    writeFile(UnitTest::SPParksDumpReaderTest::TestFile, contents);
+
+    // The energy column is a float column, which must not depend on the decimal separator of the locale
+    std::string previous = setlocale(LC_NUMERIC, nullptr);
+    const char* commaLocales[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German", "French"};
+    for(const char* name : commaLocales)
+    {
+      if(nullptr != setlocale(LC_NUMERIC, name))
+      {
+        break;
+      }
+    }
+
+    checkTimeStep(UnitTest::SPParksDumpReaderTest::TestFile, 0, 0, 4, 3, 2);
+    checkTimeStep(UnitTest::SPParksDumpReaderTest::TestFile, 2, 2, 3, 3, 3);
+    checkTimeStep(UnitTest::SPParksDumpReaderTest::TestFile, 1, 1, 5, 2, 3);
+
+    setlocale(LC_NUMERIC, previous.c_str());
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestTimeStepOutOfRange()
+  {
+    QByteArray contents = createTimeStep(0, 4, 3, 2, 0, 0);
+    contents.append(createTimeStep(1, 4, 3, 2, 0, 0));
+    writeFile(UnitTest::SPParksDumpReaderTest::TestFile, contents);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    AbstractFilter::Pointer reader = createReader(UnitTest::SPParksDumpReaderTest::TestFile, 2, dca);
+    reader->preflight();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -108);
+
+    dca = DataContainerArray::New();
+    reader = createReader(UnitTest::SPParksDumpReaderTest::TestFile, -1, dca);
+    reader->execute();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -108);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMarkerAcrossBlocks()
+  {
+    // The first time step is padded so that the "ITEM: TIMESTEP" line of the second one starts 5 bytes before the end
+    // of the first block the time steps are indexed with, so the marker is cut by the block boundary
+    const int32_t n = 64;
+    int32_t numSites = n * n * n;
+    QByteArray header = createTimeStep(0, n, n, n, 0, 0);
+    header.truncate(header.indexOf("ITEM: ATOMS"));
+    header.append("ITEM: ATOMS id type x y z energy\n");
+    int64_t siteBytes = static_cast<int64_t>(BlockReader::k_BlockBytes) - 5 - header.size();
+    int32_t lineWidth = static_cast<int32_t>(siteBytes / numSites);
+    int32_t numWideLines = static_cast<int32_t>(siteBytes % numSites);
+
+    QByteArray contents = createTimeStep(0, n, n, n, lineWidth, numWideLines);
+    DREAM3D_REQUIRE_EQUAL(contents.size(), static_cast<int32_t>(BlockReader::k_BlockBytes) - 5);
+    contents.append(createTimeStep(1, 4, 3, 2, 0, 0));
+    writeFile(UnitTest::SPParksDumpReaderTest::LargeTestFile, contents);
+    QByteArray().swap(contents);
+
+    checkTimeStep(UnitTest::SPParksDumpReaderTest::LargeTestFile, 1, 1, 4, 3, 2);
+    checkTimeStep(UnitTest::SPParksDumpReaderTest::LargeTestFile, 0, 0, n, n, n);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestTimeSteps());
+    DREAM3D_REGISTER_TEST(TestTimeStepOutOfRange());
+    DREAM3D_REGISTER_TEST(TestMarkerAcrossBlocks());
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles());
+  }
+
+public:
+  SPParksDumpReaderTest(const SPParksDumpReaderTest&) = delete;            // Copy Constructor Not Implemented
+  SPParksDumpReaderTest(SPParksDumpReaderTest&&) = delete;                 // Move Constructor Not Implemented
+  SPParksDumpReaderTest& operator=(const SPParksDumpReaderTest&) = delete; // Copy Assignment Not Implemented
+  SPParksDumpReaderTest& operator=(SPParksDumpReaderTest&&) = delete;      // Move Assignment Not Implemented
+};
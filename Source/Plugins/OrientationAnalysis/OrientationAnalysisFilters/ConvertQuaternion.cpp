@@ -17,6 +17,8 @@
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -203,7 +205,7 @@ void ConvertQuaternion::execute()
   size_t totalPoints = m_QuaternionsPtr.lock()->getNumberOfTuples();
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("ConvertQuaternion"));
   bool doParallel = true;
 #endif
 
@@ -30,8 +30,16 @@
 
 #include "EMsoftSO3Sampler.h"
 
+#include <algorithm>
 #include <cmath>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
@@ -44,6 +52,7 @@
 
 #include "OrientationLib/OrientationLibConstants.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -58,6 +67,102 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+/**
+ * @brief The EMsoftSO3SamplerImpl class tests the grid points of a range of x planes of the cubochoric
+ * grid against the Rodrigues fundamental zone. Without an output array it only records how many points of
+ * each plane are inside; with one it writes the Euler angles of those points starting at each plane's offset.
+ */
+class EMsoftSO3SamplerImpl
+{
+public:
+  EMsoftSO3SamplerImpl(EMsoftSO3Sampler* filter, int numsp, double gridShift, int32_t fzType, int32_t fzOrder, size_t* planeCounts, const size_t* planeOffsets, float* eulers)
+  : m_Filter(filter)
+  , m_Numsp(numsp)
+  , m_GridShift(gridShift)
+  , m_FZtype(fzType)
+  , m_FZorder(fzOrder)
+  , m_PlaneCounts(planeCounts)
+  , m_PlaneOffsets(planeOffsets)
+  , m_Eulers(eulers)
+  {
+  }
+  virtual ~EMsoftSO3SamplerImpl() = default;
+
+  void compute(int start, int end) const
+  {
+    typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+
+    // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
+    const double delta = (0.50 * LPs::ap) / static_cast<double>(m_Numsp);
+    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
+    const double edge = 0.5 * LPs::ap;
+
+    // Reuse the same containers for every grid point in this range
+    DOrientArrayType cu(3);
+    DOrientArrayType rod(4);
+    DOrientArrayType eu(3);
+
+    for(int plane = start; plane < end; plane++)
+    {
+      size_t count = 0;
+      cu[0] = (static_cast<double>(plane - m_Numsp + 1) + m_GridShift) * delta;
+      if(fabs(cu[0]) <= edge)
+      {
+        float* out = (nullptr == m_Eulers) ? nullptr : m_Eulers + 3 * m_PlaneOffsets[plane];
+        for(int j = -m_Numsp + 1; j < m_Numsp + 1; j++)
+        {
+          cu[1] = (static_cast<double>(j) + m_GridShift) * delta;
+          if(fabs(cu[1]) > edge)
+          {
+            continue;
+          }
+          for(int k = -m_Numsp + 1; k < m_Numsp + 1; k++)
+          {
+            cu[2] = (static_cast<double>(k) + m_GridShift) * delta;
+            if(fabs(cu[2]) > edge)
+            {
+              continue;
+            }
+            OrientationTransformsType::cu2ro(cu, rod);
+            if(m_Filter->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+            {
+              if(nullptr != out)
+              {
+                OrientationTransformsType::ro2eu(rod, eu);
+                out[count * 3 + 0] = static_cast<float>(eu[0]);
+                out[count * 3 + 1] = static_cast<float>(eu[1]);
+                out[count * 3 + 2] = static_cast<float>(eu[2]);
+              }
+              count++;
+            }
+          }
+        }
+      }
+      if(nullptr == m_Eulers)
+      {
+        m_PlaneCounts[plane] = count;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  EMsoftSO3Sampler* m_Filter;
+  int m_Numsp;
+  double m_GridShift;
+  int32_t m_FZtype;
+  int32_t m_FZorder;
+  size_t* m_PlaneCounts;
+  const size_t* m_PlaneOffsets;
+  float* m_Eulers;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -285,15 +390,13 @@ void EMsoftSO3Sampler::execute()
   OrientationListArrayType FZlist;
   typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
 
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName().getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
+
   if(getsampleModeSelector() == 0)
   {
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
-    double x, y, z, delta;
-    int32_t FZtype, FZorder;
-
-    // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
-    delta = (0.50 * LPs::ap) / static_cast<double>(getNumsp());
+    // here we perform the actual calculation in two passes over the x planes of the
+    // grid: the first counts the points inside the FZ so that the EulerAngles array can
+    // be allocated once, the second writes every plane's points into its own slot.
 
     // do we need to shift this array away from the origin?
     double gridShift = 0.0;
@@ -303,74 +406,71 @@ void EMsoftSO3Sampler::execute()
     }
 
     // determine which function we should call for this point group symmetry
-    FZtype = OrientationAnalysisConstants::FZtarray[getPointGroup() - 1];
-    FZorder = OrientationAnalysisConstants::FZoarray[getPointGroup() - 1];
+    int32_t FZtype = OrientationAnalysisConstants::FZtarray[getPointGroup() - 1];
+    int32_t FZorder = OrientationAnalysisConstants::FZoarray[getPointGroup() - 1];
 
     // loop over the cube of volume pi^2; note that we do not want to include
     // the opposite edges/facets of the cube, to avoid double counting rotations
     // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
     int Np = getNumsp();
-    int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1);
-    int Dn = Totp / 10;
-    int Dc = Dn;
-    int Di = 0;
-    int Dg = 0;
-
-    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
-    double edge = 0.5 * LPs::ap;
-
-    for(int i = -Np + 1; i < Np + 1; i++)
+    int numPlanes = 2 * Np;
+    std::vector<size_t> planeCounts(numPlanes, 0);
+    std::vector<size_t> planeOffsets(numPlanes, 0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("EMsoftSO3Sampler"));
+    bool doParallel = true;
+#endif
+
+    notifyStatusMessage("Euler Angles | Counting grid points inside the RFZ");
+    EMsoftSO3SamplerImpl counter(this, Np, gridShift, FZtype, FZorder, planeCounts.data(), nullptr, nullptr);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      x = (static_cast<double>(i) + gridShift) * delta;
-
-      if(fabs(x) <= edge)
-      {
-
-        for(int j = -Np + 1; j < Np + 1; j++)
-        {
-          y = (static_cast<double>(j) + gridShift) * delta;
+      tbb::parallel_for(tbb::blocked_range<int>(0, numPlanes, 1), counter, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      counter.compute(0, numPlanes);
+    }
 
-          if(fabs(y) <= edge)
-          {
+    if(getCancel())
+    {
+      return;
+    }
 
-            for(int k = -Np + 1; k < Np + 1; k++)
-            {
-              z = (static_cast<double>(k) + gridShift) * delta;
+    size_t Dg = 0;
+    for(int plane = 0; plane < numPlanes; plane++)
+    {
+      planeOffsets[plane] = Dg;
+      Dg += planeCounts[plane];
+    }
 
-              if(fabs(z) <= edge)
-              {
+    // resize the EulerAngles array to the number of points inside the FZ; don't forget to redefine the hard pointer
+    QVector<size_t> tDims(1, Dg);
+    am->resizeAttributeArrays(tDims);
+    m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
 
-                // convert to Rodrigues representation
-                DOrientArrayType cu(x, y, z);
-                DOrientArrayType rod(4);
-                OrientationTransformsType::cu2ro(cu, rod);
-
-                // If insideFZ=true, then add this point to FZlist
-                bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-                if(b)
-                {
-                  FZlist.push_back(rod);
-                  Dg += 1;
-                }
-                Di += 1;
-              }
-            }
-          }
-        }
-      }
+    QString ss = QString("Euler Angles | Inside RFZ: %1 | Generating Euler angles").arg(QString::number(Dg));
+    notifyStatusMessage(ss);
+    if(Dg == 0)
+    {
+      return;
+    }
 
-      // report on status of computation
-      if(Di > Dc)
-      {
-        QString ss = QString("Euler Angles | Tested: %1 of %2 | Inside RFZ: %3 ").arg(QString::number(Di), QString::number(Totp), QString::number(Dg));
-        notifyStatusMessage(ss);
-        Dc += Dn;
-      }
-      if(getCancel())
-      {
-        break;
-      }
+    EMsoftSO3SamplerImpl sampler(this, Np, gridShift, FZtype, FZorder, planeCounts.data(), planeOffsets.data(), m_EulerAngles);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<int>(0, numPlanes, 1), sampler, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      sampler.compute(0, numPlanes);
     }
+    return;
   }
 
   // here are the misorientation sampling cases:
@@ -544,7 +644,6 @@ void EMsoftSO3Sampler::execute()
   }
 
   // resize the EulerAngles array to the number of items in FZlist; don't forget to redefine the hard pointer
-  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName().getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
   QVector<size_t> tDims(1, FZlist.size());
   am->resizeAttributeArrays(tDims);
   m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
@@ -725,19 +824,14 @@ bool EMsoftSO3Sampler::insideDihedralFZ(double* rod, int order)
 bool EMsoftSO3Sampler::insideCubicFZ(double* rod, int ot)
 {
   bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = rod[0] * rod[3];
-  r[1] = rod[1] * rod[3];
-  r[2] = rod[2] * rod[3];
+  // This is called for every grid point during sampling so keep it free of heap allocations
+  const double r[3] = {fabs(rod[0] * rod[3]), fabs(rod[1] * rod[3]), fabs(rod[2] * rod[3])};
   const double r1 = 1.0;
 
   // primary cube planes (only needed for octahedral case)
   if(ot == OrientationAnalysisConstants::OctahedralType)
   {
-
-    typedef OrientationTransforms<std::vector<double>, double> OrientationTransformsType;
-
-    c1 = OrientationTransformsType::OMHelperType::maxval(OrientationTransformsType::OMHelperType::absValue(r)) <= LPs::BP[3];
+    c1 = std::max(r[0], std::max(r[1], r[2])) <= LPs::BP[3];
   }
   else
   {
@@ -745,7 +839,7 @@ bool EMsoftSO3Sampler::insideCubicFZ(double* rod, int ot)
   }
 
   // octahedral truncation planes, both for tetrahedral and octahedral point groups
-  c2 = ((fabs(r[0]) + fabs(r[1]) + fabs(r[2])) <= r1);
+  c2 = ((r[0] + r[1] + r[2]) <= r1);
 
   // if both c1 and c2, then the point is inside
   if(c1 && c2)
@@ -35,15 +35,28 @@
 
 #include "EbsdToH5Ebsd.h"
 
+#include <utility>
+
 #include <QtCore/QDir>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "H5Support/QH5Utilities.h"
 #include "H5Support/H5ScopedSentinel.h"
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "EbsdLib/HKL/H5CtfImporter.h"
 #include "EbsdLib/TSL/H5AngImporter.h"
 
@@ -51,6 +64,55 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The ParseEbsdSlicesImpl class parses a batch of EBSD files into memory, one importer
+ * per file. Nothing is written to the HDF5 file here so the files can be parsed concurrently.
+ */
+class ParseEbsdSlicesImpl
+{
+public:
+  ParseEbsdSlicesImpl(const QVector<QString>& fileList, int32_t fileOffset, std::vector<EbsdImporter::Pointer>& importers, std::vector<int32_t>& errors)
+  : m_FileList(fileList)
+  , m_FileOffset(fileOffset)
+  , m_Importers(importers)
+  , m_Errors(errors)
+  {
+  }
+
+  virtual ~ParseEbsdSlicesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Errors[i] = m_Importers[i]->parseFile(m_FileList[m_FileOffset + static_cast<int32_t>(i)]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const QVector<QString>& m_FileList;
+  int32_t m_FileOffset;
+  std::vector<EbsdImporter::Pointer>& m_Importers;
+  std::vector<int32_t>& m_Errors;
+};
+
+/**
+ * @brief The EbsdSliceBatch struct holds the importers of a batch of consecutive files and their parse errors
+ */
+struct EbsdSliceBatch
+{
+  int32_t start = 0;
+  std::vector<EbsdImporter::Pointer> importers;
+  std::vector<int32_t> parseErrors;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -65,6 +127,7 @@ EbsdToH5Ebsd::EbsdToH5Ebsd()
 , m_FileSuffix("")
 , m_FileExtension("ang")
 , m_PaddingDigits(4)
+, m_CompressionLevel(0)
 {
   m_SampleTransformation.angle = 0.0f;
   m_SampleTransformation.h = 0.0f;
@@ -91,6 +154,7 @@ void EbsdToH5Ebsd::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(EbsdToH5EbsdFilterParameter::New("Import Orientation Data", "OrientationData", getOutputFile(), FilterParameter::Parameter, this));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Compression Level (0-9)", CompressionLevel, FilterParameter::Parameter, EbsdToH5Ebsd));
 
   setFilterParameters(parameters);
 }
@@ -113,6 +177,7 @@ void EbsdToH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader,
   setPaddingDigits(reader->readValue("PaddingDigits", getPaddingDigits()));
   setSampleTransformation(reader->readAxisAngle("SampleTransformation", getSampleTransformation(), -1));
   setEulerTransformation(reader->readAxisAngle("EulerTransformation", getEulerTransformation(), -1));
+  setCompressionLevel(reader->readValue("CompressionLevel", getCompressionLevel()));
   reader->closeFilterGroup();
 }
 
@@ -144,6 +209,12 @@ void EbsdToH5Ebsd::dataCheck()
     setErrorCondition(-13, ss);
   }
 
+  if(m_CompressionLevel < 0 || m_CompressionLevel > 9)
+  {
+    ss = QObject::tr("The compression level must be between 0 (no compression) and 9");
+    setErrorCondition(-14, ss);
+  }
+
   bool hasMissingFiles = false;
   const bool stackLowToHigh = true;
   int increment = 1;
@@ -317,7 +388,7 @@ void EbsdToH5Ebsd::execute()
   QVector<QString> fileList =
       FilePathGenerator::GenerateFileList(m_ZStartIndex, m_ZEndIndex, increment, hasMissingFiles, stackLowToHigh, m_InputPath, m_FilePrefix, m_FileSuffix, m_FileExtension, m_PaddingDigits);
 
-  EbsdImporter::Pointer fileImporter;
+  bool isAngFile = false;
 
   // Write the Manufacturer of the OIM file here
   // This list will grow to be the number of EBSD file formats we support
@@ -332,7 +403,7 @@ void EbsdToH5Ebsd::execute()
       QString ss = QObject::tr("Could not write the Manufacturer Data to the HDF5 File");
       setErrorCondition(-1, ss);
     }
-    fileImporter = H5AngImporter::New();
+    isAngFile = true;
   }
   else if(ext.compare(Ebsd::Ctf::FileExt) == 0)
   {
@@ -343,7 +414,6 @@ void EbsdToH5Ebsd::execute()
       QString ss = QObject::tr("Could not write the Manufacturer Data to the HDF5 File");
       setErrorCondition(-1, ss);
     }
-    fileImporter = H5CtfImporter::New();
     CtfReader ctfReader;
     ctfReader.setFileName(fileList.front());
     err = ctfReader.readHeaderOnly();
@@ -396,45 +466,138 @@ void EbsdToH5Ebsd::execute()
   int64_t biggestxDim = 0;
   int64_t biggestyDim = 0;
   int32_t totalSlicesImported = 0;
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
-  {
-    QString ebsdFName = *filepath;
-    progress = static_cast<int32_t>(z - m_ZStartIndex);
-    progress = (int32_t)(100.0f * (float)(progress) / total);
-    QString msg = "Converting File: " + ebsdFName;
 
-    notifyStatusMessage(msg.toLatin1().data());
-    err = fileImporter->importFile(fileId, z, ebsdFName);
-    if(err < 0)
+  // The files are parsed a batch at a time on the worker threads. HDF5 is not thread safe so the parsed
+  // slices are written from this thread, in slice order, while the next batch is being parsed. Each slice
+  // is released right after being written, so at most two batches are held in memory.
+  int32_t batchSize = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("EbsdToH5Ebsd"));
+  bool doParallel = true;
+  tbb::task_group parseGroup;
+  if(doParallel)
+  {
+    batchSize = 2 * ParallelExecutionContext::Instance()->getThreadCount("EbsdToH5Ebsd");
+  }
+#endif
+
+  auto createBatch = [&](int32_t batchStart, EbsdSliceBatch& batch) {
+    int32_t batchEnd = std::min(batchStart + batchSize, fileList.size());
+    batch.start = batchStart;
+    batch.importers.resize(static_cast<size_t>(batchEnd - batchStart));
+    batch.parseErrors.assign(batch.importers.size(), 0);
+    for(EbsdImporter::Pointer& importer : batch.importers)
     {
-      setErrorCondition(err, fileImporter->getPipelineMessage());
-      return;
+      if(isAngFile)
+      {
+        importer = H5AngImporter::New();
+      }
+      else
+      {
+        importer = H5CtfImporter::New();
+      }
+      importer->setCompressionLevel(m_CompressionLevel);
     }
-    totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
+  };
 
-    fileImporter->getDims(xDim, yDim);
-    fileImporter->getSpacing(xRes, yRes);
-    if(xDim > biggestxDim)
+  auto parseBatch = [&](EbsdSliceBatch& batch) {
+    ParseEbsdSlicesImpl impl(fileList, batch.start, batch.importers, batch.parseErrors);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      biggestxDim = xDim;
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.importers.size(), 1), impl, tbb::simple_partitioner());
     }
-    if(yDim > biggestyDim)
+    else
+#endif
     {
-      biggestyDim = yDim;
+      impl.compute(0, batch.importers.size());
     }
+  };
 
-    if(err < 0)
+  EbsdSliceBatch current;
+  EbsdSliceBatch next;
+  if(!fileList.isEmpty())
+  {
+    createBatch(0, current);
+    parseBatch(current);
+  }
+
+  for(int32_t batchStart = 0; batchStart < fileList.size(); batchStart += batchSize)
+  {
+    // Start parsing the next batch before writing this one
+    int32_t nextStart = batchStart + batchSize;
+    if(nextStart < fileList.size())
     {
-      QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
-      setErrorCondition(-1, ss);
+      createBatch(nextStart, next);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
+      {
+        parseGroup.run([&]() { parseBatch(next); });
+      }
+      else
+#endif
+      {
+        parseBatch(next);
+      }
+    }
+
+    bool stop = false;
+    for(size_t i = 0; i < current.importers.size(); i++)
+    {
+      EbsdImporter::Pointer fileImporter = current.importers[i];
+      QString ebsdFName = fileList[current.start + static_cast<int32_t>(i)];
+      progress = static_cast<int32_t>(z - m_ZStartIndex);
+      progress = (int32_t)(100.0f * (float)(progress) / total);
+      QString msg = "Converting File: " + ebsdFName;
+
+      notifyStatusMessage(msg.toLatin1().data());
+      err = current.parseErrors[i];
+      if(err >= 0)
+      {
+        err = fileImporter->writeParsedFile(fileId, z);
+      }
+      if(err < 0)
+      {
+        setErrorCondition(err, fileImporter->getPipelineMessage());
+        stop = true;
+        break;
+      }
+      totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
+
+      fileImporter->getDims(xDim, yDim);
+      fileImporter->getSpacing(xRes, yRes);
+      if(xDim > biggestxDim)
+      {
+        biggestxDim = xDim;
+      }
+      if(yDim > biggestyDim)
+      {
+        biggestyDim = yDim;
+      }
+
+      // Release the parsed data of this slice now that it is in the file
+      current.importers[i].reset();
+
+      indices.push_back(static_cast<int32_t>(z));
+      ++z;
+      if(getCancel())
+      {
+        stop = true;
+        break;
+      }
     }
 
-    indices.push_back(static_cast<int32_t>(z));
-    ++z;
-    if(getCancel())
+    // The next batch must be finished before it is written, or before returning
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    parseGroup.wait();
+#endif
+    if(stop)
     {
       return;
     }
+    std::swap(current, next);
+    next.importers.clear();
+    next.parseErrors.clear();
   }
 
   // Write Z index start, Z index end and Z Spacing to the HDF5 file
@@ -515,6 +678,7 @@ AbstractFilter::Pointer EbsdToH5Ebsd::newFilterInstance(bool copyFilterParameter
     SIMPL_COPY_INSTANCEVAR(PaddingDigits)
     SIMPL_COPY_INSTANCEVAR(SampleTransformation)
     SIMPL_COPY_INSTANCEVAR(EulerTransformation)
+    SIMPL_COPY_INSTANCEVAR(CompressionLevel)
   }
   return filter;
 }
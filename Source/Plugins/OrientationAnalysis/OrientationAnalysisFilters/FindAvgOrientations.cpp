@@ -35,6 +35,9 @@
 
 #include "FindAvgOrientations.h"
 
+#include <limits>
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
@@ -42,6 +45,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/FeatureReduction.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -231,45 +235,76 @@ void FindAvgOrientations::execute()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
-  std::vector<float> counts(totalFeatures, 0.0f);
-
-  int32_t phase = 0;
-  QuatF voxquat = QuaternionMathF::New();
-  QuatF curavgquat = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
+  int32_t* featureIds = m_FeatureIds;
+  int32_t* cellPhases = m_CellPhases;
+  uint32_t* crystalStructures = m_CrystalStructures;
+  const QVector<LaueOps::Pointer>& orientationOps = m_OrientationOps;
+
+  // The first voxel of each feature, moved to the symmetric equivalent nearest the identity, is the
+  // reference every other voxel of the feature is moved next to before averaging
+  const int64_t noVoxel = std::numeric_limits<int64_t>::max();
+  std::vector<int64_t> firstVoxels(totalFeatures, noVoxel);
+  FeatureReduction::Reduce<int64_t>("FindAvgOrientations", totalPoints, totalFeatures, noVoxel,
+                                    [=](size_t i, int64_t* table) {
+                                      if(featureIds[i] > 0 && cellPhases[i] > 0 && table[featureIds[i]] == noVoxel)
+                                      {
+                                        table[featureIds[i]] = static_cast<int64_t>(i);
+                                      }
+                                    },
+                                    [](int64_t a, int64_t b) { return std::min(a, b); }, firstVoxels.data());
+
+  std::vector<QuatF> references(totalFeatures, QuaternionMathF::New());
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    QuaternionMathF::ElementWiseAssign(avgQuats[i], 0.0);
-  }
-
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
+    if(firstVoxels[i] == noVoxel)
     {
-      counts[m_FeatureIds[i]] += 1.0f;
-      phase = m_CellPhases[i];
-      QuaternionMathF::Copy(quats[i], voxquat);
-      QuaternionMathF::Copy(avgQuats[m_FeatureIds[i]], curavgquat);
-      QuaternionMathF::ScalarDivide(curavgquat, counts[m_FeatureIds[i]]);
-
-      if(counts[m_FeatureIds[i]] == 1.0f)
-      {
-        QuaternionMathF::Identity(curavgquat);
-      }
-      m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
-      QuaternionMathF::Add(avgQuats[m_FeatureIds[i]], voxquat, avgQuats[m_FeatureIds[i]]);
+      continue;
     }
+    QuatF identity = QuaternionMathF::New();
+    QuaternionMathF::Identity(identity);
+    QuaternionMathF::Copy(quats[firstVoxels[i]], references[i]);
+    orientationOps[crystalStructures[cellPhases[firstVoxels[i]]]]->getNearestQuat(identity, references[i]);
   }
 
+  // Each feature sums x, y, z, w and its voxel count
+  const size_t numComps = 5;
+  std::vector<double> sums(totalFeatures * numComps, 0.0);
+  FeatureReduction::Sum<double>("FindAvgOrientations", totalPoints, totalFeatures * numComps,
+                                [=, &references](size_t i, double* table) {
+                                  int32_t feature = featureIds[i];
+                                  if(feature > 0 && cellPhases[i] > 0)
+                                  {
+                                    QuatF voxquat = QuaternionMathF::New();
+                                    QuatF refquat = QuaternionMathF::New();
+                                    QuaternionMathF::Copy(quats[i], voxquat);
+                                    QuaternionMathF::Copy(references[feature], refquat);
+                                    orientationOps[crystalStructures[cellPhases[i]]]->getNearestQuat(refquat, voxquat);
+                                    double* featureSums = table + feature * numComps;
+                                    featureSums[0] += voxquat.x;
+                                    featureSums[1] += voxquat.y;
+                                    featureSums[2] += voxquat.z;
+                                    featureSums[3] += voxquat.w;
+                                    featureSums[4] += 1.0;
+                                  }
+                                },
+                                sums.data());
+
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    if(counts[i] == 0.0f)
+    const double* featureSums = sums.data() + i * numComps;
+    if(featureSums[4] == 0.0)
     {
       QuaternionMathF::Identity(avgQuats[i]);
     }
-    QuaternionMathF::ScalarDivide(avgQuats[i], counts[i]);
+    else
+    {
+      avgQuats[i].x = static_cast<float>(featureSums[0] / featureSums[4]);
+      avgQuats[i].y = static_cast<float>(featureSums[1] / featureSums[4]);
+      avgQuats[i].z = static_cast<float>(featureSums[2] / featureSums[4]);
+      avgQuats[i].w = static_cast<float>(featureSums[3] / featureSums[4]);
+    }
     QuaternionMathF::UnitQuaternion(avgQuats[i]);
 
     FOrientArrayType eu(m_FeatureEulerAngles + (3 * i), 3);
@@ -52,6 +52,7 @@
 
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -487,7 +488,7 @@ void FindDistsToCharactGBs::execute()
   double* m_FaceNormals = m_SurfaceMeshFaceNormalsPtr.lock()->getPointer(0);
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindDistsToCharactGBs"));
   bool doParallel = true;
 #endif
 
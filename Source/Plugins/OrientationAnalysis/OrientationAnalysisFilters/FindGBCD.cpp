@@ -57,6 +57,7 @@
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -604,7 +605,7 @@ void FindGBCD::execute()
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindGBCD"));
   bool doParallel = true;
 #endif
 
@@ -648,7 +649,7 @@ void FindGBCD::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize),
+      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize, ParallelExecutionContext::Instance()->getGrainSize("FindGBCD")),
                         CalculateGBCDImpl(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
                                           m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray),
                         tbb::auto_partitioner());
@@ -61,8 +61,10 @@
 
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/MetricBasedHelpers/SphericalBinIndex.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -311,20 +313,23 @@ public:
 
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBCD
+ * for the GBCD. A triangle can only contribute to a sampling point if its first normal is within
+ * sqrt(2) times the plane resolution of the point, so the first normals (and their inversions) are binned
+ * on the sphere and each sampling point only visits the triangles in the bins around it.
  */
 class ProbeDistrib
 {
   QVector<double>* distribValues = nullptr;
   QVector<double>* errorValues = nullptr;
-  QVector<float> samplPtsX;
-  QVector<float> samplPtsY;
-  QVector<float> samplPtsZ;
+  const QVector<float>* samplPtsX;
+  const QVector<float>* samplPtsY;
+  const QVector<float>* samplPtsZ;
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>* selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>* selectedTris;
 #endif
+  const SphericalBinIndex* normalsIndex;
   float planeResolSq;
   double totalFaceArea;
   int numDistinctGBs;
@@ -332,19 +337,20 @@ class ProbeDistrib
   float (&gFixedT)[3][3];
 
 public:
-  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float> __samplPtsX, QVector<float> __samplPtsY, QVector<float> __samplPtsZ,
+  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, const QVector<float>* __samplPtsX, const QVector<float>* __samplPtsY, const QVector<float>* __samplPtsZ,
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+               const tbb::concurrent_vector<TriAreaAndNormals>* __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+               const QVector<TriAreaAndNormals>* __selectedTris,
 #endif
-               float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
+               const SphericalBinIndex* __normalsIndex, float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalsIndex(__normalsIndex)
   , planeResolSq(__planeResolSq)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -359,34 +365,28 @@ public:
   {
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
-      float fixedNormal1[3] = {samplPtsX.at(ptIdx), samplPtsY.at(ptIdx), samplPtsZ.at(ptIdx)};
+      float fixedNormal1[3] = {samplPtsX->at(ptIdx), samplPtsY->at(ptIdx), samplPtsZ->at(ptIdx)};
       float fixedNormal2[3] = {0.0f, 0.0f, 0.0f};
       MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
-      {
-        for(int inversion = 0; inversion <= 1; inversion++)
-        {
-          float sign = 1.0f;
-          if(inversion == 1)
-          {
-            sign = -1.0f;
-          }
+      double distrib = 0.0;
+      // Each binned vector is sign * normal_grain1, with the inversion encoded in the lowest payload bit
+      normalsIndex->visitNeighbors(fixedNormal1, [&](const float* signedNormal1, size_t payload) {
+        const TriAreaAndNormals& tri = (*selectedTris)[payload >> 1];
+        float sign = (payload & 1) ? -1.0f : 1.0f;
 
-          float theta1 = acosf(sign * (selectedTris[triRepresIdx].normal_grain1_x * fixedNormal1[0] + selectedTris[triRepresIdx].normal_grain1_y * fixedNormal1[1] +
-                                       selectedTris[triRepresIdx].normal_grain1_z * fixedNormal1[2]));
+        float theta1 = acosf(signedNormal1[0] * fixedNormal1[0] + signedNormal1[1] * fixedNormal1[1] + signedNormal1[2] * fixedNormal1[2]);
 
-          float theta2 = acosf(-sign * (selectedTris[triRepresIdx].normal_grain2_x * fixedNormal2[0] + selectedTris[triRepresIdx].normal_grain2_y * fixedNormal2[1] +
-                                        selectedTris[triRepresIdx].normal_grain2_z * fixedNormal2[2]));
+        float theta2 = acosf(-sign * (tri.normal_grain2_x * fixedNormal2[0] + tri.normal_grain2_y * fixedNormal2[1] + tri.normal_grain2_z * fixedNormal2[2]));
 
-          float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
+        float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
 
-          if(distSq < planeResolSq)
-          {
-            (*distribValues)[ptIdx] += selectedTris[triRepresIdx].area;
-          }
+        if(distSq < planeResolSq)
+        {
+          distrib += tri.area;
         }
-      }
+      });
+      (*distribValues)[ptIdx] = distrib;
       (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
 
       (*distribValues)[ptIdx] /= totalFaceArea;
@@ -894,7 +894,7 @@ void FindGBCDMetricBased::execute()
 
 // ---------  find triangles (and equivalent crystallographic parameters) with +- the fixed misorientation ---------
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindGBCDMetricBased"));
   bool doParallel = true;
   tbb::concurrent_vector<GBCDMetricBased::TriAreaAndNormals> selectedTris(0);
 #else
@@ -971,6 +971,20 @@ void FindGBCDMetricBased::execute()
     totalFaceArea += m_FaceAreas[triIdx] * double(triIncluded.at(triIdx));
   }
 
+  // bin the first normal of every selected triangle, and its inversion, on the sphere; only normals
+  // within sqrt(2) * planeResol of a sampling point can satisfy 0.5 * (theta1^2 + theta2^2) < planeResol^2
+  SphericalBinIndex normalsIndex(sqrtf(2.0f * m_PlaneResolSq));
+  normalsIndex.reserve(2 * selectedTris.size());
+  for(size_t i = 0; i < selectedTris.size(); i++)
+  {
+    const GBCDMetricBased::TriAreaAndNormals& tri = selectedTris[i];
+    float normal1[3] = {tri.normal_grain1_x, tri.normal_grain1_y, tri.normal_grain1_z};
+    float invNormal1[3] = {-tri.normal_grain1_x, -tri.normal_grain1_y, -tri.normal_grain1_z};
+    normalsIndex.addVector(normal1, 2 * i);
+    normalsIndex.addVector(invNormal1, 2 * i + 1);
+  }
+  normalsIndex.build();
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -997,13 +1011,13 @@ void FindGBCDMetricBased::execute()
     if(doParallel)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
+                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalsIndex, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
+      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalsIndex, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
       serial.probe(i, i + pointsChunkSize);
     }
   }
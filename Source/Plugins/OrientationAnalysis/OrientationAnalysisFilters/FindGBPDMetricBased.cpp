@@ -61,8 +61,10 @@
 
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/MetricBasedHelpers/SphericalBinIndex.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -240,7 +242,9 @@ public:
 
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBPD
+ * for the GBPD. Instead of testing every selected triangle against every symmetric copy of the sampling
+ * point, the (unsymmetrized) grain normals are binned on the sphere once and each symmetric copy of the
+ * sampling point only visits the normals in the bins around it.
  */
 class ProbeDistrib
 {
@@ -250,10 +254,11 @@ class ProbeDistrib
   QVector<float>* samplPtsY;
   QVector<float>* samplPtsZ;
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>* selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>* selectedTris;
 #endif
+  const SphericalBinIndex* normalsIndex;
   float limitDist;
   double totalFaceArea;
   int numDistinctGBs;
@@ -265,17 +270,18 @@ class ProbeDistrib
 public:
   ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+               const tbb::concurrent_vector<TriAreaAndNormals>* __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+               const QVector<TriAreaAndNormals>* __selectedTris,
 #endif
-               float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
+               const SphericalBinIndex* __normalsIndex, float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalsIndex(__normalsIndex)
   , limitDist(__limitDist)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -290,62 +296,50 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float symT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
       double __c = 0.0;
+      double distrib = 0.0;
 
       float probeNormal[3] = {(*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx)};
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      // The angle between the probe and sym * normal equals the angle between sym^T * probe and the
+      // normal, so rotate the probe instead of every grain normal
+      for(int j = 0; j < nsym; j++)
       {
-        float normal1[3] = {selectedTris[triRepresIdx].normal_grain1_x, selectedTris[triRepresIdx].normal_grain1_y, selectedTris[triRepresIdx].normal_grain1_z};
-
-        float normal2[3] = {selectedTris[triRepresIdx].normal_grain2_x, selectedTris[triRepresIdx].normal_grain2_y, selectedTris[triRepresIdx].normal_grain2_z};
+        m_OrientationOps[cryst]->getMatSymOp(j, sym);
+        MatrixMath::Transpose3x3(sym, symT);
 
-        float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+        float symProbe[3] = {0.0f, 0.0f, 0.0f};
+        MatrixMath::Multiply3x3with3x1(symT, probeNormal, symProbe);
 
-        for(int j = 0; j < nsym; j++)
+        for(int inversion = 0; inversion <= 1; inversion++)
         {
-          m_OrientationOps[cryst]->getMatSymOp(j, sym);
-
-          float sym_normal1[3] = {0.0f, 0.0f, 0.0f};
-          float sym_normal2[3] = {0.0f, 0.0f, 0.0f};
-
-          MatrixMath::Multiply3x3with3x1(sym, normal1, sym_normal1);
-          MatrixMath::Multiply3x3with3x1(sym, normal2, sym_normal2);
-
-          for(int inversion = 0; inversion <= 1; inversion++)
+          float sign = 1.0f;
+          if(inversion == 1)
           {
-            float sign = 1.0f;
-            if(inversion == 1)
-            {
-              sign = -1.0f;
-            }
-
-            float gamma1 = acosf(sign * (probeNormal[0] * sym_normal1[0] + probeNormal[1] * sym_normal1[1] + probeNormal[2] * sym_normal1[2]));
-
-            float gamma2 = acosf(sign * (probeNormal[0] * sym_normal2[0] + probeNormal[1] * sym_normal2[1] + probeNormal[2] * sym_normal2[2]));
+            sign = -1.0f;
+          }
+          float query[3] = {sign * symProbe[0], sign * symProbe[1], sign * symProbe[2]};
 
-            if(gamma1 < limitDist)
+          normalsIndex->visitNeighbors(query, [&](const float* normal, size_t triRepresIdx) {
+            float gamma = acosf(query[0] * normal[0] + query[1] * normal[1] + query[2] * normal[2]);
+            if(gamma < limitDist)
             {
               // Kahan summation algorithm
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
-              __c -= __y;
-              (*distribValues)[ptIdx] = __t;
-            }
-            if(gamma2 < limitDist)
-            {
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
+              double __y = (*selectedTris)[triRepresIdx].area - __c;
+              double __t = distrib + __y;
+              __c = (__t - distrib);
               __c -= __y;
-              (*distribValues)[ptIdx] = __t;
+              distrib = __t;
             }
-          }
+          });
         }
       }
+      (*distribValues)[ptIdx] = distrib;
       (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
       (*distribValues)[ptIdx] /= totalFaceArea;
       (*distribValues)[ptIdx] /= ballVolume;
@@ -976,7 +970,7 @@ void FindGBPDMetricBased::execute()
   size_t numMeshTris = m_SurfaceMeshFaceAreasPtr.lock()->getNumberOfTuples();
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindGBPDMetricBased"));
   bool doParallel = true;
   tbb::concurrent_vector<GBPDMetricBased::TriAreaAndNormals> selectedTris(0);
 #else
@@ -1051,6 +1045,19 @@ void FindGBPDMetricBased::execute()
     totalFaceArea += selectedTris.at(i).area;
   }
 
+  // bin both grain normals of every selected triangle on the sphere
+  SphericalBinIndex normalsIndex(m_LimitDist);
+  normalsIndex.reserve(2 * selectedTris.size());
+  for(size_t i = 0; i < selectedTris.size(); i++)
+  {
+    const GBPDMetricBased::TriAreaAndNormals& tri = selectedTris[i];
+    float normal1[3] = {tri.normal_grain1_x, tri.normal_grain1_y, tri.normal_grain1_z};
+    float normal2[3] = {tri.normal_grain2_x, tri.normal_grain2_y, tri.normal_grain2_z};
+    normalsIndex.addVector(normal1, i);
+    normalsIndex.addVector(normal2, i);
+  }
+  normalsIndex.build();
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -1077,13 +1084,13 @@ void FindGBPDMetricBased::execute()
     if(doParallel)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
+                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalsIndex, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
+      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalsIndex, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
       serial.probe(i, i + pointsChunkSize);
     }
   }
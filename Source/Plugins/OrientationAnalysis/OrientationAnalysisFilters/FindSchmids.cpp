@@ -35,6 +35,13 @@
 
 #include "FindSchmids.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -44,12 +51,111 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The FindSchmidsImpl class implements a threaded algorithm that rotates the loading direction into the
+ * crystal frame of each feature and finds its Schmid factor and active slip system.
+ */
+class FindSchmidsImpl
+{
+  QVector<LaueOps::Pointer> m_OrientationOps;
+  float* m_AvgQuats;
+  int32_t* m_FeaturePhases;
+  unsigned int* m_CrystalStructures;
+  float* m_SampleLoading;
+  float* m_Plane;
+  float* m_Direction;
+  bool m_OverrideSystem;
+  float* m_Schmids;
+  float* m_Phis;
+  float* m_Lambdas;
+  int32_t* m_Poles;
+  int32_t* m_SlipSystems;
+
+public:
+  FindSchmidsImpl(QVector<LaueOps::Pointer> orientationOps, float* avgQuats, int32_t* featurePhases, unsigned int* crystalStructures, float* sampleLoading, float* plane, float* direction,
+                  bool overrideSystem, float* schmids, float* phis, float* lambdas, int32_t* poles, int32_t* slipSystems)
+  : m_OrientationOps(orientationOps)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_SampleLoading(sampleLoading)
+  , m_Plane(plane)
+  , m_Direction(direction)
+  , m_OverrideSystem(overrideSystem)
+  , m_Schmids(schmids)
+  , m_Phis(phis)
+  , m_Lambdas(lambdas)
+  , m_Poles(poles)
+  , m_SlipSystems(slipSystems)
+  {
+  }
+  virtual ~FindSchmidsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    int32_t ss = 0;
+    QuatF q1 = QuaternionMathF::New();
+    QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float crystalLoading[3] = {0.0f, 0.0f, 0.0f};
+    float angleComps[2] = {0.0f, 0.0f};
+    float schmid = 0.0f;
+    float plane[3] = {m_Plane[0], m_Plane[1], m_Plane[2]};
+    float direction[3] = {m_Direction[0], m_Direction[1], m_Direction[2]};
+
+    for(size_t i = start; i < end; i++)
+    {
+      uint32_t xtal = m_CrystalStructures[m_FeaturePhases[i]];
+      if(xtal >= Ebsd::CrystalStructure::LaueGroupEnd)
+      {
+        continue;
+      }
+
+      QuaternionMathF::Copy(avgQuats[i], q1);
+      FOrientArrayType om(9);
+      FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
+      om.toGMatrix(g);
+
+      MatrixMath::Multiply3x3with3x1(g, m_SampleLoading, crystalLoading);
+
+      if(!m_OverrideSystem)
+      {
+        m_OrientationOps[xtal]->getSchmidFactorAndSS(crystalLoading, schmid, angleComps, ss);
+      }
+      else
+      {
+        m_OrientationOps[xtal]->getSchmidFactorAndSS(crystalLoading, plane, direction, schmid, angleComps, ss);
+      }
+
+      m_Schmids[i] = schmid;
+      if(nullptr != m_Phis)
+      {
+        m_Phis[i] = angleComps[0];
+        m_Lambdas[i] = angleComps[1];
+      }
+      m_Poles[3 * i] = int32_t(crystalLoading[0] * 100);
+      m_Poles[3 * i + 1] = int32_t(crystalLoading[1] * 100);
+      m_Poles[3 * i + 2] = int32_t(crystalLoading[2] * 100);
+      m_SlipSystems[i] = ss;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -294,22 +400,13 @@ void FindSchmids::execute()
 
   size_t totalFeatures = m_SchmidsPtr.lock()->getNumberOfTuples();
 
-  int32_t ss = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float sampleLoading[3] = {0.0f, 0.0f, 0.0f};
-  float crystalLoading[3] = {0.0f, 0.0f, 0.0f};
-  float angleComps[2] = {0.0f, 0.0f};
-  float schmid = 0.0f;
-
   sampleLoading[0] = m_LoadingDirection[0];
   sampleLoading[1] = m_LoadingDirection[1];
   sampleLoading[2] = m_LoadingDirection[2];
   MatrixMath::Normalize3x1(sampleLoading);
-  float plane[3] = {0.0f, 0.0f};
-  float direction[3] = {0.0f, 0.0f};
+  float plane[3] = {0.0f, 0.0f, 0.0f};
+  float direction[3] = {0.0f, 0.0f, 0.0f};
 
   if(m_OverrideSystem)
   {
@@ -324,40 +421,29 @@ void FindSchmids::execute()
     MatrixMath::Normalize3x1(direction);
   }
 
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    FOrientArrayType om(9);
-    FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-    om.toGMatrix(g);
-
-    MatrixMath::Multiply3x3with3x1(g, sampleLoading, crystalLoading);
+  float* phis = m_StoreAngleComponents ? m_Phis : nullptr;
+  float* lambdas = m_StoreAngleComponents ? m_Lambdas : nullptr;
 
-    uint32_t xtal = m_CrystalStructures[m_FeaturePhases[i]];
-    if(xtal < Ebsd::CrystalStructure::LaueGroupEnd)
-    {
-      if(!m_OverrideSystem)
-      {
-        m_OrientationOps[xtal]->getSchmidFactorAndSS(crystalLoading, schmid, angleComps, ss);
-      }
-      else
-      {
-        m_OrientationOps[xtal]->getSchmidFactorAndSS(crystalLoading, plane, direction, schmid, angleComps, ss);
-      }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindSchmids"));
+  bool doParallel = true;
+#endif
 
-      m_Schmids[i] = schmid;
-      if(m_StoreAngleComponents)
-      {
-        m_Phis[i] = angleComps[0];
-        m_Lambdas[i] = angleComps[1];
-      }
-      m_Poles[3 * i] = int32_t(crystalLoading[0] * 100);
-      m_Poles[3 * i + 1] = int32_t(crystalLoading[1] * 100);
-      m_Poles[3 * i + 2] = int32_t(crystalLoading[2] * 100);
-      m_SlipSystems[i] = ss;
-    }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures),
+                      FindSchmidsImpl(m_OrientationOps, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, sampleLoading, plane, direction, m_OverrideSystem, m_Schmids, phis, lambdas, m_Poles,
+                                      m_SlipSystems),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindSchmidsImpl serial(m_OrientationOps, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, sampleLoading, plane, direction, m_OverrideSystem, m_Schmids, phis, lambdas, m_Poles,
+                           m_SlipSystems);
+    serial.compute(1, totalFeatures);
   }
-
 }
 
 // -----------------------------------------------------------------------------
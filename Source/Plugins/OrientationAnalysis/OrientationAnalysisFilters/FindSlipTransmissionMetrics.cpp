@@ -35,15 +35,149 @@
 
 #include "FindSlipTransmissionMetrics.h"
 
+#include <utility>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#include "EbsdLib/EbsdConstants.h"
+
+/**
+ * @brief The BuildSlipSystemTablesImpl class implements a threaded algorithm that rotates the slip systems of
+ * each feature into the sample frame once, so the neighbor pairs only have to compare the rotated vectors.
+ */
+class BuildSlipSystemTablesImpl
+{
+  QVector<LaueOps::Pointer> m_OrientationOps;
+  float* m_AvgQuats;
+  int32_t* m_FeaturePhases;
+  uint32_t* m_CrystalStructures;
+  float* m_LoadDir;
+  LaueOps::SlipSystemTable* m_Tables;
+
+public:
+  BuildSlipSystemTablesImpl(QVector<LaueOps::Pointer> orientationOps, float* avgQuats, int32_t* featurePhases, uint32_t* crystalStructures, float* loadDir, LaueOps::SlipSystemTable* tables)
+  : m_OrientationOps(orientationOps)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_LoadDir(loadDir)
+  , m_Tables(tables)
+  {
+  }
+  virtual ~BuildSlipSystemTablesImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    QuatF q = QuaternionMathF::New();
+    QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+    for(size_t i = start; i < end; i++)
+    {
+      uint32_t xtal = m_CrystalStructures[m_FeaturePhases[i]];
+      if(m_FeaturePhases[i] > 0 && static_cast<int64_t>(xtal) < static_cast<int64_t>(m_OrientationOps.size()))
+      {
+        QuaternionMathF::Copy(avgQuats[i], q);
+        m_OrientationOps[xtal]->getSlipSystemTable(q, m_LoadDir, m_Tables[i]);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The CalculateSlipTransmissionMetricsImpl class implements a threaded algorithm that computes mPrime, F1,
+ * F1spt and F7 for every neighbor of a range of features from the precomputed slip system tables.
+ */
+class CalculateSlipTransmissionMetricsImpl
+{
+  QVector<LaueOps::Pointer> m_OrientationOps;
+  NeighborList<int32_t>& m_NeighborList;
+  int32_t* m_FeaturePhases;
+  uint32_t* m_CrystalStructures;
+  const LaueOps::SlipSystemTable* m_Tables;
+  std::vector<std::vector<float>>& m_F1Lists;
+  std::vector<std::vector<float>>& m_F1sptLists;
+  std::vector<std::vector<float>>& m_F7Lists;
+  std::vector<std::vector<float>>& m_mPrimeLists;
+
+public:
+  CalculateSlipTransmissionMetricsImpl(QVector<LaueOps::Pointer> orientationOps, NeighborList<int32_t>& neighborList, int32_t* featurePhases, uint32_t* crystalStructures,
+                                       const LaueOps::SlipSystemTable* tables, std::vector<std::vector<float>>& F1Lists, std::vector<std::vector<float>>& F1sptLists,
+                                       std::vector<std::vector<float>>& F7Lists, std::vector<std::vector<float>>& mPrimeLists)
+  : m_OrientationOps(orientationOps)
+  , m_NeighborList(neighborList)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Tables(tables)
+  , m_F1Lists(F1Lists)
+  , m_F1sptLists(F1sptLists)
+  , m_F7Lists(F7Lists)
+  , m_mPrimeLists(mPrimeLists)
+  {
+  }
+  virtual ~CalculateSlipTransmissionMetricsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    float mprime = 0.0f, F1 = 0.0f, F1spt = 0.0f, F7 = 0.0f;
+    for(size_t i = start; i < end; i++)
+    {
+      NeighborList<int32_t>::VectorType& featureNeighborList = m_NeighborList[i];
+      size_t numNeighbors = featureNeighborList.size();
+      m_F1Lists[i].assign(numNeighbors, 0.0f);
+      m_F1sptLists[i].assign(numNeighbors, 0.0f);
+      m_F7Lists[i].assign(numNeighbors, 0.0f);
+      m_mPrimeLists[i].assign(numNeighbors, 0.0f);
+
+      uint32_t xtal = m_CrystalStructures[m_FeaturePhases[i]];
+      if(m_FeaturePhases[i] <= 0 || static_cast<int64_t>(xtal) >= static_cast<int64_t>(m_OrientationOps.size()))
+      {
+        continue;
+      }
+      for(size_t j = 0; j < numNeighbors; j++)
+      {
+        int32_t nname = featureNeighborList[j];
+        if(m_CrystalStructures[m_FeaturePhases[nname]] == xtal)
+        {
+          m_OrientationOps[xtal]->getSlipTransmissionMetrics(m_Tables[i], m_Tables[nname], mprime, F1, F1spt, F7);
+          m_mPrimeLists[i][j] = mprime;
+          m_F1Lists[i][j] = F1;
+          m_F1sptLists[i][j] = F1spt;
+          m_F7Lists[i][j] = F7;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -54,6 +188,12 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID34 = 34,
 };
 
+namespace
+{
+// The warning codes of this filter start at -1001, like the other crystallographic feature statistics filters
+const int32_t k_NonCubicPhaseWarning = -1001;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -237,84 +377,75 @@ void FindSlipTransmissionMetrics::execute()
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
+  // The slip systems are only defined for the cubic (m3m) Laue class, so every other phase gets zero for all metrics
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    if(m_FeaturePhases[i] > 0 && m_CrystalStructures[m_FeaturePhases[i]] != Ebsd::CrystalStructure::Cubic_High)
+    {
+      QString ss = QObject::tr("Feature %1 belongs to phase %2, which is not Cubic m3m. The slip transmission metrics are only calculated for Cubic m3m phases and are set to 0 for all other phases")
+                       .arg(i)
+                       .arg(m_FeaturePhases[i]);
+      setWarningCondition(k_NonCubicPhaseWarning, ss);
+      break;
+    }
+  }
+
   // But since a pointer is difficult to use operators with we will now create a
   // reference variable to the pointer with the correct variable name that allows
   // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
 
-  std::vector<std::vector<float>> F1lists;
-  std::vector<std::vector<float>> F1sptlists;
-  std::vector<std::vector<float>> F7lists;
-  std::vector<std::vector<float>> mPrimelists;
-
-  float mprime = 0.0f, F1 = 0.0f, F1spt = 0.0f, F7 = 0.0f;
-  int32_t nname;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  std::vector<std::vector<float>> F1lists(totalFeatures);
+  std::vector<std::vector<float>> F1sptlists(totalFeatures);
+  std::vector<std::vector<float>> F7lists(totalFeatures);
+  std::vector<std::vector<float>> mPrimelists(totalFeatures);
 
   float LD[3] = {0.0f, 0.0f, 1.0f};
 
-  F1lists.resize(totalFeatures);
-  F1sptlists.resize(totalFeatures);
-  F7lists.resize(totalFeatures);
-  mPrimelists.resize(totalFeatures);
+  // Every feature takes part in all of its neighbor pairs, so rotate its slip systems once up front
+  std::vector<LaueOps::SlipSystemTable> slipSystemTables(totalFeatures);
 
-  for(size_t i = 1; i < totalFeatures; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindSlipTransmissionMetrics"));
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    F1lists[i].assign(neighborlist[i].size(), 0.0f);
-    F1sptlists[i].assign(neighborlist[i].size(), 0.0f);
-    F7lists[i].assign(neighborlist[i].size(), 0.0f);
-    mPrimelists[i].assign(neighborlist[i].size(), 0.0f);
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
-    {
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[i], q1);
-      QuaternionMathF::Copy(avgQuats[nname], q1);
-      if(m_CrystalStructures[m_FeaturePhases[i]] == m_CrystalStructures[m_FeaturePhases[nname]] && m_FeaturePhases[i] > 0)
-      {
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getmPrime(q1, q2, LD, mprime);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1(q1, q2, LD, true, F1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1spt(q1, q2, LD, true, F1spt);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF7(q1, q2, LD, true, F7);
-      }
-      else
-      {
-        mprime = 0.0f;
-        F1 = 0.0f;
-        F1spt = 0.0f;
-        F7 = 0.0f;
-      }
-      mPrimelists[i][j] = mprime;
-      F1lists[i][j] = F1;
-      F1sptlists[i][j] = F1spt;
-      F7lists[i][j] = F7;
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures),
+                      BuildSlipSystemTablesImpl(m_OrientationOps, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD, slipSystemTables.data()), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures),
+                      CalculateSlipTransmissionMetricsImpl(m_OrientationOps, neighborlist, m_FeaturePhases, m_CrystalStructures, slipSystemTables.data(), F1lists, F1sptlists, F7lists, mPrimelists),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    BuildSlipSystemTablesImpl tables(m_OrientationOps, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD, slipSystemTables.data());
+    tables.generate(1, totalFeatures);
+    CalculateSlipTransmissionMetricsImpl metrics(m_OrientationOps, neighborlist, m_FeaturePhases, m_CrystalStructures, slipSystemTables.data(), F1lists, F1sptlists, F7lists, mPrimelists);
+    metrics.generate(1, totalFeatures);
   }
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1L(new std::vector<float>);
-    f1L->assign(F1lists[i].begin(), F1lists[i].end());
+    NeighborList<float>::SharedVectorType f1L(new std::vector<float>(std::move(F1lists[i])));
     m_F1List.lock()->setList(static_cast<int32_t>(i), f1L);
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f1sptL(new std::vector<float>);
-    f1sptL->assign(F1sptlists[i].begin(), F1sptlists[i].end());
+    NeighborList<float>::SharedVectorType f1sptL(new std::vector<float>(std::move(F1sptlists[i])));
     m_F1sptList.lock()->setList(static_cast<int32_t>(i), f1sptL);
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType f7L(new std::vector<float>);
-    f7L->assign(F7lists[i].begin(), F7lists[i].end());
+    NeighborList<float>::SharedVectorType f7L(new std::vector<float>(std::move(F7lists[i])));
     m_F7List.lock()->setList(static_cast<int32_t>(i), f7L);
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType mPrimeL(new std::vector<float>);
-    mPrimeL->assign(mPrimelists[i].begin(), mPrimelists[i].end());
+    NeighborList<float>::SharedVectorType mPrimeL(new std::vector<float>(std::move(mPrimelists[i])));
     m_mPrimeList.lock()->setList(static_cast<int32_t>(i), mPrimeL);
   }
-
 }
 
 // -----------------------------------------------------------------------------
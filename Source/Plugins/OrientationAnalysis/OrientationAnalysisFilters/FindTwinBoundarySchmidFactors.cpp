@@ -36,6 +36,7 @@
 #include "FindTwinBoundarySchmidFactors.h"
 
 #include <fstream>
+#include <vector>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
@@ -58,10 +59,63 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The CalculateFeatureRotationsImpl class implements a threaded algorithm that stores, for each feature, its
+ * orientation matrix followed by the loading direction rotated into its crystal frame (12 floats per feature), so the
+ * twin boundary triangles of a feature share one rotation instead of each recomputing it from the quaternion.
+ */
+class CalculateFeatureRotationsImpl
+{
+  float* m_Quats;
+  float* m_LoadDir;
+  float* m_FeatureRotations;
+
+public:
+  CalculateFeatureRotationsImpl(float* LoadingDir, float* Quats, float* FeatureRotations)
+  : m_Quats(Quats)
+  , m_LoadDir(LoadingDir)
+  , m_FeatureRotations(FeatureRotations)
+  {
+  }
+  virtual ~CalculateFeatureRotationsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    QuatF q1 = QuaternionMathF::New();
+    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+
+    for(size_t i = start; i < end; i++)
+    {
+      QuaternionMathF::Copy(quats[i], q1);
+      FOrientArrayType om(9);
+      FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
+      om.toGMatrix(g1);
+      float* rotation = m_FeatureRotations + 12 * i;
+      for(size_t r = 0; r < 3; r++)
+      {
+        rotation[3 * r] = g1[r][0];
+        rotation[3 * r + 1] = g1[r][1];
+        rotation[3 * r + 2] = g1[r][2];
+      }
+      // calculate crystal direction parallel to loading direction
+      MatrixMath::Multiply3x3with3x1(g1, m_LoadDir, rotation + 9);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 /**
  * @brief The CalculateTwinBoundarySchmidFactorsImpl class implements a threaded algorithm that computes the
  * Schmid factors across twin boundaries.
@@ -70,22 +124,18 @@ class CalculateTwinBoundarySchmidFactorsImpl
 {
   int32_t* m_Labels;
   double* m_Normals;
-  float* m_Quats;
+  float* m_FeatureRotations;
   bool* m_TwinBoundary;
   float* m_TwinBoundarySchmidFactors;
-  float* m_LoadDir;
-  QVector<LaueOps::Pointer> m_OrientationOps;
 
 public:
-  CalculateTwinBoundarySchmidFactorsImpl(float* LoadingDir, int32_t* Labels, double* Normals, float* Quats, bool* TwinBoundary, float* TwinBoundarySchmidFactors)
+  CalculateTwinBoundarySchmidFactorsImpl(int32_t* Labels, double* Normals, float* FeatureRotations, bool* TwinBoundary, float* TwinBoundarySchmidFactors)
   : m_Labels(Labels)
   , m_Normals(Normals)
-  , m_Quats(Quats)
+  , m_FeatureRotations(FeatureRotations)
   , m_TwinBoundary(TwinBoundary)
   , m_TwinBoundarySchmidFactors(TwinBoundarySchmidFactors)
-  , m_LoadDir(LoadingDir)
   {
-    m_OrientationOps = LaueOps::getOrientationOpsQVector();
   }
   virtual ~CalculateTwinBoundarySchmidFactorsImpl() = default;
 
@@ -95,8 +145,6 @@ public:
     float normal[3] = {0.0f, 0.0f, 0.0f};
     float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float schmid1 = 0.0f, schmid2 = 0.0f, schmid3 = 0.0f;
-    QuatF q1 = QuaternionMathF::New();
-    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
     float n[3] = {0.0f, 0.0f, 0.0f};
     float b[3] = {0.0f, 0.0f, 0.0f};
@@ -122,14 +170,16 @@ public:
           feature = feature2;
         }
 
-        QuaternionMathF::Copy(quats[feature], q1);
+        const float* rotation = m_FeatureRotations + 12 * feature;
+        for(size_t r = 0; r < 3; r++)
+        {
+          g1[r][0] = rotation[3 * r];
+          g1[r][1] = rotation[3 * r + 1];
+          g1[r][2] = rotation[3 * r + 2];
+          crystalLoading[r] = rotation[9 + r];
+        }
         // calculate crystal direction parallel to normal
-        FOrientArrayType om(9);
-        FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-        om.toGMatrix(g1);
         MatrixMath::Multiply3x3with3x1(g1, normal, n);
-        // calculate crystal direction parallel to loading direction
-        MatrixMath::Multiply3x3with3x1(g1, m_LoadDir, crystalLoading);
 
         if(n[2] < 0.0f)
         {
@@ -459,7 +509,7 @@ void FindTwinBoundarySchmidFactors::execute()
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindTwinBoundarySchmidFactors"));
   bool doParallel = true;
 #endif
 
@@ -470,17 +520,23 @@ void FindTwinBoundarySchmidFactors::execute()
   LoadingDir[1] = m_LoadingDir[1];
   LoadingDir[2] = m_LoadingDir[2];
 
+  size_t numFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
+  std::vector<float> featureRotations(12 * numFeatures, 0.0f);
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), CalculateTwinBoundarySchmidFactorsImpl(LoadingDir, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats,
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), CalculateFeatureRotationsImpl(LoadingDir, m_AvgQuats, featureRotations.data()), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), CalculateTwinBoundarySchmidFactorsImpl(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, featureRotations.data(),
                                                                                                           m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundarySchmidFactors),
                       tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateTwinBoundarySchmidFactorsImpl serial(LoadingDir, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundarySchmidFactors);
+    CalculateFeatureRotationsImpl rotations(LoadingDir, m_AvgQuats, featureRotations.data());
+    rotations.generate(0, numFeatures);
+    CalculateTwinBoundarySchmidFactorsImpl serial(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, featureRotations.data(), m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundarySchmidFactors);
     serial.generate(0, numTriangles);
   }
 
@@ -52,6 +52,7 @@
 #include "SIMPLib/Utilities/ColorTable.h"
 
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -323,7 +324,7 @@ void GenerateIPFColors::execute()
   MatrixMath::Normalize3x1(normRefDir[0], normRefDir[1], normRefDir[2]);
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("GenerateIPFColors"));
   bool doParallel = true;
 #endif
 
@@ -9,6 +9,8 @@
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -184,7 +186,7 @@ void GenerateOrientationMatrixTranspose::execute()
   size_t totalPoints = m_OrientationMatrixPtr.lock()->getNumberOfTuples();
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("GenerateOrientationMatrixTranspose"));
   bool doParallel = true;
 #endif
 
@@ -35,6 +35,13 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "EbsdLib/HKL/CtfFields.h"
 #include "EbsdLib/HKL/CtfReader.h"
 #include "EbsdLib/TSL/AngFields.h"
@@ -42,11 +49,16 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "OrientationAnalysis/FilterParameters/EbsdMontageImportFilterParameter.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
@@ -54,6 +66,59 @@
 #include "OrientationAnalysis/OrientationAnalysisFilters/ReadCtfData.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The CopyEbsdTileImpl class copies the rows of one tile that has already been read into their place in
+ * the stitched Cell Attribute Matrix. Where tiles overlap, the tile above or to the left owns the overlap, so
+ * the rows and columns of the overlap are skipped and every stitched cell is written by exactly one tile.
+ */
+class CopyEbsdTileImpl
+{
+public:
+  CopyEbsdTileImpl(AttributeMatrix::Pointer tileAttrMat, AttributeMatrix::Pointer stitchedAttrMat, const std::array<size_t, 6>& tilePlacement, size_t stitchedWidth)
+  : m_TilePlacement(tilePlacement)
+  , m_StitchedWidth(stitchedWidth)
+  {
+    for(const QString& name : stitchedAttrMat->getAttributeArrayNames())
+    {
+      IDataArray::Pointer src = tileAttrMat->getAttributeArray(name);
+      IDataArray::Pointer dst = stitchedAttrMat->getAttributeArray(name);
+      if(nullptr != src && nullptr != dst)
+      {
+        m_Arrays.push_back(std::make_pair(src, dst));
+      }
+    }
+  }
+
+  virtual ~CopyEbsdTileImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    // { x offset, y offset, width, height, skipped columns, skipped rows }
+    const std::array<size_t, 6>& place = m_TilePlacement;
+    for(const std::pair<IDataArray::Pointer, IDataArray::Pointer>& array : m_Arrays)
+    {
+      for(size_t y = start; y < end; y++)
+      {
+        size_t srcOffset = y * place[2] + place[4];
+        size_t dstOffset = (place[1] + y) * m_StitchedWidth + place[0] + place[4];
+        array.second->copyFromArray(dstOffset, array.first, srcOffset, place[2] - place[4]);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::array<size_t, 6>& m_TilePlacement;
+  size_t m_StitchedWidth;
+  std::vector<std::pair<IDataArray::Pointer, IDataArray::Pointer>> m_Arrays;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -61,6 +126,8 @@ ImportEbsdMontage::ImportEbsdMontage()
 : m_DataContainerName("OIM Data Container")
 , m_CellEnsembleAttributeMatrixName("Phase Data")
 , m_CellAttributeMatrixName("Scan Data")
+, m_StitchTiles(false)
+, m_TileOverlap(0)
 {
   initialize();
 }
@@ -88,7 +155,14 @@ void ImportEbsdMontage::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(SIMPL_NEW_EbsdMontageListInfo_FP("Input File List", InputFileListInfo, FilterParameter::Parameter, ImportEbsdMontage));
-  // parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ImportEbsdMontage));
+  {
+    QStringList linkedProps;
+    linkedProps << "TileOverlap"
+                << "DataContainerName";
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stitch Tiles Into One Geometry", StitchTiles, FilterParameter::Parameter, ImportEbsdMontage, linkedProps));
+  }
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Tile Overlap (Cells)", TileOverlap, FilterParameter::Parameter, ImportEbsdMontage));
+  parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ImportEbsdMontage));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_STRING_FP("Cell Attribute Matrix", CellAttributeMatrixName, FilterParameter::CreatedArray, ImportEbsdMontage));
   parameters.push_back(SIMPL_NEW_STRING_FP("Cell Ensemble Attribute Matrix", CellEnsembleAttributeMatrixName, FilterParameter::CreatedArray, ImportEbsdMontage));
@@ -147,6 +221,226 @@ void readEbsdFile(ImportEbsdMontage* filter, const QString& fileName, std::map<Q
   filter->getDataContainerArray()->addDataContainer(dc);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <class EbsdReaderClass>
+AbstractFilter::Pointer createTileReader(ImportEbsdMontage* filter, const QString& fileName, std::map<QString, AbstractFilter::Pointer>& prevFilterCache,
+                                         std::map<QString, AbstractFilter::Pointer>& newFilterCache)
+{
+  typename EbsdReaderClass::Pointer reader = EbsdReaderClass::NullPointer();
+  if(prevFilterCache.find(fileName) != prevFilterCache.end())
+  {
+    reader = std::dynamic_pointer_cast<EbsdReaderClass>(prevFilterCache[fileName]);
+  }
+  if(nullptr == reader.get())
+  {
+    reader = EbsdReaderClass::New();
+    reader->setInputFile(fileName);
+    reader->setDataContainerName(QFileInfo(fileName).completeBaseName());
+  }
+  newFilterCache[fileName] = reader;
+  reader->setDataContainerArray(DataContainerArray::New());
+  reader->setCellEnsembleAttributeMatrixName(filter->getCellEnsembleAttributeMatrixName());
+  reader->setCellAttributeMatrixName(filter->getCellAttributeMatrixName());
+  return reader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::stitchTiles(const FilePathGenerator::TileRCIncexLayout2D& tileLayout2d)
+{
+  std::map<QString, AbstractFilter::Pointer> newFilterCache;
+
+  size_t numRows = tileLayout2d.size();
+  size_t numCols = tileLayout2d[0].size();
+  std::vector<AbstractFilter::Pointer> readers;
+  QVector<QString> dcNames;
+  std::vector<std::array<size_t, 3>> tileDims;
+
+  // Read the header of every tile to find out how big the stitched geometry has to be
+  for(const FilePathGenerator::TileRCIndexRow2D& tileRow2D : tileLayout2d)
+  {
+    if(tileRow2D.size() != numCols)
+    {
+      setErrorCondition(-74001, "Every row of the montage must have the same number of tiles");
+      return;
+    }
+    for(const FilePathGenerator::TileRCIndex2D& tile2D : tileRow2D)
+    {
+      AbstractFilter::Pointer reader;
+      if(m_InputFileListInfo.FileExtension == Ebsd::Ang::FileExt)
+      {
+        reader = createTileReader<ReadAngData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+      }
+      else if(m_InputFileListInfo.FileExtension == Ebsd::Ctf::FileExt)
+      {
+        reader = createTileReader<ReadCtfData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+      }
+      else
+      {
+        QString msg = QString("Unsupported EBSD file extension '%1'").arg(m_InputFileListInfo.FileExtension);
+        setErrorCondition(-74004, msg);
+        return;
+      }
+      reader->preflight();
+      if(reader->getErrorCode() < 0)
+      {
+        QString msg = QString("Sub filter (%1) caused an error during preflight of %2.").arg(reader->getHumanLabel(), tile2D.FileName);
+        setErrorCondition(reader->getErrorCode(), msg);
+        m_FilterCache = newFilterCache;
+        return;
+      }
+
+      QString fname = QFileInfo(tile2D.FileName).completeBaseName();
+      ImageGeom::Pointer imageGeom = reader->getDataContainerArray()->getDataContainer(fname)->getGeometryAs<ImageGeom>();
+      std::array<size_t, 3> dims = {{0, 0, 0}};
+      std::tie(dims[0], dims[1], dims[2]) = imageGeom->getDimensions();
+      readers.push_back(reader);
+      dcNames.push_back(fname);
+      tileDims.push_back(dims);
+    }
+  }
+  m_FilterCache = newFilterCache;
+
+  // Every tile in a column has the width of the top tile and every tile in a row has the height of the left tile
+  size_t overlap = static_cast<size_t>(std::max(m_TileOverlap, 0));
+  std::vector<size_t> colX(numCols, 0);
+  std::vector<size_t> rowY(numRows, 0);
+  for(size_t c = 1; c < numCols; c++)
+  {
+    colX[c] = colX[c - 1] + tileDims[c - 1][0] - overlap;
+  }
+  for(size_t r = 1; r < numRows; r++)
+  {
+    rowY[r] = rowY[r - 1] + tileDims[(r - 1) * numCols][1] - overlap;
+  }
+
+  std::vector<std::array<size_t, 6>> tilePlacement(readers.size());
+  for(size_t r = 0; r < numRows; r++)
+  {
+    for(size_t c = 0; c < numCols; c++)
+    {
+      size_t t = r * numCols + c;
+      if(tileDims[t][0] != tileDims[c][0] || tileDims[t][1] != tileDims[r * numCols][1] || tileDims[t][2] != 1)
+      {
+        QString msg = QString("Tile '%1' does not have the same size as the other tiles in its row and column").arg(dcNames[t]);
+        setErrorCondition(-74002, msg);
+        return;
+      }
+      if(overlap >= tileDims[t][0] || overlap >= tileDims[t][1])
+      {
+        QString msg = QString("The tile overlap (%1) must be smaller than the size of tile '%2'").arg(overlap).arg(dcNames[t]);
+        setErrorCondition(-74003, msg);
+        return;
+      }
+      tilePlacement[t] = {{colX[c], rowY[r], tileDims[t][0], tileDims[t][1], (c > 0 ? overlap : 0), (r > 0 ? overlap : 0)}};
+    }
+  }
+
+  size_t lastTile = readers.size() - 1;
+  QVector<size_t> tDims(3, 1);
+  tDims[0] = tilePlacement[lastTile][0] + tilePlacement[lastTile][2];
+  tDims[1] = tilePlacement[lastTile][1] + tilePlacement[lastTile][3];
+
+  // Create the stitched geometry from the layout of the first tile
+  DataContainer::Pointer firstDc = readers[0]->getDataContainerArray()->getDataContainer(dcNames[0]);
+  ImageGeom::Pointer firstGeom = firstDc->getGeometryAs<ImageGeom>();
+  DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName());
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  image->setDimensions(tDims.data());
+  std::array<float, 3> res = {{0.0f, 0.0f, 0.0f}};
+  std::tie(res[0], res[1], res[2]) = firstGeom->getResolution();
+  image->setResolution(res.data());
+  // The stitched geometry starts at the origin the reader gives the top left tile. Every other tile is placed
+  // relative to it by its row and column in the montage.
+  std::array<float, 3> origin = {{0.0f, 0.0f, 0.0f}};
+  std::tie(origin[0], origin[1], origin[2]) = firstGeom->getOrigin();
+  image->setOrigin(origin.data());
+  m->setGeometry(image);
+
+  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix(this, getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+  size_t numTuples = tDims[0] * tDims[1] * tDims[2];
+  AttributeMatrix::Pointer firstCellAttrMat = firstDc->getAttributeMatrix(getCellAttributeMatrixName());
+  for(const QString& name : firstCellAttrMat->getAttributeArrayNames())
+  {
+    IDataArray::Pointer p = firstCellAttrMat->getAttributeArray(name);
+    cellAttrMat->insertOrAssign(p->createNewArray(numTuples, p->getComponentDimensions(), p->getName(), !getInPreflight()));
+  }
+
+  if(getInPreflight())
+  {
+    AttributeMatrix::Pointer ensembleAttrMat = firstDc->getAttributeMatrix(getCellEnsembleAttributeMatrixName());
+    m->addOrReplaceAttributeMatrix(ensembleAttrMat->deepCopy(true));
+    return;
+  }
+
+  // The reader filters are not safe to run concurrently, so the tiles are read one at a time. The rows of each tile
+  // are copied into the stitched arrays in parallel and the tile is released before the next one is read.
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("ImportEbsdMontage"));
+  bool doParallel = true;
+#endif
+
+  AttributeMatrix::Pointer ensembleAttrMat;
+  for(size_t t = 0; t < readers.size(); t++)
+  {
+    QString msg = QString("==> [%1/%2] %3").arg(t + 1).arg(readers.size()).arg(dcNames[t]);
+    notifyStatusMessage(msg);
+
+    AbstractFilter::Pointer reader = readers[t];
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    reader->setDataContainerArray(dca);
+    reader->execute();
+    if(reader->getErrorCode() < 0)
+    {
+      msg = QString("Sub filter (%1) caused an error while reading %2.").arg(reader->getHumanLabel(), dcNames[t]);
+      setErrorCondition(reader->getErrorCode(), msg);
+      return;
+    }
+
+    DataContainer::Pointer dc = dca->getDataContainer(dcNames[t]);
+    CopyEbsdTileImpl impl(dc->getAttributeMatrix(getCellAttributeMatrixName()), cellAttrMat, tilePlacement[t], tDims[0]);
+    size_t firstRow = tilePlacement[t][5];
+    size_t numTileRows = tilePlacement[t][3];
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(firstRow, numTileRows), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.compute(firstRow, numTileRows);
+    }
+
+    if(t == 0)
+    {
+      ensembleAttrMat = dc->getAttributeMatrix(getCellEnsembleAttributeMatrixName());
+    }
+    dca->removeDataContainer(dcNames[t]);
+
+    if(getCancel())
+    {
+      return;
+    }
+  }
+
+  if(nullptr != ensembleAttrMat.get())
+  {
+    m->addOrReplaceAttributeMatrix(ensembleAttrMat);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -191,6 +485,12 @@ void ImportEbsdMontage::dataCheck()
     return;
   }
 
+  if(m_StitchTiles)
+  {
+    stitchTiles(tileLayout2d);
+    return;
+  }
+
   int32_t numRows = tileLayout2d.size();
   int32_t numCols = tileLayout2d[0].size();
   int32_t totalTiles = numRows * numCols;
@@ -41,6 +41,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/FilePathGenerator.h"
 
 #include "OrientationAnalysis/FilterParameters/EbsdMontageImportFilterParameter.h"
 
@@ -72,6 +73,12 @@ public:
   SIMPL_FILTER_PARAMETER(EbsdMontageListInfo_t, InputFileListInfo)
   Q_PROPERTY(EbsdMontageListInfo_t InputFileListInfo READ getInputFileListInfo WRITE setInputFileListInfo)
 
+  SIMPL_FILTER_PARAMETER(bool, StitchTiles)
+  Q_PROPERTY(bool StitchTiles READ getStitchTiles WRITE setStitchTiles)
+
+  SIMPL_FILTER_PARAMETER(int, TileOverlap)
+  Q_PROPERTY(int TileOverlap READ getTileOverlap WRITE setTileOverlap)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -171,6 +178,13 @@ protected:
 private:
   std::map<QString, AbstractFilter::Pointer> m_FilterCache;
 
+  /**
+   * @brief stitchTiles Sets up a single Image Geometry that holds every tile of the montage and, during
+   * execute, reads the tiles concurrently and copies each one into its place in that geometry.
+   * @param tileLayout2d
+   */
+  void stitchTiles(const FilePathGenerator::TileRCIncexLayout2D& tileLayout2d);
+
 public:
   /* Rule of 5: All special member functions should be defined if any are defined.
    * https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-default-operation-define-or-delete-them-all
@@ -0,0 +1,180 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+/**
+ * @brief The SphericalBinIndex class bins unit vectors into the cells of a uniform grid laid over the
+ * cube [-1,1]^3 so that every binned vector within a given angle of a query direction can be found by
+ * visiting only the 27 cells around the query. The cell edge is at least the chord length of that angle,
+ * so vectors in any other cell are always farther away. Each binned vector carries a payload (e.g., the
+ * index of the triangle it came from). The vectors of a cell are stored contiguously and in the order
+ * they were added, so visiting the index is deterministic.
+ */
+class SphericalBinIndex
+{
+public:
+  /**
+   * @brief SphericalBinIndex
+   * @param maxAngle Largest angle (in radians) that will be queried
+   */
+  explicit SphericalBinIndex(float maxAngle)
+  {
+    // A small margin keeps vectors that are not exactly unit length from being missed at the cell borders
+    double angle = std::min(static_cast<double>(maxAngle), SIMPLib::Constants::k_Pi);
+    double chord = 2.0 * std::sin(0.5 * angle) * 1.001;
+    m_NumCells = 1;
+    if(chord > 0.0)
+    {
+      m_NumCells = static_cast<int32_t>(std::min(2.0 / chord, static_cast<double>(k_MaxCellsPerDim)));
+      m_NumCells = std::max(m_NumCells, 1);
+    }
+    m_CellWidth = 2.0f / static_cast<float>(m_NumCells);
+  }
+
+  virtual ~SphericalBinIndex() = default;
+
+  /**
+   * @brief reserve Reserves storage for the given number of vectors
+   * @param count
+   */
+  void reserve(size_t count)
+  {
+    m_Vectors.reserve(3 * count);
+    m_Payloads.reserve(count);
+    m_Cells.reserve(count);
+  }
+
+  /**
+   * @brief addVector Adds a vector to the index. build() must be called before the index is queried.
+   * @param v Unit vector
+   * @param payload Value handed back when the vector is visited
+   */
+  void addVector(const float v[3], size_t payload)
+  {
+    m_Vectors.insert(m_Vectors.end(), v, v + 3);
+    m_Payloads.push_back(payload);
+    m_Cells.push_back(cellIndex(cellCoord(v[0]), cellCoord(v[1]), cellCoord(v[2])));
+  }
+
+  /**
+   * @brief build Sorts the added vectors by cell
+   */
+  void build()
+  {
+    size_t numCells = static_cast<size_t>(m_NumCells) * m_NumCells * m_NumCells;
+    m_CellOffsets.assign(numCells + 1, 0);
+    for(size_t cell : m_Cells)
+    {
+      m_CellOffsets[cell + 1]++;
+    }
+    for(size_t c = 0; c < numCells; c++)
+    {
+      m_CellOffsets[c + 1] += m_CellOffsets[c];
+    }
+
+    std::vector<size_t> next(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+    std::vector<float> vectors(m_Vectors.size());
+    std::vector<size_t> payloads(m_Payloads.size());
+    for(size_t i = 0; i < m_Cells.size(); i++)
+    {
+      size_t slot = next[m_Cells[i]]++;
+      vectors[3 * slot + 0] = m_Vectors[3 * i + 0];
+      vectors[3 * slot + 1] = m_Vectors[3 * i + 1];
+      vectors[3 * slot + 2] = m_Vectors[3 * i + 2];
+      payloads[slot] = m_Payloads[i];
+    }
+    m_Vectors.swap(vectors);
+    m_Payloads.swap(payloads);
+    std::vector<size_t>().swap(m_Cells);
+  }
+
+  /**
+   * @brief visitNeighbors Calls visit(const float* vector, size_t payload) for every binned vector in the
+   * cells around the query direction. This is a superset of the vectors within maxAngle of the query; the
+   * visitor does the exact test.
+   * @param q Unit query vector
+   * @param visit
+   */
+  template <typename Visitor> void visitNeighbors(const float q[3], Visitor&& visit) const
+  {
+    int32_t cq[3] = {cellCoord(q[0]), cellCoord(q[1]), cellCoord(q[2])};
+    int32_t lo[3] = {0, 0, 0};
+    int32_t hi[3] = {0, 0, 0};
+    for(int32_t d = 0; d < 3; d++)
+    {
+      lo[d] = std::max(cq[d] - 1, 0);
+      hi[d] = std::min(cq[d] + 1, m_NumCells - 1);
+    }
+    for(int32_t z = lo[2]; z <= hi[2]; z++)
+    {
+      for(int32_t y = lo[1]; y <= hi[1]; y++)
+      {
+        for(int32_t x = lo[0]; x <= hi[0]; x++)
+        {
+          size_t cell = cellIndex(x, y, z);
+          for(size_t e = m_CellOffsets[cell]; e < m_CellOffsets[cell + 1]; e++)
+          {
+            visit(m_Vectors.data() + 3 * e, m_Payloads[e]);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  static const int32_t k_MaxCellsPerDim = 128;
+
+  int32_t m_NumCells = 1;
+  float m_CellWidth = 2.0f;
+  std::vector<float> m_Vectors;
+  std::vector<size_t> m_Payloads;
+  std::vector<size_t> m_Cells;
+  std::vector<size_t> m_CellOffsets;
+
+  int32_t cellCoord(float x) const
+  {
+    int32_t c = static_cast<int32_t>((x + 1.0f) / m_CellWidth);
+    return std::min(std::max(c, 0), m_NumCells - 1);
+  }
+
+  size_t cellIndex(int32_t x, int32_t y, int32_t z) const
+  {
+    return (static_cast<size_t>(z) * m_NumCells + y) * m_NumCells + x;
+  }
+};
@@ -55,6 +55,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -479,7 +481,7 @@ void NeighborOrientationCorrelation::execute()
       return;
     }
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::task_scheduler_init init;
+    tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("NeighborOrientationCorrelation"));
     bool doParallel = true;
 #endif
 
@@ -129,6 +129,8 @@ if(1)
   addIpfHelper(Trigonal)
 endif()
 
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} MetricBasedHelpers/SphericalBinIndex.hpp)
+
 
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
@@ -1,36 +1,70 @@
-// -----------------------------------------------------------------------------
-// Insert your license & copyright information here
-// -----------------------------------------------------------------------------
-#pragma once
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/FilterFactory.hpp"
 #include "SIMPLib/Filtering/FilterManager.h"
-#include "SIMPLib/Filtering/FilterPipeline.h"
-#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
-#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/FilePathGenerator.h"
+#include "UnitTestSupport.hpp"
 
-#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "EbsdLib/TSL/AngConstants.h"
 
-#include "UnitTestSupport.hpp"
+#include "Plugins/OrientationAnalysis/OrientationAnalysisFilters/ImportEbsdMontage.h"
 
-#include "EbsdMontageTestFileLocations.h"
+#include "OrientationAnalysisTestFileLocations.h"
 
 class ImportEbsdMontageTest
 {
-
 public:
   ImportEbsdMontageTest() = default;
-  ~ImportEbsdMontageTest() = default;
-  ImportEbsdMontageTest(const ImportEbsdMontageTest&) = delete;            // Copy Constructor
-  ImportEbsdMontageTest(ImportEbsdMontageTest&&) = delete;                 // Move Constructor
-  ImportEbsdMontageTest& operator=(const ImportEbsdMontageTest&) = delete; // Copy Assignment
-  ImportEbsdMontageTest& operator=(ImportEbsdMontageTest&&) = delete;      // Move Assignment
+  virtual ~ImportEbsdMontageTest() = default;
+
+  SIMPL_TYPE_MACRO(ImportEbsdMontageTest)
+
+  // Every tile has 4 columns and 3 rows and neighboring tiles share one column or row
+  const size_t k_TileWidth = 4;
+  const size_t k_TileHeight = 3;
+  const int k_Overlap = 1;
 
   // -----------------------------------------------------------------------------
   //
@@ -38,8 +72,7 @@ public:
   void RemoveTestFiles()
   {
 #if REMOVE_TEST_FILES
-    QFile::remove(UnitTest::ImportEbsdMontageTest::TestFile1);
-    QFile::remove(UnitTest::ImportEbsdMontageTest::TestFile2);
+    QDir(UnitTest::ImportEbsdMontageTest::InputDir).removeRecursively();
 #endif
   }
 
@@ -48,45 +81,153 @@ public:
   // -----------------------------------------------------------------------------
   int TestFilterAvailability()
   {
-    // Now instantiate the ImportEbsdMontageTest Filter from the FilterManager
+    // Now instantiate the ImportEbsdMontage Filter from the FilterManager
     QString filtName = "ImportEbsdMontage";
     FilterManager* fm = FilterManager::Instance();
     IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
     if(nullptr == filterFactory.get())
     {
       std::stringstream ss;
-      ss << "The ImportEbsdMontageTest Requires the use of the " << filtName.toStdString() << " filter which is found in the EbsdMontage Plugin";
+      ss << "The ImportEbsdMontageTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
       DREAM3D_TEST_THROW_EXCEPTION(ss.str())
     }
     return 0;
   }
 
+  // -----------------------------------------------------------------------------
+  // The image quality of every cell encodes the tile it came from and its place in that tile
+  // -----------------------------------------------------------------------------
+  static float TileValue(size_t row, size_t col, size_t x, size_t y)
+  {
+    return static_cast<float>(1000 * row + 100 * col + 10 * y + x);
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
-  int TestImportEbsdMontageTest()
+  void WriteAngTile(const QString& fileName, size_t row, size_t col)
   {
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    /* Please write ImportEbsdMontageTest test code here.
-     *
-     * Your IO test files are:
-     * UnitTest::ImportEbsdMontageTest::TestFile1
-     * UnitTest::ImportEbsdMontageTest::TestFile2
-     *
-     * SIMPLib provides some macros that will throw exceptions when a test fails
-     * and thus report that during testing. These macros are located in the
-     * SIMPLib/Utilities/UnitTestSupport.hpp file. Some examples are:
-     *
-     * SIMPLib_REQUIRE_EQUAL(foo, 0)
-     * This means that if the variable foo is NOT equal to Zero then test will fail
-     * and the current test will exit immediately. If there are more tests registered
-     * with the SIMPLib_REGISTER_TEST() macro, the next test will execute. There are
-     * lots of examples in the SIMPLib/Test folder to look at.
-     */
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-
-    int foo = -1;
-    DREAM3D_REQUIRE_EQUAL(foo, 0)
+    QFile file(fileName);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Text))
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\n";
+    out << "# Phase 1\n";
+    out << "# MaterialName  \tNickel\n";
+    out << "# Formula     \tNi\n";
+    out << "# Symmetry              43\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\n";
+    out << "# NumberFamilies        0\n";
+    out << "# GRID: SqrGrid\n";
+    out << "# XSTEP: 0.500000\n";
+    out << "# YSTEP: 0.250000\n";
+    out << "# NCOLS_ODD: " << k_TileWidth << "\n";
+    out << "# NCOLS_EVEN: " << k_TileWidth << "\n";
+    out << "# NROWS: " << k_TileHeight << "\n";
+    out << "#\n";
+    for(size_t y = 0; y < k_TileHeight; y++)
+    {
+      for(size_t x = 0; x < k_TileWidth; x++)
+      {
+        out << "0.10000 0.20000 0.30000 " << 0.5f * x << " " << 0.25f * y << " " << TileValue(row, col, x, y) << " 0.900 1 0 0.500\n";
+      }
+    }
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestStitchTiles()
+  {
+    EbsdMontageListInfo_t listInfo;
+    listInfo.PaddingDigits = 1;
+    listInfo.Ordering = 0;
+    listInfo.RowStart = 0;
+    listInfo.RowEnd = 1;
+    listInfo.ColStart = 0;
+    listInfo.ColEnd = 1;
+    listInfo.InputPath = UnitTest::ImportEbsdMontageTest::InputDir;
+    listInfo.FilePrefix = "Tile_";
+    listInfo.FileSuffix = "";
+    listInfo.FileExtension = "ang";
+
+    QDir().mkpath(listInfo.InputPath);
+    bool hasMissingFiles = false;
+    FilePathGenerator::TileRCIncexLayout2D tileLayout2d =
+        FilePathGenerator::GenerateRCIndexMontageFileList(listInfo.RowStart, listInfo.RowEnd, listInfo.ColStart, listInfo.ColEnd, hasMissingFiles, true, listInfo.InputPath, listInfo.FilePrefix,
+                                                          listInfo.FileSuffix, listInfo.FileExtension, listInfo.PaddingDigits);
+    DREAM3D_REQUIRE_EQUAL(tileLayout2d.size(), 2)
+    for(size_t r = 0; r < tileLayout2d.size(); r++)
+    {
+      DREAM3D_REQUIRE_EQUAL(tileLayout2d[r].size(), 2)
+      for(size_t c = 0; c < tileLayout2d[r].size(); c++)
+      {
+        WriteAngTile(tileLayout2d[r][c].FileName, r, c);
+      }
+    }
+
+    ImportEbsdMontage::Pointer filter = ImportEbsdMontage::New();
+    filter->setInputFileListInfo(listInfo);
+    filter->setStitchTiles(true);
+    filter->setTileOverlap(k_Overlap);
+    filter->setDataContainerName(DataArrayPath("Montage", "", ""));
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    // The stitched geometry is the only DataContainer; the tiles are not kept
+    DREAM3D_REQUIRE_EQUAL(dca->getDataContainers().size(), 1)
+    DataContainer::Pointer m = dca->getDataContainer("Montage");
+    DREAM3D_REQUIRE_VALID_POINTER(m.get())
+    ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+    DREAM3D_REQUIRE_VALID_POINTER(image.get())
+
+    size_t width = 2 * k_TileWidth - k_Overlap;
+    size_t height = 2 * k_TileHeight - k_Overlap;
+    size_t dims[3] = {0, 0, 0};
+    std::tie(dims[0], dims[1], dims[2]) = image->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], width)
+    DREAM3D_REQUIRE_EQUAL(dims[1], height)
+    DREAM3D_REQUIRE_EQUAL(dims[2], 1)
+    float res[3] = {0.0f, 0.0f, 0.0f};
+    std::tie(res[0], res[1], res[2]) = image->getResolution();
+    DREAM3D_REQUIRE_EQUAL(res[0], 0.5f)
+    DREAM3D_REQUIRE_EQUAL(res[1], 0.25f)
+    float origin[3] = {-1.0f, -1.0f, -1.0f};
+    std::tie(origin[0], origin[1], origin[2]) = image->getOrigin();
+    DREAM3D_REQUIRE_EQUAL(origin[0], 0.0f)
+    DREAM3D_REQUIRE_EQUAL(origin[1], 0.0f)
+
+    AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(filter->getCellAttributeMatrixName());
+    DREAM3D_REQUIRE_VALID_POINTER(cellAttrMat.get())
+    DREAM3D_REQUIRE_EQUAL(cellAttrMat->getNumberOfTuples(), width * height)
+    FloatArrayType::Pointer iq = cellAttrMat->getAttributeArrayAs<FloatArrayType>(Ebsd::Ang::ImageQuality);
+    DREAM3D_REQUIRE_VALID_POINTER(iq.get())
+    Int32ArrayType::Pointer phases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+    DREAM3D_REQUIRE_VALID_POINTER(phases.get())
+    DREAM3D_REQUIRE_VALID_POINTER(m->getAttributeMatrix(filter->getCellEnsembleAttributeMatrixName()).get())
+
+    // The shared column and row belong to the tile to the left and the tile above
+    for(size_t y = 0; y < height; y++)
+    {
+      size_t row = (y < k_TileHeight ? 0 : 1);
+      size_t tileY = y - row * (k_TileHeight - k_Overlap);
+      for(size_t x = 0; x < width; x++)
+      {
+        size_t col = (x < k_TileWidth ? 0 : 1);
+        size_t tileX = x - col * (k_TileWidth - k_Overlap);
+        DREAM3D_REQUIRE_EQUAL(iq->getValue(y * width + x), TileValue(row, col, tileX, tileY))
+        DREAM3D_REQUIRE_EQUAL(phases->getValue(y * width + x), 1)
+      }
+    }
+
+    // Spot check the cells on both sides of the seams
+    DREAM3D_REQUIRE_EQUAL(iq->getValue(3), 3.0f)
+    DREAM3D_REQUIRE_EQUAL(iq->getValue(4), 101.0f)
+    DREAM3D_REQUIRE_EQUAL(iq->getValue(2 * width + 3), 23.0f)
+    DREAM3D_REQUIRE_EQUAL(iq->getValue(3 * width + 0), 1010.0f)
+    DREAM3D_REQUIRE_EQUAL(iq->getValue(3 * width + 4), 1111.0f)
 
     return EXIT_SUCCESS;
   }
@@ -97,13 +238,18 @@ public:
   void operator()()
   {
     int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
 
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
-    DREAM3D_REGISTER_TEST(TestImportEbsdMontageTest())
+    DREAM3D_REGISTER_TEST(TestStitchTiles());
 
-    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles());
   }
 
-private:
+public:
+  ImportEbsdMontageTest(const ImportEbsdMontageTest&) = delete;            // Copy Constructor Not Implemented
+  ImportEbsdMontageTest(ImportEbsdMontageTest&&) = delete;                 // Move Constructor Not Implemented
+  ImportEbsdMontageTest& operator=(const ImportEbsdMontageTest&) = delete; // Copy Assignment Not Implemented
+  ImportEbsdMontageTest& operator=(ImportEbsdMontageTest&&) = delete;      // Move Assignment Not Implemented
 };
@@ -0,0 +1,240 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/MetricBasedHelpers/SphericalBinIndex.hpp"
+
+class SphericalBinIndexTest
+{
+public:
+  SphericalBinIndexTest() = default;
+  virtual ~SphericalBinIndexTest() = default;
+
+  SIMPL_TYPE_MACRO(SphericalBinIndexTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  static void Normalize(float v[3])
+  {
+    float norm = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    v[0] /= norm;
+    v[1] /= norm;
+    v[2] /= norm;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Same angular cut-off as FindGBPDMetricBased and FindGBCDMetricBased use on the visited normals
+  // -----------------------------------------------------------------------------
+  static bool IsWithin(const float q[3], const float v[3], float maxAngle)
+  {
+    return acosf(q[0] * v[0] + q[1] * v[1] + q[2] * v[2]) < maxAngle;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Appends the vector at the given angle from q, turned towards a random direction perpendicular to q
+  // -----------------------------------------------------------------------------
+  static void AppendAtAngle(const float q[3], double angle, std::mt19937& generator, std::vector<float>& vectors)
+  {
+    std::normal_distribution<double> normal(0.0, 1.0);
+    double t[3] = {normal(generator), normal(generator), normal(generator)};
+    double dot = t[0] * q[0] + t[1] * q[1] + t[2] * q[2];
+    double norm = 0.0;
+    for(int d = 0; d < 3; d++)
+    {
+      t[d] -= dot * q[d];
+      norm += t[d] * t[d];
+    }
+    norm = std::sqrt(norm);
+    float v[3] = {0.0f, 0.0f, 0.0f};
+    for(int d = 0; d < 3; d++)
+    {
+      v[d] = static_cast<float>(std::cos(angle) * q[d] + std::sin(angle) * t[d] / norm);
+    }
+    Normalize(v);
+    vectors.insert(vectors.end(), v, v + 3);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Checks that the index finds exactly the vectors a brute-force angular search over all of them finds
+  // -----------------------------------------------------------------------------
+  void CompareWithBruteForce(float maxAngle, const std::vector<float>& vectors, const std::vector<float>& queries)
+  {
+    SphericalBinIndex index(maxAngle);
+    size_t numVectors = vectors.size() / 3;
+    index.reserve(numVectors);
+    for(size_t i = 0; i < numVectors; i++)
+    {
+      index.addVector(vectors.data() + 3 * i, i);
+    }
+    index.build();
+
+    for(size_t q = 0; q < queries.size() / 3; q++)
+    {
+      const float* query = queries.data() + 3 * q;
+
+      std::vector<size_t> expected;
+      for(size_t i = 0; i < numVectors; i++)
+      {
+        if(IsWithin(query, vectors.data() + 3 * i, maxAngle))
+        {
+          expected.push_back(i);
+        }
+      }
+
+      std::vector<size_t> found;
+      index.visitNeighbors(query, [&](const float* v, size_t payload) {
+        // The index hands back the vector that was added with the payload
+        DREAM3D_REQUIRE_EQUAL(v[0], vectors[3 * payload + 0])
+        DREAM3D_REQUIRE_EQUAL(v[1], vectors[3 * payload + 1])
+        DREAM3D_REQUIRE_EQUAL(v[2], vectors[3 * payload + 2])
+        if(IsWithin(query, v, maxAngle))
+        {
+          found.push_back(payload);
+        }
+      });
+      std::sort(found.begin(), found.end());
+
+      DREAM3D_REQUIRE_EQUAL(found.size(), expected.size())
+      for(size_t i = 0; i < expected.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(found[i], expected[i])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRandomNeighbors()
+  {
+    std::mt19937 generator(5489u);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+    // The smallest angles give the finest grids, the largest ones a single cell. The last two are the cut-offs
+    // of the GBCD filter for plane resolutions of 7 and 60 degrees.
+    const float angles[] = {0.02f, 0.1f, 0.35f, 1.0f, 2.0f, static_cast<float>(SIMPLib::Constants::k_Pi), sqrtf(2.0f) * 7.0f * static_cast<float>(SIMPLib::Constants::k_PiOver180),
+                            sqrtf(2.0f) * 60.0f * static_cast<float>(SIMPLib::Constants::k_PiOver180)};
+
+    for(float maxAngle : angles)
+    {
+      // Query directions: the poles and the ends of the other axes, points on the borders of the cells, and random ones
+      std::vector<float> queries = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f};
+
+      // The grid of the index has the same number of cells per dimension as computed here, so these queries sit on
+      // the cell borders in x and y
+      double chord = 2.0 * std::sin(0.5 * std::min(static_cast<double>(maxAngle), SIMPLib::Constants::k_Pi)) * 1.001;
+      int numCells = std::max(static_cast<int>(std::min(2.0 / chord, 128.0)), 1);
+      float cellWidth = 2.0f / static_cast<float>(numCells);
+      for(int i = 0; i < 20; i++)
+      {
+        float q[3] = {-1.0f + cellWidth * static_cast<float>(generator() % (numCells + 1)), 0.0f, 0.0f};
+        q[1] = -1.0f + cellWidth * static_cast<float>(generator() % (numCells + 1));
+        float rest = 1.0f - q[0] * q[0] - q[1] * q[1];
+        if(rest < 0.0f)
+        {
+          q[1] = 0.0f;
+          rest = 1.0f - q[0] * q[0];
+        }
+        q[2] = (i % 2 == 0 ? 1.0f : -1.0f) * sqrtf(std::max(rest, 0.0f));
+        queries.insert(queries.end(), q, q + 3);
+      }
+      for(int i = 0; i < 60; i++)
+      {
+        float q[3] = {normal(generator), normal(generator), normal(generator)};
+        Normalize(q);
+        queries.insert(queries.end(), q, q + 3);
+      }
+
+      // Binned vectors: uniformly random ones, ones on the cell borders, and for every query a ring just inside and
+      // just outside of the cut-off angle
+      std::vector<float> vectors;
+      for(int i = 0; i < 2000; i++)
+      {
+        float v[3] = {normal(generator), normal(generator), normal(generator)};
+        Normalize(v);
+        vectors.insert(vectors.end(), v, v + 3);
+      }
+      for(int i = 0; i < 200; i++)
+      {
+        float border = -1.0f + cellWidth * static_cast<float>(generator() % (numCells + 1));
+        float radius = sqrtf(std::max(1.0f - border * border, 0.0f));
+        float phi = static_cast<float>(SIMPLib::Constants::k_Pi) * uniform(generator);
+        float v[3] = {border, radius * cosf(phi), radius * sinf(phi)};
+        std::swap(v[0], v[generator() % 3]);
+        vectors.insert(vectors.end(), v, v + 3);
+      }
+      for(size_t q = 0; q < queries.size() / 3; q++)
+      {
+        for(double factor : {0.999, 0.9999, 1.0001, 1.001})
+        {
+          AppendAtAngle(queries.data() + 3 * q, std::min(factor * maxAngle, SIMPLib::Constants::k_Pi), generator, vectors);
+        }
+      }
+      CompareWithBruteForce(maxAngle, vectors, queries);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestRandomNeighbors());
+  }
+
+public:
+  SphericalBinIndexTest(const SphericalBinIndexTest&) = delete;            // Copy Constructor Not Implemented
+  SphericalBinIndexTest(SphericalBinIndexTest&&) = delete;                 // Move Constructor Not Implemented
+  SphericalBinIndexTest& operator=(const SphericalBinIndexTest&) = delete; // Copy Assignment Not Implemented
+  SphericalBinIndexTest& operator=(SphericalBinIndexTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -62,6 +62,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 #include "ProcessingFilters/HelperClasses/DetectEllipsoidsImpl.h"
@@ -397,7 +399,7 @@ void DetectEllipsoids::execute()
     m_MaxFeatureId = m_TotalNumberOfFeatures;
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::task_scheduler_init init;
+    tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("DetectEllipsoids"));
     bool doParallel = true;
 
     if(doParallel)
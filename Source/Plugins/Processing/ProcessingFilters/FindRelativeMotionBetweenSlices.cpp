@@ -53,6 +53,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -325,7 +327,7 @@ void FindRelativeMotionBetweenSlices::execute()
   ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindRelativeMotionBetweenSlices"));
   bool doParallel = true;
 #endif
 
@@ -35,6 +35,16 @@
 
 #include "MinNeighbors.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -44,9 +54,164 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
+/**
+ * @brief The MinNeighborsVoteImpl class picks, for every unassigned voxel of a range of z slabs, the
+ * face neighbor whose feature is most common around it. It only reads the feature ids, so the slabs are
+ * independent; the number of unassigned voxels of each slab is stored so the caller knows when to stop.
+ */
+class MinNeighborsVoteImpl
+{
+public:
+  MinNeighborsVoteImpl(int32_t* featureIds, int32_t* neighbors, int64_t* dims, size_t slabSize, std::vector<size_t>& badCounts)
+  : m_FeatureIds(featureIds)
+  , m_Neighbors(neighbors)
+  , m_Dims(dims)
+  , m_SlabSize(slabSize)
+  , m_BadCounts(badCounts)
+  {
+  }
+  virtual ~MinNeighborsVoteImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      int64_t zStart = static_cast<int64_t>(slab * m_SlabSize);
+      int64_t zEnd = std::min(zStart + static_cast<int64_t>(m_SlabSize), m_Dims[2]);
+      m_BadCounts[slab] = vote(zStart, zEnd);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  int32_t* m_Neighbors = nullptr;
+  int64_t* m_Dims = nullptr;
+  size_t m_SlabSize = 1;
+  std::vector<size_t>& m_BadCounts;
+
+  size_t vote(int64_t zStart, int64_t zEnd) const
+  {
+    const int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    bool good[6] = {true, true, true, true, true, true};
+    int32_t features[6] = {0, 0, 0, 0, 0, 0};
+    int32_t counts[6] = {0, 0, 0, 0, 0, 0};
+    size_t counter = 0;
+
+    for(int64_t k = zStart; k < zEnd; k++)
+    {
+      good[0] = (k != 0);
+      good[5] = (k != m_Dims[2] - 1);
+      for(int64_t j = 0; j < m_Dims[1]; j++)
+      {
+        good[1] = (j != 0);
+        good[4] = (j != m_Dims[1] - 1);
+        int64_t rowStart = (k * m_Dims[1] + j) * m_Dims[0];
+        for(int64_t i = 0; i < m_Dims[0]; i++)
+        {
+          int64_t count = rowStart + i;
+          if(m_FeatureIds[count] >= 0)
+          {
+            continue;
+          }
+          counter++;
+          good[2] = (i != 0);
+          good[3] = (i != m_Dims[0] - 1);
+          int32_t numFeatures = 0;
+          int32_t most = 0;
+          for(int32_t l = 0; l < 6; l++)
+          {
+            if(!good[l])
+            {
+              continue;
+            }
+            int64_t neighpoint = count + neighpoints[l];
+            int32_t feature = m_FeatureIds[neighpoint];
+            if(feature < 0)
+            {
+              continue;
+            }
+            int32_t f = 0;
+            while(f < numFeatures && features[f] != feature)
+            {
+              f++;
+            }
+            if(f == numFeatures)
+            {
+              features[f] = feature;
+              counts[f] = 0;
+              numFeatures++;
+            }
+            counts[f]++;
+            if(counts[f] > most)
+            {
+              most = counts[f];
+              m_Neighbors[count] = static_cast<int32_t>(neighpoint);
+            }
+          }
+        }
+      }
+    }
+    return counter;
+  }
+};
+
+/**
+ * @brief The MinNeighborsFillImpl class copies every cell array from the chosen neighbor into each
+ * unassigned voxel of a range. The chosen neighbors were assigned when the votes were taken and are
+ * never written here, so the voxels can be filled in any order.
+ */
+class MinNeighborsFillImpl
+{
+public:
+  MinNeighborsFillImpl(int32_t* featureIds, int32_t* neighbors, const std::vector<IDataArray::Pointer>& arrays)
+  : m_FeatureIds(featureIds)
+  , m_Neighbors(neighbors)
+  , m_Arrays(arrays)
+  {
+  }
+  virtual ~MinNeighborsFillImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t j = start; j < end; j++)
+    {
+      int32_t featurename = m_FeatureIds[j];
+      int32_t neighbor = m_Neighbors[j];
+      if(featurename < 0 && neighbor >= 0 && m_FeatureIds[neighbor] >= 0)
+      {
+        for(const IDataArray::Pointer& p : m_Arrays)
+        {
+          p->copyTuple(neighbor, j);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  int32_t* m_Neighbors = nullptr;
+  const std::vector<IDataArray::Pointer>& m_Arrays;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -287,146 +452,62 @@ void MinNeighbors::assign_badpoints()
   m_Neighbors = neighborsPtr->getPointer(0);
   neighborsPtr->initializeWithValue(-1);
 
-  int32_t good = 1;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
+  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
+  {
+    voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+  }
+  std::vector<IDataArray::Pointer> voxelArrays;
+  for(const auto& arrayName : voxelArrayNames)
+  {
+    voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName));
+  }
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+  size_t zPoints = udims[2];
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("MinNeighbors"));
+  bool doParallel = true;
+  numSlabs = static_cast<size_t>(ParallelExecutionContext::Instance()->getThreadCount("MinNeighbors")) * 4;
+#endif
+  numSlabs = std::max(static_cast<size_t>(1), std::min(numSlabs, zPoints));
+  size_t slabSize = (zPoints + numSlabs - 1) / numSlabs;
+  numSlabs = (zPoints + slabSize - 1) / slabSize;
+  std::vector<size_t> badCounts(numSlabs, 0);
+
+  MinNeighborsVoteImpl voteImpl(m_FeatureIds, m_Neighbors, dims, slabSize, badCounts);
+  MinNeighborsFillImpl fillImpl(m_FeatureIds, m_Neighbors, voxelArrays);
 
   size_t counter = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t neighbor = 0;
-  QVector<int32_t> n(numfeatures + 1, 0);
   while(counter != 0)
   {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), voteImpl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      voteImpl.compute(0, numSlabs);
+    }
+
     counter = 0;
-    for(int64_t k = 0; k < dims[2]; k++)
+    for(size_t badCount : badCounts)
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if(featurename < 0)
-          {
-            counter++;
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature >= 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature >= 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
+      counter += badCount;
     }
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-    for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), fillImpl, tbb::auto_partitioner());
     }
-    for(size_t j = 0; j < totalPoints; j++)
+    else
+#endif
     {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(featurename < 0 && neighbor >= 0 && m_FeatureIds[neighbor] >= 0)
-      {
-        for(const auto& arrayName : voxelArrayNames)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-          p->copyTuple(neighbor, j);
-        }
-      }
+      fillImpl.compute(0, totalPoints);
     }
   }
 }
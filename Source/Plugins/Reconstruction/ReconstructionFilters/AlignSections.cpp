@@ -55,6 +55,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -290,7 +292,7 @@ void AlignSections::execute()
   find_shifts(xshifts, yshifts);
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("AlignSections"));
   bool doParallel = true;
 #endif
 
@@ -38,6 +38,13 @@
 #include <cmath>
 #include <fstream>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -46,9 +53,71 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The AlignSectionsFeatureCentroidImpl class computes the centroid of the masked voxels
+ * for a range of slices. The centroid of each slice is independent of every other slice.
+ */
+class AlignSectionsFeatureCentroidImpl
+{
+public:
+  AlignSectionsFeatureCentroidImpl(size_t* dims, bool* goodVoxels, float xRes, float yRes, std::vector<float>& xCentroid, std::vector<float>& yCentroid)
+  : m_Dims(dims)
+  , m_GoodVoxels(goodVoxels)
+  , m_XRes(xRes)
+  , m_YRes(yRes)
+  , m_XCentroid(xCentroid)
+  , m_YCentroid(yCentroid)
+  {
+  }
+  virtual ~AlignSectionsFeatureCentroidImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t iter = start; iter < end; iter++)
+    {
+      size_t count = 0;
+      float xCentroid = 0.0f;
+      float yCentroid = 0.0f;
+      size_t slice = static_cast<size_t>((m_Dims[2] - 1) - iter);
+      for(size_t l = 0; l < m_Dims[1]; l++)
+      {
+        for(size_t n = 0; n < m_Dims[0]; n++)
+        {
+          size_t point = ((slice)*m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+          if(m_GoodVoxels[point])
+          {
+            xCentroid = xCentroid + (static_cast<float>(n) * m_XRes);
+            yCentroid = yCentroid + (static_cast<float>(l) * m_YRes);
+            count++;
+          }
+        }
+      }
+      m_XCentroid[iter] = xCentroid / static_cast<float>(count);
+      m_YCentroid[iter] = yCentroid / static_cast<float>(count);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  size_t* m_Dims = nullptr;
+  bool* m_GoodVoxels = nullptr;
+  float m_XRes = 0.0f;
+  float m_YRes = 0.0f;
+  std::vector<float>& m_XCentroid;
+  std::vector<float>& m_YCentroid;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -185,9 +254,7 @@ void AlignSectionsFeatureCentroid::find_shifts(std::vector<int64_t>& xshifts, st
 
   size_t newxshift = 0;
   size_t newyshift = 0;
-  size_t count = 0;
   size_t slice = 0;
-  size_t point = 0;
   float xRes = 0.0f;
   float yRes = 0.0f;
   float zRes = 0.0f;
@@ -195,30 +262,23 @@ void AlignSectionsFeatureCentroid::find_shifts(std::vector<int64_t>& xshifts, st
   std::vector<float> xCentroid(dims[2], 0.0f);
   std::vector<float> yCentroid(dims[2], 0.0f);
 
-  for(size_t iter = 0; iter < dims[2]; iter++)
+  notifyStatusMessage(QObject::tr("Aligning Sections || Determining Shifts"));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("AlignSectionsFeatureCentroid"));
+  bool doParallel = true;
+#endif
+
+  AlignSectionsFeatureCentroidImpl impl(dims, m_GoodVoxels, xRes, yRes, xCentroid, yCentroid);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    count = 0;
-    xCentroid[iter] = 0;
-    yCentroid[iter] = 0;
-
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg((static_cast<double>(iter) / dims[2]) * 100);
-    notifyStatusMessage(ss);
-    slice = static_cast<size_t>((dims[2] - 1) - iter);
-    for(size_t l = 0; l < dims[1]; l++)
-    {
-      for(size_t n = 0; n < dims[0]; n++)
-      {
-        point = ((slice)*dims[0] * dims[1]) + (l * dims[0]) + n;
-        if(m_GoodVoxels[point])
-        {
-          xCentroid[iter] = xCentroid[iter] + (static_cast<float>(n) * xRes);
-          yCentroid[iter] = yCentroid[iter] + (static_cast<float>(l) * yRes);
-          count++;
-        }
-      }
-    }
-    xCentroid[iter] = xCentroid[iter] / static_cast<float>(count);
-    yCentroid[iter] = yCentroid[iter] / static_cast<float>(count);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, dims[2]), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.compute(0, dims[2]);
   }
 
   bool xWarning = false;
@@ -35,9 +35,18 @@
 
 #include "AlignSectionsMisorientation.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include <QtCore/QDateTime>
+#include <QtCore/QMutexLocker>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -47,9 +56,168 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The AlignSectionsMisorientationImpl class finds the relative shift between each slice and
+ * the slice above it. Each slice pair is independent of every other pair so a range of pairs
+ * can be processed on each thread.
+ */
+class AlignSectionsMisorientationImpl
+{
+public:
+  AlignSectionsMisorientationImpl(AlignSectionsMisorientation* filter, int64_t* dims, float* quats, int32_t* cellPhases, bool* goodVoxels, uint32_t* crystalStructures, float misorientationTolerance,
+                                  std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_Quats(reinterpret_cast<QuatF*>(quats))
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_CrystalStructures(crystalStructures)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_NewXShifts(newxshifts)
+  , m_NewYShifts(newyshifts)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+  virtual ~AlignSectionsMisorientationImpl() = default;
+
+  /**
+   * @brief compute Finds the shifts for the slice pairs in the range [start, end)
+   * @param start First iteration (1 based, counted from the top of the stack)
+   * @param end One past the last iteration
+   */
+  void compute(int64_t start, int64_t end) const
+  {
+    const int64_t halfDim0 = static_cast<int64_t>(m_Dims[0] * 0.5f);
+    const int64_t halfDim1 = static_cast<int64_t>(m_Dims[1] * 0.5f);
+    const int64_t sliceStride = m_Dims[0] * m_Dims[1];
+    const bool useGoodVoxels = (nullptr != m_GoodVoxels);
+    const uint32_t numOps = static_cast<uint32_t>(m_OrientationOps.size());
+
+    // Each range of slices gets its own visited table that is reused from pair to pair
+    std::vector<uint8_t> misorients(static_cast<size_t>(sliceStride), 0);
+
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      float mindisorientation = std::numeric_limits<float>::max();
+      int64_t slice = (m_Dims[2] - 1) - iter;
+      int64_t oldxshift = -1;
+      int64_t oldyshift = -1;
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+
+      std::fill(misorients.begin(), misorients.end(), 0);
+
+      const int64_t refSliceOffset = (slice + 1) * sliceStride;
+      const int64_t curSliceOffset = slice * sliceStride;
+
+      while(newxshift != oldxshift || newyshift != oldyshift)
+      {
+        oldxshift = newxshift;
+        oldyshift = newyshift;
+        for(int32_t j = -3; j < 4; j++)
+        {
+          for(int32_t k = -3; k < 4; k++)
+          {
+            float disorientation = 0.0f;
+            float count = 0.0f;
+            int64_t xIdx = k + oldxshift + halfDim0;
+            int64_t yIdx = j + oldyshift + halfDim1;
+            int64_t idx = (m_Dims[0] * yIdx) + xIdx;
+            if(llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1 && misorients[idx] == 0)
+            {
+              for(int64_t l = 0; l < m_Dims[1]; l = l + 4)
+              {
+                int64_t curRow = l + j + oldyshift;
+                if(curRow < 0 || curRow >= m_Dims[1])
+                {
+                  continue;
+                }
+                for(int64_t n = 0; n < m_Dims[0]; n = n + 4)
+                {
+                  int64_t curCol = n + k + oldxshift;
+                  if(curCol < 0 || curCol >= m_Dims[0])
+                  {
+                    continue;
+                  }
+                  count++;
+                  int64_t refposition = refSliceOffset + (l * m_Dims[0]) + n;
+                  int64_t curposition = curSliceOffset + (curRow * m_Dims[0]) + curCol;
+                  if(!useGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
+                  {
+                    float w = std::numeric_limits<float>::max();
+                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
+                    {
+                      uint32_t phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+                      uint32_t phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+                      if(phase1 == phase2 && phase1 < numOps)
+                      {
+                        QuaternionMathF::Copy(m_Quats[refposition], q1);
+                        QuaternionMathF::Copy(m_Quats[curposition], q2);
+                        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+                      }
+                    }
+                    if(w > m_MisorientationTolerance)
+                    {
+                      disorientation++;
+                    }
+                  }
+                  if(useGoodVoxels && m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+                  {
+                    disorientation++;
+                  }
+                }
+              }
+              disorientation = disorientation / count;
+              misorients[idx] = 1;
+              if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
+              {
+                newxshift = k + oldxshift;
+                newyshift = j + oldyshift;
+                mindisorientation = disorientation;
+              }
+            }
+          }
+        }
+      }
+      m_NewXShifts[iter] = newxshift;
+      m_NewYShifts[iter] = newyshift;
+      m_Filter->notifySliceCompleted();
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AlignSectionsMisorientation* m_Filter = nullptr;
+  int64_t* m_Dims = nullptr;
+  QuatF* m_Quats = nullptr;
+  int32_t* m_CellPhases = nullptr;
+  bool* m_GoodVoxels = nullptr;
+  uint32_t* m_CrystalStructures = nullptr;
+  float m_MisorientationTolerance = 0.0f;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -236,138 +404,46 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  uint32_t phase1 = 0, phase2 = 0;
-  int64_t progInt = 0;
-
-  // Allocate a 2D Array which will be reused from slice to slice
-  BoolArrayType::Pointer misorientsPtr = BoolArrayType::CreateArray(dims[0] * dims[1], "_INTERNAL_USE_ONLY_Misorients");
-  misorientsPtr->initializeWithValue(false);
-  bool* misorients = misorientsPtr->getPointer(0); // Get the raw pointer to use in our calculations for speed.
-
-  int64_t idx = 0; // This will be used to compute the index into the flat array
-  int64_t xIdx = 0;
-  int64_t yIdx = 0;
-
-  const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
-  const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
-
-  // Loop over the Z Direction
-  for(int64_t iter = 1; iter < dims[2]; iter++)
-  {
-    progInt = ((float)iter / dims[2]) * 100.0f;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(ss);
-    if(getCancel())
-    {
-      return;
-    }
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
+  // The shift between each pair of adjacent slices only depends on those two slices, so
+  // every pair is registered independently and the shifts are accumulated afterwards.
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
 
-    misorientsPtr->initializeWithValue(false); // Initialize everything to false
+  m_SlicesCompleted = 0;
+  m_TotalSlices = dims[2];
 
-    float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
+  float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
 
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          xIdx = k + oldxshift + halfDim0;
-          yIdx = j + oldyshift + halfDim1;
-          idx = (dims[0] * yIdx) + xIdx;
-          if(!misorients[idx] && llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1)
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
-                  {
-                    w = std::numeric_limits<float>::max();
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-                      QuaternionMathF::Copy(quats[refposition], q1);
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      QuaternionMathF::Copy(quats[curposition], q2);
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
-                      {
-                        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                      }
-                    }
-                    if(w > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels)
-                  {
-                    if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                    if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            xIdx = k + oldxshift + halfDim0;
-            yIdx = j + oldyshift + halfDim1;
-            idx = (dims[0] * yIdx) + xIdx;
-            misorients[idx] = true;
-            if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("AlignSectionsMisorientation"));
+  bool doParallel = true;
+#endif
+
+  AlignSectionsMisorientationImpl impl(this, dims, m_Quats, m_CellPhases, m_UseGoodVoxels ? m_GoodVoxels : nullptr, m_CrystalStructures, misorientationTolerance, newxshifts, newyshifts);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(1, dims[2], 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.compute(1, dims[2]);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
   }
   if(getWriteAlignmentShifts())
@@ -395,6 +471,18 @@ void AlignSectionsMisorientation::execute()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsMisorientation::notifySliceCompleted()
+{
+  QMutexLocker locker(&m_SlicesCompletedMutex);
+  m_SlicesCompleted++;
+  int64_t progInt = static_cast<int64_t>((static_cast<float>(m_SlicesCompleted) / m_TotalSlices) * 100.0f);
+  QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
+  notifyStatusMessage(ss);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
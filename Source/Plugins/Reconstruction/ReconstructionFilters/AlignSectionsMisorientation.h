@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <QtCore/QMutex>
+
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
@@ -148,6 +150,12 @@ public:
   */
   void preflight() override;
 
+  /**
+   * @brief notifySliceCompleted Reports the progress of the shift search. It is called by the search
+   * threads once each pair of slices has been registered.
+   */
+  void notifySliceCompleted();
+
 protected:
   AlignSectionsMisorientation();
   /**
@@ -173,6 +181,10 @@ private:
 
   QVector<LaueOps::Pointer> m_OrientationOps;
 
+  QMutex m_SlicesCompletedMutex;
+  int64_t m_SlicesCompleted = 0;
+  int64_t m_TotalSlices = 0;
+
   uint64_t m_RandomSeed;
 
 public:
@@ -34,8 +34,18 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
 
+#include <QtCore/QMutexLocker>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -45,9 +55,165 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The AlignSectionsMutualInformationImpl class finds the relative shift between each section and
+ * the section above it by maximizing the mutual information of the per-section feature ids. Each pair
+ * of sections is independent so a range of pairs can be processed on each thread.
+ */
+class AlignSectionsMutualInformationImpl
+{
+public:
+  AlignSectionsMutualInformationImpl(AlignSectionsMutualInformation* filter, int64_t* dims, int32_t* miFeatureIds, int32_t* featureCounts, std::vector<int64_t>& newxshifts,
+                                     std::vector<int64_t>& newyshifts)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featureCounts)
+  , m_NewXShifts(newxshifts)
+  , m_NewYShifts(newyshifts)
+  {
+  }
+  virtual ~AlignSectionsMutualInformationImpl() = default;
+
+  void compute(int64_t start, int64_t end) const
+  {
+    // The visited table and the histograms are reused from pair to pair within this range
+    // The search is bounded by |x shift| < dims[0] / 2 but only by y shift < dims[1] / 2. Shifts with no
+    // overlap between the sections never win, so y never goes below -(dims[1] + 3) and the visited table
+    // covers y shifts in [-yOffset, dims[1] / 2).
+    const int64_t yOffset = m_Dims[1] + 3;
+    const int64_t yExtent = yOffset + m_Dims[1] / 2;
+    std::vector<float> misorients(static_cast<size_t>(m_Dims[0] * yExtent), 0.0f);
+    std::vector<float> mutualinfo12;
+    std::vector<float> mutualinfo1;
+    std::vector<float> mutualinfo2;
+
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      float mindisorientation = std::numeric_limits<float>::max();
+      int64_t slice = (m_Dims[2] - 1) - iter;
+      int32_t featurecount1 = m_FeatureCounts[slice];
+      int32_t featurecount2 = m_FeatureCounts[slice + 1];
+      mutualinfo12.assign(static_cast<size_t>(featurecount1) * featurecount2, 0.0f);
+      mutualinfo1.assign(featurecount1, 0.0f);
+      mutualinfo2.assign(featurecount2, 0.0f);
+
+      int64_t oldxshift = -1;
+      int64_t oldyshift = -1;
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+      std::fill(misorients.begin(), misorients.end(), 0.0f);
+
+      while(newxshift != oldxshift || newyshift != oldyshift)
+      {
+        oldxshift = newxshift;
+        oldyshift = newyshift;
+        for(int32_t j = -3; j < 4; j++)
+        {
+          for(int32_t k = -3; k < 4; k++)
+          {
+            float disorientation = 0.0f;
+            float count = 0.0f;
+            size_t misIdx = (k + oldxshift + m_Dims[0] / 2) * yExtent + (j + oldyshift + yOffset);
+            if(llabs(k + oldxshift) < (m_Dims[0] / 2) && (j + oldyshift) < (m_Dims[1] / 2) && (j + oldyshift) >= -yOffset && misorients[misIdx] == 0)
+            {
+              for(int64_t l = 0; l < m_Dims[1]; l = l + 4)
+              {
+                for(int64_t n = 0; n < m_Dims[0]; n = n + 4)
+                {
+                  if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < m_Dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < m_Dims[0])
+                  {
+                    int64_t refposition = ((slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+                    int64_t curposition = (slice * m_Dims[0] * m_Dims[1]) + ((l + j + oldyshift) * m_Dims[0]) + (n + k + oldxshift);
+                    int32_t refgnum = m_MIFeatureIds[refposition];
+                    int32_t curgnum = m_MIFeatureIds[curposition];
+                    if(curgnum >= 0 && refgnum >= 0)
+                    {
+                      mutualinfo12[curgnum * featurecount2 + refgnum]++;
+                      mutualinfo1[curgnum]++;
+                      mutualinfo2[refgnum]++;
+                      count++;
+                    }
+                  }
+                  else
+                  {
+                    mutualinfo12[0]++;
+                    mutualinfo1[0]++;
+                    mutualinfo2[0]++;
+                  }
+                }
+              }
+              for(int32_t b = 0; b < featurecount1; b++)
+              {
+                mutualinfo1[b] = mutualinfo1[b] / count;
+              }
+              for(int32_t c = 0; c < featurecount2; c++)
+              {
+                mutualinfo2[c] = mutualinfo2[c] / count;
+              }
+              for(int32_t b = 0; b < featurecount1; b++)
+              {
+                float* row = mutualinfo12.data() + static_cast<size_t>(b) * featurecount2;
+                for(int32_t c = 0; c < featurecount2; c++)
+                {
+                  row[c] = row[c] / count;
+                  float value = 0.0f;
+                  if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
+                  {
+                    value = (row[c] / (mutualinfo1[b] * mutualinfo2[c]));
+                  }
+                  if(value != 0)
+                  {
+                    disorientation = disorientation + (row[c] * logf(value));
+                  }
+                }
+              }
+              std::fill(mutualinfo12.begin(), mutualinfo12.end(), 0.0f);
+              std::fill(mutualinfo1.begin(), mutualinfo1.end(), 0.0f);
+              std::fill(mutualinfo2.begin(), mutualinfo2.end(), 0.0f);
+              disorientation = 1.0f / disorientation;
+              misorients[misIdx] = disorientation;
+              if(disorientation < mindisorientation)
+              {
+                newxshift = k + oldxshift;
+                newyshift = j + oldyshift;
+                mindisorientation = disorientation;
+              }
+            }
+          }
+        }
+      }
+      m_NewXShifts[iter] = newxshift;
+      m_NewYShifts[iter] = newyshift;
+      m_Filter->notifySliceCompleted();
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  AlignSectionsMutualInformation* m_Filter = nullptr;
+  int64_t* m_Dims = nullptr;
+  int32_t* m_MIFeatureIds = nullptr;
+  int32_t* m_FeatureCounts = nullptr;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -239,180 +405,42 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
   form_features_sections();
 
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
+  // Once the features have been identified on each section, the shift between each pair of
+  // adjacent sections only depends on those two sections so the pairs are registered independently.
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+
+  m_SlicesCompleted = 0;
+  m_TotalSlices = dims[2];
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("AlignSectionsMutualInformation"));
+  bool doParallel = true;
+#endif
+
+  AlignSectionsMutualInformationImpl impl(this, dims, miFeatureIds, featurecounts, newxshifts, newyshifts);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(1, dims[2], 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
   {
-    misorients[a].assign(dims[1], 0.0f);
+    impl.compute(1, dims[2]);
   }
 
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    float prog = ((float)iter / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
-    }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
@@ -607,6 +635,18 @@ void AlignSectionsMutualInformation::execute()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsMutualInformation::notifySliceCompleted()
+{
+  QMutexLocker locker(&m_SlicesCompletedMutex);
+  m_SlicesCompleted++;
+  int64_t progInt = static_cast<int64_t>((static_cast<float>(m_SlicesCompleted) / m_TotalSlices) * 100.0f);
+  QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
+  notifyStatusMessage(ss);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <QtCore/QMutex>
+
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
@@ -150,6 +152,12 @@ public:
   */
   void preflight() override;
 
+  /**
+   * @brief notifySliceCompleted Reports the progress of the shift search. It is called by the search
+   * threads once each pair of slices has been registered.
+   */
+  void notifySliceCompleted();
+
 protected:
   AlignSectionsMutualInformation();
   /**
@@ -181,6 +189,10 @@ private:
 
   QVector<LaueOps::Pointer> m_OrientationOps;
 
+  QMutex m_SlicesCompletedMutex;
+  int64_t m_SlicesCompleted = 0;
+  int64_t m_TotalSlices = 0;
+
   Int32ArrayType::Pointer m_MIFeaturesPtr;
   uint64_t m_RandomSeed;
 
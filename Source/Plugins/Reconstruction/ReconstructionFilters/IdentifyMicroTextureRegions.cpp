@@ -58,6 +58,7 @@
 #include "SIMPLib/Math/GeometryMath.h"
 
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "EbsdLib/EbsdConstants.h"
 
@@ -589,7 +590,7 @@ void IdentifyMicroTextureRegions::execute()
   m_CAxisToleranceRad = m_CAxisTolerance * SIMPLib::Constants::k_Pi / 180.0f;
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("IdentifyMicroTextureRegions"));
   bool doParallel = true;
 #endif
 
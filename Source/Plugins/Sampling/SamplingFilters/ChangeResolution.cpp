@@ -35,20 +35,99 @@
 
 #include "ChangeResolution.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/HelperClasses/ImageResampler.h"
 #include "Sampling/SamplingVersion.h"
 
+/**
+ * @brief The ChangeResolutionMapImpl class fills the resampling index map for a range of planes
+ * of the new geometry
+ */
+class ChangeResolutionMapImpl
+{
+public:
+  ChangeResolutionMapImpl(ImageResampler* resampler, const size_t srcDims[3], const FloatVec3Type& srcRes, const size_t newDims[3], const FloatVec3Type& newRes)
+  : m_Resampler(resampler)
+  , m_SrcRes(srcRes)
+  , m_NewRes(newRes)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_SrcDims[d] = srcDims[d];
+      m_NewDims[d] = newDims[d];
+    }
+  }
+
+  virtual ~ChangeResolutionMapImpl() = default;
+
+  void compute(size_t zStart, size_t zEnd) const
+  {
+    int64_t* newindicies = m_Resampler->getIndices();
+    bool nearest = (m_Resampler->getStencilSize() == 1);
+    for(size_t i = zStart; i < zEnd; i++)
+    {
+      for(size_t j = 0; j < m_NewDims[1]; j++)
+      {
+        for(size_t k = 0; k < m_NewDims[0]; k++)
+        {
+          size_t index = (i * m_NewDims[0] * m_NewDims[1]) + (j * m_NewDims[0]) + k;
+          if(nearest)
+          {
+            size_t col = size_t((k * m_NewRes[0]) / m_SrcRes[0]);
+            size_t row = size_t((j * m_NewRes[1]) / m_SrcRes[1]);
+            size_t plane = size_t((i * m_NewRes[2]) / m_SrcRes[2]);
+            newindicies[index] = static_cast<int64_t>((plane * m_SrcDims[1] * m_SrcDims[0]) + (row * m_SrcDims[0]) + col);
+          }
+          else
+          {
+            // Sample at the center of the new cell, in units of old cells
+            float u = ((k + 0.5f) * m_NewRes[0]) / m_SrcRes[0] - 0.5f;
+            float v = ((j + 0.5f) * m_NewRes[1]) / m_SrcRes[1] - 0.5f;
+            float w = ((i + 0.5f) * m_NewRes[2]) / m_SrcRes[2] - 0.5f;
+            m_Resampler->setSamplePoint(index, u, v, w, m_SrcDims);
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  ImageResampler* m_Resampler;
+  size_t m_SrcDims[3];
+  FloatVec3Type m_SrcRes;
+  size_t m_NewDims[3];
+  FloatVec3Type m_NewRes;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -59,6 +138,7 @@ ChangeResolution::ChangeResolution()
 , m_RenumberFeatures(true)
 , m_SaveAsNewDataContainer(false)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
+, m_InterpolationMethod(0)
 {
   m_Spacing[0] = 1.0f;
   m_Spacing[1] = 1.0f;
@@ -77,6 +157,18 @@ void ChangeResolution::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Spacing", Spacing, FilterParameter::Parameter, ChangeResolution));
+  {
+    QVector<QString> choices;
+    choices.push_back("Nearest Neighbor");
+    choices.push_back("Trilinear");
+    choices.push_back("Majority Vote");
+    parameters.push_back(SIMPL_NEW_CHOICE_FP("Interpolation Method", InterpolationMethod, FilterParameter::Parameter, ChangeResolution, choices, false));
+  }
+  {
+    MultiDataArraySelectionFilterParameter::RequirementType req =
+        MultiDataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_MDA_SELECTION_FP("Arrays Never Interpolated (Majority Vote)", VotedArrayPaths, FilterParameter::Parameter, ChangeResolution, req));
+  }
 
   QStringList linkedProps;
   linkedProps << "CellFeatureAttributeMatrixPath"
@@ -118,6 +210,8 @@ void ChangeResolution::readFilterParameters(AbstractFilterParametersReader* read
   setSpacing(reader->readFloatVec3("Spacing", getSpacing()));
   setRenumberFeatures(reader->readValue("RenumberFeatures", getRenumberFeatures()));
   setSaveAsNewDataContainer(reader->readValue("SaveAsNewDataContainer", getSaveAsNewDataContainer()));
+  setInterpolationMethod(reader->readValue("InterpolationMethod", getInterpolationMethod()));
+  setVotedArrayPaths(reader->readDataArrayPathVector("VotedArrayPaths", getVotedArrayPaths()));
   reader->closeFilterGroup();
 }
 
@@ -154,6 +248,12 @@ void ChangeResolution::dataCheck()
     setErrorCondition(-5557, ss);
   }
 
+  if(getInterpolationMethod() < 0 || getInterpolationMethod() > 2)
+  {
+    QString ss = QObject::tr("The interpolation method (%1) must be 0 (Nearest Neighbor), 1 (Trilinear) or 2 (Majority Vote)").arg(getInterpolationMethod());
+    setErrorCondition(-5558, ss);
+  }
+
   if(!getSaveAsNewDataContainer())
   {
     getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getCellAttributeMatrixPath().getDataContainerName());
@@ -166,6 +266,17 @@ void ChangeResolution::dataCheck()
 
   getDataContainerArray()->getPrereqAttributeMatrixFromPath<AbstractFilter>(this, getCellAttributeMatrixPath(), -301);
 
+  for(const DataArrayPath& path : getVotedArrayPaths())
+  {
+    if(path.getDataContainerName() != getCellAttributeMatrixPath().getDataContainerName() || path.getAttributeMatrixName() != getCellAttributeMatrixPath().getAttributeMatrixName())
+    {
+      QString ss = QObject::tr("The array '%1' that is never interpolated must be in the Cell Attribute Matrix '%2'").arg(path.serialize("/"), getCellAttributeMatrixPath().serialize("/"));
+      setErrorCondition(-5559, ss);
+      continue;
+    }
+    getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, path);
+  }
+
   if(getRenumberFeatures())
   {
     QVector<size_t> cDims(1, 1);
@@ -342,74 +453,49 @@ void ChangeResolution::execute()
     m_ZP = 1;
   }
   size_t totalPoints = m_XP * m_YP * m_ZP;
-
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  size_t col = 0, row = 0, plane = 0;
-  size_t index = 0;
-  size_t index_old = 0;
-  size_t progressInt = 0;
-  std::vector<size_t> newindicies(totalPoints);
+  size_t newDims[3] = {m_XP, m_YP, m_ZP};
   FloatVec3Type res = {0.0f, 0.0f, 0.0f};
   m->getGeometryAs<ImageGeom>()->getSpacing(res);
 
-  for(size_t i = 0; i < m_ZP; i++)
+  QString ss = QObject::tr("Changing Spacing...");
+  notifyStatusMessage(ss);
+
+  ImageResampler resampler(totalPoints, static_cast<ImageResampler::Method>(m_InterpolationMethod));
+  QStringList votedArrays;
+  for(const DataArrayPath& path : m_VotedArrayPaths)
   {
-    if(getCancel())
-    {
-      break;
-    }
-    progressInt = static_cast<size_t>((static_cast<float>(i) / m_ZP) * 100.0f);
-    QString ss = QObject::tr("Changing Spacing || %1% Complete").arg(progressInt);
-    notifyStatusMessage(ss);
-    for(size_t j = 0; j < m_YP; j++)
-    {
-      for(size_t k = 0; k < m_XP; k++)
-      {
-        x = (k * m_Spacing[0]);
-        y = (j * m_Spacing[1]);
-        z = (i * m_Spacing[2]);
-        col = size_t(x / res[0]);
-        row = size_t(y / res[1]);
-        plane = size_t(z / res[2]);
-        index_old = (plane * dims[1] * dims[0]) + (row * dims[0]) + col;
-        index = (i * m_XP * m_YP) + (j * m_XP) + k;
-        newindicies[index] = index_old;
-      }
-    }
+    votedArrays.push_back(path.getDataArrayName());
+  }
+  resampler.setVotedArrays(votedArrays);
+  ChangeResolutionMapImpl mapImpl(&resampler, dims, res, newDims, m_Spacing);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("ChangeResolution"));
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_ZP), mapImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    mapImpl.compute(0, m_ZP);
+  }
+  if(getCancel())
+  {
+    return;
   }
-
-  QString ss = QObject::tr("Copying Data...");
-  notifyStatusMessage(ss);
 
   QVector<size_t> tDims(3, 0);
   tDims[0] = m_XP;
   tDims[1] = m_YP;
   tDims[2] = m_ZP;
   AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
-
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  resampler.gatherAttributeMatrix(cellAttrMat, newCellAttrMat, true, this);
+  if(getCancel())
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory.
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resizeTuples(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->insertOrAssign(data);
+    return;
   }
+
   m->getGeometryAs<ImageGeom>()->setSpacing(std::make_tuple(m_Spacing[0], m_Spacing[1], m_Spacing[2]));
   m->getGeometryAs<ImageGeom>()->setDimensions(std::make_tuple(m_XP, m_YP, m_ZP));
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
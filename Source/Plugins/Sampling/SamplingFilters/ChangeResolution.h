@@ -56,6 +56,8 @@ class Sampling_EXPORT ChangeResolution : public AbstractFilter
     PYB11_PROPERTY(bool RenumberFeatures READ getRenumberFeatures WRITE setRenumberFeatures)
     PYB11_PROPERTY(bool SaveAsNewDataContainer READ getSaveAsNewDataContainer WRITE setSaveAsNewDataContainer)
     PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
+    PYB11_PROPERTY(int InterpolationMethod READ getInterpolationMethod WRITE setInterpolationMethod)
+    PYB11_PROPERTY(QVector<DataArrayPath> VotedArrayPaths READ getVotedArrayPaths WRITE setVotedArrayPaths)
 public:
   SIMPL_SHARED_POINTERS(ChangeResolution)
   SIMPL_FILTER_NEW_MACRO(ChangeResolution)
@@ -84,6 +86,12 @@ public:
   SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureIdsArrayPath)
   Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 
+  SIMPL_FILTER_PARAMETER(int, InterpolationMethod)
+  Q_PROPERTY(int InterpolationMethod READ getInterpolationMethod WRITE setInterpolationMethod)
+
+  SIMPL_FILTER_PARAMETER(QVector<DataArrayPath>, VotedArrayPaths)
+  Q_PROPERTY(QVector<DataArrayPath> VotedArrayPaths READ getVotedArrayPaths WRITE setVotedArrayPaths)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
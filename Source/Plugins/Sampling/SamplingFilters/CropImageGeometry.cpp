@@ -35,6 +35,13 @@
 
 #include "CropImageGeometry.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -49,9 +56,64 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/HelperClasses/ImageResampler.h"
 #include "Sampling/SamplingVersion.h"
 
+/**
+ * @brief The CropImageGeometryMapImpl class fills the index map from the cropped geometry back
+ * into the source geometry for a range of planes
+ */
+class CropImageGeometryMapImpl
+{
+public:
+  CropImageGeometryMapImpl(int64_t* newindicies, const int64_t srcDims[3], const int64_t newDims[3], const int64_t minIndex[3])
+  : m_NewIndicies(newindicies)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_SrcDims[d] = srcDims[d];
+      m_NewDims[d] = newDims[d];
+      m_MinIndex[d] = minIndex[d];
+    }
+  }
+
+  virtual ~CropImageGeometryMapImpl() = default;
+
+  void compute(int64_t zStart, int64_t zEnd) const
+  {
+    for(int64_t i = zStart; i < zEnd; i++)
+    {
+      int64_t planeold = (i + m_MinIndex[2]) * (m_SrcDims[0] * m_SrcDims[1]);
+      int64_t plane = (i * m_NewDims[0] * m_NewDims[1]);
+      for(int64_t j = 0; j < m_NewDims[1]; j++)
+      {
+        int64_t rowold = (j + m_MinIndex[1]) * m_SrcDims[0];
+        int64_t row = (j * m_NewDims[0]);
+        for(int64_t k = 0; k < m_NewDims[0]; k++)
+        {
+          m_NewIndicies[plane + row + k] = planeold + rowold + (k + m_MinIndex[0]);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int64_t* m_NewIndicies;
+  int64_t m_SrcDims[3];
+  int64_t m_NewDims[3];
+  int64_t m_MinIndex[3];
+};
+
 enum createdPathID : RenameDataPath::DataID_t
 {
   DataContainerID = 1
@@ -416,10 +478,6 @@ void CropImageGeometry::execute()
 
     destCellDataContainer->getGeometryAs<ImageGeom>()->setOrigin(o);
     destCellDataContainer->getGeometryAs<ImageGeom>()->setSpacing(r);
-
-    AttributeMatrix::Pointer cellAttrMatCopy = cellAttrMat->deepCopy(false);
-    destCellDataContainer->addOrReplaceAttributeMatrix(cellAttrMatCopy);
-    cellAttrMat = destCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   }
 
   if(nullptr == destCellDataContainer.get() || nullptr == cellAttrMat.get() || getErrorCode() < 0)
@@ -440,6 +498,10 @@ void CropImageGeometry::execute()
   // Check to see if the dims have actually changed.
   if(dims[0] == (m_XMax - m_XMin) && dims[1] == (m_YMax - m_YMin) && dims[2] == (m_ZMax - m_ZMin))
   {
+    if(m_SaveAsNewDataContainer)
+    {
+      destCellDataContainer->addOrReplaceAttributeMatrix(cellAttrMat->deepCopy(false));
+    }
     return;
   }
 
@@ -482,50 +544,49 @@ void CropImageGeometry::execute()
   int64_t YP = ((m_YMax - m_YMin) + 1);
   int64_t ZP = ((m_ZMax - m_ZMin) + 1);
 
-  int64_t col = 0, row = 0, plane = 0;
-  int64_t colold = 0, rowold = 0, planeold = 0;
-  int64_t index = 0;
-  int64_t index_old = 0;
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(int64_t i = 0; i < ZP; i++)
+  int64_t srcDims[3] = {dims[0], dims[1], dims[2]};
+  int64_t newDims[3] = {XP, YP, ZP};
+  int64_t minIndex[3] = {m_XMin, m_YMin, m_ZMin};
+
+  QString ss = QObject::tr("Cropping Volume...");
+  notifyStatusMessage(ss);
+
+  ImageResampler resampler(static_cast<size_t>(XP * YP * ZP), ImageResampler::Method::NearestNeighbor);
+  CropImageGeometryMapImpl mapImpl(resampler.getIndices(), srcDims, newDims, minIndex);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("CropImageGeometry"));
+  bool doParallel = true;
+  if(doParallel)
   {
-    if(getCancel())
-    {
-      break;
-    }
-    QString ss = QObject::tr("Cropping Volume || Slice %1 of %2 Complete").arg(i).arg(ZP);
-    notifyStatusMessage(ss);
-    planeold = (i + m_ZMin) * (srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints() * srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
-    plane = (i * XP * YP);
-    for(int64_t j = 0; j < YP; j++)
-    {
-      rowold = (j + m_YMin) * srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints();
-      row = (j * XP);
-      for(int64_t k = 0; k < XP; k++)
-      {
-        colold = (k + m_XMin);
-        col = k;
-        index_old = planeold + rowold + colold;
-        index = plane + row + col;
-        for(const auto& arrayName : voxelArrayNames)
-        {
-          IDataArray::Pointer p = cellAttrMat->getAttributeArray(arrayName);
-          p->copyTuple(index_old, index);
-        }
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, ZP), mapImpl, tbb::auto_partitioner());
   }
-  if(getCancel())
+  else
+#endif
   {
-    return;
+    mapImpl.compute(0, ZP);
   }
-  destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
-  totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
+
   QVector<size_t> tDims(3, 0);
   tDims[0] = XP;
   tDims[1] = YP;
   tDims[2] = ZP;
-  cellAttrMat->setTupleDimensions(tDims); // THIS WILL CAUSE A RESIZE of all the underlying data arrays.
+
+  // The source arrays are only released when they are cropped in place; a new Data Container leaves them untouched
+  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
+  resampler.gatherAttributeMatrix(cellAttrMat, newCellAttrMat, !m_SaveAsNewDataContainer, this);
+  if(getCancel())
+  {
+    return;
+  }
+  if(!m_SaveAsNewDataContainer)
+  {
+    destCellDataContainer->removeAttributeMatrix(cellAttrMat->getName());
+  }
+  destCellDataContainer->addOrReplaceAttributeMatrix(newCellAttrMat);
+  cellAttrMat = newCellAttrMat;
+
+  destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
+  totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
 
   if(m_RenumberFeatures)
   {
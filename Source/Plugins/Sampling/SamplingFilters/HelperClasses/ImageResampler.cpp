@@ -0,0 +1,417 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ImageResampler.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
+namespace
+{
+const size_t k_TrilinearStencilSize = 8;
+
+/**
+ * @brief The ResampleGatherImpl class gathers the tuples of one array through the index map
+ */
+template <typename T> class ResampleGatherImpl
+{
+public:
+  ResampleGatherImpl(const T* source, T* destination, size_t numComp, const int64_t* indices, const float* weights, size_t stencilSize, bool interpolate)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_NumComp(numComp)
+  , m_Indices(indices)
+  , m_Weights(weights)
+  , m_StencilSize(stencilSize)
+  , m_Interpolate(interpolate)
+  {
+  }
+
+  virtual ~ResampleGatherImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    if(m_StencilSize == 1)
+    {
+      for(size_t i = start; i < end; i++)
+      {
+        T* dest = m_Destination + i * m_NumComp;
+        int64_t index = m_Indices[i];
+        if(index < 0)
+        {
+          std::fill(dest, dest + m_NumComp, static_cast<T>(0));
+        }
+        else
+        {
+          const T* src = m_Source + static_cast<size_t>(index) * m_NumComp;
+          std::copy(src, src + m_NumComp, dest);
+        }
+      }
+    }
+    else if(m_Interpolate)
+    {
+      for(size_t i = start; i < end; i++)
+      {
+        interpolateTuple(i);
+      }
+    }
+    else
+    {
+      for(size_t i = start; i < end; i++)
+      {
+        voteTuple(i);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  void interpolateTuple(size_t i) const
+  {
+    const int64_t* indices = m_Indices + i * m_StencilSize;
+    const float* weights = m_Weights + i * m_StencilSize;
+    T* dest = m_Destination + i * m_NumComp;
+    for(size_t c = 0; c < m_NumComp; c++)
+    {
+      double sum = 0.0;
+      double totalWeight = 0.0;
+      for(size_t s = 0; s < m_StencilSize; s++)
+      {
+        if(indices[s] >= 0)
+        {
+          sum += static_cast<double>(weights[s]) * static_cast<double>(m_Source[static_cast<size_t>(indices[s]) * m_NumComp + c]);
+          totalWeight += weights[s];
+        }
+      }
+      dest[c] = static_cast<T>(totalWeight > 0.0 ? sum / totalWeight : 0.0);
+    }
+  }
+
+  bool sameTuple(int64_t a, int64_t b) const
+  {
+    if(a == b)
+    {
+      return true;
+    }
+    const T* ta = m_Source + static_cast<size_t>(a) * m_NumComp;
+    const T* tb = m_Source + static_cast<size_t>(b) * m_NumComp;
+    return std::equal(ta, ta + m_NumComp, tb);
+  }
+
+  void voteTuple(size_t i) const
+  {
+    const int64_t* indices = m_Indices + i * m_StencilSize;
+    const float* weights = m_Weights + i * m_StencilSize;
+    int64_t winner = -1;
+    float winnerWeight = -1.0f;
+    for(size_t a = 0; a < m_StencilSize; a++)
+    {
+      if(indices[a] < 0)
+      {
+        continue;
+      }
+      float weight = 0.0f;
+      for(size_t b = 0; b < m_StencilSize; b++)
+      {
+        if(indices[b] >= 0 && sameTuple(indices[a], indices[b]))
+        {
+          weight += weights[b];
+        }
+      }
+      if(weight > winnerWeight)
+      {
+        winner = indices[a];
+        winnerWeight = weight;
+      }
+    }
+
+    T* dest = m_Destination + i * m_NumComp;
+    if(winner < 0)
+    {
+      std::fill(dest, dest + m_NumComp, static_cast<T>(0));
+    }
+    else
+    {
+      const T* src = m_Source + static_cast<size_t>(winner) * m_NumComp;
+      std::copy(src, src + m_NumComp, dest);
+    }
+  }
+
+  const T* m_Source;
+  T* m_Destination;
+  size_t m_NumComp;
+  const int64_t* m_Indices;
+  const float* m_Weights;
+  size_t m_StencilSize;
+  bool m_Interpolate;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+bool gatherTypedArray(const IDataArray::Pointer& source, const IDataArray::Pointer& destination, size_t numTuples, const int64_t* indices, const float* weights, size_t stencilSize,
+                      ImageResampler::Method method)
+{
+  typename DataArray<T>::Pointer src = std::dynamic_pointer_cast<DataArray<T>>(source);
+  typename DataArray<T>::Pointer dest = std::dynamic_pointer_cast<DataArray<T>>(destination);
+  if(nullptr == src.get() || nullptr == dest.get())
+  {
+    return false;
+  }
+  if(numTuples == 0)
+  {
+    return true;
+  }
+
+  bool interpolate = (method == ImageResampler::Method::Trilinear && std::is_floating_point<T>::value);
+  ResampleGatherImpl<T> impl(src->getPointer(0), dest->getPointer(0), static_cast<size_t>(src->getNumberOfComponents()), indices, weights, stencilSize, interpolate);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("ImageResampler"));
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTuples), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.compute(0, numTuples);
+  }
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImageResampler::ImageResampler(size_t numTuples, Method method)
+: m_NumTuples(numTuples)
+, m_Method(method)
+{
+  m_StencilSize = (method == Method::NearestNeighbor) ? 1 : k_TrilinearStencilSize;
+  m_Indices.resize(m_NumTuples * m_StencilSize, -1);
+  if(m_StencilSize > 1)
+  {
+    m_Weights.resize(m_NumTuples * m_StencilSize, 0.0f);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImageResampler::~ImageResampler() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ImageResampler::getStencilSize() const
+{
+  return m_StencilSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ImageResampler::getNumberOfTuples() const
+{
+  return m_NumTuples;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t* ImageResampler::getIndices()
+{
+  return m_Indices.data();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float* ImageResampler::getWeights()
+{
+  return m_Weights.data();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageResampler::setSamplePoint(size_t destIndex, float u, float v, float w, const size_t srcDims[3])
+{
+  float p[3] = {u, v, w};
+  size_t lo[3] = {0, 0, 0};
+  size_t hi[3] = {0, 0, 0};
+  float frac[3] = {0.0f, 0.0f, 0.0f};
+  for(size_t d = 0; d < 3; d++)
+  {
+    float maxPos = static_cast<float>(srcDims[d] - 1);
+    p[d] = std::max(0.0f, std::min(p[d], maxPos));
+    lo[d] = static_cast<size_t>(std::floor(p[d]));
+    hi[d] = std::min(lo[d] + 1, srcDims[d] - 1);
+    frac[d] = p[d] - static_cast<float>(lo[d]);
+  }
+
+  int64_t* indices = m_Indices.data() + destIndex * m_StencilSize;
+  if(m_StencilSize == 1)
+  {
+    size_t col = frac[0] < 0.5f ? lo[0] : hi[0];
+    size_t row = frac[1] < 0.5f ? lo[1] : hi[1];
+    size_t plane = frac[2] < 0.5f ? lo[2] : hi[2];
+    indices[0] = static_cast<int64_t>((plane * srcDims[1] + row) * srcDims[0] + col);
+    return;
+  }
+
+  float* weights = m_Weights.data() + destIndex * m_StencilSize;
+  for(size_t s = 0; s < k_TrilinearStencilSize; s++)
+  {
+    bool upX = (s & 1) != 0;
+    bool upY = (s & 2) != 0;
+    bool upZ = (s & 4) != 0;
+    size_t col = upX ? hi[0] : lo[0];
+    size_t row = upY ? hi[1] : lo[1];
+    size_t plane = upZ ? hi[2] : lo[2];
+    indices[s] = static_cast<int64_t>((plane * srcDims[1] + row) * srcDims[0] + col);
+    weights[s] = (upX ? frac[0] : 1.0f - frac[0]) * (upY ? frac[1] : 1.0f - frac[1]) * (upZ ? frac[2] : 1.0f - frac[2]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageResampler::setVotedArrays(const QStringList& names)
+{
+  m_VotedArrays = names;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer ImageResampler::gatherArray(const IDataArray::Pointer& source) const
+{
+  IDataArray::Pointer destination = source->createNewArray(m_NumTuples, source->getComponentDimensions(), source->getName(), true);
+  const int64_t* indices = m_Indices.data();
+  const float* weights = m_Weights.data();
+
+  // Arrays the caller does not want averaged take the tuple with the largest summed weight instead
+  Method method = m_Method;
+  if(method == Method::Trilinear && m_VotedArrays.contains(source->getName()))
+  {
+    method = Method::MajorityVote;
+  }
+
+  bool gathered = gatherTypedArray<float>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<double>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<int8_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<uint8_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<int16_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<uint16_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<int32_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<uint32_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<int64_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<uint64_t>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method) ||
+                  gatherTypedArray<bool>(source, destination, m_NumTuples, indices, weights, m_StencilSize, method);
+  if(gathered)
+  {
+    return destination;
+  }
+
+  // Anything that is not a primitive array (strings, neighbor lists) is copied tuple by tuple
+  // from the heaviest candidate of each stencil
+  for(size_t i = 0; i < m_NumTuples; i++)
+  {
+    const int64_t* stencil = indices + i * m_StencilSize;
+    int64_t index = stencil[0];
+    float bestWeight = m_StencilSize > 1 ? weights[i * m_StencilSize] : 0.0f;
+    for(size_t s = 1; s < m_StencilSize; s++)
+    {
+      if(stencil[s] >= 0 && weights[i * m_StencilSize + s] > bestWeight)
+      {
+        index = stencil[s];
+        bestWeight = weights[i * m_StencilSize + s];
+      }
+    }
+    if(index >= 0)
+    {
+      destination->copyFromArray(i, source, static_cast<size_t>(index), 1);
+    }
+  }
+  return destination;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ImageResampler::gatherAttributeMatrix(const AttributeMatrix::Pointer& source, const AttributeMatrix::Pointer& destination, bool releaseSource, AbstractFilter* filter) const
+{
+  QList<QString> arrayNames = source->getAttributeArrayNames();
+  int32_t count = 0;
+  for(const QString& name : arrayNames)
+  {
+    if(nullptr != filter)
+    {
+      if(filter->getCancel())
+      {
+        return;
+      }
+      QString ss = QObject::tr("Copying Data || Array %1 of %2").arg(++count).arg(arrayNames.size());
+      filter->notifyStatusMessage(ss);
+    }
+    IDataArray::Pointer p = source->getAttributeArray(name);
+    destination->insertOrAssign(gatherArray(p));
+    if(releaseSource)
+    {
+      source->removeAttributeArray(name);
+    }
+  }
+}
@@ -0,0 +1,151 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QStringList>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The ImageResampler class moves the cell data of an Image Geometry onto a new grid. The
+ * caller fills in an index map that gives, for every destination cell, the source cells it is built
+ * from; the arrays are then gathered through that map in parallel with one kernel per primitive type.
+ *
+ * With a stencil size of 1 every destination cell copies a single source tuple (or is zeroed if its
+ * index is -1). With a stencil size of 8 each destination cell holds the 8 source cells around a sample
+ * point together with their trilinear weights; floating point arrays are then interpolated with the
+ * Trilinear method and every other array takes the tuple with the largest summed weight (a weighted
+ * majority vote), which keeps ids and phases valid. Floating point arrays that must not be averaged, such
+ * as orientations, are named by the caller with setVotedArrays() and always use the majority vote.
+ */
+class ImageResampler
+{
+public:
+  enum class Method : int
+  {
+    NearestNeighbor = 0,
+    Trilinear = 1,
+    MajorityVote = 2
+  };
+
+  /**
+   * @brief ImageResampler
+   * @param numTuples The number of tuples (cells) of the destination grid
+   * @param method How the stencil of each destination cell is combined
+   */
+  ImageResampler(size_t numTuples, Method method);
+  virtual ~ImageResampler();
+
+  /**
+   * @brief Returns the number of source candidates stored for each destination tuple
+   */
+  size_t getStencilSize() const;
+
+  /**
+   * @brief Returns the number of destination tuples
+   */
+  size_t getNumberOfTuples() const;
+
+  /**
+   * @brief Returns the index map: getStencilSize() source tuple indices per destination tuple.
+   * An index of -1 means that candidate does not exist.
+   */
+  int64_t* getIndices();
+
+  /**
+   * @brief Returns the stencil weights, parallel to the index map. Only used when the stencil size is 8.
+   */
+  float* getWeights();
+
+  /**
+   * @brief Fills the stencil of a destination tuple with the 8 source cells around a sample point given in
+   * continuous source cell coordinates, where the center of cell (i, j, k) is at (i, j, k). Sample points
+   * outside the source grid are clamped onto it. For a stencil size of 1 the closest cell is used instead.
+   * This does not touch any shared state, so it may be called for different destination tuples concurrently.
+   * @param destIndex Destination tuple
+   * @param u Continuous X position in source cells
+   * @param v Continuous Y position in source cells
+   * @param w Continuous Z position in source cells
+   * @param srcDims Dimensions of the source grid
+   */
+  void setSamplePoint(size_t destIndex, float u, float v, float w, const size_t srcDims[3]);
+
+  /**
+   * @brief Sets the names of the arrays that take the majority vote even when the method is Trilinear. Orientation
+   * arrays belong here: Euler angles wrap at 0/2pi and component-wise averaged quaternions are no longer normalized.
+   * @param names Array names
+   */
+  void setVotedArrays(const QStringList& names);
+
+  /**
+   * @brief Creates a new array with the destination number of tuples and gathers the source values into it.
+   * This lets a caller materialize only the arrays it actually needs.
+   * @param source The array to resample
+   * @return The resampled array, with the same name and component dimensions as the source
+   */
+  IDataArray::Pointer gatherArray(const IDataArray::Pointer& source) const;
+
+  /**
+   * @brief Gathers every array of the source Attribute Matrix and inserts the results into the destination
+   * Attribute Matrix, which must already have the destination tuple dimensions.
+   * @param source Attribute Matrix holding the source arrays
+   * @param destination Attribute Matrix that receives the resampled arrays
+   * @param releaseSource If true each source array is removed from the source Attribute Matrix as soon as it
+   * has been gathered, so only one extra array is alive at a time
+   * @param filter The calling filter, used to check for cancellation and report progress. May be nullptr.
+   */
+  void gatherAttributeMatrix(const AttributeMatrix::Pointer& source, const AttributeMatrix::Pointer& destination, bool releaseSource, AbstractFilter* filter) const;
+
+private:
+  size_t m_NumTuples = 0;
+  Method m_Method = Method::NearestNeighbor;
+  size_t m_StencilSize = 1;
+  std::vector<int64_t> m_Indices;
+  std::vector<float> m_Weights;
+  QStringList m_VotedArrays;
+
+public:
+  ImageResampler(const ImageResampler&) = delete;            // Copy Constructor Not Implemented
+  ImageResampler(ImageResampler&&) = delete;                 // Move Constructor Not Implemented
+  ImageResampler& operator=(const ImageResampler&) = delete; // Copy Assignment Not Implemented
+  ImageResampler& operator=(ImageResampler&&) = delete;      // Move Assignment Not Implemented
+};
@@ -59,6 +59,8 @@
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -455,7 +457,7 @@ void SampleSurfaceMesh::execute()
   notifyStatusMessage("Sampling triangle geometry ...");
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("SampleSurfaceMesh"));
   bool doParallel = true;
 #endif
 
@@ -468,7 +470,7 @@ void SampleSurfaceMesh::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, polyIds), tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures, ParallelExecutionContext::Instance()->getGrainSize("SampleSurfaceMesh")), SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, polyIds), tbb::auto_partitioner());
     }
     else
 #endif
@@ -488,7 +490,7 @@ void SampleSurfaceMesh::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
       if(doParallel)
       {
-        tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), SampleSurfaceMeshImplByPoints(this, triangleGeom, faceLists, faceBBs, points, featureId, polyIds), tbb::auto_partitioner());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints, ParallelExecutionContext::Instance()->getGrainSize("SampleSurfaceMesh")), SampleSurfaceMeshImplByPoints(this, triangleGeom, faceLists, faceBBs, points, featureId, polyIds), tbb::auto_partitioner());
       }
       else
 #endif
@@ -49,6 +49,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/HelperClasses/ImageResampler.h"
 #include "Sampling/SamplingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -236,7 +237,6 @@ void WarpRegularGrid::execute()
   }
 
   AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
-  AttributeMatrix::Pointer newCellAttrMat = cellAttrMat->deepCopy(false);
 
   size_t dims[3] = {0, 0, 0};
   std::tie(dims[0], dims[1], dims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -249,8 +249,8 @@ void WarpRegularGrid::execute()
   int col = 0.0f, row = 0.0f, plane = 0.0f;
   size_t index;
   size_t index_old;
-  std::vector<size_t> newindicies(totalPoints);
-  std::vector<bool> goodPoint(totalPoints, true);
+  ImageResampler resampler(totalPoints, ImageResampler::Method::NearestNeighbor);
+  int64_t* newindicies = resampler.getIndices();
 
   for(size_t i = 0; i < dims[2]; i++)
   {
@@ -270,51 +270,21 @@ void WarpRegularGrid::execute()
         row = newY / res[1];
         plane = i;
 
-        index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
-        newindicies[index] = index_old;
+        // Points warped off of the grid keep the -1 index and are zero filled
         if(col > 0 && col < dims[0] && row > 0 && row < dims[1])
         {
-          goodPoint[index] = true;
-        }
-        else
-        {
-          goodPoint[index] = false;
+          index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
+          newindicies[index] = static_cast<int64_t>(index_old);
         }
       }
     }
   }
 
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(cellAttrMat->getTupleDimensions(), cellAttrMat->getName(), cellAttrMat->getType());
+  resampler.gatherAttributeMatrix(cellAttrMat, newCellAttrMat, true, this);
+  if(getCancel())
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resizeTuples(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-
-      if(goodPoint[i])
-      {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-      }
-      else
-      {
-        int var = 0;
-        data->initializeTuple(i, &var);
-      }
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->insertOrAssign(data);
+    return;
   }
   m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   m->addOrReplaceAttributeMatrix(newCellAttrMat);
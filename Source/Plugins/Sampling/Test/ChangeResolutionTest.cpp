@@ -0,0 +1,306 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SamplingTestFileLocations.h"
+
+class ChangeResolutionTest
+{
+public:
+  ChangeResolutionTest() = default;
+  virtual ~ChangeResolutionTest() = default;
+
+  SIMPL_TYPE_MACRO(ChangeResolutionTest)
+
+  const QString k_FieldName = QString("Field");
+  const QString k_LabelsName = QString("Labels");
+  const QString k_EulersName = QString("EulerAngles");
+
+  // The 4x4 source labels, row by row. Each new cell of the 2x2 result holds a 2x2 block of old cells where one label
+  // has the largest summed weight but not the largest single weight.
+  const int32_t k_Labels[16] = {1, 2, 5, 5, 2, 8, 4, 6, 7, 8, 4, 4, 9, 9, 9, 9};
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the ChangeResolution Filter from the FilterManager
+    QString filtName = "ChangeResolution";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The ChangeResolutionTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Sampling Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A 4x4x1 grid of unit cells holding the field x^2 + 10 y^2, the labels and Euler angles that follow the labels
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateDataContainerArray()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(std::make_tuple(4, 4, 1));
+    image->setSpacing(std::make_tuple(1.0f, 1.0f, 1.0f));
+    image->setOrigin(std::make_tuple(0.0f, 0.0f, 0.0f));
+    m->setGeometry(image);
+
+    QVector<size_t> tDims = {4, 4, 1};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    QVector<size_t> cDims(1, 1);
+    FloatArrayType::Pointer field = FloatArrayType::CreateArray(tDims, cDims, k_FieldName, true);
+    Int32ArrayType::Pointer labels = Int32ArrayType::CreateArray(tDims, cDims, k_LabelsName, true);
+    cDims[0] = 3;
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(tDims, cDims, k_EulersName, true);
+    for(size_t y = 0; y < 4; y++)
+    {
+      for(size_t x = 0; x < 4; x++)
+      {
+        size_t index = y * 4 + x;
+        field->setValue(index, static_cast<float>(x * x + 10 * y * y));
+        labels->setValue(index, k_Labels[index]);
+        for(int32_t c = 0; c < 3; c++)
+        {
+          eulers->setComponent(index, c, EulerComponent(k_Labels[index], c));
+        }
+      }
+    }
+    cellAttrMat->insertOrAssign(field);
+    cellAttrMat->insertOrAssign(labels);
+    cellAttrMat->insertOrAssign(eulers);
+    m->addOrReplaceAttributeMatrix(cellAttrMat);
+    dca->addOrReplaceDataContainer(m);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The Euler angles of a label; 2pi - 0.1 and 0.1 sit on both sides of the wrap of the first angle
+  // -----------------------------------------------------------------------------
+  static float EulerComponent(int32_t label, int32_t comp)
+  {
+    if(comp == 0)
+    {
+      return (label % 2 == 0) ? 6.2f : 0.1f;
+    }
+    return 0.1f * static_cast<float>(label + comp);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Changes the spacing to (2, 1.5, 1), so the 4x4 cells become 2x2. The centers of the new cells sit at
+  // x = 0.5 and 2.5 (halfway between two old cells) and y = 0.25 and 1.75 in old cell units.
+  // -----------------------------------------------------------------------------
+  AttributeMatrix::Pointer RunChangeResolution(int method, const QVector<DataArrayPath>& votedPaths)
+  {
+    DataContainerArray::Pointer dca = CreateDataContainerArray();
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("ChangeResolution");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+
+    QVariant var;
+    FloatVec3Type spacing = {2.0f, 1.5f, 1.0f};
+    var.setValue(spacing);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("Spacing", var), true)
+    var.setValue(method);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("InterpolationMethod", var), true)
+    var.setValue(votedPaths);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("VotedArrayPaths", var), true)
+    var.setValue(false);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("RenumberFeatures", var), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("SaveAsNewDataContainer", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellAttributeMatrixPath", var), true)
+
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    size_t dims[3] = {0, 0, 0};
+    std::tie(dims[0], dims[1], dims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], 2)
+    DREAM3D_REQUIRE_EQUAL(dims[1], 2)
+    DREAM3D_REQUIRE_EQUAL(dims[2], 1)
+
+    AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(cellAttrMat.get())
+    DREAM3D_REQUIRE_EQUAL(cellAttrMat->getNumberOfTuples(), 4)
+    return cellAttrMat;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CheckLabelsAndEulers(const AttributeMatrix::Pointer& cellAttrMat, const int32_t expected[4])
+  {
+    Int32ArrayType::Pointer labels = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(k_LabelsName);
+    FloatArrayType::Pointer eulers = cellAttrMat->getAttributeArrayAs<FloatArrayType>(k_EulersName);
+    DREAM3D_REQUIRE_VALID_POINTER(labels.get())
+    DREAM3D_REQUIRE_VALID_POINTER(eulers.get())
+    for(size_t i = 0; i < 4; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(labels->getValue(i), expected[i])
+      for(int32_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(eulers->getComponent(i, c), EulerComponent(expected[i], c))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestNearestNeighbor()
+  {
+    // The old cells (0,0), (2,0), (0,1) and (2,1)
+    AttributeMatrix::Pointer cellAttrMat = RunChangeResolution(0, QVector<DataArrayPath>());
+    FloatArrayType::Pointer field = cellAttrMat->getAttributeArrayAs<FloatArrayType>(k_FieldName);
+    DREAM3D_REQUIRE_VALID_POINTER(field.get())
+    const float expectedField[4] = {0.0f, 4.0f, 10.0f, 14.0f};
+    for(size_t i = 0; i < 4; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(field->getValue(i), expectedField[i])
+    }
+    const int32_t expectedLabels[4] = {1, 5, 2, 4};
+    CheckLabelsAndEulers(cellAttrMat, expectedLabels);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestTrilinear()
+  {
+    QVector<DataArrayPath> votedPaths(1, DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, k_EulersName));
+    AttributeMatrix::Pointer cellAttrMat = RunChangeResolution(1, votedPaths);
+
+    // The weights are 0.5 and 0.5 in x and 0.75 and 0.25 in y, so every new value is the mean of x^2 over the two
+    // columns plus 10 times the weighted mean of y^2 over the two rows:
+    // (0 + 1) / 2 + 10 * (0.75 * 0 + 0.25 * 1) = 3
+    // (4 + 9) / 2 + 10 * (0.75 * 0 + 0.25 * 1) = 9
+    // (0 + 1) / 2 + 10 * (0.25 * 1 + 0.75 * 4) = 33
+    // (4 + 9) / 2 + 10 * (0.25 * 1 + 0.75 * 4) = 39
+    FloatArrayType::Pointer field = cellAttrMat->getAttributeArrayAs<FloatArrayType>(k_FieldName);
+    DREAM3D_REQUIRE_VALID_POINTER(field.get())
+    const float expectedField[4] = {3.0f, 9.0f, 33.0f, 39.0f};
+    for(size_t i = 0; i < 4; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(field->getValue(i), expectedField[i])
+    }
+
+    // Integer arrays and the selected Euler angles are voted instead of interpolated
+    const int32_t expectedLabels[4] = {2, 5, 8, 4};
+    CheckLabelsAndEulers(cellAttrMat, expectedLabels);
+
+    // Without the selection the Euler angles are averaged across the wrap: in the first new cell the first angle is
+    // 0.1 with weight 0.375 and 6.2 with weight 0.625
+    cellAttrMat = RunChangeResolution(1, QVector<DataArrayPath>());
+    FloatArrayType::Pointer eulers = cellAttrMat->getAttributeArrayAs<FloatArrayType>(k_EulersName);
+    DREAM3D_REQUIRE_VALID_POINTER(eulers.get())
+    float interpolated = 0.375f * 0.1f + 0.375f * 6.2f + 0.125f * 6.2f + 0.125f * 6.2f;
+    DREAM3D_REQUIRE(std::fabs(eulers->getComponent(0, 0) - interpolated) < 1.0E-5f)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMajorityVote()
+  {
+    // The first new cell holds label 1 with weight 0.375, label 2 with 0.375 + 0.125 and label 8 with 0.125, so the
+    // vote picks 2 even though label 1 is the first cell with the largest single weight. The third new cell holds
+    // labels 2 and 8 (0.125 each) and 7 and 8 (0.375 each), so 8 wins over 7.
+    AttributeMatrix::Pointer cellAttrMat = RunChangeResolution(2, QVector<DataArrayPath>());
+    const int32_t expectedLabels[4] = {2, 5, 8, 4};
+    CheckLabelsAndEulers(cellAttrMat, expectedLabels);
+
+    // Every value of the float field is a value of the old grid
+    FloatArrayType::Pointer field = cellAttrMat->getAttributeArrayAs<FloatArrayType>(k_FieldName);
+    DREAM3D_REQUIRE_VALID_POINTER(field.get())
+    for(size_t i = 0; i < 4; i++)
+    {
+      float value = field->getValue(i);
+      bool found = false;
+      for(size_t y = 0; y < 4; y++)
+      {
+        for(size_t x = 0; x < 4; x++)
+        {
+          found = found || (value == static_cast<float>(x * x + 10 * y * y));
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(found, true)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestNearestNeighbor());
+    DREAM3D_REGISTER_TEST(TestTrilinear());
+    DREAM3D_REGISTER_TEST(TestMajorityVote());
+  }
+
+public:
+  ChangeResolutionTest(const ChangeResolutionTest&) = delete;            // Copy Constructor Not Implemented
+  ChangeResolutionTest(ChangeResolutionTest&&) = delete;                 // Move Constructor Not Implemented
+  ChangeResolutionTest& operator=(const ChangeResolutionTest&) = delete; // Copy Assignment Not Implemented
+  ChangeResolutionTest& operator=(ChangeResolutionTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,6 +35,9 @@
 
 #include "BetaOps.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 // -----------------------------------------------------------------------------
@@ -50,81 +53,23 @@ BetaOps::BetaOps() = default;
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int BetaOps::calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs)
-{
-  int err = 0;
-  float avg = 0;
-  float stddev = 0;
-  float alpha = 0;
-  float beta = 0;
-  if(data.size() > 1)
-  {
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      avg = avg + data[i];
-    }
-    avg = avg / float(data.size());
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      stddev = stddev + ((avg - data[i]) * (avg - data[i]));
-    }
-    stddev = stddev / float(data.size());
-    alpha = avg * (((avg * (1 - avg)) / stddev) - 1);
-    beta = (1 - avg) * (((avg * (1 - avg)) / stddev) - 1);
-  }
-  else
-  {
-    alpha = 0;
-    beta = 0;
-  }
-  outputs->setValue(0, alpha);
-  outputs->setValue(1, beta);
-  return err;
-}
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int BetaOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs)
+void BetaOps::calculateBinParameters(const float* data, size_t count, float* params) const
 {
-  int err = 0;
-  float avg = 0;
-  float stddev = 0;
-  float alpha = 0;
-  float beta = 0;
-  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+  float alpha = 0.0f;
+  float beta = 0.0f;
+  if(count > 1)
   {
-    avg = 0;
-    stddev = 0;
-    if(data[i].size() > 1)
-    {
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        avg = avg + data[i][j];
-      }
-      avg = avg / float(data[i].size());
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        stddev = stddev + ((avg - data[i][j]) * (avg - data[i][j]));
-      }
-      stddev = stddev / float(data[i].size());
-      if(stddev == 0)
-      {
-        alpha = 0;
-        beta = 0;
-      }
-      else
-      {
-        alpha = avg * (((avg * (1 - avg)) / stddev) - 1);
-        beta = (1 - avg) * (((avg * (1 - avg)) / stddev) - 1);
-      }
-    }
-    else
+    double sum = 0.0;
+    double sumSq = 0.0;
+    AccumulateMoments(data, count, [](float v) { return static_cast<double>(v); }, sum, sumSq);
+    float avg = static_cast<float>(sum / count);
+    float stddev = static_cast<float>(std::max(sumSq / count - (sum / count) * (sum / count), 0.0));
+    if(stddev != 0.0f)
     {
-      alpha = 0;
-      beta = 0;
+      alpha = avg * (((avg * (1 - avg)) / stddev) - 1);
+      beta = (1 - avg) * (((avg * (1 - avg)) / stddev) - 1);
     }
-    outputs[0]->setValue(i, alpha);
-    outputs[1]->setValue(i, beta);
   }
-  return err;
+  params[0] = alpha;
+  params[1] = beta;
 }
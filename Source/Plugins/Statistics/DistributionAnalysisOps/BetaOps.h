@@ -57,8 +57,7 @@ class BetaOps : public DistributionAnalysisOps
     virtual ~BetaOps();
 
 
-    int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs);
-    int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs);
+    void calculateBinParameters(const float* data, size_t count, float* params) const override;
 
   protected:
     BetaOps();
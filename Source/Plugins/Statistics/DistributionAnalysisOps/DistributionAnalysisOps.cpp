@@ -38,6 +38,49 @@
 #include <limits>
 #include <numeric>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The FitBinsImpl class fits a range of bins of a bin sorted value array
+ */
+class FitBinsImpl
+{
+public:
+  FitBinsImpl(const DistributionAnalysisOps* ops, const float* values, const size_t* binOffsets, float* params)
+  : m_Ops(ops)
+  , m_Values(values)
+  , m_BinOffsets(binOffsets)
+  , m_Params(params)
+  {
+  }
+  virtual ~FitBinsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t b = start; b < end; b++)
+    {
+      m_Ops->calculateBinParameters(m_Values + m_BinOffsets[b], m_BinOffsets[b + 1] - m_BinOffsets[b], m_Params + b * DistributionAnalysisOps::k_NumParameters);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const DistributionAnalysisOps* m_Ops;
+  const float* m_Values;
+  const size_t* m_BinOffsets;
+  float* m_Params;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -48,15 +91,75 @@ DistributionAnalysisOps::DistributionAnalysisOps() = default;
 // -----------------------------------------------------------------------------
 DistributionAnalysisOps::~DistributionAnalysisOps() = default;
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DistributionAnalysisOps::calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs)
+{
+  float params[k_NumParameters];
+  calculateBinParameters(data.data(), data.size(), params);
+  for(size_t p = 0; p < k_NumParameters; p++)
+  {
+    outputs->setValue(p, params[p]);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DistributionAnalysisOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs)
+{
+  float params[k_NumParameters];
+  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+  {
+    calculateBinParameters(data[i].data(), data[i].size(), params);
+    for(size_t p = 0; p < k_NumParameters; p++)
+    {
+      outputs[p]->setValue(i, params[p]);
+    }
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DistributionAnalysisOps::calculateBinnedParameters(const std::vector<float>& values, const std::vector<size_t>& binOffsets, std::vector<float>& params) const
+{
+  size_t numBins = binOffsets.empty() ? 0 : binOffsets.size() - 1;
+  params.assign(numBins * k_NumParameters, 0.0f);
+  FitBinsImpl impl(this, values.data(), binOffsets.data(), params.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(numBins > 1)
+  {
+    // Bins differ widely in size, so let the scheduler split down to single bins
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBins, 1), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.compute(0, numBins);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void DistributionAnalysisOps::determineMaxAndMinValues(std::vector<float>& data, float& max, float& min)
+{
+  determineMaxAndMinValues(data.data(), data.size(), max, min);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DistributionAnalysisOps::determineMaxAndMinValues(const float* data, size_t count, float& max, float& min)
 {
   float value;
   min = std::numeric_limits<float>::max();
   max = std::numeric_limits<float>::min();
-  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+  for(size_t i = 0; i < count; i++)
   {
     value = data[i];
     if(value > max)
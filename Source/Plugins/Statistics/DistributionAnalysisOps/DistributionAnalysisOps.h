@@ -57,15 +57,97 @@ class DistributionAnalysisOps
 //   SIMPL_STATIC_NEW_MACRO(DistributionAnalysisOps)
     virtual ~DistributionAnalysisOps();
 
-    virtual int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs) = 0;
-    virtual int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs) = 0;
+    static const size_t k_NumParameters = 2;
+
+    virtual int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs);
+    virtual int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs);
+
+    /**
+     * @brief calculateBinParameters Fits the distribution to count contiguous values
+     * @param data First value of the bin
+     * @param count Number of values in the bin
+     * @param params The k_NumParameters fitted parameters
+     */
+    virtual void calculateBinParameters(const float* data, size_t count, float* params) const = 0;
+
+    /**
+     * @brief calculateBinnedParameters Fits every bin of a bin sorted value array in parallel. Bin b holds the
+     * values [binOffsets[b], binOffsets[b + 1]) and its parameters are written to params[b * k_NumParameters].
+     * @param values Values sorted by bin
+     * @param binOffsets Start of each bin followed by the total number of values
+     * @param params Resized to hold the parameters of all bins
+     */
+    void calculateBinnedParameters(const std::vector<float>& values, const std::vector<size_t>& binOffsets, std::vector<float>& params) const;
+
+    /**
+     * @brief SortIntoBins Counting sort of item ids by bin that keeps the item order within each bin.
+     * binOf(item) returns the bin of an item, or a value of at least numBins to leave the item out.
+     * @param binOffsets Start of each bin in sortedItems followed by the number of sorted items
+     * @param sortedItems Item ids ordered by bin
+     */
+    template <typename BinFunctor>
+    static void SortIntoBins(size_t numItems, size_t numBins, const BinFunctor& binOf, std::vector<size_t>& binOffsets, std::vector<size_t>& sortedItems)
+    {
+      std::vector<size_t> itemBins(numItems);
+      binOffsets.assign(numBins + 1, 0);
+      for(size_t i = 0; i < numItems; i++)
+      {
+        itemBins[i] = binOf(i);
+        if(itemBins[i] < numBins)
+        {
+          binOffsets[itemBins[i] + 1]++;
+        }
+      }
+      for(size_t b = 0; b < numBins; b++)
+      {
+        binOffsets[b + 1] += binOffsets[b];
+      }
+      sortedItems.resize(binOffsets[numBins]);
+      std::vector<size_t> next(binOffsets.begin(), binOffsets.end() - 1);
+      for(size_t i = 0; i < numItems; i++)
+      {
+        if(itemBins[i] < numBins)
+        {
+          sortedItems[next[itemBins[i]]++] = i;
+        }
+      }
+    }
 
     static void determineMaxAndMinValues(std::vector<float>& data, float& max, float& min);
+    static void determineMaxAndMinValues(const float* data, size_t count, float& max, float& min);
     static void determineBinNumbers(float& max, float& min, float& numbins, FloatArrayType::Pointer binnumbers);
 
   protected:
     DistributionAnalysisOps();
 
+    /**
+     * @brief AccumulateMoments Sums transform(x) and transform(x)^2 over count values. Four independent partial
+     * sums break the dependency chain of the reduction so the compiler can keep several additions in flight.
+     */
+    template <typename Transform> static void AccumulateMoments(const float* data, size_t count, const Transform& transform, double& sum, double& sumSq)
+    {
+      double s[4] = {0.0, 0.0, 0.0, 0.0};
+      double sq[4] = {0.0, 0.0, 0.0, 0.0};
+      size_t i = 0;
+      for(; i + 4 <= count; i += 4)
+      {
+        for(size_t l = 0; l < 4; l++)
+        {
+          double v = transform(data[i + l]);
+          s[l] += v;
+          sq[l] += v * v;
+        }
+      }
+      for(; i < count; i++)
+      {
+        double v = transform(data[i]);
+        s[0] += v;
+        sq[0] += v * v;
+      }
+      sum = (s[0] + s[1]) + (s[2] + s[3]);
+      sumSq = (sq[0] + sq[1]) + (sq[2] + sq[3]);
+    }
+
   public:
     DistributionAnalysisOps(const DistributionAnalysisOps&) = delete; // Copy Constructor Not Implemented
     DistributionAnalysisOps(DistributionAnalysisOps&&) = delete;      // Move Constructor Not Implemented
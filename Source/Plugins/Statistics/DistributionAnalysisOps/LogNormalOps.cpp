@@ -35,6 +35,9 @@
 
 #include "LogNormalOps.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 // -----------------------------------------------------------------------------
@@ -50,77 +53,23 @@ LogNormalOps::LogNormalOps() = default;
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int LogNormalOps::calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs)
+void LogNormalOps::calculateBinParameters(const float* data, size_t count, float* params) const
 {
-  int err = 0;
-  float avg = 0;
-  float stddev = 0;
-  if(data.size() > 1)
+  float avg = 0.0f;
+  float stddev = 0.0f;
+  if(count > 1)
   {
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      avg = avg + log(data[i]);
-    }
-    avg = avg / float(data.size());
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      stddev = stddev + ((avg - log(data[i])) * (avg - log(data[i])));
-    }
-    stddev = stddev / float(data.size());
-    stddev = sqrt(stddev);
+    double sum = 0.0;
+    double sumSq = 0.0;
+    AccumulateMoments(data, count, [](float v) { return std::log(static_cast<double>(v)); }, sum, sumSq);
+    avg = static_cast<float>(sum / count);
+    stddev = static_cast<float>(std::sqrt(std::max(sumSq / count - (sum / count) * (sum / count), 0.0)));
   }
-  else if(data.size() == 1)
+  else if(count == 1)
   {
     avg = data[0];
-    stddev = 0;
-  }
-  else
-  {
-    avg = 0;
-    stddev = 0;
-  }
-  outputs->setValue(0, avg);
-  outputs->setValue(1, stddev);
-  return err;
-}
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int LogNormalOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs)
-{
-  int err = 0;
-  float avg = 0;
-  float stddev = 0;
-  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-  {
-    avg = 0;
-    stddev = 0;
-    if(data[i].size() > 1)
-    {
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        avg = avg + log(data[i][j]);
-      }
-      avg = avg / float(data[i].size());
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        stddev = stddev + ((avg - log(data[i][j])) * (avg - log(data[i][j])));
-      }
-      stddev = stddev / float(data[i].size());
-      stddev = sqrt(stddev);
-    }
-    else if(data[i].size() == 1)
-    {
-      avg = data[i][0];
-      stddev = 0;
-    }
-    else
-    {
-      avg = 0;
-      stddev = 0;
-    }
-    outputs[0]->setValue(i, avg);
-    outputs[1]->setValue(i, stddev);
+    stddev = 0.0f;
   }
-  return err;
+  params[0] = avg;
+  params[1] = stddev;
 }
@@ -34,6 +34,8 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 #include "PowerLawOps.h"
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <numeric>
 
@@ -52,73 +54,28 @@ PowerLawOps::PowerLawOps() = default;
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int PowerLawOps::calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs)
+void PowerLawOps::calculateBinParameters(const float* data, size_t count, float* params) const
 {
-  int err = 0;
-  float alpha = 0;
-  float min = std::numeric_limits<float>::max();
-  if(data.size() > 1)
+  float alpha = 0.0f;
+  float min = 0.0f;
+  if(count > 1)
   {
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+    min = std::numeric_limits<float>::max();
+    for(size_t i = 0; i < count; i++)
     {
-      if(data[i] < min)
-      {
-        min = data[i];
-      }
+      min = std::min(min, data[i]);
     }
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+    double sum = 0.0;
+    double sumSq = 0.0;
+    const double logMin = std::log(static_cast<double>(min));
+    AccumulateMoments(data, count, [logMin](float v) { return std::log(static_cast<double>(v)) - logMin; }, sum, sumSq);
+    alpha = static_cast<float>(sum);
+    if(alpha != 0.0f)
     {
-      alpha = alpha + log(data[i] / min);
+      alpha = 1.0f / alpha;
     }
-    alpha = 1.0f / alpha;
-    alpha = 1 + (alpha * data.size());
+    alpha = 1.0f + (alpha * count);
   }
-  else
-  {
-    min = 0;
-    alpha = 0;
-  }
-  outputs->setValue(0, alpha);
-  outputs->setValue(1, min);
-  return err;
-}
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int PowerLawOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs)
-{
-  int err = 0;
-  float alpha = 0;
-  float min;
-  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-  {
-    if(data[i].size() > 1)
-    {
-      min = std::numeric_limits<float>::max();
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        if(data[i][j] < min)
-        {
-          min = data[i][j];
-        }
-      }
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        alpha = alpha + log(data[i][j] / min);
-      }
-      if(alpha != 0.0f)
-      {
-        alpha = 1.0f / alpha;
-      }
-      alpha = 1.0f + (alpha * data[i].size());
-    }
-    else
-    {
-      min = 0;
-      alpha = 0;
-    }
-    outputs[0]->setValue(i, alpha);
-    outputs[1]->setValue(i, min);
-  }
-  return err;
+  params[0] = alpha;
+  params[1] = min;
 }
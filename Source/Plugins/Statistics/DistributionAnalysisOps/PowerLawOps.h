@@ -58,8 +58,7 @@ class PowerLawOps : public DistributionAnalysisOps
     virtual ~PowerLawOps();
 
 
-    int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs);
-    int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs);
+    void calculateBinParameters(const float* data, size_t count, float* params) const override;
 
   protected:
     PowerLawOps();
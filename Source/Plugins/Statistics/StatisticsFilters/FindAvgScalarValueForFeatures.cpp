@@ -42,6 +42,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "OrientationLib/Utilities/FeatureReduction.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -173,26 +175,26 @@ template <typename T> void findAverage(IDataArray::Pointer inDataPtr, FloatArray
   size_t numPoints = inputDataPtr->getNumberOfTuples();
   size_t numFeatures = averageArray->getNumberOfTuples();
 
-  std::vector<float> counts(numFeatures, 0.0f);
+  // Each feature sums its values and its cell count
+  std::vector<double> sums(numFeatures * 2, 0.0);
+  FeatureReduction::Sum<double>("FindAvgScalarValueForFeatures", numPoints, numFeatures * 2,
+                                [=](size_t i, double* table) {
+                                  int32_t feature = fIds[i];
+                                  table[feature * 2] += static_cast<double>(cPtr[i]);
+                                  table[feature * 2 + 1] += 1.0;
+                                },
+                                sums.data());
 
-  int32_t feature = 0;
-  float value = 0.0f;
-  for(size_t i = 0; i < numPoints; i++)
-  {
-    value = float(cPtr[i]);
-    feature = fIds[i];
-    aPtr[feature] += value;
-    counts[feature] += 1.0f;
-  }
+  aPtr[0] += static_cast<float>(sums[0]);
   for(size_t i = 1; i < numFeatures; i++)
   {
-    if(counts[i] == 0)
+    if(sums[i * 2 + 1] == 0.0)
     {
       aPtr[i] = 0;
     }
     else
     {
-      aPtr[i] /= counts[i];
+      aPtr[i] = static_cast<float>((static_cast<double>(aPtr[i]) + sums[i * 2]) / sums[i * 2 + 1]);
     }
   }
 }
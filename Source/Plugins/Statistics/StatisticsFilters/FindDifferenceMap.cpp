@@ -9,6 +9,8 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -86,7 +88,7 @@ public:
   void Execute(IDataArray::Pointer firstArrayPtr, IDataArray::Pointer secondArrayPtr, IDataArray::Pointer differenceMapPtr)
   {
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::task_scheduler_init init;
+    tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindDifferenceMap"));
     bool doParallel = true;
 #endif
 
@@ -54,6 +54,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -668,7 +670,7 @@ void FindEuclideanDistMap::findDistanceMap()
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindEuclideanDistMap"));
   bool doParallel = true;
 #endif
 
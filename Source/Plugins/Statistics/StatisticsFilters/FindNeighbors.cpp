@@ -35,7 +35,17 @@
 
 #include "FindNeighbors.h"
 
-#include <QtCore/QDateTime>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -46,6 +56,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -57,6 +69,122 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
+/**
+ * @brief The FindNeighborsFacesImpl class extracts the faces shared by two different features over a
+ * range of z slabs. Every face is recorded from the side of each feature as a key holding both feature
+ * ids; each slab sorts its own keys and reduces them to (key, face count) pairs so the merge only
+ * handles one record per feature pair and slab. The boundary cell counts are written directly since
+ * every voxel belongs to exactly one slab.
+ */
+class FindNeighborsFacesImpl
+{
+public:
+  FindNeighborsFacesImpl(int32_t* featureIds, int8_t* boundaryCells, int64_t* dims, size_t slabSize, std::vector<std::vector<std::pair<uint64_t, int32_t>>>& partials)
+  : m_FeatureIds(featureIds)
+  , m_BoundaryCells(boundaryCells)
+  , m_Dims(dims)
+  , m_SlabSize(slabSize)
+  , m_Partials(partials)
+  {
+  }
+  virtual ~FindNeighborsFacesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    std::vector<uint64_t> keys;
+    for(size_t slab = start; slab < end; slab++)
+    {
+      int64_t zStart = static_cast<int64_t>(slab * m_SlabSize);
+      int64_t zEnd = std::min(zStart + static_cast<int64_t>(m_SlabSize), m_Dims[2]);
+      keys.clear();
+      extract(zStart, zEnd, keys);
+      std::sort(keys.begin(), keys.end());
+
+      std::vector<std::pair<uint64_t, int32_t>>& pairs = m_Partials[slab];
+      pairs.clear();
+      for(size_t k = 0; k < keys.size(); k++)
+      {
+        if(pairs.empty() || pairs.back().first != keys[k])
+        {
+          pairs.push_back(std::make_pair(keys[k], 0));
+        }
+        pairs.back().second++;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+  /**
+   * @brief Packs the two feature ids of a face so that sorting the keys orders them by feature, then by neighbor
+   */
+  static uint64_t makeKey(int32_t feature, int32_t neighbor)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(feature)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(neighbor));
+  }
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  int8_t* m_BoundaryCells = nullptr;
+  int64_t* m_Dims = nullptr;
+  size_t m_SlabSize = 1;
+  std::vector<std::vector<std::pair<uint64_t, int32_t>>>& m_Partials;
+
+  void extract(int64_t zStart, int64_t zEnd, std::vector<uint64_t>& keys) const
+  {
+    const int64_t xPoints = m_Dims[0];
+    const int64_t yPoints = m_Dims[1];
+    const int64_t zPoints = m_Dims[2];
+    const int64_t neighpoints[6] = {-xPoints * yPoints, -xPoints, -1, 1, xPoints, xPoints * yPoints};
+    bool good[6] = {true, true, true, true, true, true};
+
+    for(int64_t plane = zStart; plane < zEnd; plane++)
+    {
+      good[0] = (plane != 0);
+      good[5] = (plane != zPoints - 1);
+      for(int64_t row = 0; row < yPoints; row++)
+      {
+        good[1] = (row != 0);
+        good[4] = (row != yPoints - 1);
+        int64_t rowStart = (plane * yPoints + row) * xPoints;
+        for(int64_t column = 0; column < xPoints; column++)
+        {
+          good[2] = (column != 0);
+          good[3] = (column != xPoints - 1);
+          int64_t j = rowStart + column;
+          int32_t feature = m_FeatureIds[j];
+          int8_t onsurf = 0;
+          if(feature > 0)
+          {
+            for(int32_t k = 0; k < 6; k++)
+            {
+              if(!good[k])
+              {
+                continue;
+              }
+              int32_t neighbor = m_FeatureIds[j + neighpoints[k]];
+              if(neighbor != feature && neighbor > 0)
+              {
+                onsurf++;
+                keys.push_back(makeKey(feature, neighbor));
+              }
+            }
+          }
+          if(nullptr != m_BoundaryCells)
+          {
+            m_BoundaryCells[j] = onsurf;
+          }
+        }
+      }
+    }
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -238,7 +366,6 @@ void FindNeighbors::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
   size_t udims[3] = {0, 0, 0};
@@ -248,134 +375,130 @@ void FindNeighbors::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
     m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
     if(m_StoreSurfaceFeatures)
     {
       m_SurfaceFeatures[i] = false;
     }
   }
 
-  for(size_t j = 0; j < totalPoints; j++)
+  // Features touching the outer faces of the volume; only the shell of the volume is visited
+  if(m_StoreSurfaceFeatures)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    for(int64_t plane = 0; plane < dims[2]; plane++)
     {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0)
-    {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures)
+      bool zFace = (dims[2] != 1) && (plane == 0 || plane == dims[2] - 1);
+      for(int64_t row = 0; row < dims[1]; row++)
       {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
+        bool yFace = (row == 0 || row == dims[1] - 1);
+        int64_t rowStart = (plane * dims[1] + row) * dims[0];
+        int64_t step = (zFace || yFace) ? 1 : std::max(dims[0] - 1, static_cast<int64_t>(1));
+        for(int64_t column = 0; column < dims[0]; column += step)
         {
-          m_SurfaceFeatures[feature] = true;
-        }
-      }
-      for(int32_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
+          int32_t feature = m_FeatureIds[rowStart + column];
+          if(feature > 0)
+          {
+            m_SurfaceFeatures[feature] = true;
+          }
         }
       }
     }
-    if(m_StoreBoundaryCells)
+  }
+
+  notifyStatusMessage("Finding Neighbors || Extracting Shared Faces");
+
+  // The volume is cut into more slabs than threads so that slabs with many boundaries do not hold up
+  // the others. Each slab reduces its faces to one record per feature pair.
+  size_t zPoints = udims[2];
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindNeighbors"));
+  bool doParallel = true;
+  numSlabs = static_cast<size_t>(ParallelExecutionContext::Instance()->getThreadCount("FindNeighbors")) * 4;
+#endif
+  numSlabs = std::max(static_cast<size_t>(1), std::min(numSlabs, zPoints));
+  size_t slabSize = (zPoints + numSlabs - 1) / numSlabs;
+  numSlabs = (zPoints + slabSize - 1) / slabSize;
+
+  std::vector<std::vector<std::pair<uint64_t, int32_t>>> partials(numSlabs);
+  FindNeighborsFacesImpl facesImpl(m_FeatureIds, m_StoreBoundaryCells ? m_BoundaryCells : nullptr, dims, slabSize, partials);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), facesImpl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    facesImpl.compute(0, numSlabs);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  notifyStatusMessage("Finding Neighbors || Sorting Shared Faces");
+
+  size_t numRecords = 0;
+  for(const std::vector<std::pair<uint64_t, int32_t>>& partial : partials)
+  {
+    numRecords += partial.size();
+  }
+  std::vector<std::pair<uint64_t, int32_t>> records;
+  records.reserve(numRecords);
+  for(std::vector<std::pair<uint64_t, int32_t>>& partial : partials)
+  {
+    records.insert(records.end(), partial.begin(), partial.end());
+    std::vector<std::pair<uint64_t, int32_t>>().swap(partial);
+  }
+
+  auto keyLess = [](const std::pair<uint64_t, int32_t>& a, const std::pair<uint64_t, int32_t>& b) { return a.first < b.first; };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_sort(records.begin(), records.end(), keyLess);
+  }
+  else
+#endif
+  {
+    std::sort(records.begin(), records.end(), keyLess);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Sum the face counts of the same feature pair from different slabs and lay the neighbors out as
+  // compressed rows: the neighbors of feature i are neighbors[offsets[i]] to neighbors[offsets[i + 1]]
+  std::vector<size_t> offsets(totalFeatures + 1, 0);
+  std::vector<int32_t> neighbors;
+  std::vector<int32_t> faceCounts;
+  neighbors.reserve(records.size());
+  faceCounts.reserve(records.size());
+  for(size_t r = 0; r < records.size(); r++)
+  {
+    size_t feature = static_cast<size_t>(records[r].first >> 32);
+    if(feature >= totalFeatures)
+    {
+      continue;
+    }
+    if(r > 0 && records[r].first == records[r - 1].first)
     {
-      m_BoundaryCells[j] = onsurf;
+      faceCounts.back() += records[r].second;
+      continue;
     }
+    neighbors.push_back(static_cast<int32_t>(records[r].first & 0xFFFFFFFF));
+    faceCounts.push_back(records[r].second);
+    offsets[feature + 1]++;
+  }
+  std::vector<std::pair<uint64_t, int32_t>>().swap(records);
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    offsets[i + 1] += offsets[i];
   }
 
   float xRes = 0.0f;
@@ -383,61 +506,21 @@ void FindNeighbors::execute()
   float zRes = 0.0f;
   std::tie(xRes, yRes, zRes) = m->getGeometryAs<ImageGeom>()->getSpacing();
 
+  notifyStatusMessage("Finding Neighbors || Calculating Surface Areas");
+
   // We do this to create new set of NeighborList objects
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]));
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>(offsets[i + 1] - offsets[i]));
+    for(size_t n = offsets[i]; n < offsets[i + 1]; n++)
     {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * xRes * yRes;
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
+      (*sharedSAL)[n - offsets[i]] = float(faceCounts[n]) * xRes * yRes;
     }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    m_NumNeighbors[i] = static_cast<int32_t>(sharedNeiLst->size());
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
-
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
     m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
-
 }
 
 // -----------------------------------------------------------------------------
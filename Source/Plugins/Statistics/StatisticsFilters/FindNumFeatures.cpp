@@ -41,6 +41,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "OrientationLib/Utilities/FeatureReduction.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -156,13 +158,24 @@ void FindNumFeatures::execute()
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
   size_t totalEnsembles = m_NumFeaturesPtr.lock()->getNumberOfTuples();
 
-  for(size_t i = 1; i < totalEnsembles; i++)
+  std::vector<int32_t> counts(totalEnsembles, 0);
+  int32_t* featurePhases = m_FeaturePhases;
+  FeatureReduction::Sum<int32_t>("FindNumFeatures", totalFeatures, totalEnsembles,
+                                 [=](size_t i, int32_t* table) {
+                                   if(i > 0)
+                                   {
+                                     table[featurePhases[i]]++;
+                                   }
+                                 },
+                                 counts.data());
+
+  if(totalEnsembles > 0)
   {
-    m_NumFeatures[i] = 0;
+    m_NumFeatures[0] += counts[0];
   }
-  for(size_t i = 1; i < totalFeatures; i++)
+  for(size_t i = 1; i < totalEnsembles; i++)
   {
-    m_NumFeatures[m_FeaturePhases[i]]++;
+    m_NumFeatures[i] = counts[i];
   }
 
 }
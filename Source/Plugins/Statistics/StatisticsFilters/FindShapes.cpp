@@ -34,6 +34,16 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindShapes.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -44,6 +54,8 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/FeatureReduction.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
@@ -58,6 +70,287 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID34 = 34,
 };
 
+/**
+ * @brief The FindShapesAxesImpl class solves the principal moments of a range of features and derives
+ * the axis lengths and aspect ratios of the equivalent ellipsoids. Each feature is independent.
+ */
+class FindShapesAxesImpl
+{
+public:
+  FindShapesAxesImpl(double* featureMoments, double* featureEigenVals, float* axisLengths, float* aspectRatios, double scaleFactor)
+  : m_FeatureMoments(featureMoments)
+  , m_FeatureEigenVals(featureEigenVals)
+  , m_AxisLengths(axisLengths)
+  , m_AspectRatios(aspectRatios)
+  , m_ScaleFactor(scaleFactor)
+  {
+  }
+  virtual ~FindShapesAxesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    double I1 = 0.0, I2 = 0.0, I3 = 0.0;
+    double Ixx = 0.0, Iyy = 0.0, Izz = 0.0, Ixy = 0.0, Ixz = 0.0, Iyz = 0.0;
+    double a = 0.0, b = 0.0, c = 0.0, d = 0.0, f = 0.0, g = 0.0, h = 0.0;
+    double rsquare = 0.0, r = 0.0, theta = 0.0;
+    double A = 0.0, B = 0.0, C = 0.0;
+    double r1 = 0.0, r2 = 0.0, r3 = 0.0;
+    float bovera = 0.0f, covera = 0.0f;
+    double value = 0.0;
+
+    for(size_t i = start; i < end; i++)
+    {
+      Ixx = m_FeatureMoments[i * 6 + 0];
+      Iyy = m_FeatureMoments[i * 6 + 1];
+      Izz = m_FeatureMoments[i * 6 + 2];
+
+      Ixy = m_FeatureMoments[i * 6 + 3];
+      Iyz = m_FeatureMoments[i * 6 + 4];
+      Ixz = m_FeatureMoments[i * 6 + 5];
+
+      a = 1.0;
+      b = (-Ixx - Iyy - Izz);
+      c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
+      d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
+      // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
+      f = ((3.0 * c / a) - ((b / a) * (b / a))) / 3.0;
+      g = ((2.0 * (b / a) * (b / a) * (b / a)) - (9.0 * b * c / (a * a)) + (27.0 * (d / a))) / 27.0;
+      h = (g * g / 4.0) + (f * f * f / 27.0);
+      rsquare = (g * g / 4.0) - h;
+      r = sqrt(rsquare);
+      if(rsquare < 0.0)
+      {
+        r = 0.0;
+      }
+      theta = 0;
+      if(r != 0)
+      {
+        value = -g / (2.0 * r);
+        if(value > 1)
+        {
+          value = 1.0;
+        }
+        if(value < -1)
+        {
+          value = -1.0;
+        }
+        theta = acos(value);
+      }
+      double const1 = pow(r, 0.33333333333);
+      double const2 = cos(theta / 3.0);
+      double const3 = b / (3.0 * a);
+      double const4 = 1.7320508 * sin(theta / 3.0);
+
+      r1 = 2 * const1 * const2 - (const3);
+      r2 = -const1 * (const2 - (const4)) - const3;
+      r3 = -const1 * (const2 + (const4)) - const3;
+      m_FeatureEigenVals[3 * i] = r1;
+      m_FeatureEigenVals[3 * i + 1] = r2;
+      m_FeatureEigenVals[3 * i + 2] = r3;
+
+      I1 = (15.0 * r1) / (4.0 * M_PI);
+      I2 = (15.0 * r2) / (4.0 * M_PI);
+      I3 = (15.0 * r3) / (4.0 * M_PI);
+      A = (I1 + I2 - I3) / 2.0;
+      B = (I1 + I3 - I2) / 2.0;
+      C = (I2 + I3 - I1) / 2.0;
+      a = (A * A * A * A) / (B * C);
+      a = pow(a, 0.1);
+      b = B / A;
+      b = sqrt(b) * a;
+      c = A / (a * a * a * b);
+
+      m_AxisLengths[3 * i] = static_cast<float>(a / m_ScaleFactor);
+      m_AxisLengths[3 * i + 1] = static_cast<float>(b / m_ScaleFactor);
+      m_AxisLengths[3 * i + 2] = static_cast<float>(c / m_ScaleFactor);
+      bovera = static_cast<float>(b / a);
+      covera = static_cast<float>(c / a);
+      if(A == 0.0 || B == 0.0 || C == 0.0)
+      {
+        bovera = 0.0f;
+        covera = 0.0f;
+      }
+      m_AspectRatios[2 * i] = bovera;
+      m_AspectRatios[2 * i + 1] = covera;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  double* m_FeatureMoments = nullptr;
+  double* m_FeatureEigenVals = nullptr;
+  float* m_AxisLengths = nullptr;
+  float* m_AspectRatios = nullptr;
+  double m_ScaleFactor = 1.0;
+};
+
+/**
+ * @brief The FindShapesAxisEulersImpl class finds the principal axes of a range of features from their
+ * moments and eigenvalues and stores the orientation of those axes as Euler angles.
+ */
+class FindShapesAxisEulersImpl
+{
+public:
+  FindShapesAxisEulersImpl(double* featureMoments, double* featureEigenVals, float* axisEulerAngles)
+  : m_FeatureMoments(featureMoments)
+  , m_FeatureEigenVals(featureEigenVals)
+  , m_AxisEulerAngles(axisEulerAngles)
+  {
+  }
+  virtual ~FindShapesAxisEulersImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      double Ixx = m_FeatureMoments[i * 6 + 0];
+      double Iyy = m_FeatureMoments[i * 6 + 1];
+      double Izz = m_FeatureMoments[i * 6 + 2];
+      double Ixy = m_FeatureMoments[i * 6 + 3];
+      double Iyz = m_FeatureMoments[i * 6 + 4];
+      double Ixz = m_FeatureMoments[i * 6 + 5];
+      double radius1 = m_FeatureEigenVals[3 * i];
+      double radius2 = m_FeatureEigenVals[3 * i + 1];
+      double radius3 = m_FeatureEigenVals[3 * i + 2];
+
+      double e[3][1];
+      double vect[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+      e[0][0] = radius1;
+      e[1][0] = radius2;
+      e[2][0] = radius3;
+      double uber[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+      double bmat[3][1];
+      bmat[0][0] = 0.0000001;
+      bmat[1][0] = 0.0000001;
+      bmat[2][0] = 0.0000001;
+
+      for(int32_t j = 0; j < 3; j++)
+      {
+        uber[0][0] = Ixx - e[j][0];
+        uber[0][1] = Ixy;
+        uber[0][2] = Ixz;
+        uber[1][0] = Ixy;
+        uber[1][1] = Iyy - e[j][0];
+        uber[1][2] = Iyz;
+        uber[2][0] = Ixz;
+        uber[2][1] = Iyz;
+        uber[2][2] = Izz - e[j][0];
+        // Solve (I - eI)v = b by Gaussian elimination on a stack allocated copy of the system
+        double uberelim[3][3];
+        double uberbelim[3][1];
+        const int32_t elimcount = 3;
+        double sum = 0.0;
+        double c = 0.0;
+        for(int32_t a = 0; a < 3; a++)
+        {
+          for(int32_t b = 0; b < 3; b++)
+          {
+            uberelim[a][b] = uber[a][b];
+          }
+          uberbelim[a][0] = bmat[a][0];
+        }
+        for(int32_t k = 0; k < elimcount - 1; k++)
+        {
+          for(int32_t l = k + 1; l < elimcount; l++)
+          {
+            c = uberelim[l][k] / uberelim[k][k];
+            for(int32_t r = k + 1; r < elimcount; r++)
+            {
+              uberelim[l][r] = uberelim[l][r] - c * uberelim[k][r];
+            }
+            uberbelim[l][0] = uberbelim[l][0] - c * uberbelim[k][0];
+          }
+        }
+        uberbelim[elimcount - 1][0] = uberbelim[elimcount - 1][0] / uberelim[elimcount - 1][elimcount - 1];
+        for(int32_t l = 1; l < elimcount; l++)
+        {
+          int32_t r = (elimcount - 1) - l;
+          sum = 0.0;
+          for(int32_t n = r + 1; n < elimcount; n++)
+          {
+            sum = sum + (uberelim[r][n] * uberbelim[n][0]);
+          }
+          uberbelim[r][0] = (uberbelim[r][0] - sum) / uberelim[r][r];
+        }
+        for(int32_t p = 0; p < elimcount; p++)
+        {
+          vect[j][p] = uberbelim[p][0];
+        }
+      }
+
+      double n1x = vect[0][0];
+      double n1y = vect[0][1];
+      double n1z = vect[0][2];
+      double n2x = vect[1][0];
+      double n2y = vect[1][1];
+      double n2z = vect[1][2];
+      double n3x = vect[2][0];
+      double n3y = vect[2][1];
+      double n3z = vect[2][2];
+      double norm1 = sqrt(((n1x * n1x) + (n1y * n1y) + (n1z * n1z)));
+      double norm2 = sqrt(((n2x * n2x) + (n2y * n2y) + (n2z * n2z)));
+      double norm3 = sqrt(((n3x * n3x) + (n3y * n3y) + (n3z * n3z)));
+      n1x = n1x / norm1;
+      n1y = n1y / norm1;
+      n1z = n1z / norm1;
+      n2x = n2x / norm2;
+      n2y = n2y / norm2;
+      n2z = n2z / norm2;
+      n3x = n3x / norm3;
+      n3y = n3y / norm3;
+      n3z = n3z / norm3;
+
+      // insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
+      //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
+      float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+      g[0][0] = n3x;
+      g[0][1] = n3y;
+      g[0][2] = n3z;
+      g[1][0] = n2x;
+      g[1][1] = n2y;
+      g[1][2] = n2z;
+      g[2][0] = n1x;
+      g[2][1] = n1y;
+      g[2][2] = n1z;
+
+      // check for right-handedness
+      typedef OrientationTransforms<FOrientArrayType, float> OrientationTransformType;
+      OrientationTransformType::ResultType result = FOrientTransformsType::om_check(FOrientArrayType(g));
+      if(result.result == 0)
+      {
+        g[2][0] *= -1.0f;
+        g[2][1] *= -1.0f;
+        g[2][2] *= -1.0f;
+      }
+
+      FOrientArrayType eu(3, 0.0f);
+      FOrientTransformsType::om2eu(FOrientArrayType(g), eu);
+
+      m_AxisEulerAngles[3 * i] = eu[0];
+      m_AxisEulerAngles[3 * i + 1] = eu[1];
+      m_AxisEulerAngles[3 * i + 2] = eu[2];
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  double* m_FeatureMoments = nullptr;
+  double* m_FeatureEigenVals = nullptr;
+  float* m_AxisEulerAngles = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -235,7 +528,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
 
   size_t xPoints = imageGeom->getXPoints();
   size_t yPoints = imageGeom->getYPoints();
@@ -258,90 +550,58 @@ void FindShapes::find_moments()
 
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
+  // Every voxel is split into 8 sub-voxels whose offsets from the feature centroid give its second
+  // moments. Each feature sums its 6 moments followed by its voxel count.
+  const size_t numValues = 7;
+  std::vector<double> sums(numfeatures * numValues, 0.0);
+  size_t dims[3] = {xPoints, yPoints, zPoints};
+  int32_t* featureIds = m_FeatureIds;
+  float* centroids = m_Centroids;
+  float scaleFactor = static_cast<float>(m_ScaleFactor);
+  FeatureReduction::SumImage<double>("FindShapes", dims, numfeatures * numValues,
+                                     [=](size_t cell, size_t k, size_t j, size_t i, double* table) {
+                                       int32_t gnum = featureIds[cell];
+                                       float x = float(k * modXRes) + (xOrigin * scaleFactor);
+                                       float y = float(j * modYRes) + (yOrigin * scaleFactor);
+                                       float z = float(i * modZRes) + (zOrigin * scaleFactor);
+                                       float xs[2] = {x + (modXRes / 4.0f), x - (modXRes / 4.0f)};
+                                       float ys[2] = {y + (modYRes / 4.0f), y - (modYRes / 4.0f)};
+                                       float zs[2] = {z + (modZRes / 4.0f), z - (modZRes / 4.0f)};
+                                       float cx = centroids[gnum * 3 + 0] * scaleFactor;
+                                       float cy = centroids[gnum * 3 + 1] * scaleFactor;
+                                       float cz = centroids[gnum * 3 + 2] * scaleFactor;
+                                       float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, yz = 0.0f, xz = 0.0f;
+                                       for(size_t c = 0; c < 8; c++)
+                                       {
+                                         float xdist = xs[c / 4] - cx;
+                                         float ydist = ys[(c / 2) % 2] - cy;
+                                         float zdist = zs[c % 2] - cz;
+                                         xx = xx + (ydist * ydist) + (zdist * zdist);
+                                         yy = yy + (xdist * xdist) + (zdist * zdist);
+                                         zz = zz + (xdist * xdist) + (ydist * ydist);
+                                         xy = xy + (xdist * ydist);
+                                         yz = yz + (ydist * zdist);
+                                         xz = xz + (xdist * zdist);
+                                       }
+                                       double* featureMoments = table + gnum * numValues;
+                                       featureMoments[0] += static_cast<double>(xx);
+                                       featureMoments[1] += static_cast<double>(yy);
+                                       featureMoments[2] += static_cast<double>(zz);
+                                       featureMoments[3] += static_cast<double>(xy);
+                                       featureMoments[4] += static_cast<double>(yz);
+                                       featureMoments[5] += static_cast<double>(xz);
+                                       featureMoments[6] += 1.0;
+                                     },
+                                     sums.data());
   for(size_t i = 0; i < numfeatures; i++)
   {
-    m_FeatureMoments[6 * i + 0] = 0.0;
-    m_FeatureMoments[6 * i + 1] = 0.0;
-    m_FeatureMoments[6 * i + 2] = 0.0;
-    m_FeatureMoments[6 * i + 3] = 0.0;
-    m_FeatureMoments[6 * i + 4] = 0.0;
-    m_FeatureMoments[6 * i + 5] = 0.0;
-  }
-
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    for(size_t v = 0; v < 6; v++)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes) + (xOrigin * static_cast<float>(m_ScaleFactor));
-        y = float(j * modYRes) + (yOrigin * static_cast<float>(m_ScaleFactor));
-        z = float(i * modZRes) + (zOrigin * static_cast<float>(m_ScaleFactor));
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3)) + ((ydist4) * (ydist4)) +
-             ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6)) + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) +
-             ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3)) + ((xdist4) * (xdist4)) +
-             ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6)) + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) +
-             ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3)) + ((xdist4) * (xdist4)) +
-             ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6)) + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) +
-             ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6)) + ((xdist7) * (ydist7)) +
-             ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6)) + ((ydist7) * (zdist7)) +
-             ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6)) + ((xdist7) * (zdist7)) +
-             ((xdist8) * (zdist8));
-
-        m_FeatureMoments[gnum * 6 + 0] = m_FeatureMoments[gnum * 6 + 0] + static_cast<double>(xx);
-        m_FeatureMoments[gnum * 6 + 1] = m_FeatureMoments[gnum * 6 + 1] + static_cast<double>(yy);
-        m_FeatureMoments[gnum * 6 + 2] = m_FeatureMoments[gnum * 6 + 2] + static_cast<double>(zz);
-        m_FeatureMoments[gnum * 6 + 3] = m_FeatureMoments[gnum * 6 + 3] + static_cast<double>(xy);
-        m_FeatureMoments[gnum * 6 + 4] = m_FeatureMoments[gnum * 6 + 4] + static_cast<double>(yz);
-        m_FeatureMoments[gnum * 6 + 5] = m_FeatureMoments[gnum * 6 + 5] + static_cast<double>(xz);
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
+      m_FeatureMoments[i * 6 + v] = sums[i * numValues + v];
     }
+    m_Volumes[i] = m_Volumes[i] + static_cast<float>(sums[i * numValues + 6]);
   }
+
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
   double konst1 = static_cast<double>((modXRes / 2.0) * (modYRes / 2.0) * (modZRes / 2.0));
@@ -390,7 +650,6 @@ void FindShapes::find_moments2D()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
-  float xx = 0.0f, yy = 0.0f, xy = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
   size_t xPoints = 0, yPoints = 0;
@@ -426,43 +685,47 @@ void FindShapes::find_moments2D()
   float zOrigin = 0.0f;
   std::tie(xOrigin, yOrigin, zOrigin) = imageGeom->getOrigin();
 
-  for(size_t i = 0; i < 6 * numfeatures; i++)
+  // Every pixel is split into 4 sub-pixels; each feature sums its 3 moments followed by its pixel count
+  const size_t numValues = 4;
+  std::vector<double> sums(numfeatures * numValues, 0.0);
+  size_t dims[3] = {xPoints, yPoints, 1};
+  int32_t* featureIds = m_FeatureIds;
+  float* centroids = m_Centroids;
+  float scaleFactor = static_cast<float>(m_ScaleFactor);
+  FeatureReduction::SumImage<double>("FindShapes", dims, numfeatures * numValues,
+                                     [=](size_t cell, size_t k, size_t j, size_t /* i */, double* table) {
+                                       int32_t gnum = featureIds[cell];
+                                       float x = float(k * modXRes) + (xOrigin * scaleFactor);
+                                       float y = float(j * modYRes) + (yOrigin * scaleFactor);
+                                       float xs[2] = {x + (modXRes / 4.0f), x - (modXRes / 4.0f)};
+                                       float ys[2] = {y + (modYRes / 4.0f), y - (modYRes / 4.0f)};
+                                       float cx = centroids[gnum * 3 + 0] * scaleFactor;
+                                       float cy = centroids[gnum * 3 + 1] * scaleFactor;
+                                       float xx = 0.0f, yy = 0.0f, xy = 0.0f;
+                                       for(size_t c = 0; c < 4; c++)
+                                       {
+                                         float xdist = xs[c / 2] - cx;
+                                         float ydist = ys[c % 2] - cy;
+                                         xx = xx + (ydist * ydist);
+                                         yy = yy + (xdist * xdist);
+                                         xy = xy + (xdist * ydist);
+                                       }
+                                       double* featureMoments = table + gnum * numValues;
+                                       featureMoments[0] += static_cast<double>(xx);
+                                       featureMoments[1] += static_cast<double>(yy);
+                                       featureMoments[2] += static_cast<double>(xy);
+                                       featureMoments[3] += 1.0;
+                                     },
+                                     sums.data());
+  for(size_t i = 0; i < numfeatures; i++)
   {
-    m_FeatureMoments[i] = 0.0;
-  }
-
-  float x = 0.0f, y = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f;
-  size_t yStride = 0;
-  for(size_t j = 0; j < yPoints; j++)
-  {
-    yStride = j * xPoints;
-    for(size_t k = 0; k < xPoints; k++)
-    {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      x = float(k * modXRes) + (xOrigin * static_cast<float>(m_ScaleFactor));
-      y = float(j * modYRes) + (yOrigin * static_cast<float>(m_ScaleFactor));
-      x1 = x + (modXRes / 4.0f);
-      x2 = x - (modXRes / 4.0f);
-      y1 = y + (modYRes / 4.0f);
-      y2 = y - (modYRes / 4.0f);
-      xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist2 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist3 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist3 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist4 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xx = ((ydist1) * (ydist1)) + ((ydist2) * (ydist2)) + ((ydist3) * (ydist3)) + ((ydist4) * (ydist4));
-      yy = ((xdist1) * (xdist1)) + ((xdist2) * (xdist2)) + ((xdist3) * (xdist3)) + ((xdist4) * (xdist4));
-      xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4));
-      m_FeatureMoments[gnum * 6 + 0] = m_FeatureMoments[gnum * 6 + 0] + xx;
-      m_FeatureMoments[gnum * 6 + 1] = m_FeatureMoments[gnum * 6 + 1] + yy;
-      m_FeatureMoments[gnum * 6 + 2] = m_FeatureMoments[gnum * 6 + 2] + xy;
-      m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-    }
+    m_FeatureMoments[i * 6 + 0] = sums[i * numValues + 0];
+    m_FeatureMoments[i * 6 + 1] = sums[i * numValues + 1];
+    m_FeatureMoments[i * 6 + 2] = sums[i * numValues + 2];
+    m_FeatureMoments[i * 6 + 3] = 0.0;
+    m_FeatureMoments[i * 6 + 4] = 0.0;
+    m_FeatureMoments[i * 6 + 5] = 0.0;
+    m_Volumes[i] = m_Volumes[i] + static_cast<float>(sums[i * numValues + 3]);
   }
   double konst1 = static_cast<double>( (modXRes / 2.0f) * (modYRes / 2.0f));
   double konst2 = static_cast<double>(xRes * yRes);
@@ -484,97 +747,27 @@ void FindShapes::find_moments2D()
 // -----------------------------------------------------------------------------
 void FindShapes::find_axes()
 {
-  double I1 = 0.0, I2 = 0.0, I3 = 0.0;
-  double Ixx = 0.0, Iyy = 0.0, Izz = 0.0, Ixy = 0.0, Ixz = 0.0, Iyz = 0.0;
-  double a = 0.0, b = 0.0, c = 0.0, d = 0.0, f = 0.0, g = 0.0, h = 0.0;
-  double rsquare = 0.0, r = 0.0, theta = 0.0;
-  double A = 0.0, B = 0.0, C = 0.0;
-  double r1 = 0.0, r2 = 0.0, r3 = 0.0;
-  float bovera = 0.0f, covera = 0.0f;
-  double value = 0.0;
-
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
+  if(numfeatures < 2)
+  {
+    return;
+  }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindShapes"));
+  bool doParallel = true;
+#endif
 
-  for(size_t i = 1; i < numfeatures; i++)
+  FindShapesAxesImpl impl(m_FeatureMoments, m_FeatureEigenVals, m_AxisLengths, m_AspectRatios, m_ScaleFactor);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    Ixx = m_FeatureMoments[i * 6 + 0];
-    Iyy = m_FeatureMoments[i * 6 + 1];
-    Izz = m_FeatureMoments[i * 6 + 2];
-
-    Ixy = m_FeatureMoments[i * 6 + 3];
-    Iyz = m_FeatureMoments[i * 6 + 4];
-    Ixz = m_FeatureMoments[i * 6 + 5];
-
-    a = 1.0;
-    b = (-Ixx - Iyy - Izz);
-    c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
-    d = 0.0;
-    d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
-    // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
-    f = ((3.0 * c / a) - ((b / a) * (b / a))) / 3.0;
-    g = ((2.0 * (b / a) * (b / a) * (b / a)) - (9.0 * b * c / (a * a)) + (27.0 * (d / a))) / 27.0;
-    h = (g * g / 4.0) + (f * f * f / 27.0);
-    rsquare = (g * g / 4.0) - h;
-    r = sqrt(rsquare);
-    if(rsquare < 0.0)
-    {
-      r = 0.0;
-    }
-    theta = 0;
-    if(r == 0)
-    {
-      theta = 0;
-    }
-    if(r != 0)
-    {
-      value = -g / (2.0 * r);
-      if(value > 1)
-      {
-        value = 1.0;
-      }
-      if(value < -1)
-      {
-        value = -1.0;
-      }
-      theta = acos(value);
-    }
-    double const1 = pow(r, 0.33333333333);
-    double const2 = cos(theta / 3.0);
-    double const3 = b / (3.0 * a);
-    double const4 = 1.7320508 * sin(theta / 3.0);
-
-    r1 = 2 * const1 * const2 - (const3);
-    r2 = -const1 * (const2 - (const4)) - const3;
-    r3 = -const1 * (const2 + (const4)) - const3;
-    m_FeatureEigenVals[3 * i] = r1;
-    m_FeatureEigenVals[3 * i + 1] = r2;
-    m_FeatureEigenVals[3 * i + 2] = r3;
-
-    I1 = (15.0 * r1) / (4.0 * M_PI);
-    I2 = (15.0 * r2) / (4.0 * M_PI);
-    I3 = (15.0 * r3) / (4.0 * M_PI);
-    A = (I1 + I2 - I3) / 2.0;
-    B = (I1 + I3 - I2) / 2.0;
-    C = (I2 + I3 - I1) / 2.0;
-    a = (A * A * A * A) / (B * C);
-    a = pow(a, 0.1);
-    b = B / A;
-    b = sqrt(b) * a;
-    c = A / (a * a * a * b);
-
-    m_AxisLengths[3 * i] = static_cast<float>(a / m_ScaleFactor);
-    m_AxisLengths[3 * i + 1] = static_cast<float>(b / m_ScaleFactor);
-    m_AxisLengths[3 * i + 2] = static_cast<float>(c / m_ScaleFactor);
-    bovera = static_cast<float>(b / a);
-    covera = static_cast<float>(c / a);
-    if(A == 0.0 || B == 0.0 || C == 0.0)
-    {
-      bovera = 0.0f;
-      covera = 0.0f;
-    }
-    m_AspectRatios[2 * i] = bovera;
-    m_AspectRatios[2 * i + 1] = covera;
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.compute(1, numfeatures);
   }
 }
 
@@ -664,153 +857,26 @@ void FindShapes::find_axes2D()
 void FindShapes::find_axiseulers()
 {
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
-  for(size_t i = 1; i < numfeatures; i++)
+  if(numfeatures < 2)
   {
-    double Ixx = m_FeatureMoments[i * 6 + 0];
-    double Iyy = m_FeatureMoments[i * 6 + 1];
-    double Izz = m_FeatureMoments[i * 6 + 2];
-    double Ixy = m_FeatureMoments[i * 6 + 3];
-    double Iyz = m_FeatureMoments[i * 6 + 4];
-    double Ixz = m_FeatureMoments[i * 6 + 5];
-    double radius1 = m_FeatureEigenVals[3 * i];
-    double radius2 = m_FeatureEigenVals[3 * i + 1];
-    double radius3 = m_FeatureEigenVals[3 * i + 2];
-
-    double e[3][1];
-    double vect[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
-    e[0][0] = radius1;
-    e[1][0] = radius2;
-    e[2][0] = radius3;
-    double uber[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
-    double bmat[3][1];
-    bmat[0][0] = 0.0000001;
-    bmat[1][0] = 0.0000001;
-    bmat[2][0] = 0.0000001;
-
-    for(int32_t j = 0; j < 3; j++)
-    {
-      uber[0][0] = Ixx - e[j][0];
-      uber[0][1] = Ixy;
-      uber[0][2] = Ixz;
-      uber[1][0] = Ixy;
-      uber[1][1] = Iyy - e[j][0];
-      uber[1][2] = Iyz;
-      uber[2][0] = Ixz;
-      uber[2][1] = Iyz;
-      uber[2][2] = Izz - e[j][0];
-      double** uberelim;
-      double** uberbelim;
-      uberelim = new double*[3];
-      uberbelim = new double*[3];
-      for(int32_t d = 0; d < 3; d++)
-      {
-        uberelim[d] = new double[3];
-        uberbelim[d] = new double[1];
-      }
-      int32_t elimcount = 0;
-      int32_t elimcount1 = 0;
-      double q = 0.0;
-      double sum = 0.0;
-      double c = 0.0;
-      for(int32_t a = 0; a < 3; a++)
-      {
-        elimcount1 = 0;
-        for(int32_t b = 0; b < 3; b++)
-        {
-          uberelim[elimcount][elimcount1] = uber[a][b];
-          elimcount1++;
-        }
-        uberbelim[elimcount][0] = bmat[a][0];
-        elimcount++;
-      }
-      for(int32_t k = 0; k < elimcount - 1; k++)
-      {
-        for(int32_t l = k + 1; l < elimcount; l++)
-        {
-          c = uberelim[l][k] / uberelim[k][k];
-          for(int32_t r = k + 1; r < elimcount; r++)
-          {
-            uberelim[l][r] = uberelim[l][r] - c * uberelim[k][r];
-          }
-          uberbelim[l][0] = uberbelim[l][0] - c * uberbelim[k][0];
-        }
-      }
-      uberbelim[elimcount - 1][0] = uberbelim[elimcount - 1][0] / uberelim[elimcount - 1][elimcount - 1];
-      for(int32_t l = 1; l < elimcount; l++)
-      {
-        int32_t r = (elimcount - 1) - l;
-        sum = 0.0;
-        for(int32_t n = r + 1; n < elimcount; n++)
-        {
-          sum = sum + (uberelim[r][n] * uberbelim[n][0]);
-        }
-        uberbelim[r][0] = (uberbelim[r][0] - sum) / uberelim[r][r];
-      }
-      for(int32_t p = 0; p < elimcount; p++)
-      {
-        q = uberbelim[p][0];
-        vect[j][p] = q;
-      }
-      for(int32_t d = 0; d < 3; d++)
-      {
-        delete uberelim[d];
-        delete uberbelim[d];
-      }
-      delete uberelim;
-      delete uberbelim;
-    }
-
-    double n1x = vect[0][0];
-    double n1y = vect[0][1];
-    double n1z = vect[0][2];
-    double n2x = vect[1][0];
-    double n2y = vect[1][1];
-    double n2z = vect[1][2];
-    double n3x = vect[2][0];
-    double n3y = vect[2][1];
-    double n3z = vect[2][2];
-    double norm1 = sqrt(((n1x * n1x) + (n1y * n1y) + (n1z * n1z)));
-    double norm2 = sqrt(((n2x * n2x) + (n2y * n2y) + (n2z * n2z)));
-    double norm3 = sqrt(((n3x * n3x) + (n3y * n3y) + (n3z * n3z)));
-    n1x = n1x / norm1;
-    n1y = n1y / norm1;
-    n1z = n1z / norm1;
-    n2x = n2x / norm2;
-    n2y = n2y / norm2;
-    n2z = n2z / norm2;
-    n3x = n3x / norm3;
-    n3y = n3y / norm3;
-    n3z = n3z / norm3;
-
-    // insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
-    //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
-    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-    g[0][0] = n3x;
-    g[0][1] = n3y;
-    g[0][2] = n3z;
-    g[1][0] = n2x;
-    g[1][1] = n2y;
-    g[1][2] = n2z;
-    g[2][0] = n1x;
-    g[2][1] = n1y;
-    g[2][2] = n1z;
-
-    // check for right-handedness
-    typedef OrientationTransforms<FOrientArrayType, float> OrientationTransformType;
-    OrientationTransformType::ResultType result = FOrientTransformsType::om_check(FOrientArrayType(g));
-    if(result.result == 0)
-    {
-      g[2][0] *= -1.0f;
-      g[2][1] *= -1.0f;
-      g[2][2] *= -1.0f;
-    }
+    return;
+  }
 
-    FOrientArrayType eu(3, 0.0f);
-    FOrientTransformsType::om2eu(FOrientArrayType(g), eu);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FindShapes"));
+  bool doParallel = true;
+#endif
 
-    m_AxisEulerAngles[3 * i] = eu[0];
-    m_AxisEulerAngles[3 * i + 1] = eu[1];
-    m_AxisEulerAngles[3 * i + 2] = eu[2];
+  FindShapesAxisEulersImpl impl(m_FeatureMoments, m_FeatureEigenVals, m_AxisEulerAngles);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.compute(1, numfeatures);
   }
 }
 
@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "OrientationLib/Utilities/FeatureReduction.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -214,11 +216,9 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
   float diameter = 0.0f;
   float res_scalar = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
+  int32_t* featureIds = m_FeatureIds;
+  FeatureReduction::Sum<uint64_t>("FindSizes", totalPoints, numfeatures, [=](size_t j, uint64_t* table) { table[featureIds[j]]++; }, featurecounts);
+
   float xRes = 0.0f;
   float yRes = 0.0f;
   float zRes = 0.0f;
@@ -314,23 +314,28 @@ void FindSizes::findSizesUnstructured(IGeometry::Pointer igeom)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
-
   float rad = 0.0f;
   float diameter = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
+  // Each feature sums its element count and its element sizes
+  std::vector<double> sums(numfeatures * 2, 0.0);
+  int32_t* featureIds = m_FeatureIds;
+  FeatureReduction::Sum<double>("FindSizes", totalPoints, numfeatures * 2,
+                                [=](size_t j, double* table) {
+                                  int32_t gnum = featureIds[j];
+                                  table[gnum * 2] += 1.0;
+                                  table[gnum * 2 + 1] += sizes[j];
+                                },
+                                sums.data());
+  for(size_t i = 0; i < numfeatures; i++)
   {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-    m_Volumes[gnum] += sizes[j];
+    m_Volumes[i] += static_cast<float>(sums[i * 2 + 1]);
   }
+
   float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pif;
   for(size_t i = 1; i < numfeatures; i++)
   {
-    m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
+    m_NumElements[i] = static_cast<int32_t>(sums[i * 2]);
     rad = m_Volumes[i] / vol_term;
     diameter = 2.0f * powf(rad, 0.3333333333f);
     m_EquivalentDiameters[i] = diameter;
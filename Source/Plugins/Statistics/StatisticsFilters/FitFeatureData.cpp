@@ -209,8 +209,6 @@ template <typename T> void fitData(IDataArray::Pointer inDataPtr, float* ensembl
 {
   typename DataArray<T>::Pointer inputDataPtr = std::dynamic_pointer_cast<DataArray<T>>(inDataPtr);
 
-  StatsData::Pointer sData = StatsData::New();
-
   std::vector<DistributionAnalysisOps::Pointer> distributionAnalysis;
   distributionAnalysis.push_back(BetaOps::New());
   distributionAnalysis.push_back(LogNormalOps::New());
@@ -235,35 +233,27 @@ template <typename T> void fitData(IDataArray::Pointer inDataPtr, float* ensembl
 
   T* fPtr = inputDataPtr->getPointer(0);
 
-  std::vector<FloatArrayType::Pointer> dist;
-  std::vector<std::vector<float>> values;
-
   size_t numfeatures = inputDataPtr->getNumberOfTuples();
 
-  dist.resize(numEnsembles);
-  values.resize(numEnsembles);
-
-  for(size_t i = 1; i < numEnsembles; i++)
+  // Sort the feature values by ensemble into one flat array, then fit every ensemble at once
+  std::vector<size_t> ensembleOffsets;
+  std::vector<size_t> sortedFeatures;
+  DistributionAnalysisOps::SortIntoBins(numfeatures, numEnsembles,
+                                        [=](size_t f) { return (f == 0 || (removeBiasedFeatures && biasedFeatures[f])) ? numEnsembles : static_cast<size_t>(eIds[f]); },
+                                        ensembleOffsets, sortedFeatures);
+  std::vector<float> values(sortedFeatures.size());
+  for(size_t k = 0; k < sortedFeatures.size(); k++)
   {
-    dist[i] = sData->CreateDistributionArrays(dType);
+    values[k] = static_cast<float>(fPtr[sortedFeatures[k]]);
   }
 
-  int32_t ensemble = 0;
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(!removeBiasedFeatures || !biasedFeatures[i])
-    {
-      ensemble = eIds[i];
-      values[ensemble].push_back(static_cast<float>(fPtr[i]));
-    }
-  }
+  std::vector<float> params;
+  distributionAnalysis[dType]->calculateBinnedParameters(values, ensembleOffsets, params);
   for(size_t i = 1; i < numEnsembles; i++)
   {
-    distributionAnalysis[dType]->calculateParameters(values[i], dist[i]);
-    for(int32_t j = 0; j < numComp; j++)
+    for(int32_t j = 0; j < numComp && static_cast<size_t>(j) < DistributionAnalysisOps::k_NumParameters; j++)
     {
-      FloatArrayType::Pointer data = dist[i];
-      ensembleArray[numComp * i + j] = data->getValue(j);
+      ensembleArray[numComp * i + j] = params[i * DistributionAnalysisOps::k_NumParameters + j];
     }
   }
 }
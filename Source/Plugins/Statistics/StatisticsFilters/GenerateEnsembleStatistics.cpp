@@ -53,6 +53,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "Statistics/DistributionAnalysisOps/BetaOps.h"
 #include "Statistics/DistributionAnalysisOps/LogNormalOps.h"
@@ -62,6 +63,10 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -677,7 +682,6 @@ void GenerateEnsembleStatistics::gatherSizeStats()
   float mindiam = 0.0f;
   float totalUnbiasedVolume = 0.0f;
   QVector<VectorOfFloatArray> sizedist;
-  std::vector<std::vector<std::vector<float>>> values;
 
   FloatArrayType::Pointer binnumbers;
   size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
@@ -685,21 +689,33 @@ void GenerateEnsembleStatistics::gatherSizeStats()
 
   std::vector<float> fractions(numensembles, 0.0f);
   sizedist.resize(numensembles);
-  values.resize(numensembles);
+
+  // Sort the unbiased diameters by phase so each phase is one contiguous bin, then fit all phases at once
+  std::vector<size_t> phaseOffsets;
+  std::vector<size_t> sortedFeatures;
+  DistributionAnalysisOps::SortIntoBins(numfeatures, numensembles,
+                                        [this, numensembles](size_t f) { return (f == 0 || m_BiasedFeatures[f]) ? numensembles : static_cast<size_t>(m_FeaturePhases[f]); }, phaseOffsets,
+                                        sortedFeatures);
+  std::vector<float> values(sortedFeatures.size());
+  for(size_t k = 0; k < sortedFeatures.size(); k++)
+  {
+    values[k] = m_EquivalentDiameters[sortedFeatures[k]];
+  }
+  std::vector<float> params;
+  m_DistributionAnalysis[m_SizeDistributionFitType]->calculateBinnedParameters(values, phaseOffsets, params);
 
   for(size_t i = 1; i < numensembles; i++)
   {
     sizedist[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_SizeDistributionFitType, 1);
-    values[i].resize(1);
+    for(size_t p = 0; p < DistributionAnalysisOps::k_NumParameters; p++)
+    {
+      sizedist[i][p]->setValue(0, params[i * DistributionAnalysisOps::k_NumParameters + p]);
+    }
   }
 
   float vol = 0.0f;
   for(size_t i = 1; i < numfeatures; i++)
   {
-    if(!m_BiasedFeatures[i])
-    {
-      values[m_FeaturePhases[i]][0].push_back(m_EquivalentDiameters[i]);
-    }
     vol = (1.0f / 6.0f) * SIMPLib::Constants::k_Pi * m_EquivalentDiameters[i] * m_EquivalentDiameters[i] * m_EquivalentDiameters[i];
     fractions[m_FeaturePhases[i]] = fractions[m_FeaturePhases[i]] + vol;
     totalUnbiasedVolume = totalUnbiasedVolume + vol;
@@ -715,9 +731,8 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
       pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
+      DistributionAnalysisOps::determineMaxAndMinValues(values.data() + phaseOffsets[i], phaseOffsets[i + 1] - phaseOffsets[i], maxdiam, mindiam);
       int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
@@ -728,9 +743,8 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
       pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
+      DistributionAnalysisOps::determineMaxAndMinValues(values.data() + phaseOffsets[i], phaseOffsets[i + 1] - phaseOffsets[i], maxdiam, mindiam);
       int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
@@ -741,9 +755,8 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
       tp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
       tp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
+      DistributionAnalysisOps::determineMaxAndMinValues(values.data() + phaseOffsets[i], phaseOffsets[i + 1] - phaseOffsets[i], maxdiam, mindiam);
       int numbins = int(maxdiam / m_SizeCorrelationResolution) + 1;
       tp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
@@ -756,95 +769,130 @@ void GenerateEnsembleStatistics::gatherSizeStats()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherAspectRatioStats()
+void GenerateEnsembleStatistics::sortFeaturesBySizeBin()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> boveras;
-  QVector<VectorOfFloatArray> coveras;
-  std::vector<std::vector<std::vector<float>>> bvalues;
-  std::vector<std::vector<std::vector<float>>> cvalues;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
-  size_t numfeatures = m_AspectRatiosPtr.lock()->getNumberOfTuples();
+  size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
-  boveras.resize(numensembles);
-  coveras.resize(numensembles);
-  bvalues.resize(numensembles);
-  cvalues.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
+  // Phase i owns the size bins [m_EnsembleFirstSizeBin[i], m_EnsembleFirstSizeBin[i + 1]) of the flat layout
+  std::vector<float> mindiams(numensembles, 0.0f);
+  std::vector<float> binsteps(numensembles, 1.0f);
+  m_EnsembleFirstSizeBin.assign(numensembles + 1, 0);
   for(size_t i = 1; i < numensembles; i++)
   {
+    FloatArrayType::Pointer binNumbers;
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
+      binNumbers = pp->getBinNumbers();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
+      binNumbers = pp->getBinNumbers();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      boveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      coveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      bvalues[i].resize(tp->getBinNumbers()->getSize());
-      cvalues[i].resize(tp->getBinNumbers()->getSize());
+      binNumbers = tp->getBinNumbers();
       mindiams[i] = tp->getMinFeatureDiameter();
       binsteps[i] = tp->getBinStepSize();
     }
+    m_EnsembleFirstSizeBin[i + 1] = m_EnsembleFirstSizeBin[i] + (nullptr != binNumbers.get() ? binNumbers->getSize() : 0);
   }
-  for(size_t i = 1; i < numfeatures; i++)
+
+  size_t numBins = m_EnsembleFirstSizeBin[numensembles];
+  auto binOf = [&](size_t f) {
+    if(f == 0 || m_BiasedFeatures[f] || m_FeaturePhases[f] < 1 || static_cast<size_t>(m_FeaturePhases[f]) >= numensembles)
+    {
+      return numBins;
+    }
+    size_t phase = static_cast<size_t>(m_FeaturePhases[f]);
+    float bin = (m_EquivalentDiameters[f] - mindiams[phase]) / binsteps[phase];
+    if(!(bin >= 0.0f) || bin >= static_cast<float>(m_EnsembleFirstSizeBin[phase + 1] - m_EnsembleFirstSizeBin[phase]))
+    {
+      return numBins;
+    }
+    return m_EnsembleFirstSizeBin[phase] + static_cast<size_t>(bin);
+  };
+  DistributionAnalysisOps::SortIntoBins(numfeatures, numBins, binOf, m_SizeBinOffsets, m_SizeBinFeatures);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<VectorOfFloatArray> GenerateEnsembleStatistics::fitSizeBinnedValues(const std::vector<float>& values, int32_t fitType)
+{
+  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+
+  std::vector<float> params;
+  m_DistributionAnalysis[fitType]->calculateBinnedParameters(values, m_SizeBinOffsets, params);
+
+  QVector<VectorOfFloatArray> dists(numensembles);
+  for(size_t i = 1; i < numensembles; i++)
   {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+    if(m_PhaseTypes[i] != static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) && m_PhaseTypes[i] != static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) &&
+       m_PhaseTypes[i] != static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
-      if(!m_BiasedFeatures[i])
+      continue;
+    }
+    size_t firstBin = m_EnsembleFirstSizeBin[i];
+    size_t numBins = m_EnsembleFirstSizeBin[i + 1] - firstBin;
+    dists[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(fitType, numBins);
+    for(size_t b = 0; b < numBins; b++)
+    {
+      for(size_t p = 0; p < DistributionAnalysisOps::k_NumParameters; p++)
       {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        bvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i]);
-        cvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i + 1]);
+        dists[i][p]->setValue(b, params[(firstBin + b) * DistributionAnalysisOps::k_NumParameters + p]);
       }
     }
   }
+  return dists;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateEnsembleStatistics::gatherAspectRatioStats()
+{
+  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+
+  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+
+  std::vector<float> bvalues(m_SizeBinFeatures.size());
+  std::vector<float> cvalues(m_SizeBinFeatures.size());
+  for(size_t k = 0; k < m_SizeBinFeatures.size(); k++)
+  {
+    bvalues[k] = m_AspectRatios[2 * m_SizeBinFeatures[k]];
+    cvalues[k] = m_AspectRatios[2 * m_SizeBinFeatures[k] + 1];
+  }
+  QVector<VectorOfFloatArray> boveras = fitSizeBinnedValues(bvalues, m_AspectRatioDistributionFitType);
+  QVector<VectorOfFloatArray> coveras = fitSizeBinnedValues(cvalues, m_AspectRatioDistributionFitType);
+
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
       pp->setFeatureSize_BOverA(boveras[i]);
       pp->setFeatureSize_COverA(coveras[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
       pp->setFeatureSize_BOverA(boveras[i]);
       pp->setFeatureSize_COverA(coveras[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
       tp->setFeatureSize_BOverA(boveras[i]);
       tp->setFeatureSize_COverA(coveras[i]);
     }
@@ -858,75 +906,30 @@ void GenerateEnsembleStatistics::gatherOmega3Stats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> omega3s;
-  std::vector<std::vector<std::vector<float>>> values;
-  QVector<float> mindiams;
-  QVector<float> binsteps;
-  size_t numfeatures = m_Omega3sPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
-  omega3s.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
-  for(size_t i = 1; i < numensembles; i++)
+  std::vector<float> values(m_SizeBinFeatures.size());
+  for(size_t k = 0; k < m_SizeBinFeatures.size(); k++)
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
-    {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
-    {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      omega3s[i] = tp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
-    }
-  }
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(m_Omega3s[i]);
-      }
-    }
+    values[k] = m_Omega3s[m_SizeBinFeatures[k]];
   }
+  QVector<VectorOfFloatArray> omega3s = fitSizeBinnedValues(values, m_Omega3DistributionFitType);
+
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
       pp->setFeatureSize_Omegas(omega3s[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
       pp->setFeatureSize_Omegas(omega3s[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
       tp->setFeatureSize_Omegas(omega3s[i]);
     }
   }
@@ -939,76 +942,30 @@ void GenerateEnsembleStatistics::gatherNeighborhoodStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> neighborhoods;
-  std::vector<std::vector<std::vector<float>>> values;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
-  size_t numfeatures = m_NeighborhoodsPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
-  neighborhoods.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
-  for(size_t i = 1; i < numensembles; i++)
+  std::vector<float> values(m_SizeBinFeatures.size());
+  for(size_t k = 0; k < m_SizeBinFeatures.size(); k++)
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
-    {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
-    {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
-    }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      neighborhoods[i] = tp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
-    }
+    values[k] = static_cast<float>(m_Neighborhoods[m_SizeBinFeatures[k]]);
   }
+  QVector<VectorOfFloatArray> neighborhoods = fitSizeBinnedValues(values, m_NeighborhoodDistributionFitType);
 
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(static_cast<float>(m_Neighborhoods[i]));
-      }
-    }
-  }
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
       pp->setFeatureSize_Neighbors(neighborhoods[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
       pp->setFeatureSize_Clustering(neighborhoods[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
       tp->setFeatureSize_Neighbors(neighborhoods[i]);
     }
   }
@@ -1425,10 +1382,19 @@ void GenerateEnsembleStatistics::execute()
     m_StatsDataArray->fillArrayWithNewStatsData(m_PhaseTypesPtr.lock()->getNumberOfTuples(), m_PhaseTypes);
   }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("GenerateEnsembleStatistics"));
+#endif
+
   if(m_ComputeSizeDistribution)
   {
     gatherSizeStats();
   }
+  // The size bins are set by the size distribution, so the size binned statistics share one sort made after it
+  if(m_ComputeAspectRatioDistribution || m_ComputeOmega3Distribution || m_ComputeNeighborhoodDistribution)
+  {
+    sortFeaturesBySizeBin();
+  }
   if(m_ComputeAspectRatioDistribution)
   {
     gatherAspectRatioStats();
@@ -326,6 +326,20 @@ protected:
    */
   void gatherSizeStats();
 
+  /**
+   * @brief sortFeaturesBySizeBin Sorts the unbiased Features of the primary, precipitate and transformation phases
+   * by phase and size bin in one pass, so the size binned statistics fit flat, contiguous bins
+   */
+  void sortFeaturesBySizeBin();
+
+  /**
+   * @brief fitSizeBinnedValues Fits all size bins of all phases in parallel
+   * @param values Feature values in the order of the size bin sort
+   * @param fitType Distribution to fit
+   * @return Fitted parameters of each size binned phase, indexed by phase
+   */
+  QVector<VectorOfFloatArray> fitSizeBinnedValues(const std::vector<float>& values, int32_t fitType);
+
   /**
    * @brief gatherAspectRatioStats Consolidates Feature aspect ratio statistics
    */
@@ -392,6 +406,10 @@ private:
 
   QVector<DistributionAnalysisOps::Pointer> m_DistributionAnalysis;
 
+  std::vector<size_t> m_SizeBinFeatures;
+  std::vector<size_t> m_SizeBinOffsets;
+  std::vector<size_t> m_EnsembleFirstSizeBin;
+
 public:
   GenerateEnsembleStatistics(const GenerateEnsembleStatistics&) = delete; // Copy Constructor Not Implemented
   GenerateEnsembleStatistics(GenerateEnsembleStatistics&&) = delete;      // Move Constructor Not Implemented
@@ -0,0 +1,313 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+// Directly include the .cpp files instead of the headers because of the way the unit
+// tests are compiled.
+#include "DistributionAnalysisOps/BetaOps.cpp"
+#include "DistributionAnalysisOps/DistributionAnalysisOps.cpp"
+#include "DistributionAnalysisOps/LogNormalOps.cpp"
+#include "DistributionAnalysisOps/PowerLawOps.cpp"
+
+class DistributionAnalysisOpsTest
+{
+public:
+  DistributionAnalysisOpsTest() = default;
+  virtual ~DistributionAnalysisOpsTest() = default;
+
+  SIMPL_TYPE_MACRO(DistributionAnalysisOpsTest)
+
+  // -----------------------------------------------------------------------------
+  // Bin 0 and the last bin are empty, bin 1 holds a single value and bin 2 holds five equal values. The other
+  // bins hold random values in (0, 1) so every fit is defined, and are large enough to use all four partial sums.
+  // -----------------------------------------------------------------------------
+  void createBins(std::vector<std::vector<float>>& bins)
+  {
+    std::mt19937 generator(5489u);
+    std::uniform_real_distribution<float> distribution(0.05f, 0.95f);
+    const size_t binSizes[] = {0, 1, 5, 2, 3, 7, 100, 1001, 0};
+    bins.clear();
+    for(size_t count : binSizes)
+    {
+      std::vector<float> bin(count, 0.0f);
+      for(size_t i = 0; i < count; i++)
+      {
+        bin[i] = distribution(generator);
+      }
+      bins.push_back(bin);
+    }
+    bins[2].assign(5, 0.5f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSortIntoBins()
+  {
+    // Item i falls in bin (i * 7) % 5, where bin 4 is past the end and leaves the item out
+    const size_t numItems = 23;
+    const size_t numBins = 4;
+    auto binOf = [](size_t i) { return (i * 7) % 5; };
+    std::vector<size_t> binOffsets;
+    std::vector<size_t> sortedItems;
+    DistributionAnalysisOps::SortIntoBins(numItems, numBins, binOf, binOffsets, sortedItems);
+
+    DREAM3D_REQUIRE_EQUAL(binOffsets.size(), numBins + 1);
+    DREAM3D_REQUIRE_EQUAL(binOffsets[0], 0);
+    DREAM3D_REQUIRE_EQUAL(binOffsets[numBins], sortedItems.size());
+    size_t k = 0;
+    for(size_t b = 0; b < numBins; b++)
+    {
+      // Every bin lists its items in increasing order
+      for(size_t i = 0; i < numItems; i++)
+      {
+        if(binOf(i) == b)
+        {
+          DREAM3D_REQUIRE_EQUAL(sortedItems[k], i);
+          k++;
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(binOffsets[b + 1], k);
+    }
+    DREAM3D_REQUIRE_EQUAL(k, sortedItems.size());
+
+    DistributionAnalysisOps::SortIntoBins(0, numBins, binOf, binOffsets, sortedItems);
+    DREAM3D_REQUIRE_EQUAL(binOffsets.size(), numBins + 1);
+    DREAM3D_REQUIRE_EQUAL(binOffsets[numBins], 0);
+    DREAM3D_REQUIRE_EQUAL(sortedItems.size(), 0);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fits the bins both through the bin sorted layout and through the vector per bin path, which must agree
+  // exactly, and returns the parameters of the bin sorted layout
+  // -----------------------------------------------------------------------------
+  std::vector<float> fitBins(DistributionAnalysisOps* ops, std::vector<std::vector<float>>& bins)
+  {
+    std::vector<float> values;
+    std::vector<size_t> binOffsets(1, 0);
+    for(const std::vector<float>& bin : bins)
+    {
+      values.insert(values.end(), bin.begin(), bin.end());
+      binOffsets.push_back(values.size());
+    }
+    std::vector<float> params;
+    ops->calculateBinnedParameters(values, binOffsets, params);
+    DREAM3D_REQUIRE_EQUAL(params.size(), bins.size() * DistributionAnalysisOps::k_NumParameters);
+
+    VectorOfFloatArray outputs;
+    for(size_t p = 0; p < DistributionAnalysisOps::k_NumParameters; p++)
+    {
+      outputs.push_back(FloatArrayType::CreateArray(bins.size(), QString("Parameter %1").arg(p), true));
+    }
+    DREAM3D_REQUIRE_EQUAL(ops->calculateCorrelatedParameters(bins, outputs), 0);
+    for(size_t b = 0; b < bins.size(); b++)
+    {
+      for(size_t p = 0; p < DistributionAnalysisOps::k_NumParameters; p++)
+      {
+        DREAM3D_REQUIRE_EQUAL(params[b * DistributionAnalysisOps::k_NumParameters + p], outputs[p]->getValue(b));
+      }
+
+      // A single bin through the vector path gives the same parameters as well
+      FloatArrayType::Pointer single = FloatArrayType::CreateArray(DistributionAnalysisOps::k_NumParameters, "Parameters", true);
+      DREAM3D_REQUIRE_EQUAL(ops->calculateParameters(bins[b], single), 0);
+      for(size_t p = 0; p < DistributionAnalysisOps::k_NumParameters; p++)
+      {
+        DREAM3D_REQUIRE_EQUAL(params[b * DistributionAnalysisOps::k_NumParameters + p], single->getValue(p));
+      }
+    }
+
+    // No bins at all
+    std::vector<float> noParams(3, 1.0f);
+    ops->calculateBinnedParameters(std::vector<float>(), std::vector<size_t>(1, 0), noParams);
+    DREAM3D_REQUIRE_EQUAL(noParams.size(), 0);
+    return params;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void requireClose(double value, double expected)
+  {
+    DREAM3D_REQUIRE(std::fabs(value - expected) <= 1.0E-4 * std::max(1.0, std::fabs(expected)));
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLogNormalOps()
+  {
+    std::vector<std::vector<float>> bins;
+    createBins(bins);
+    LogNormalOps::Pointer ops = LogNormalOps::New();
+    std::vector<float> params = fitBins(ops.get(), bins);
+
+    DREAM3D_REQUIRE_EQUAL(params[0], 0.0f);
+    DREAM3D_REQUIRE_EQUAL(params[1], 0.0f);
+    // A single value is stored as is
+    DREAM3D_REQUIRE_EQUAL(params[2], bins[1][0]);
+    DREAM3D_REQUIRE_EQUAL(params[3], 0.0f);
+    requireClose(params[4], std::log(0.5));
+    requireClose(params[5], 0.0);
+    DREAM3D_REQUIRE_EQUAL(params[16], 0.0f);
+    DREAM3D_REQUIRE_EQUAL(params[17], 0.0f);
+
+    // Mean and standard deviation of the logs, computed in two passes
+    for(size_t b = 3; b + 1 < bins.size(); b++)
+    {
+      double mean = 0.0;
+      for(float v : bins[b])
+      {
+        mean += std::log(static_cast<double>(v));
+      }
+      mean /= bins[b].size();
+      double variance = 0.0;
+      for(float v : bins[b])
+      {
+        variance += (std::log(static_cast<double>(v)) - mean) * (std::log(static_cast<double>(v)) - mean);
+      }
+      variance /= bins[b].size();
+      requireClose(params[2 * b], mean);
+      requireClose(params[2 * b + 1], std::sqrt(variance));
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestBetaOps()
+  {
+    std::vector<std::vector<float>> bins;
+    createBins(bins);
+    BetaOps::Pointer ops = BetaOps::New();
+    std::vector<float> params = fitBins(ops.get(), bins);
+
+    // Empty, single value and zero variance bins have no fit
+    for(size_t b : {0, 1, 2, 8})
+    {
+      DREAM3D_REQUIRE_EQUAL(params[2 * b], 0.0f);
+      DREAM3D_REQUIRE_EQUAL(params[2 * b + 1], 0.0f);
+    }
+
+    // Method of moments estimate, computed in two passes
+    for(size_t b = 3; b + 1 < bins.size(); b++)
+    {
+      double mean = 0.0;
+      for(float v : bins[b])
+      {
+        mean += v;
+      }
+      mean /= bins[b].size();
+      double variance = 0.0;
+      for(float v : bins[b])
+      {
+        variance += (v - mean) * (v - mean);
+      }
+      variance /= bins[b].size();
+      double factor = mean * (1.0 - mean) / variance - 1.0;
+      requireClose(params[2 * b], mean * factor);
+      requireClose(params[2 * b + 1], (1.0 - mean) * factor);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPowerLawOps()
+  {
+    std::vector<std::vector<float>> bins;
+    createBins(bins);
+    PowerLawOps::Pointer ops = PowerLawOps::New();
+    std::vector<float> params = fitBins(ops.get(), bins);
+
+    for(size_t b : {0, 1, 8})
+    {
+      DREAM3D_REQUIRE_EQUAL(params[2 * b], 0.0f);
+      DREAM3D_REQUIRE_EQUAL(params[2 * b + 1], 0.0f);
+    }
+    // Equal values sum to no log ratio at all, which leaves alpha at 1
+    DREAM3D_REQUIRE_EQUAL(params[4], 1.0f);
+    DREAM3D_REQUIRE_EQUAL(params[5], 0.5f);
+
+    // Maximum likelihood estimate over the smallest value of the bin
+    for(size_t b = 3; b + 1 < bins.size(); b++)
+    {
+      float min = *std::min_element(bins[b].begin(), bins[b].end());
+      double sum = 0.0;
+      for(float v : bins[b])
+      {
+        sum += std::log(static_cast<double>(v) / min);
+      }
+      DREAM3D_REQUIRE_EQUAL(params[2 * b + 1], min);
+      requireClose(params[2 * b], 1.0 + bins[b].size() / sum);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestSortIntoBins());
+    DREAM3D_REGISTER_TEST(TestLogNormalOps());
+    DREAM3D_REGISTER_TEST(TestBetaOps());
+    DREAM3D_REGISTER_TEST(TestPowerLawOps());
+  }
+
+public:
+  DistributionAnalysisOpsTest(const DistributionAnalysisOpsTest&) = delete;            // Copy Constructor Not Implemented
+  DistributionAnalysisOpsTest(DistributionAnalysisOpsTest&&) = delete;                 // Move Constructor Not Implemented
+  DistributionAnalysisOpsTest& operator=(const DistributionAnalysisOpsTest&) = delete; // Copy Assignment Not Implemented
+  DistributionAnalysisOpsTest& operator=(DistributionAnalysisOpsTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,6 +35,8 @@
 
 #include "CalculateTriangleGroupCurvatures.h"
 
+#include <algorithm>
+
 #include <QtCore/QtGlobal>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -56,7 +58,8 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
                                                                    DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1,
                                                                    DoubleArrayType::Pointer principleDirection2, DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature,
                                                                    TriangleGeom::Pointer trianglesGeom, DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
-                                                                   DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids, AbstractFilter* parent)
+                                                                   DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids, TriangleAdjacency::Pointer adjacency,
+                                                                   AbstractFilter* parent)
 : m_NRing(nring)
 , m_TriangleIds(triangleIds)
 , m_UseNormalsForCurveFitting(useNormalsForCurveFitting)
@@ -70,6 +73,7 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
 , m_SurfaceMeshFaceLabels(surfaceMeshFaceLabels)
 , m_SurfaceMeshFaceNormals(surfaceMeshFaceNormals)
 , m_SurfaceMeshTriangleCentroids(surfaceMeshTriangleCentroids)
+, m_Adjacency(adjacency)
 , m_ParentFilter(parent)
 {
 }
@@ -79,21 +83,6 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
 // -----------------------------------------------------------------------------
 CalculateTriangleGroupCurvatures::~CalculateTriangleGroupCurvatures() = default;
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void subtractVector3d(DataArray<double>::Pointer data, double* v)
-{
-  size_t count = data->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    double* ptr = data->getPointer(i * 3);
-    ptr[0] = ptr[0] - v[0];
-    ptr[1] = ptr[1] - v[1];
-    ptr[2] = ptr[2] - v[2];
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -129,37 +118,70 @@ void CalculateTriangleGroupCurvatures::operator()() const
   bool computeMean = (m_MeanCurvature.get() != nullptr);
   bool computeDirection = (m_PrincipleDirection1.get() != nullptr);
 
+  nRingNeighborAlg->setRegionId0(feature0);
+  nRingNeighborAlg->setRegionId1(feature1);
+  nRingNeighborAlg->setRing(m_NRing);
+
+  // Gather the n-ring patch of every triangle in the group up front. The patches are stored back to back
+  // with the seed triangle first in each one.
   std::vector<int64_t>::size_type tCount = m_TriangleIds.size();
-  // For each triangle in the group
+  std::vector<size_t> patchOffsets(tCount + 1, 0);
+  std::vector<int64_t> patchTriangles;
+  std::vector<int64_t> patch;
   for(std::vector<int64_t>::size_type i = 0; i < tCount; ++i)
   {
     if(m_ParentFilter->getCancel() == true)
     {
       return;
     }
-    int64_t triId = m_TriangleIds[i];
-    nRingNeighborAlg->setTriangleId(triId);
-    nRingNeighborAlg->setRegionId0(feature0);
-    nRingNeighborAlg->setRegionId1(feature1);
-    nRingNeighborAlg->setRing(m_NRing);
-    err = nRingNeighborAlg->generate(m_TrianglesPtr, faceLabels);
+    nRingNeighborAlg->setTriangleId(m_TriangleIds[i]);
+    err = nRingNeighborAlg->generate(*m_Adjacency, faceLabels, patch);
     Q_ASSERT(err >= 0);
+    Q_ASSERT(patch.size() > 1);
+    patchTriangles.insert(patchTriangles.end(), patch.begin(), patch.end());
+    patchOffsets[i + 1] = patchTriangles.size();
+  }
 
-    UniqueFaceIds_t triPatch = nRingNeighborAlg->getNRingTriangles();
-    Q_ASSERT(triPatch.size() > 1);
+  // Fit the patches in order of size so the scratch matrices below only change shape when the patch size does
+  std::vector<size_t> fitOrder(tCount);
+  for(size_t i = 0; i < tCount; ++i)
+  {
+    fitOrder[i] = i;
+  }
+  std::stable_sort(fitOrder.begin(), fitOrder.end(), [&](size_t a, size_t b) { return (patchOffsets[a + 1] - patchOffsets[a]) < (patchOffsets[b + 1] - patchOffsets[b]); });
 
-    DataArray<double>::Pointer patchCentroids = extractPatchData(triId, triPatch, m_SurfaceMeshTriangleCentroids->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Centroids"));
-    DataArray<double>::Pointer patchNormals = extractPatchData(triId, triPatch, m_SurfaceMeshFaceNormals->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Normals"));
+  static const uint32_t NO_NORMALS = 3;
+  static const uint32_t USE_NORMALS = 7;
+  uint32_t cols = NO_NORMALS;
+  if(m_UseNormalsForCurveFitting == true)
+  {
+    cols = USE_NORMALS;
+  }
+  Eigen::MatrixXd A;
+  Eigen::VectorXd b;
+  Eigen::VectorXd sln1(cols);
+  Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr;
 
-    // Translate the patch to the 0,0,0 origin
-    double sub[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    subtractVector3d(patchCentroids, sub);
+  double* centroids = m_SurfaceMeshTriangleCentroids->getPointer(0);
+  double* normals = m_SurfaceMeshFaceNormals->getPointer(0);
 
-    double np[3] = {patchNormals->getComponent(0, 0), patchNormals->getComponent(0, 1), patchNormals->getComponent(0, 2)};
+  // For each triangle in the group
+  for(std::vector<size_t>::size_type f = 0; f < tCount; ++f)
+  {
+    if(m_ParentFilter->getCancel() == true)
+    {
+      return;
+    }
+    size_t i = fitOrder[f];
+    int64_t triId = m_TriangleIds[i];
+    const int64_t* triPatch = patchTriangles.data() + patchOffsets[i];
+    Eigen::MatrixXd::Index rows = static_cast<Eigen::MatrixXd::Index>(patchOffsets[i + 1] - patchOffsets[i]);
 
-    double seedCentroid[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    double firstCentroid[3] = {patchCentroids->getComponent(1, 0), patchCentroids->getComponent(1, 1), patchCentroids->getComponent(1, 2)};
+    // The patch is translated so the seed centroid sits at the 0,0,0 origin
+    double* seedCentroid = centroids + triId * 3;
+    double* firstCentroid = centroids + triPatch[1] * 3;
 
+    double np[3] = {normals[triId * 3], normals[triId * 3 + 1], normals[triId * 3 + 2]};
     double temp[3] = {firstCentroid[0] - seedCentroid[0], firstCentroid[1] - seedCentroid[1], firstCentroid[2] - seedCentroid[2]};
     double vp[3] = {0.0, 0.0, 0.0};
 
@@ -174,72 +196,49 @@ void CalculateTriangleGroupCurvatures::operator()() const
 
     // this constitutes a rotation matrix to a local coordinate system
     double rot[3][3] = {{up[0], up[1], up[2]}, {vp[0], vp[1], vp[2]}, {np[0], np[1], np[2]}};
-    double out[3] = {0.0, 0.0, 0.0};
-    // Transform all centroids and normals to new coordinate system
-    for(size_t m = 0; m < patchCentroids->getNumberOfTuples(); ++m)
-    {
-      ::memcpy(out, patchCentroids->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchCentroids->getPointer(m * 3), out);
-      ::memcpy(patchCentroids->getPointer(m * 3), out, 3 * sizeof(double));
-
-      ::memcpy(out, patchNormals->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchNormals->getPointer(m * 3), out);
-      ::memcpy(patchNormals->getPointer(m * 3), out, 3 * sizeof(double));
-
-      // We rotate the normals now but we dont use them yet. If we start using part 3 of Goldfeathers paper then we
-      // will need the normals.
-    }
 
     {
-      // Solve the Least Squares fit
-      static const uint32_t NO_NORMALS = 3;
-      static const uint32_t USE_NORMALS = 7;
-      uint32_t cols = NO_NORMALS;
-      if(m_UseNormalsForCurveFitting == true)
+      // Solve the Least Squares fit. The patch centroids are transformed into the local coordinate system
+      // as the rows are written. The patch normals would only be needed if we start using part 3 of
+      // Goldfeathers paper so they are not transformed.
+      if(A.rows() != rows)
       {
-        cols = USE_NORMALS;
+        A.resize(rows, cols);
+        b.resize(rows);
       }
-      size_t rows = patchCentroids->getNumberOfTuples();
-      Eigen::MatrixXd A(rows, cols);
-      Eigen::VectorXd b(rows);
+      double local[3] = {0.0, 0.0, 0.0};
+      double out[3] = {0.0, 0.0, 0.0};
       double x = 0.0, y = 0.0, z = 0.0;
-      for(size_t m = 0; m < rows; ++m)
+      for(Eigen::MatrixXd::Index m = 0; m < rows; ++m)
       {
-        x = patchCentroids->getComponent(m, 0);
-        y = patchCentroids->getComponent(m, 1);
-        z = patchCentroids->getComponent(m, 2);
-
-        A(m) = 0.5 * x * x;            // 1/2 x^2
-        A(m + rows) = x * y;           // x*y
-        A(m + rows * 2) = 0.5 * y * y; // 1/2 y^2
+        double* c = centroids + triPatch[m] * 3;
+        local[0] = c[0] - seedCentroid[0];
+        local[1] = c[1] - seedCentroid[1];
+        local[2] = c[2] - seedCentroid[2];
+        MatrixMath::Multiply3x3with3x1(rot, local, out);
+        x = out[0];
+        y = out[1];
+        z = out[2];
+
+        A(m, 0) = 0.5 * x * x; // 1/2 x^2
+        A(m, 1) = x * y;       // x*y
+        A(m, 2) = 0.5 * y * y; // 1/2 y^2
         if(m_UseNormalsForCurveFitting == true)
         {
-          A(m + rows * 3) = x * x * x;
-          A(m + rows * 4) = x * x * y;
-          A(m + rows * 5) = x * y * y;
-          A(m + rows * 6) = y * y * y;
+          A(m, 3) = x * x * x;
+          A(m, 4) = x * x * y;
+          A(m, 5) = x * y * y;
+          A(m, 6) = y * y * y;
         }
         b[m] = z; // The Z Values
       }
 
+      // Now that we have the A, B, C (and D, E, F & G when using normals) constants we can solve the
+      // Eigen value/vector problem to get the principal curvatures and pricipal directions.
+      qr.compute(A);
+      sln1 = qr.solve(b);
       Eigen::Matrix2d M;
-
-      if(false == m_UseNormalsForCurveFitting)
-      {
-        typedef Eigen::Matrix<double, NO_NORMALS, 1> Vector3d;
-        Vector3d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
-      }
-      else
-      {
-        typedef Eigen::Matrix<double, USE_NORMALS, 1> Vector7d;
-        Vector7d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C, D, E, F & G constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
-      }
+      M << sln1(0), sln1(1), sln1(1), sln1(2);
 
       Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(M);
       Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::RealVectorType eValues = eig.eigenvalues();
@@ -280,32 +279,3 @@ void CalculateTriangleGroupCurvatures::operator()() const
     }
   } // End Loop over this triangle
 }
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const
-{
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer extractedData = DataArray<double>::CreateArray(triPatch.size(), cDims, name);
-  // This little chunk makes sure the current seed triangles centroid and normal data appear
-  // first in the returned arrays which makes the next steps a tad easier.
-  int32_t i = 0;
-  extractedData->setComponent(i, 0, data[triId * 3]);
-  extractedData->setComponent(i, 1, data[triId * 3 + 1]);
-  extractedData->setComponent(i, 2, data[triId * 3 + 2]);
-  ++i;
-  triPatch.erase(triId);
-
-  for(UniqueFaceIds_t::iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
-  {
-    int64_t t = *iter;
-    extractedData->setComponent(i, 0, data[t * 3]);
-    extractedData->setComponent(i, 1, data[t * 3 + 1]);
-    extractedData->setComponent(i, 2, data[t * 3 + 2]);
-    ++i;
-  }
-  triPatch.insert(triId);
-
-  return extractedData;
-}
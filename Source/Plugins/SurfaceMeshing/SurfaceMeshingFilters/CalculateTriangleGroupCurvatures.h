@@ -35,16 +35,20 @@
 
 #pragma once
 
-#include <set>
+#include <vector>
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/SIMPLib.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/TriangleAdjacency.h"
+
 /**
  * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a group of triangles
  * where each triangle in the group will have the 2 Principal Curvature values computed and optionally
- * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed.
+ * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed. The n-ring patches are
+ * gathered from a shared TriangleAdjacency and the least squares fits of the group reuse one set of scratch matrices.
  */
 class CalculateTriangleGroupCurvatures
 {
@@ -53,27 +57,15 @@ public:
                                    DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2,
                                    DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature, TriangleGeom::Pointer trianglesGeom,
                                    DataArray<int32_t>::Pointer surfaceMeshFaceLabels, DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids,
-                                   AbstractFilter* parent);
+                                   TriangleAdjacency::Pointer adjacency, AbstractFilter* parent);
 
   virtual ~CalculateTriangleGroupCurvatures();
 
   void operator()() const;
 
-  typedef std::set<int64_t> UniqueFaceIds_t;
-
 protected:
   CalculateTriangleGroupCurvatures();
 
-  /**
-   * @brief extractPatchData Extracts out the needed data values from the global arrays
-   * @param triId The seed triangle Id
-   * @param triPatch The group of triangles being used
-   * @param data The data to extract from
-   * @param name The name of the data array being used
-   * @return Shared pointer to the extracted data
-   */
-  DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const;
-
 private:
   int64_t m_NRing;
   std::vector<int64_t> m_TriangleIds;
@@ -88,6 +80,7 @@ private:
   DataArray<int32_t>::Pointer m_SurfaceMeshFaceLabels;
   DataArray<double>::Pointer m_SurfaceMeshFaceNormals;
   DataArray<double>::Pointer m_SurfaceMeshTriangleCentroids;
+  TriangleAdjacency::Pointer m_Adjacency;
   AbstractFilter* m_ParentFilter;
 };
 
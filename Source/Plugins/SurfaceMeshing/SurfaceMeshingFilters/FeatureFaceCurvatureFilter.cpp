@@ -49,7 +49,10 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "CalculateTriangleGroupCurvatures.h"
+#include "TriangleAdjacency.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -360,14 +363,6 @@ void FeatureFaceCurvatureFilter::execute()
   // Just to double check we have everything.
   int64_t numTriangles = triangleGeom->getNumberOfTris();
 
-  // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
-  // assert if the data is NOT in the SurfaceMesh Data Container
-  ElementDynamicList::Pointer vertLinks = triangleGeom->getElementsContainingVert();
-  if(nullptr == vertLinks.get())
-  {
-    triangleGeom->findElementsContainingVert();
-  }
-
   // get the QMap from the SharedFeatureFaces filter
   SharedFeatureFaces_t sharedFeatureFaces;
 
@@ -404,10 +399,19 @@ void FeatureFaceCurvatureFilter::execute()
   m_CompletedFeatureFaces = 0;
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("FeatureFaceCurvatureFilter"));
   bool doParallel = true;
 #endif
 
+  // Build the vertex and triangle connectivity once; every feature face group walks its n-rings on it
+  TriangleAdjacency::Pointer adjacency = TriangleAdjacency::New();
+  if(adjacency->build(triangleGeom) < 0)
+  {
+    QString ss = QObject::tr("Error building the triangle connectivity for the surface mesh");
+    setErrorCondition(-1010, ss);
+    return;
+  }
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   std::shared_ptr<tbb::task_group> g(new tbb::task_group);
 #else
@@ -428,7 +432,7 @@ void FeatureFaceCurvatureFilter::execute()
       g->run(CalculateTriangleGroupCurvatures(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
                                               m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
                                               m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                              m_SurfaceMeshTriangleCentroidsPtr.lock(), this));
+                                              m_SurfaceMeshTriangleCentroidsPtr.lock(), adjacency, this));
     }
     else
 #endif
@@ -436,7 +440,7 @@ void FeatureFaceCurvatureFilter::execute()
       CalculateTriangleGroupCurvatures curvature(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
                                                  m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
                                                  m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                                 m_SurfaceMeshTriangleCentroidsPtr.lock(), this);
+                                                 m_SurfaceMeshTriangleCentroidsPtr.lock(), adjacency, this);
       curvature();
     }
   }
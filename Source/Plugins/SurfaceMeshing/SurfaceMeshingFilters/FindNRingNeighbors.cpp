@@ -36,6 +36,8 @@
 
 #include "FindNRingNeighbors.h"
 
+#include <algorithm>
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -143,3 +145,59 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
   }
   return err;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FindNRingNeighbors::generate(const TriangleAdjacency& adjacency, const int32_t* faceLabels, std::vector<int64_t>& patch)
+{
+  patch.clear();
+
+  bool check0 = faceLabels[m_TriangleId * 2] == m_RegionId0 && faceLabels[m_TriangleId * 2 + 1] == m_RegionId1;
+  bool check1 = faceLabels[m_TriangleId * 2 + 1] == m_RegionId0 && faceLabels[m_TriangleId * 2] == m_RegionId1;
+  if(!check0 && !check1)
+  {
+    qDebug() << "FindNRingNeighbors Seed triangle ID does not have a matching Region ID for " << m_RegionId0 << " & " << m_RegionId1 << "\n";
+    qDebug() << "Region Ids are: " << faceLabels[m_TriangleId * 2] << " & " << faceLabels[m_TriangleId * 2 + 1] << "\n";
+    return 0;
+  }
+
+  TriangleAdjacency::VisitMarks& visitMarks = adjacency.getLocalVisitMarks();
+  uint32_t epoch = adjacency.beginVisit(visitMarks);
+  uint32_t* marks = visitMarks.marks.data();
+
+  // The patch doubles as the breadth first queue; [ringStart, ringEnd) is the ring being expanded
+  patch.push_back(m_TriangleId);
+  marks[m_TriangleId] = epoch;
+  size_t ringStart = 0;
+  for(int64_t ring = 0; ring < m_Ring; ++ring)
+  {
+    size_t ringEnd = patch.size();
+    for(size_t p = ringStart; p < ringEnd; ++p)
+    {
+      int64_t triangleIdx = patch[p];
+      int64_t nCount = adjacency.getNumberOfTriangleNeighbors(triangleIdx);
+      const int64_t* neighbors = adjacency.getTriangleNeighbors(triangleIdx);
+      for(int64_t n = 0; n < nCount; ++n)
+      {
+        int64_t tid = neighbors[n];
+        if(marks[tid] == epoch)
+        {
+          continue;
+        }
+        check0 = faceLabels[tid * 2] == m_RegionId0 && faceLabels[tid * 2 + 1] == m_RegionId1;
+        check1 = faceLabels[tid * 2 + 1] == m_RegionId0 && faceLabels[tid * 2] == m_RegionId1;
+        if(check0 || check1)
+        {
+          marks[tid] = epoch;
+          patch.push_back(tid);
+        }
+      }
+    }
+    ringStart = ringEnd;
+  }
+
+  // Keep the same ordering the set based walk produced so downstream local frames are unchanged
+  std::sort(patch.begin() + 1, patch.end());
+  return 0;
+}
@@ -37,11 +37,14 @@
 #pragma once
 
 #include <set>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/TriangleAdjacency.h"
+
 /**
  * @brief The FindNRingNeighbors class calculates the set of triangles that are "N" rings (based on vertex) from a seed triangle
  */
@@ -94,6 +97,17 @@ class FindNRingNeighbors
      */
     int32_t generate(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels);
 
+    /**
+     * @brief generate Generates the N rings by walking a prebuilt TriangleAdjacency. Visited triangles are
+     * tracked with the calling thread's epoch stamped marks, so this may be called concurrently on separate
+     * FindNRingNeighbors instances sharing one adjacency.
+     * @param adjacency Triangle to triangle connectivity of the TriangleGeom
+     * @param faceLabels Feature Id labels for the TriangleGeom
+     * @param patch Output list holding the seed triangle first followed by the remaining ring triangles in ascending Id order
+     * @return Integer error value
+     */
+    int32_t generate(const TriangleAdjacency& adjacency, const int32_t* faceLabels, std::vector<int64_t>& patch);
+
     SIMPL_INSTANCE_PROPERTY(bool, WriteBinaryFile)
     SIMPL_INSTANCE_PROPERTY(bool, WriteConformalMesh)
 
@@ -35,12 +35,24 @@
 
 #include "SharedFeatureFaceFilter.h"
 
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
@@ -51,6 +63,108 @@ enum createdPathID : RenameDataPath::DataID_t
   AttributeMatrixID21 = 21,
 };
 
+namespace
+{
+/**
+ * @brief A triangle tagged with the packed (smaller label, larger label) pair of the feature face it belongs to
+ */
+struct FaceKeyRecord
+{
+  uint64_t key;
+  int64_t tri;
+};
+
+/**
+ * @brief A run of FaceKeyRecords sharing one key once the records are sorted
+ */
+struct FaceGroup
+{
+  int64_t start;
+  int64_t count;
+};
+
+/**
+ * @brief The SharedFeatureFaceKeysImpl class packs the face labels of a range of triangles into FaceKeyRecords
+ */
+class SharedFeatureFaceKeysImpl
+{
+public:
+  SharedFeatureFaceKeysImpl(const int32_t* faceLabels, FaceKeyRecord* records)
+  : m_FaceLabels(faceLabels)
+  , m_Records(records)
+  {
+  }
+  virtual ~SharedFeatureFaceKeysImpl() = default;
+
+  void compute(int64_t start, int64_t end) const
+  {
+    for(int64_t t = start; t < end; t++)
+    {
+      int32_t fl0 = m_FaceLabels[t * 2];
+      int32_t fl1 = m_FaceLabels[t * 2 + 1];
+      if(fl1 < fl0)
+      {
+        std::swap(fl0, fl1);
+      }
+      m_Records[t].key = (static_cast<uint64_t>(static_cast<uint32_t>(fl0)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(fl1));
+      m_Records[t].tri = t;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FaceLabels;
+  FaceKeyRecord* m_Records;
+};
+
+/**
+ * @brief The SharedFeatureFaceIdsImpl class writes the feature face Id of a range of groups onto their triangles
+ */
+class SharedFeatureFaceIdsImpl
+{
+public:
+  SharedFeatureFaceIdsImpl(const FaceKeyRecord* records, const FaceGroup* groups, int32_t* featureFaceIds)
+  : m_Records(records)
+  , m_Groups(groups)
+  , m_FeatureFaceIds(featureFaceIds)
+  {
+  }
+  virtual ~SharedFeatureFaceIdsImpl() = default;
+
+  void compute(int64_t start, int64_t end) const
+  {
+    for(int64_t g = start; g < end; g++)
+    {
+      const FaceKeyRecord* record = m_Records + m_Groups[g].start;
+      const FaceKeyRecord* recordEnd = record + m_Groups[g].count;
+      int32_t faceId = static_cast<int32_t>(g + 1);
+      for(; record != recordEnd; ++record)
+      {
+        m_FeatureFaceIds[record->tri] = faceId;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const FaceKeyRecord* m_Records;
+  const FaceGroup* m_Groups;
+  int32_t* m_FeatureFaceIds;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -202,72 +316,93 @@ void SharedFeatureFaceFilter::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t totalPoints = triangleGeom->getNumberOfTris();
 
-  QMap<uint64_t, int32_t> faceSizeMap;
-  QMap<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
-  int32_t index = 1;
-  struct
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("SharedFeatureFaceFilter"));
+  bool doParallel = true;
+#endif
+
+  // Tag every triangle with its packed label pair and sort on (key, triangle). Each key then forms one
+  // contiguous run whose first record is the lowest triangle carrying that label pair.
+  std::vector<FaceKeyRecord> records(totalPoints);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    int g;
-    int r;
-  } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
-  int32_t fl0 = -1;
-  int32_t fl1 = -1;
-
-  std::vector<std::pair<int32_t, int32_t>> faceLabelMap;
-  faceLabelMap.push_back(std::pair<int32_t, int32_t>(0, 0));
-
-  // Loop through all the Triangles and figure out how many triangles we have in each one.
-  for(int64_t t = 0; t < totalPoints; ++t)
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, totalPoints), SharedFeatureFaceKeysImpl(m_SurfaceMeshFaceLabels, records.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
   {
-    fl0 = m_SurfaceMeshFaceLabels[t * 2];
-    fl1 = m_SurfaceMeshFaceLabels[t * 2 + 1];
-    if(fl0 < fl1)
-    {
-      faceId.g = fl0;
-      faceId.r = fl1;
-    }
-    else
-    {
-      faceId.g = fl1;
-      faceId.r = fl0;
-    }
+    SharedFeatureFaceKeysImpl(m_SurfaceMeshFaceLabels, records.data()).compute(0, totalPoints);
+  }
 
-    QMap<uint64_t, int32_t>::iterator iter = faceSizeMap.find(*faceId_64);
-    if(iter == faceSizeMap.end())
-    {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      m_SurfaceMeshFeatureFaceIds[t] = index;
-      faceLabelMap.push_back(std::pair<int32_t, int32_t>(faceId.g, faceId.r));
-      ++index;
-    }
-    else
+  auto recordLess = [](const FaceKeyRecord& a, const FaceKeyRecord& b) { return a.key < b.key || (a.key == b.key && a.tri < b.tri); };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_sort(records.begin(), records.end(), recordLess);
+  }
+  else
+#endif
+  {
+    std::sort(records.begin(), records.end(), recordLess);
+  }
+
+  std::vector<FaceGroup> groups;
+  for(int64_t r = 0; r < totalPoints;)
+  {
+    FaceGroup group = {r, 1};
+    while(r + group.count < totalPoints && records[r + group.count].key == records[r].key)
     {
-      iter.value()++;
-      m_SurfaceMeshFeatureFaceIds[t] = faceIdMap[*faceId_64];
+      group.count++;
     }
+    groups.push_back(group);
+    r += group.count;
+  }
+
+  // Feature face Ids are handed out in the order the faces are first met while walking the triangles
+  std::sort(groups.begin(), groups.end(), [&](const FaceGroup& a, const FaceGroup& b) { return records[a.start].tri < records[b.start].tri; });
+
+  int64_t numGroups = static_cast<int64_t>(groups.size());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, numGroups), SharedFeatureFaceIdsImpl(records.data(), groups.data(), m_SurfaceMeshFeatureFaceIds), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SharedFeatureFaceIdsImpl(records.data(), groups.data(), m_SurfaceMeshFeatureFaceIds).compute(0, numGroups);
   }
 
   // resize + update pointers
+  int32_t index = static_cast<int32_t>(numGroups + 1);
   QVector<size_t> tDims(1, index);
   faceFeatureAttrMat->resizeAttributeArrays(tDims);
   m_SurfaceMeshFeatureFaceLabels = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getPointer(0);
   m_SurfaceMeshFeatureFaceNumTriangles = m_SurfaceMeshFeatureFaceNumTrianglesPtr.lock()->getPointer(0);
 
-  for(int32_t i = 0; i < index; i++)
+  // Feature face 0 has the (0, 0) labels and shares the triangle count of a real (0, 0) face if one exists
+  m_SurfaceMeshFeatureFaceLabels[0] = 0;
+  m_SurfaceMeshFeatureFaceLabels[1] = 0;
+  m_SurfaceMeshFeatureFaceNumTriangles[0] = 0;
+  for(int32_t i = 1; i < index; i++)
   {
+    const FaceGroup& group = groups[i - 1];
+    int64_t tri = records[group.start].tri;
+    int32_t fl0 = m_SurfaceMeshFaceLabels[tri * 2];
+    int32_t fl1 = m_SurfaceMeshFaceLabels[tri * 2 + 1];
+
     // get feature face labels
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceLabelMap[i].first;
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceLabelMap[i].second;
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = std::min(fl0, fl1);
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = std::max(fl0, fl1);
 
     // get feature triangle count
-    faceId.g = faceLabelMap[i].first;
-    faceId.r = faceLabelMap[i].second;
-    m_SurfaceMeshFeatureFaceNumTriangles[i] = faceSizeMap[*faceId_64];
+    m_SurfaceMeshFeatureFaceNumTriangles[i] = static_cast<int32_t>(group.count);
+    if(records[group.start].key == 0)
+    {
+      m_SurfaceMeshFeatureFaceNumTriangles[0] = static_cast<int32_t>(group.count);
+    }
   }
-
-
 }
 
 // -----------------------------------------------------------------------------
@@ -31,6 +31,7 @@ set(_PublicFilters
   TriangleDihedralAngleFilter
   TriangleNormalFilter
   GenerateGeometryConnectivity
+  VerifyTriangleWinding
 )
 
 if(SIMPL_USE_EIGEN)
@@ -63,7 +64,6 @@ set(_PrivateFilters
   # These filters require extensive updates to comply with the IGeometry design
   #M3CSliceBySlice
   #MovingFiniteElementSmoothing
-  #VerifyTriangleWinding
 )
 
 #-----------------
@@ -89,6 +89,9 @@ ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} MeshLi
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.h)
 ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.cpp)
 
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} TriangleAdjacency.h)
+ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} TriangleAdjacency.cpp)
+
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/Vector3.h)
 ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/Vector3.cpp)
 
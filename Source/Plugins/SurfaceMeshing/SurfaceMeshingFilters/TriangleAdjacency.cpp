@@ -0,0 +1,340 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "TriangleAdjacency.h"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The TriangleNeighborsImpl class gathers the vertex sharing neighbors of a range of triangles. With
+ * a null neighbor list it only records the counts so the offsets can be sized before the second pass fills them.
+ */
+class TriangleNeighborsImpl
+{
+public:
+  TriangleNeighborsImpl(const int64_t* triangles, const int64_t* vertOffsets, const int64_t* vertTriangles, const int64_t* triOffsets, int64_t* counts, int64_t* neighbors)
+  : m_Triangles(triangles)
+  , m_VertOffsets(vertOffsets)
+  , m_VertTriangles(vertTriangles)
+  , m_TriOffsets(triOffsets)
+  , m_Counts(counts)
+  , m_Neighbors(neighbors)
+  {
+  }
+  virtual ~TriangleNeighborsImpl() = default;
+
+  void compute(int64_t start, int64_t end) const
+  {
+    std::vector<int64_t> local;
+    for(int64_t t = start; t < end; t++)
+    {
+      local.clear();
+      for(int32_t i = 0; i < 3; i++)
+      {
+        int64_t vert = m_Triangles[t * 3 + i];
+        local.insert(local.end(), m_VertTriangles + m_VertOffsets[vert], m_VertTriangles + m_VertOffsets[vert + 1]);
+      }
+      std::sort(local.begin(), local.end());
+      local.erase(std::unique(local.begin(), local.end()), local.end());
+      local.erase(std::remove(local.begin(), local.end(), t), local.end());
+
+      if(nullptr == m_Neighbors)
+      {
+        m_Counts[t] = static_cast<int64_t>(local.size());
+      }
+      else
+      {
+        std::copy(local.begin(), local.end(), m_Neighbors + m_TriOffsets[t]);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int64_t* m_Triangles;
+  const int64_t* m_VertOffsets;
+  const int64_t* m_VertTriangles;
+  const int64_t* m_TriOffsets;
+  int64_t* m_Counts;
+  int64_t* m_Neighbors;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleAdjacency::TriangleAdjacency() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleAdjacency::~TriangleAdjacency() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriangleAdjacency::build(TriangleGeom::Pointer triangleGeom)
+{
+  if(nullptr == triangleGeom.get())
+  {
+    return -1;
+  }
+
+  int64_t numTris = static_cast<int64_t>(triangleGeom->getNumberOfTris());
+  int64_t numVerts = static_cast<int64_t>(triangleGeom->getNumberOfVertices());
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+
+  m_NumTriangles = numTris;
+
+  // Vertex -> triangle table, a counting sort keyed on the vertex Id
+  m_VertOffsets.assign(numVerts + 1, 0);
+  for(int64_t t = 0; t < numTris * 3; t++)
+  {
+    m_VertOffsets[triangles[t] + 1]++;
+  }
+  for(int64_t v = 0; v < numVerts; v++)
+  {
+    m_VertOffsets[v + 1] += m_VertOffsets[v];
+  }
+  m_VertTriangles.resize(numTris * 3);
+  std::vector<int64_t> cursor(m_VertOffsets.begin(), m_VertOffsets.end() - 1);
+  for(int64_t t = 0; t < numTris; t++)
+  {
+    for(int32_t i = 0; i < 3; i++)
+    {
+      m_VertTriangles[cursor[triangles[t * 3 + i]]++] = t;
+    }
+  }
+  std::vector<int64_t>().swap(cursor);
+
+  // Triangle -> triangle table. The first pass counts, the second pass fills the sized table.
+  m_TriangleOffsets.assign(numTris + 1, 0);
+  m_TriangleNeighbors.clear();
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<int64_t>(0, numTris),
+                    TriangleNeighborsImpl(triangles, m_VertOffsets.data(), m_VertTriangles.data(), nullptr, m_TriangleOffsets.data() + 1, nullptr), tbb::auto_partitioner());
+#else
+  TriangleNeighborsImpl(triangles, m_VertOffsets.data(), m_VertTriangles.data(), nullptr, m_TriangleOffsets.data() + 1, nullptr).compute(0, numTris);
+#endif
+
+  for(int64_t t = 0; t < numTris; t++)
+  {
+    m_TriangleOffsets[t + 1] += m_TriangleOffsets[t];
+  }
+  m_TriangleNeighbors.resize(m_TriangleOffsets[numTris]);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<int64_t>(0, numTris),
+                    TriangleNeighborsImpl(triangles, m_VertOffsets.data(), m_VertTriangles.data(), m_TriangleOffsets.data(), nullptr, m_TriangleNeighbors.data()), tbb::auto_partitioner());
+#else
+  TriangleNeighborsImpl(triangles, m_VertOffsets.data(), m_VertTriangles.data(), m_TriangleOffsets.data(), nullptr, m_TriangleNeighbors.data()).compute(0, numTris);
+#endif
+
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriangleAdjacency::buildEdges(TriangleGeom::Pointer triangleGeom)
+{
+  if(nullptr == triangleGeom.get())
+  {
+    return -1;
+  }
+
+  int64_t numTris = static_cast<int64_t>(triangleGeom->getNumberOfTris());
+  const int64_t* triangles = triangleGeom->getTriPointer(0);
+
+  m_NumTriangles = numTris;
+
+  // Sort the triangle edge slots (3 * triangle + i) by their unordered vertex pair so that every slot
+  // of the same edge lands in one run. Ties are broken by slot, which keeps each run in triangle order.
+  auto edgeKey = [triangles](int64_t slot) {
+    int64_t v0 = triangles[slot];
+    int64_t v1 = triangles[slot - slot % 3 + (slot % 3 + 1) % 3];
+    return v0 < v1 ? std::make_pair(v0, v1) : std::make_pair(v1, v0);
+  };
+  std::vector<int64_t> slots(numTris * 3);
+  for(int64_t i = 0; i < numTris * 3; i++)
+  {
+    slots[i] = i;
+  }
+  auto slotLess = [&edgeKey](int64_t a, int64_t b) {
+    std::pair<int64_t, int64_t> ka = edgeKey(a);
+    std::pair<int64_t, int64_t> kb = edgeKey(b);
+    return ka < kb || (ka == kb && a < b);
+  };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(slots.begin(), slots.end(), slotLess);
+#else
+  std::sort(slots.begin(), slots.end(), slotLess);
+#endif
+
+  m_TriangleEdges.resize(numTris * 3);
+  m_EdgeTriangles.resize(numTris * 3);
+  m_EdgeOffsets.clear();
+  m_EdgeOffsets.reserve(numTris * 3 / 2 + 2);
+  for(int64_t i = 0; i < numTris * 3; i++)
+  {
+    if(i == 0 || edgeKey(slots[i]) != edgeKey(slots[i - 1]))
+    {
+      m_EdgeOffsets.push_back(i);
+    }
+    m_TriangleEdges[slots[i]] = static_cast<int64_t>(m_EdgeOffsets.size()) - 1;
+    m_EdgeTriangles[i] = slots[i] / 3;
+  }
+  m_EdgeOffsets.push_back(numTris * 3);
+
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleAdjacency::getNumberOfTriangles() const
+{
+  return m_NumTriangles;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleAdjacency::getNumberOfTrianglesContainingVert(int64_t vert) const
+{
+  return m_VertOffsets[vert + 1] - m_VertOffsets[vert];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int64_t* TriangleAdjacency::getTrianglesContainingVert(int64_t vert) const
+{
+  return m_VertTriangles.data() + m_VertOffsets[vert];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleAdjacency::getNumberOfTriangleNeighbors(int64_t tri) const
+{
+  return m_TriangleOffsets[tri + 1] - m_TriangleOffsets[tri];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int64_t* TriangleAdjacency::getTriangleNeighbors(int64_t tri) const
+{
+  return m_TriangleNeighbors.data() + m_TriangleOffsets[tri];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleAdjacency::getNumberOfEdges() const
+{
+  return m_EdgeOffsets.empty() ? 0 : static_cast<int64_t>(m_EdgeOffsets.size()) - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int64_t* TriangleAdjacency::getTriangleEdges(int64_t tri) const
+{
+  return m_TriangleEdges.data() + tri * 3;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleAdjacency::getNumberOfTrianglesContainingEdge(int64_t edge) const
+{
+  return m_EdgeOffsets[edge + 1] - m_EdgeOffsets[edge];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int64_t* TriangleAdjacency::getTrianglesContainingEdge(int64_t edge) const
+{
+  return m_EdgeTriangles.data() + m_EdgeOffsets[edge];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleAdjacency::VisitMarks& TriangleAdjacency::getLocalVisitMarks() const
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  VisitMarks& visitMarks = m_VisitMarks.local();
+#else
+  VisitMarks& visitMarks = m_VisitMarks;
+#endif
+  if(visitMarks.marks.size() != static_cast<size_t>(m_NumTriangles))
+  {
+    visitMarks.marks.assign(m_NumTriangles, 0);
+    visitMarks.epoch = 0;
+  }
+  return visitMarks;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint32_t TriangleAdjacency::beginVisit(VisitMarks& visitMarks) const
+{
+  visitMarks.epoch++;
+  if(visitMarks.epoch == 0)
+  {
+    // The stamp wrapped around so stale marks could alias the new epoch; start over from a clean slate
+    std::fill(visitMarks.marks.begin(), visitMarks.marks.end(), 0);
+    visitMarks.epoch = 1;
+  }
+  return visitMarks.epoch;
+}
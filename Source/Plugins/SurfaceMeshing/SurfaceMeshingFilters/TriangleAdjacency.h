@@ -0,0 +1,187 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+/**
+ * @brief The TriangleAdjacency class holds compressed (CSR) vertex to triangle and triangle to triangle
+ * connectivity for a TriangleGeom. Two triangles are neighbors when they share at least one vertex, which
+ * is the same definition FindNRingNeighbors uses for its rings. The class also hands out per thread visit
+ * marks so that graph walks can use an epoch stamp instead of a set to track visited triangles. An optional
+ * edge to triangle table can be built for walks that must only cross shared edges.
+ */
+class TriangleAdjacency
+{
+  public:
+    SIMPL_SHARED_POINTERS(TriangleAdjacency)
+    SIMPL_STATIC_NEW_MACRO(TriangleAdjacency)
+    SIMPL_TYPE_MACRO(TriangleAdjacency)
+
+    virtual ~TriangleAdjacency();
+
+    /**
+     * @brief The VisitMarks struct stores one stamp per triangle. A triangle counts as visited when its
+     * stamp equals the current epoch, so starting a new walk only costs an increment.
+     */
+    struct VisitMarks
+    {
+      std::vector<uint32_t> marks;
+      uint32_t epoch = 0;
+    };
+
+    /**
+     * @brief build Builds both adjacency tables from the supplied TriangleGeom
+     * @param triangleGeom Incoming TriangleGeom object
+     * @return Integer error value
+     */
+    int32_t build(TriangleGeom::Pointer triangleGeom);
+
+    /**
+     * @brief buildEdges Builds the edge to triangle table from the supplied TriangleGeom. Edge i of a triangle
+     * runs from its vertex i to vertex (i + 1) % 3. This table is independent of the one built by build().
+     * @param triangleGeom Incoming TriangleGeom object
+     * @return Integer error value
+     */
+    int32_t buildEdges(TriangleGeom::Pointer triangleGeom);
+
+    /**
+     * @brief getNumberOfTriangles Returns the number of triangles the tables were built for
+     * @return Number of triangles
+     */
+    int64_t getNumberOfTriangles() const;
+
+    /**
+     * @brief getNumberOfTrianglesContainingVert Returns how many triangles use the given vertex
+     * @param vert Vertex Id
+     * @return Number of triangles
+     */
+    int64_t getNumberOfTrianglesContainingVert(int64_t vert) const;
+
+    /**
+     * @brief getTrianglesContainingVert Returns the triangles that use the given vertex
+     * @param vert Vertex Id
+     * @return Pointer to the first triangle Id
+     */
+    const int64_t* getTrianglesContainingVert(int64_t vert) const;
+
+    /**
+     * @brief getNumberOfTriangleNeighbors Returns how many triangles share a vertex with the given triangle
+     * @param tri Triangle Id
+     * @return Number of neighboring triangles
+     */
+    int64_t getNumberOfTriangleNeighbors(int64_t tri) const;
+
+    /**
+     * @brief getTriangleNeighbors Returns the triangles sharing a vertex with the given triangle, sorted by Id
+     * @param tri Triangle Id
+     * @return Pointer to the first neighboring triangle Id
+     */
+    const int64_t* getTriangleNeighbors(int64_t tri) const;
+
+    /**
+     * @brief getNumberOfEdges Returns the number of unique edges found by buildEdges()
+     * @return Number of edges
+     */
+    int64_t getNumberOfEdges() const;
+
+    /**
+     * @brief getTriangleEdges Returns the three edge Ids of the given triangle
+     * @param tri Triangle Id
+     * @return Pointer to the first of three edge Ids
+     */
+    const int64_t* getTriangleEdges(int64_t tri) const;
+
+    /**
+     * @brief getNumberOfTrianglesContainingEdge Returns how many triangles use the given edge
+     * @param edge Edge Id
+     * @return Number of triangles
+     */
+    int64_t getNumberOfTrianglesContainingEdge(int64_t edge) const;
+
+    /**
+     * @brief getTrianglesContainingEdge Returns the triangles that use the given edge, sorted by Id
+     * @param edge Edge Id
+     * @return Pointer to the first triangle Id
+     */
+    const int64_t* getTrianglesContainingEdge(int64_t edge) const;
+
+    /**
+     * @brief getLocalVisitMarks Returns the visit marks owned by the calling thread
+     * @return Visit marks sized for this adjacency
+     */
+    VisitMarks& getLocalVisitMarks() const;
+
+    /**
+     * @brief beginVisit Starts a new walk on the given marks and returns the epoch to stamp visited triangles with
+     * @param visitMarks Visit marks obtained from getLocalVisitMarks()
+     * @return Epoch value for this walk
+     */
+    uint32_t beginVisit(VisitMarks& visitMarks) const;
+
+  protected:
+    TriangleAdjacency();
+
+  private:
+    int64_t m_NumTriangles = 0;
+    std::vector<int64_t> m_VertOffsets;
+    std::vector<int64_t> m_VertTriangles;
+    std::vector<int64_t> m_TriangleOffsets;
+    std::vector<int64_t> m_TriangleNeighbors;
+    std::vector<int64_t> m_TriangleEdges;
+    std::vector<int64_t> m_EdgeOffsets;
+    std::vector<int64_t> m_EdgeTriangles;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    mutable tbb::enumerable_thread_specific<VisitMarks> m_VisitMarks;
+#else
+    mutable VisitMarks m_VisitMarks;
+#endif
+
+  public:
+    TriangleAdjacency(const TriangleAdjacency&) = delete; // Copy Constructor Not Implemented
+    TriangleAdjacency(TriangleAdjacency&&) = delete;      // Move Constructor Not Implemented
+    TriangleAdjacency& operator=(const TriangleAdjacency&) = delete; // Copy Assignment Not Implemented
+    TriangleAdjacency& operator=(TriangleAdjacency&&) = delete;      // Move Assignment Not Implemented
+};
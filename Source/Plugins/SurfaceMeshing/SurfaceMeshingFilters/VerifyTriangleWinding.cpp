@@ -35,212 +35,203 @@
 
 #include "VerifyTriangleWinding.h"
 
-#include <QtCore/QString>
-#include <deque>
-#include <iostream>
+#include <algorithm>
 #include <limits>
-#include <queue>
-
-#ifdef _MSC_VER
-#include <hash_set>
-// using namespace stdext;
-#define STDEXT stdext
-#else
-#include <ext/hash_set>
-// using namespace __gnu_cxx;
-#define STDEXT __gnu_cxx
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
 #endif
 
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Math/MatrixMath.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/ReverseTriangleWinding.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/Plane.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleOps.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/util/Vector3.h"
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class Mesh
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
+#include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/TriangleAdjacency.h"
+#include "SurfaceMeshing/SurfaceMeshingVersion.h"
+
+/**
+ * @brief The VerifyWindingImpl class walks the faces of a range of features across their shared edges and
+ * decides, face by face, whether the triangle has to be flipped so that every face of the feature winds the
+ * same way as a seed face whose normal points out of the feature. Each feature only sees a triangle through
+ * its own side of the face labels, so a feature writes only its own flip slot (2 * triangle + side) and
+ * features can be processed concurrently without touching the mesh.
+ */
+class VerifyWindingImpl
 {
 public:
-  SIMPL_SHARED_POINTERS(Mesh)
-  SIMPL_STATIC_NEW_MACRO(Mesh)
-  virtual ~Mesh()
-  {
-  }
-  int getMaxLabel()
-  {
-    return -1;
-  }
-  int getMinLabel()
-  {
-    return -1;
-  }
-  void setMaxLabel(int32_t l)
-  {
-    m_MaxLabel = l;
-  }
-  void setMinLabel(int32_t l)
+  VerifyWindingImpl(const int64_t* triangles, const float* vertices, const int32_t* faceLabels, const int64_t* featureOffsets, const int64_t* featureFaces, TriangleAdjacency* adjacency,
+                    uint8_t* flips)
+  : m_Triangles(triangles)
+  , m_Vertices(vertices)
+  , m_FaceLabels(faceLabels)
+  , m_FeatureOffsets(featureOffsets)
+  , m_FeatureFaces(featureFaces)
+  , m_Adjacency(adjacency)
+  , m_Flips(flips)
   {
-    m_MinLabel = l;
-  }
-  void incrementMaxLabel()
-  {
-    m_MaxLabel++;
   }
+  virtual ~VerifyWindingImpl() = default;
 
-protected:
-  Mesh()
+  void compute(int64_t start, int64_t end) const
   {
-  }
+    std::vector<int64_t> faceQueue;
+    for(int64_t feature = start; feature < end; feature++)
+    {
+      int64_t first = m_FeatureOffsets[feature];
+      int64_t last = m_FeatureOffsets[feature + 1];
+      if(first == last)
+      {
+        continue;
+      }
 
-private:
-  int32_t m_MinLabel;
-  int32_t m_MaxLabel;
+      TriangleAdjacency::VisitMarks& visitMarks = m_Adjacency->getLocalVisitMarks();
+      uint32_t epoch = m_Adjacency->beginVisit(visitMarks);
+      uint32_t* visited = visitMarks.marks.data();
 
-  Mesh(const Mesh&);           // Copy Constructor Not Implemented
-  void operator=(const Mesh&); // Operator '=' Not Implemented
-};
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-class LabelVisitorInfo
-{
-public:
-  //   typedef Mesh<int32_t>::Pointer                MeshPtrType;
-  typedef FaceArray::Face_t FaceType;
-  typedef QVector<int32_t> FaceListType;
+      // A feature may be made of several disconnected shells; each one gets its own seed
+      int64_t numVisited = 0;
+      while(numVisited < last - first)
+      {
+        int64_t seed = findSeed(first, last, visited, epoch);
+        int64_t seedTri = seed / 2;
+        if(normalX(seedTri, seed % 2) < 0.0f)
+        {
+          m_Flips[seed] = 1;
+        }
+        visited[seedTri] = epoch;
+        numVisited++;
 
-  SIMPL_SHARED_POINTERS(LabelVisitorInfo)
-  static Pointer New(int32_t label, size_t tIndex)
-  {
-    Pointer sharedPtr(new LabelVisitorInfo(label, tIndex));
-    return sharedPtr;
+        faceQueue.clear();
+        faceQueue.push_back(seed);
+        for(size_t q = 0; q < faceQueue.size(); q++)
+        {
+          int64_t face = faceQueue[q];
+          int64_t tri = face / 2;
+          // Orientation of this face as the feature currently sees it: 0 keeps the stored vertex order
+          uint8_t orient = static_cast<uint8_t>(face % 2) ^ m_Flips[face];
+          const int64_t* edges = m_Adjacency->getTriangleEdges(tri);
+          for(int32_t i = 0; i < 3; i++)
+          {
+            uint8_t ascending = edgeAscending(tri, i) ^ orient;
+            int64_t count = m_Adjacency->getNumberOfTrianglesContainingEdge(edges[i]);
+            const int64_t* edgeTris = m_Adjacency->getTrianglesContainingEdge(edges[i]);
+            for(int64_t n = 0; n < count; n++)
+            {
+              int64_t nTri = edgeTris[n];
+              if(visited[nTri] == epoch)
+              {
+                continue;
+              }
+              int64_t nSide = sideOf(nTri, static_cast<int32_t>(feature));
+              if(nSide < 0)
+              {
+                continue;
+              }
+              // Consistent neighbors traverse the shared edge in the opposite direction
+              int32_t j = localEdge(nTri, edges[i]);
+              uint8_t nOrient = ascending ^ edgeAscending(nTri, j) ^ 1;
+              m_Flips[nTri * 2 + nSide] = nOrient ^ static_cast<uint8_t>(nSide);
+              visited[nTri] = epoch;
+              numVisited++;
+              faceQueue.push_back(nTri * 2 + nSide);
+            }
+          }
+        }
+      }
+    }
   }
 
-  virtual ~LabelVisitorInfo()
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
   {
+    compute(r.begin(), r.end());
   }
+#endif
 
 private:
-  int32_t m_Label;
-
-public:
-  int32_t getLabel()
-  {
-    if(m_Relabeled)
-    {
-      return m_NewLabel;
-    }
-    return m_Label;
-  }
-
-  SIMPL_INSTANCE_PROPERTY(size_t, StartIndex)
-  SIMPL_INSTANCE_PROPERTY(bool, Primed)
-  SIMPL_INSTANCE_PROPERTY(int32_t, NewLabel)
-  SIMPL_INSTANCE_PROPERTY(bool, Relabeled)
-
-  QSet<int32_t> m_Faces;
-  QSet<int32_t> m_OriginalFaceList;
+  const int64_t* m_Triangles;
+  const float* m_Vertices;
+  const int32_t* m_FaceLabels;
+  const int64_t* m_FeatureOffsets;
+  const int64_t* m_FeatureFaces;
+  TriangleAdjacency* m_Adjacency;
+  uint8_t* m_Flips;
 
   /**
-  *
-  * @param mesh
-  * @param masterVisited
-  * @return
-  */
-  Pointer relabelFaces(Mesh::Pointer mesh, DataArray<int32_t>::Pointer masterFaceListPtr, const QVector<bool>& masterVisited)
+   * @brief findSeed Returns the unvisited face of the feature whose centroid lies furthest along +X. The
+   * outward normal of that face has to point along +X, which fixes the winding for the rest of its shell.
+   */
+  int64_t findSeed(int64_t first, int64_t last, const uint32_t* visited, uint32_t epoch) const
   {
-    size_t triangleIndex = *(m_Faces.begin());
-    int32_t newLabel = mesh->getMaxLabel() + 1;
-    mesh->incrementMaxLabel();
-    int32_t* masterFaceList = masterFaceListPtr->getPointer(0);
-    LabelVisitorInfo::Pointer p = LabelVisitorInfo::New(m_Label, triangleIndex);
-
-    p->setPrimed(false);
-    p->setNewLabel(newLabel);
-    p->setRelabeled(true);
-    p->m_Faces = m_Faces;            // This will make a copy of the current set of triangles
-    p->m_OriginalFaceList = m_Faces; // Make a copy that does NOT get updated
-    bool seedIsSet = false;
-    for(QSet<int32_t>::iterator triIter = p->m_Faces.begin(); triIter != p->m_Faces.end(); ++triIter)
+    float xMax = std::numeric_limits<float>::lowest();
+    int64_t seed = -1;
+    for(int64_t f = first; f < last; f++)
     {
-      if(masterFaceList[(*triIter) * 2] == m_Label)
-      {
-        masterFaceList[(*triIter) * 2] = newLabel;
-      }
-      if(masterFaceList[(*triIter) * 2 + 1] == m_Label)
+      int64_t tri = m_FeatureFaces[f] / 2;
+      if(visited[tri] == epoch)
       {
-        masterFaceList[(*triIter) * 2 + 1] = newLabel;
+        continue;
       }
-      if(masterVisited[*triIter])
+      const int64_t* verts = m_Triangles + tri * 3;
+      float avgX = (m_Vertices[verts[0] * 3] + m_Vertices[verts[1] * 3] + m_Vertices[verts[2] * 3]) / 3.0f;
+      if(seed < 0 || avgX > xMax)
       {
-        p->setStartIndex(*triIter);
-        seedIsSet = true;
+        xMax = avgX;
+        seed = m_FeatureFaces[f];
       }
     }
-    if(seedIsSet)
-    {
-      p->setPrimed(true);
-    }
-
-    return p;
+    return seed;
   }
 
   /**
-   *
-   * @param mesh
+   * @brief normalX Returns the X component of the (unnormalized) triangle normal as seen from the given side
    */
-  void revertFaceLabels(DataArray<int32_t>::Pointer masterFaceListPtr)
+  float normalX(int64_t tri, int64_t side) const
   {
-    int32_t* masterFaceList = masterFaceListPtr->getPointer(0);
+    const float* v0 = m_Vertices + m_Triangles[tri * 3] * 3;
+    const float* v1 = m_Vertices + m_Triangles[tri * 3 + 1] * 3;
+    const float* v2 = m_Vertices + m_Triangles[tri * 3 + 2] * 3;
+    float nx = (v1[1] - v0[1]) * (v2[2] - v0[2]) - (v1[2] - v0[2]) * (v2[1] - v0[1]);
+    return side == 0 ? nx : -nx;
+  }
 
-    if(m_Relabeled == true)
-    {
-      //  qDebug() << "    Reverting Label " << m_NewLabel << " To " << m_Label << "\n";
-      for(QSet<int32_t>::iterator triIter = m_OriginalFaceList.begin(); triIter != m_OriginalFaceList.end(); ++triIter)
-      {
-        if(masterFaceList[(*triIter) * 2] == m_NewLabel)
-        {
-          masterFaceList[(*triIter) * 2] = m_Label;
-        }
-        if(masterFaceList[(*triIter) * 2 + 1] == m_NewLabel)
-        {
-          masterFaceList[(*triIter) * 2 + 1] = m_Label;
-        }
-      }
-      m_Relabeled = false;
-      m_NewLabel = m_Label;
-      m_Primed = false;
-    }
+  uint8_t edgeAscending(int64_t tri, int32_t i) const
+  {
+    return m_Triangles[tri * 3 + i] < m_Triangles[tri * 3 + (i + 1) % 3] ? 1 : 0;
   }
 
-protected:
-  LabelVisitorInfo(int32_t label, size_t tIndex)
-  : m_Label(label)
-  , m_StartIndex(tIndex)
-  , m_Primed(false)
-  , m_NewLabel(label)
-  , m_Relabeled(false)
+  int32_t localEdge(int64_t tri, int64_t edge) const
   {
+    const int64_t* edges = m_Adjacency->getTriangleEdges(tri);
+    return edges[0] == edge ? 0 : (edges[1] == edge ? 1 : 2);
   }
 
-private:
-  LabelVisitorInfo(const LabelVisitorInfo&); // Copy Constructor Not Implemented
-  void operator=(const LabelVisitorInfo&);   // Operator '=' Not Implemented
+  int64_t sideOf(int64_t tri, int32_t feature) const
+  {
+    if(m_FaceLabels[tri * 2] == feature)
+    {
+      return 0;
+    }
+    if(m_FaceLabels[tri * 2 + 1] == feature)
+    {
+      return 1;
+    }
+    return -1;
+  }
 };
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 VerifyTriangleWinding::VerifyTriangleWinding()
-: m_SurfaceDataContainerName(SIMPL::Defaults::DataContainerName)
-, m_SurfaceMeshNodeFacesArrayName(SIMPL::VertexData::SurfaceMeshNodeFaces)
-, m_SurfaceMeshFaceLabelsArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels)
-, m_SurfaceMeshFaceLabelsArrayName(SIMPL::FaceData::SurfaceMeshFaceLabels)
-, m_SurfaceMeshFaceLabels(nullptr)
+: m_SurfaceMeshFaceLabelsArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels)
 {
 }
 
@@ -257,10 +248,9 @@ void VerifyTriangleWinding::setupFilterParameters()
   SurfaceMeshFilter::setupFilterParameters();
   FilterParameterVectorType parameters;
 
-  parameters.push_back(SeparatorFilterParameter::New("Required Information", FilterParameter::Uncategorized));
-  parameters.push_back(DataArraySelectionFilterParameter::New("SurfaceMeshFaceLabels", "SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath(), FilterParameter::Uncategorized,
-                                                              SIMPL_BIND_SETTER(VerifyTriangleWinding, this, SurfaceMeshFaceLabelsArrayPath),
-                                                              SIMPL_BIND_GETTER(VerifyTriangleWinding, this, SurfaceMeshFaceLabelsArrayPath)));
+  DataArraySelectionFilterParameter::RequirementType dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 2, AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
+  parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::RequiredArray));
+  parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Labels", SurfaceMeshFaceLabelsArrayPath, FilterParameter::RequiredArray, VerifyTriangleWinding, dasReq));
   setFilterParameters(parameters);
 }
 
@@ -286,47 +276,31 @@ void VerifyTriangleWinding::initialize()
 // -----------------------------------------------------------------------------
 void VerifyTriangleWinding::dataCheck()
 {
-  DataContainer::Pointer sm = getDataContainerArray()->getPrereqDataContainer(this, getSurfaceMeshFaceLabelsArrayPath().getDataContainerName(), false);
-  if(getErrorCondition() < 0)
-  {
-    return;
-  }
+  clearErrorCode();
+  clearWarningCode();
 
-  IGeometry::Pointer geom = sm->getGeometry();
-  if(nullptr == geom.get())
+  TriangleGeom::Pointer triangles = getDataContainerArray()->getPrereqGeometryFromDataContainer<TriangleGeom, AbstractFilter>(this, getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
+  if(getErrorCode() < 0)
   {
-    QString ss = QObject::tr("DataContainer Geometry is missing.");
-    setErrorCondition(-385, ss);
     return;
   }
 
-  TriangleGeom::Pointer triangles = sm->getGeometryAs<TriangleGeom>();
-  if(nullptr == triangles.get())
+  QVector<size_t> cDims(1, 2);
+  m_SurfaceMeshFaceLabelsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getSurfaceMeshFaceLabelsArrayPath(),
+                                                                                                                   cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_SurfaceMeshFaceLabelsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_SurfaceMeshFaceLabels = m_SurfaceMeshFaceLabelsPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  if(getErrorCode() < 0)
   {
-    QString ss = QObject::tr("DataContainer Geometry is not compatible. The Geometry type is %1").arg(geom->getGeometryTypeAsString());
-    setErrorCondition(-384, ss);
     return;
   }
 
-  // We MUST have Nodes
-  if(nullptr == triangles->getVertices().get())
-  {
-    setErrorCondition(-386, "DataContainer Geometry missing Vertices");
-  }
-  // We MUST have Triangles defined also.
-  if(nullptr == triangles->getTriangles().get())
-  {
-    setErrorCondition(-387, "DataContainer Geometry missing Triangles");
-  }
-  else
+  if(m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples() != triangles->getNumberOfTris())
   {
-    QVector<size_t> dims(1, 2);
-    m_SurfaceMeshFaceLabelsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getSurfaceMeshFaceLabelsArrayPath(),
-                                                                                                                     dims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_SurfaceMeshFaceLabelsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
-    {
-      m_SurfaceMeshFaceLabels = m_SurfaceMeshFaceLabelsPtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    QString ss = QObject::tr("The number of Face Labels (%1) does not match the number of triangles (%2)").arg(m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples()).arg(triangles->getNumberOfTris());
+    setErrorCondition(-558, ss);
   }
 }
 
@@ -341,11 +315,6 @@ void VerifyTriangleWinding::preflight()
   dataCheck();
   emit preflightExecuted();
   setInPreflight(false);
-
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
-  QString ss = QObject::tr("Filter is NOT updated for IGeometry Redesign. A Programmer needs to check this filter. Please report this to the DREAM3D developers.");
-  setErrorCondition(0xABABABAB, ss);
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
 }
 
 // -----------------------------------------------------------------------------
@@ -353,450 +322,119 @@ void VerifyTriangleWinding::preflight()
 // -----------------------------------------------------------------------------
 void VerifyTriangleWinding::execute()
 {
-  clearErrorCode();
-  clearWarningCode();
   dataCheck();
-  if(getErrorCondition() < 0)
-  {
-    return;
-  }
-
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-
-  FaceArray::Pointer facesPtr = sm->getFaces();
-
-  notifyStatusMessage("Generating Face List for each Node");
-  // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
-  // assert if the data is NOT in the SurfaceMesh Data Container
-  if(nullptr == facesPtr->getFacesContainingVert())
-  {
-    facesPtr->findFacesContainingVert();
-  }
-  if(getCancel())
-  {
-    return;
-  }
-  if(nullptr == facesPtr->getFaceNeighbors())
-  {
-    facesPtr->findFaceNeighbors();
-  }
-  if(getCancel())
+  if(getErrorCode() < 0)
   {
     return;
   }
-  if(facesPtr->getUniqueEdges() == nullptr)
-  {
-    facesPtr->generateUniqueEdgeIds();
-  }
 
-  // Execute the actual verification step.
-  notifyStatusMessage("Generating Connectivity Complete. Starting Analysis");
+  notifyStatusMessage("Verifying the winding of each Feature");
   verifyTriangleWinding();
-
-
-}
-
-// -----------------------------------------------------------------------------
-// Groups the triangles according to which Feature they are a part of
-// -----------------------------------------------------------------------------
-void VerifyTriangleWinding::getLabelTriangelMap(LabelFaceMap_t& trianglesToLabelMap)
-{
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-  FaceArray::Pointer masterFaceList = sm->getFaces();
-  if(nullptr == masterFaceList.get())
-  {
-    setErrorCondition(-556, "The SurfaceMesh DataContainer Does NOT contain Faces");
-    return;
-  }
-
-  int ntri = masterFaceList->getNumberOfTuples();
-  // FaceArray::Face_t* triangles = masterFaceList->getPointer(0);
-
-  // Loop over all the triangles and group them according to which feature/region they are a part of
-  for(int t = 0; t < ntri; ++t)
-  {
-    int32_t* label = m_SurfaceMeshFaceLabels + t * 2;
-    trianglesToLabelMap[label[0]].insert(t);
-    trianglesToLabelMap[label[1]].insert(t);
-  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t VerifyTriangleWinding::getSeedTriangle(int32_t label, QSet<int32_t>& triangleIndices)
+int VerifyTriangleWinding::verifyTriangleWinding()
 {
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
-  VertexArray::Vert_t* verts = sm->getVertices()->getPointer(0);
-  FaceArray::Face_t* triangles = sm->getFaces()->getPointer(0);
-
-  float xMax = std::numeric_limits<float>::min();
-  float avgX = 0.0f;
-  int32_t seedFaceIdx = 0;
+  int64_t numTris = static_cast<int64_t>(triangleGeom->getNumberOfTris());
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+  float* vertices = triangleGeom->getVertexPointer(0);
 
-  for(QSet<int32_t>::iterator iter = triangleIndices.begin(); iter != triangleIndices.end(); ++iter)
+  TriangleAdjacency::Pointer adjacency = TriangleAdjacency::New();
+  if(adjacency->buildEdges(triangleGeom) < 0)
   {
-    int32_t i = *iter;
-    avgX = (verts[triangles[i].verts[0]].pos[0] + verts[triangles[i].verts[1]].pos[0] + verts[triangles[i].verts[2]].pos[0]) / 3.0;
-    if(avgX > xMax)
-    {
-      xMax = avgX;
-      seedFaceIdx = i;
-    }
+    setErrorCondition(-556, "Error generating the edge connectivity of the triangles");
+    return getErrorCode();
   }
-  // Now we have the "right most" triangle based on x component of the centroid of the triangles for this label.
-  // Lets now figure out if the normal points generally in the positive or negative X direction.
-
-  int32_t* faceLabel = m_SurfaceMeshFaceLabels + seedFaceIdx * 2;
-  VectorType normal;
-  if(faceLabel[0] == label)
+  if(getCancel())
   {
-    normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[0]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[2]]);
+    return -1;
   }
-  else
+
+  // Feature -> face table. A face is one side of a triangle, stored as 2 * triangle + side. Labels below 1
+  // mark the outside of the volume or unassigned space, which do not bound a closed surface.
+  int32_t maxLabel = 0;
+  for(int64_t i = 0; i < numTris * 2; i++)
   {
-    normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[2]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[0]]);
+    maxLabel = std::max(maxLabel, m_SurfaceMeshFaceLabels[i]);
   }
-
-  if(normal.x < 0.0f)
+  std::vector<int64_t> featureOffsets(static_cast<size_t>(maxLabel) + 2, 0);
+  for(int64_t i = 0; i < numTris * 2; i++)
   {
-    ReverseTriangleWinding::Pointer reverse = ReverseTriangleWinding::New();
-    reverse->setDataContainerArray(getDataContainerArray());
-    connect(reverse.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
-    reverse->setMessagePrefix(getMessagePrefix());
-    reverse->execute();
-    if(reverse->getErrorCondition() < 0)
-    {
-      setErrorCondition(reverse->getErrorCondition(), "Error Reversing the Face Winding");
-      return -1;
-    }
-    if(faceLabel[0] == label)
-    {
-      normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[0]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[2]]);
-    }
-    else
-    {
-      normal = TriangleOps::computeNormal(verts[triangles[seedFaceIdx].verts[2]], verts[triangles[seedFaceIdx].verts[1]], verts[triangles[seedFaceIdx].verts[0]]);
-    }
-    if(normal.x < 0.0f)
+    if(m_SurfaceMeshFaceLabels[i] > 0)
     {
-      setErrorCondition(-802, "Error After attempted triangle winding reversal. Face normal is still oriented in wrong direction.");
-      seedFaceIdx = -1;
+      featureOffsets[m_SurfaceMeshFaceLabels[i] + 1]++;
     }
   }
-
-  return seedFaceIdx;
-}
-
-#define PRINT_FACE(index, triangles)                                                                                                                                                                   \
-  qDebug() << " " << triangles[index].verts[0] << " " << triangles[index].verts[1] << " " << triangles[index].verts[2] << "\n";                                                                        \
-  qDebug() << "Face ID: " << index << "\n";                                                                                                                                                            \
-  qDebug() << "Face.labels[0] " << triangles[index].labels[0] << "\n";                                                                                                                                 \
-  qDebug() << "Face.labels[1] " << triangles[index].labels[1] << "\n";
-
-#define PRINT_VERT(index) qDebug() << index << " " << verts[index].pos[0] << " " << verts[index].pos[1] << " " << verts[index].pos[2] << "\n";
-
-#define PRINT_NORMAL(i, nodes, triangles)                                                                                                                                                              \
-  {                                                                                                                                                                                                    \
-    VectorType normal = TriangleOps::computeNormal(nodes[triangles[i].verts[0]], nodes[triangles[i].verts[1]], nodes[triangles[i].verts[2]]);                                                          \
-    qDebug() << normal.x << " " << normal.y << " " << normal.z << "\n";                                                                                                                                \
-  }
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int VerifyTriangleWinding::verifyTriangleWinding()
-{
-  int err = 0;
-  //  qDebug() << "--------------------------------------------------------------" << "\n";
-  //  FaceListType& masterFaceList = *(mesh->triangles());  // Create a reference variable for better syntax
-  //  NodeVector&       masterNodeList = *(mesh->nodes());
-
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-  // get the triangle definitions - use the pointer to the start of the Struct Array
-  FaceArray::Pointer masterFaceList = sm->getFaces();
-  if(nullptr == masterFaceList.get())
-  {
-    setErrorCondition(-556, "The SurfaceMesh DataContainer Does NOT contain Faces");
-    return getErrorCondition();
-  }
-  FaceArray::Face_t* triangles = masterFaceList->getPointer(0);
-
-  int numFaces = masterFaceList->getNumberOfTuples();
-
-  VertexArray::Pointer masterNodeListPtr = sm->getVertices();
-  if(nullptr == masterNodeListPtr.get())
+  for(int32_t f = 0; f <= maxLabel; f++)
   {
-    setErrorCondition(-555, "The SurfaceMesh DataContainer Does NOT contain Nodes");
-    return getErrorCondition();
+    featureOffsets[f + 1] += featureOffsets[f];
   }
-
-  Mesh::Pointer mesh = Mesh::New();
-  int min = std::numeric_limits<int32_t>::max();
-  int max = std::numeric_limits<int32_t>::min();
-  // Set the min and Max labels in the Mesh class;
-  for(int n = 0; n < numFaces; ++n)
+  std::vector<int64_t> featureFaces(featureOffsets[maxLabel + 1]);
+  std::vector<int64_t> cursor(featureOffsets.begin(), featureOffsets.end() - 1);
+  for(int64_t i = 0; i < numTris * 2; i++)
   {
-    int l = m_SurfaceMeshFaceLabels[n * 2];
-    if(l < min)
-    {
-      min = l;
-    }
-    if(l > max)
-    {
-      max = l;
-    }
-    l = m_SurfaceMeshFaceLabels[n * 2 + 1];
-    if(l < min)
-    {
-      min = l;
-    }
-    if(l > max)
+    if(m_SurfaceMeshFaceLabels[i] > 0)
     {
-      max = l;
+      featureFaces[cursor[m_SurfaceMeshFaceLabels[i]]++] = i;
     }
   }
-  mesh->setMaxLabel(max);
-  mesh->setMinLabel(min);
+  std::vector<int64_t>().swap(cursor);
 
-  // Get a grouping of triangles by feature ID
-  LabelFaceMap_t trianglesToLabelMap;
-  getLabelTriangelMap(trianglesToLabelMap);
-  //  for(LabelFaceMap_t::iterator iter = trianglesToLabelMap.begin(); iter != trianglesToLabelMap.end(); ++iter)
-  //  {
-  //    qDebug() << "Feature: " << iter.key() << "   Face Count: " << iter.value().size() << "\n";
-  //  }
+  std::vector<uint8_t> flips(numTris * 2, 0);
 
-  int32_t currentLabel = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("VerifyTriangleWinding"));
+  bool doParallel = true;
+#endif
 
-  // Find the first Non Zero Feature Id (Label). This is going to be our starting feature.
-  for(LabelFaceMap_t::iterator iter = trianglesToLabelMap.begin(); iter != trianglesToLabelMap.end(); ++iter)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    if(iter.key() > 0)
-    {
-      currentLabel = iter.key();
-      break;
-    }
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, maxLabel + 1),
+                      VerifyWindingImpl(triangles, vertices, m_SurfaceMeshFaceLabels, featureOffsets.data(), featureFaces.data(), adjacency.get(), flips.data()), tbb::auto_partitioner());
   }
-
-  std::deque<LabelVisitorInfo::Pointer> labelObjectsToVisit;
-
-  // Keeps a list of all the triangles that have been visited.
-  QVector<bool> masterVisited(masterFaceList->getNumberOfTuples(), false);
-
-  STDEXT::hash_set<int32_t> labelsVisitedSet;
-  STDEXT::hash_set<int32_t> labelsToVisitSet;
-  int32_t triIndex = 0;
-
-  bool firstLabel = false;
-
-  // Get the first triangle in the list
-  // FaceArray::Face_t& triangle = triangles[triIndex];
-
-  // Now that we have the starting Feature, lets try and get a seed triangle that is oriented in the proper direction.
-  /* Make sure the winding is correct on the first triangle of the first label that will be checked. */
-  triIndex = getSeedTriangle(currentLabel, trianglesToLabelMap[currentLabel]);
-  if(getErrorCondition() < 0 || triIndex < 0)
+  else
+#endif
+  {
+    VerifyWindingImpl serial(triangles, vertices, m_SurfaceMeshFaceLabels, featureOffsets.data(), featureFaces.data(), adjacency.get(), flips.data());
+    serial.compute(0, maxLabel + 1);
+  }
+  if(getCancel())
   {
     return -1;
   }
 
-  LabelVisitorInfo::Pointer ldo = LabelVisitorInfo::New(currentLabel, triIndex);
-  labelObjectsToVisit.push_back(ldo);
-  LabelVisitorInfo::Pointer curLdo = LabelVisitorInfo::NullPointer();
-  labelsToVisitSet.insert(currentLabel);
-
-  float total = (float)(trianglesToLabelMap.size());
-  float curPercent = 0.0;
-  int progressIndex = 0;
-
-  // Start looping on all the Face Labels (Feature Ids) values
-  while(labelObjectsToVisit.empty() == false)
+  // Both features of a properly labeled face agree on its winding. When they do not, the side 0 feature wins.
+  int64_t numFlipped = 0;
+  int64_t numConflicts = 0;
+  for(int64_t t = 0; t < numTris; t++)
   {
-    if(getCancel())
+    bool side0 = m_SurfaceMeshFaceLabels[t * 2] > 0;
+    bool side1 = m_SurfaceMeshFaceLabels[t * 2 + 1] > 0;
+    if(side0 && side1 && flips[t * 2] != flips[t * 2 + 1])
     {
-      return -1;
+      numConflicts++;
     }
-    if((progressIndex / total * 100.0f) > (curPercent))
+    if((side0 && flips[t * 2] != 0) || (!side0 && side1 && flips[t * 2 + 1] != 0))
     {
-      QString ss = QObject::tr("%1% Complete").arg(static_cast<int>(progressIndex / total * 100.0f));
-      notifyStatusMessage(ss);
-      curPercent += 5.0f;
-    }
-    ++progressIndex;
-
-    QMap<int32_t, int32_t> neighborlabels;
-
-    curLdo = labelObjectsToVisit.front();
-    labelObjectsToVisit.pop_front();
-    currentLabel = curLdo->getLabel();
-    labelsToVisitSet.erase(currentLabel);
-    labelsVisitedSet.insert(currentLabel);
-    if(curLdo->getPrimed() == false && curLdo->getRelabeled() == false)
-    {
-      curLdo->m_Faces = trianglesToLabelMap[currentLabel];
-      curLdo->setPrimed(true);
-    }
-    else if(curLdo->getPrimed() == false && curLdo->getRelabeled() == true)
-    {
-      //    qDebug() << "    Reint32_ting could not find a starting index. Using first index in triangle set" << "\n";
-      curLdo->setStartIndex(*(curLdo->m_Faces.begin()));
-      curLdo->setPrimed(true);
-    }
-
-    if(firstLabel == true)
-    {
-      triIndex = 0;
-      firstLabel = false;
-    }
-    else
-    {
-      triIndex = curLdo->getStartIndex();
-    }
-    // Get the number of triangles remaining to be visited for the current label
-    QSet<int32_t>::size_type nLabelTriStart = curLdo->m_Faces.size();
-
-    STDEXT::hash_set<int> localVisited;
-    std::deque<int> triangleDeque;
-    // FaceArray::Face_t& triangle = triangles[triIndex];
-    triangleDeque.push_back(triIndex);
-
-    while(triangleDeque.empty() == false)
-    {
-      int32_t triangleIndex = triangleDeque.front();
-      FaceArray::Face_t& triangle = triangles[triangleIndex];
-      int32_t* faceLabel = m_SurfaceMeshFaceLabels + (triangleIndex * 2); // Here we are getting a new pointer offset from the start of the labels array
-
-      //   qDebug() << " $ tIndex: " << triangleIndex << "\n";
-      FaceArray::Pointer facesPtr = sm->getFaces();
-      if(facesPtr == nullptr)
-      {
-        break;
-      }
-      // FaceArray::Face_t* faces = facesPtr->getPointer(0);
-
-      QVector<int32_t> adjTris = TriangleOps::findAdjacentTriangles(facesPtr, triangleIndex, m_SurfaceMeshFaceLabelsPtr.lock(), currentLabel);
-
-      for(FaceList_t::iterator adjTri = adjTris.begin(); adjTri != adjTris.end(); ++adjTri)
-      {
-        // qDebug() << "  ^ AdjTri index: " << *adjTri << "\n";
-        if(masterVisited[*adjTri] == false)
-        {
-          //    qDebug() << "   * Checking Winding: " << *adjTri << "\n";
-          if(TriangleOps::verifyWinding(triangle, triangles[*adjTri], faceLabel, m_SurfaceMeshFaceLabels + (*adjTri * 2), currentLabel) == true)
-          {
-            //   qDebug() << "Face winding flipped for triangle id = " << *adjTri << " Feature Id: " << currentLabel << "\n";
-          }
-        }
-
-        if(localVisited.find(*adjTri) == localVisited.end() && find(triangleDeque.begin(), triangleDeque.end(), *adjTri) == triangleDeque.end())
-        {
-          // qDebug() << "   # Adding to Deque: " << *adjTri << "\n";
-          triangleDeque.push_back(*adjTri);
-          localVisited.insert(*adjTri);
-          masterVisited[*adjTri] = true;
-        }
-      }
-
-      // Just add the neighbor label to a set so we end up with a list of unique
-      // labels that are neighbors to the current label
-      if(currentLabel != faceLabel[0])
-      {
-        neighborlabels.insert(faceLabel[0], triangleIndex);
-      }
-      if(currentLabel != faceLabel[1])
-      {
-        neighborlabels.insert(faceLabel[1], triangleIndex);
-      }
-
-      localVisited.insert(triangleIndex);
-      masterVisited[triangleIndex] = true;
-      curLdo->m_Faces.remove(triangleIndex);
-      triangleDeque.pop_front();
-    } // End of loop to visit all triangles in the 'currentLabel'
-
-    // Find the Next label to push onto the end of the labels List, but ONLY if it is NOT
-    // currently on the list and NOT currently on the label visited list.
-    for(QMap<int32_t, int32_t>::iterator neigh = neighborlabels.begin(); neigh != neighborlabels.end(); ++neigh)
-    {
-      int32_t triangleIndex = neigh.value();
-      int32_t* triangleLabel = m_SurfaceMeshFaceLabels + triangleIndex * 2;
-
-      if(labelsToVisitSet.find(triangleLabel[0]) == labelsToVisitSet.end() && (labelsVisitedSet.find(triangleLabel[0]) == labelsVisitedSet.end()))
-      {
-        // Push the int32_t value into the "set"
-        labelsToVisitSet.insert(triangleLabel[0]);
-        LabelVisitorInfo::Pointer l = LabelVisitorInfo::New(triangleLabel[0], triangleIndex);
-        labelObjectsToVisit.push_back(l);
-        // qDebug() << "    Adding Label " << triangle.labels[0] << " to visit starting at tIndex " << triangleIndex << "\n";
-      }
-      if(labelsToVisitSet.find(triangleLabel[1]) == labelsToVisitSet.end() && (labelsVisitedSet.find(triangleLabel[1]) == labelsVisitedSet.end()))
-      {
-        // Push the int32_t value into the "set"
-        labelsToVisitSet.insert(triangleLabel[1]);
-        LabelVisitorInfo::Pointer l = LabelVisitorInfo::New(triangleLabel[1], triangleIndex);
-        labelObjectsToVisit.push_back(l);
-        //  qDebug() << "    Adding Label " << triangle.labels[1] << " to visit starting at tIndex " << triangleIndex << "\n";
-      }
-    }
-
-    QSet<int32_t>::size_type nLabelTriEnd = curLdo->m_Faces.size();
-    if(nLabelTriStart == nLabelTriEnd)
-    {
-      // qDebug() << "    !--!++! No new triangles visited for int32_t " << currentLabel << "\n";
-    }
-    else if(nLabelTriEnd == 0)
-    {
-      //  qDebug() << "    No Faces remain to be visited for label " << "\n";
-      // If this currentLabel was the result of a "relabeling" then revert back to the original
-      // label for those triangles.
-      curLdo->revertFaceLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-    }
-    else
-    {
-      // qDebug() << "    Not all triangles visited for label"  << "\n";
-      // qDebug() << "    " << nLabelTriEnd << " Faces Remaining to be visited" << "\n";
-      // At this point relabel the remaining triangles
-      //      if (currentLabel == 28) {
-      //        qDebug() << "break" << "\n";
-      //      }
-      LabelVisitorInfo::Pointer p = curLdo->relabelFaces(mesh, m_SurfaceMeshFaceLabelsPtr.lock(), masterVisited);
-      labelObjectsToVisit.push_back(p);
-      labelsToVisitSet.insert(p->getLabel());
-      // Revert the current labelVisitorObject to its original label
-      curLdo->revertFaceLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-      // qDebug() << "    New label " << mesh->getMaxLabel() << " added to visit" << "\n";
-    }
-
-  } // End of Loop over each int32_t
-
-  // qDebug() << "Total: "<< total << "\n";
-  // qDebug() << "labelsToVisitSet.size() :" << labelsToVisitSet.size() << "\n";
-  if(labelsToVisitSet.size() != 0)
-  {
-    // qDebug() << " labelsToVisitSet:" << "\n";
-    for(STDEXT::hash_set<int32_t>::iterator iter = labelsToVisitSet.begin(); iter != labelsToVisitSet.end(); ++iter)
-    {
-      // qDebug() << "  int32_t: " << *iter << "\n";
+      std::swap(triangles[t * 3], triangles[t * 3 + 2]);
+      numFlipped++;
     }
   }
-  // qDebug() << "labelsVisited.size() :" << labelsVisitedSet.size() << "\n";
 
-  QSet<int32_t> thelabels = TriangleOps::generateUniqueLabels(m_SurfaceMeshFaceLabelsPtr.lock());
-  for(STDEXT::hash_set<int32_t>::iterator iter = labelsVisitedSet.begin(); iter != labelsVisitedSet.end(); ++iter)
+  if(numConflicts > 0)
   {
-    thelabels.remove(*iter);
+    QString ss = QObject::tr("%1 triangles are wound inconsistently between the two Features they separate").arg(numConflicts);
+    setWarningCondition(-557, ss);
   }
+  notifyStatusMessage(QObject::tr("Flipped the winding of %1 triangles").arg(numFlipped));
 
-  // qDebug() << "labels NOT visited:" << "\n";
-  for(QSet<int32_t>::iterator iter = thelabels.begin(); iter != thelabels.end(); ++iter)
-  {
-    // qDebug() << "  int32_t: " << *iter << "\n";
-  }
-
-  // qDebug() << "--------------------------------------------------------------" << "\n";
-  return err;
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -805,7 +443,7 @@ int VerifyTriangleWinding::verifyTriangleWinding()
 AbstractFilter::Pointer VerifyTriangleWinding::newFilterInstance(bool copyFilterParameters) const
 {
   VerifyTriangleWinding::Pointer filter = VerifyTriangleWinding::New();
-  if(true == copyFilterParameters)
+  if(copyFilterParameters)
   {
     copyFilterParameterInstanceVariables(filter.get());
   }
@@ -820,6 +458,25 @@ const QString VerifyTriangleWinding::getCompiledLibraryName() const
   return SurfaceMeshingConstants::SurfaceMeshingBaseName;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VerifyTriangleWinding::getBrandingString() const
+{
+  return "SurfaceMeshing";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VerifyTriangleWinding::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << SurfaceMeshing::Version::Major() << "." << SurfaceMeshing::Version::Minor() << "." << SurfaceMeshing::Version::Patch();
+  return version;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
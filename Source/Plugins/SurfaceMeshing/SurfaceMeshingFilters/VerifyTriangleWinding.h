@@ -36,53 +36,65 @@
 
 #pragma once
 
-#include <QtCore/QString>
-
-#include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
-#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/SIMPLib.h"
+
 #include "SurfaceMeshing/SurfaceMeshingFilters/SurfaceMeshFilter.h"
-#include "SurfaceMeshing/SurfaceMeshingConstants.h"
-#include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 #include "SurfaceMeshing/SurfaceMeshingDLLExport.h"
 
 /**
- * @class VerifyTriangleWinding VerifyTriangleWinding.h /SurfaceMeshFilters/VerifyTriangleWinding.h
- * @brief
- * @author
- * @date
- * @version 1.0
+ * @brief The VerifyTriangleWinding class. See [Filter documentation](@ref verifytrianglewinding) for details.
  */
 class SurfaceMeshing_EXPORT VerifyTriangleWinding : public SurfaceMeshFilter
 {
-    Q_OBJECT
-  //  PYB11_CREATE_BINDINGS(VerifyTriangleWinding SUPERCLASS SurfaceMeshFilter)
-  //  PYB11_PROPERTY(DataArrayPath SurfaceMeshFaceLabelsArrayPath READ getSurfaceMeshFaceLabelsArrayPath WRITE setSurfaceMeshFaceLabelsArrayPath)
+  Q_OBJECT
+    PYB11_CREATE_BINDINGS(VerifyTriangleWinding SUPERCLASS SurfaceMeshFilter)
+    PYB11_PROPERTY(DataArrayPath SurfaceMeshFaceLabelsArrayPath READ getSurfaceMeshFaceLabelsArrayPath WRITE setSurfaceMeshFaceLabelsArrayPath)
   public:
     SIMPL_SHARED_POINTERS(VerifyTriangleWinding)
     SIMPL_FILTER_NEW_MACRO(VerifyTriangleWinding)
     SIMPL_TYPE_MACRO_SUPER_OVERRIDE(VerifyTriangleWinding, SurfaceMeshFilter)
 
     ~VerifyTriangleWinding() override;
-    SIMPL_INSTANCE_STRING_PROPERTY(SurfaceDataContainerName)
-
-    SIMPL_INSTANCE_STRING_PROPERTY(SurfaceMeshNodeFacesArrayName)
-
-    typedef QMap<int, QSet<int> >                      LabelFaceMap_t;
-    typedef QVector<int32_t>                               FaceList_t;
 
-    /**
-    * @brief This returns the group that the filter belonds to. You can select
-    * a different group if you want. The string returned here will be displayed
-    * in the GUI for the filter
-    */
     SIMPL_FILTER_PARAMETER(DataArrayPath, SurfaceMeshFaceLabelsArrayPath)
     Q_PROPERTY(DataArrayPath SurfaceMeshFaceLabelsArrayPath READ getSurfaceMeshFaceLabelsArrayPath WRITE setSurfaceMeshFaceLabelsArrayPath)
 
+    /**
+     * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+     */
     const QString getCompiledLibraryName() const override;
+
+    /**
+     * @brief getBrandingString Returns the branding string for the filter, which is a tag
+     * used to denote the filter's association with specific plugins
+     * @return Branding string
+     */
+    const QString getBrandingString() const override;
+
+    /**
+     * @brief getFilterVersion Returns a version string for this filter. Default
+     * value is an empty string.
+     * @return
+     */
+    const QString getFilterVersion() const override;
+
+    /**
+     * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+     */
     AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+    /**
+     * @brief getGroupName Reimplemented from @see AbstractFilter class
+     */
     const QString getGroupName() const override;
+
+    /**
+     * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+     */
     const QString getSubGroupName() const override;
 
     /**
@@ -92,40 +104,30 @@ class SurfaceMeshing_EXPORT VerifyTriangleWinding : public SurfaceMeshFilter
     const QUuid getUuid() override;
 
     /**
-     * @brief This returns a string that is displayed in the GUI. It should be readable
-     * and understandable by humans.
+     * @brief getHumanLabel Reimplemented from @see AbstractFilter class
      */
     const QString getHumanLabel() const override;
 
     /**
-    * @brief This method will instantiate all the end user settable options/parameters
-    * for this filter
-    */
+     * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+     */
     void setupFilterParameters() override;
 
     /**
-    * @brief This method will read the options from a file
-    * @param reader The reader that is used to read the options from a file
-    */
+     * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+     */
     void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
 
     /**
-    * @brief Reimplemented from @see AbstractFilter class
-    */
+     * @brief execute Reimplemented from @see AbstractFilter class
+     */
     void execute() override;
 
     /**
-    * @brief This function runs some sanity checks on the DataContainer and inputs
-    * in an attempt to ensure the filter can process the inputs.
-    */
+     * @brief preflight Reimplemented from @see AbstractFilter class
+     */
     void preflight() override;
 
-  signals:
-    void updateFilterParameters(AbstractFilter* filter);
-    void parametersChanged();
-    void preflightAboutToExecute();
-    void preflightExecuted();
-
   protected:
     VerifyTriangleWinding();
 
@@ -139,40 +141,19 @@ class SurfaceMeshing_EXPORT VerifyTriangleWinding : public SurfaceMeshFilter
      */
     void initialize();
 
-
-    /**
-     * @brief This method generates a mapping between a "Label" (Feature Id) and the set of triangles that belong to that
-     * lable value.
-     * @param trianglesToLabelMap
-     */
-    void getLabelTriangelMap(LabelFaceMap_t& trianglesToLabelMap);
-
     /**
-     * @brief This method verifies the winding of all the triangles and makes them consistent
-     * @return
+     * @brief This method verifies the winding of all the triangles and makes them consistent. Each Feature is
+     * walked independently across its shared edges, so the Features are processed in parallel.
+     * @return Integer error value
      */
     int verifyTriangleWinding();
 
-    /**
-     * @brief VerifyTriangleWinding::getSeedTriangle
-     * @param label
-     * @param triangleIndices
-     * @return
-     */
-    int32_t getSeedTriangle(int32_t label, QSet<int32_t>& triangleIndices);
-
   private:
     DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
 
-    bool m_DoNodeFaceConnectivityFilter;
-
   public:
-    VerifyTriangleWinding(const VerifyTriangleWinding&) = delete; // Copy Constructor Not Implemented
-    VerifyTriangleWinding(VerifyTriangleWinding&&) = delete;      // Move Constructor Not Implemented
+    VerifyTriangleWinding(const VerifyTriangleWinding&) = delete;            // Copy Constructor Not Implemented
+    VerifyTriangleWinding(VerifyTriangleWinding&&) = delete;                 // Move Constructor Not Implemented
     VerifyTriangleWinding& operator=(const VerifyTriangleWinding&) = delete; // Copy Assignment Not Implemented
     VerifyTriangleWinding& operator=(VerifyTriangleWinding&&) = delete;      // Move Assignment Not Implemented
 };
-
-
-
-
@@ -0,0 +1,308 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <QtCore/QCoreApplication>
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class VerifyTriangleWindingTest
+{
+
+public:
+  VerifyTriangleWindingTest() = default;
+  virtual ~VerifyTriangleWindingTest() = default;
+
+  SIMPL_TYPE_MACRO(VerifyTriangleWindingTest)
+
+  VerifyTriangleWindingTest(const VerifyTriangleWindingTest&) = delete;            // Copy Constructor Not Implemented
+  VerifyTriangleWindingTest(VerifyTriangleWindingTest&&) = delete;                 // Move Constructor Not Implemented
+  VerifyTriangleWindingTest& operator=(const VerifyTriangleWindingTest&) = delete; // Copy Assignment Not Implemented
+  VerifyTriangleWindingTest& operator=(VerifyTriangleWindingTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the VerifyTriangleWinding Filter from the FilterManager
+    QString filtName = "VerifyTriangleWinding";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Splits the quad (a, b, c, d) into two triangles wound so that their normals point out of the Feature on
+  // side 0 of the labels, or into the Feature on side 1 when side 0 is outside of the volume
+  // -----------------------------------------------------------------------------
+  void addQuad(const float* vertices, int64_t a, int64_t b, int64_t c, int64_t d, int32_t label0, int32_t label1, std::vector<int64_t>& tris, std::vector<int32_t>& labels)
+  {
+    int32_t feature = label0 > 0 ? label0 : label1;
+    float sign = label0 > 0 ? 1.0f : -1.0f;
+    // Feature 1 is the cube [0,1]^3 and Feature 2 is the cube [1,2]x[0,1]x[0,1]
+    float center[3] = {static_cast<float>(feature) - 0.5f, 0.5f, 0.5f};
+
+    int64_t quad[2][3] = {{a, b, c}, {a, c, d}};
+    for(int32_t t = 0; t < 2; t++)
+    {
+      const float* v0 = vertices + quad[t][0] * 3;
+      const float* v1 = vertices + quad[t][1] * 3;
+      const float* v2 = vertices + quad[t][2] * 3;
+      float normal[3] = {(v1[1] - v0[1]) * (v2[2] - v0[2]) - (v1[2] - v0[2]) * (v2[1] - v0[1]), (v1[2] - v0[2]) * (v2[0] - v0[0]) - (v1[0] - v0[0]) * (v2[2] - v0[2]),
+                         (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v1[1] - v0[1]) * (v2[0] - v0[0])};
+      float dot = 0.0f;
+      for(int32_t i = 0; i < 3; i++)
+      {
+        float centroid = (v0[i] + v1[i] + v2[i]) / 3.0f;
+        dot += normal[i] * (centroid - center[i]);
+      }
+      if(dot * sign < 0.0f)
+      {
+        std::swap(quad[t][0], quad[t][2]);
+      }
+      tris.insert(tris.end(), quad[t], quad[t] + 3);
+      labels.push_back(label0);
+      labels.push_back(label1);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds two unit cubes (Features 1 and 2) that share the face x = 1. Every triangle is wound consistently.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTwoCubes()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addOrReplaceDataContainer(tdc);
+
+    // Vertex (i, j, k) has the Id i + 3 * (j + 2 * k)
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(12);
+    float* vertices = vertex->getPointer(0);
+    for(int64_t k = 0; k < 2; k++)
+    {
+      for(int64_t j = 0; j < 2; j++)
+      {
+        for(int64_t i = 0; i < 3; i++)
+        {
+          int64_t id = i + 3 * (j + 2 * k);
+          vertices[id * 3 + 0] = static_cast<float>(i);
+          vertices[id * 3 + 1] = static_cast<float>(j);
+          vertices[id * 3 + 2] = static_cast<float>(k);
+        }
+      }
+    }
+
+    std::vector<int64_t> tris;
+    std::vector<int32_t> labels;
+    // End caps and the shared face
+    addQuad(vertices, 0, 3, 9, 6, 1, -1, tris, labels);
+    addQuad(vertices, 1, 4, 10, 7, 1, 2, tris, labels);
+    addQuad(vertices, 2, 5, 11, 8, -1, 2, tris, labels);
+    // Sides of both cubes, with the outside on either side of the labels
+    for(int32_t feature = 1; feature <= 2; feature++)
+    {
+      int64_t i = feature - 1;
+      addQuad(vertices, i, i + 1, i + 7, i + 6, feature, -1, tris, labels);
+      addQuad(vertices, i + 3, i + 4, i + 10, i + 9, -1, feature, tris, labels);
+      addQuad(vertices, i, i + 1, i + 4, i + 3, feature, -1, tris, labels);
+      addQuad(vertices, i + 6, i + 7, i + 10, i + 9, -1, feature, tris, labels);
+    }
+
+    size_t numTris = tris.size() / 3;
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTris, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    std::copy(tris.begin(), tris.end(), triangle->getTriPointer(0));
+
+    QVector<size_t> tDims(1, numTris);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addOrReplaceAttributeMatrix(faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->insertOrAssign(faceLabels);
+    std::copy(labels.begin(), labels.end(), faceLabels->getPointer(0));
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int runFilter(const DataContainerArray::Pointer& dca)
+  {
+    QString filtName = "VerifyTriangleWinding";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+
+    filter->setDataContainerArray(dca);
+
+    DataArrayPath path(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    QVariant var;
+    var.setValue(path);
+    bool propWasSet = filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+    DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), 0)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void flipTriangle(int64_t* tris, size_t tri)
+  {
+    std::swap(tris[tri * 3], tris[tri * 3 + 2]);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestConsistentMeshUnchanged()
+  {
+    DataContainerArray::Pointer dca = createTwoCubes();
+    TriangleGeom::Pointer triangle = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
+    int64_t* tris = triangle->getTriPointer(0);
+    size_t numTris = triangle->getNumberOfTris();
+    std::vector<int64_t> expected(tris, tris + numTris * 3);
+
+    runFilter(dca);
+
+    for(size_t i = 0; i < numTris * 3; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(tris[i], expected[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFlippedTrianglesRestored()
+  {
+    DataContainerArray::Pointer dca = createTwoCubes();
+    TriangleGeom::Pointer triangle = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
+    int64_t* tris = triangle->getTriPointer(0);
+    size_t numTris = triangle->getNumberOfTris();
+    std::vector<int64_t> expected(tris, tris + numTris * 3);
+
+    // An end cap, both halves of the shared face, the right most (seed) triangle of Feature 2 and two sides
+    std::vector<size_t> flipped = {0, 2, 3, 5, 9, 16};
+    for(size_t tri : flipped)
+    {
+      flipTriangle(tris, tri);
+    }
+
+    runFilter(dca);
+
+    for(size_t i = 0; i < numTris * 3; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(tris[i], expected[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestInvertedMeshRestored()
+  {
+    DataContainerArray::Pointer dca = createTwoCubes();
+    TriangleGeom::Pointer triangle = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
+    int64_t* tris = triangle->getTriPointer(0);
+    size_t numTris = triangle->getNumberOfTris();
+    std::vector<int64_t> expected(tris, tris + numTris * 3);
+
+    // Every triangle is consistent with its neighbors but the normals point into the Features
+    for(size_t tri = 0; tri < numTris; tri++)
+    {
+      flipTriangle(tris, tri);
+    }
+
+    runFilter(dca);
+
+    for(size_t i = 0; i < numTris * 3; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(tris[i], expected[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestConsistentMeshUnchanged())
+    DREAM3D_REGISTER_TEST(TestFlippedTrianglesRestored())
+    DREAM3D_REGISTER_TEST(TestInvertedMeshRestored())
+  }
+
+};
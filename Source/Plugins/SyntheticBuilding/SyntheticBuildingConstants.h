@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
 #include <QtCore/QString>
 
 namespace SyntheticBuildingConstants
@@ -25,6 +27,17 @@ namespace SyntheticBuildingConstants
 
   static const int k_HSV_Saturation = 160;
   static const int k_HSV_Value = 160;
+
+  /**
+   * @brief Returns the seed for the random number generators of the packing and matching filters. Setting
+   * the DREAM3D_RANDOM_SEED environment variable fixes it so benchmark runs are repeatable.
+   */
+  inline uint64_t RandomSeed()
+  {
+    bool ok = false;
+    uint64_t seed = qgetenv("DREAM3D_RANDOM_SEED").toULongLong(&ok);
+    return ok ? seed : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+  }
 }
 
 /**
@@ -355,7 +355,7 @@ void InsertPrecipitatePhases::initialize()
   m_PointsToAdd.clear();
   m_PointsToRemove.clear();
 
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_Seed = SyntheticBuildingConstants::RandomSeed();
 
   m_FeatureSizeDist.clear();
   m_SimFeatureSizeDist.clear();
@@ -368,6 +368,9 @@ void InsertPrecipitatePhases::initialize()
   m_GSizes.clear();
 
   m_AvailablePointsCount = 0;
+  m_AvailablePointsKey.clear();
+  m_AvailableBoundaryPoints.clear();
+  m_AvailableInteriorPoints.clear();
   m_currentRDFerror = m_oldRDFerror = 0.0f;
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
   m_rdfMax = m_rdfMin = m_StepSize = 0.0f;
@@ -776,7 +779,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
 
   clearErrorCode();
   clearWarningCode();
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_Seed = SyntheticBuildingConstants::RandomSeed();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
@@ -875,11 +878,6 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
     return;
   }
 
-  // This is the set that we are going to keep updated with the points that are
-  // not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
-
   // Get a pointer to the Feature Owners that was just initialized in the
   // initialize_packinggrid() method
   int32_t* exclusionZones = exclusionZonesPtr->getPointer(0);
@@ -1018,21 +1016,30 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
     }
   }
 
-  // determine initial set of available points
+  // clear the pointsToRemove and pointsToAdd vectors from the initial packing
+  m_PointsToRemove.clear();
+  m_PointsToAdd.clear();
+
+  // determine initial set of available points. The points that are not in an
+  // exclusion zone are kept in two pools, one for Feature boundary points and
+  // one for interior points, so a centroid of either kind can be drawn directly
+  m_AvailablePointsKey.assign(m_TotalPoints, -1);
+  m_AvailableBoundaryPoints.clear();
+  m_AvailableInteriorPoints.clear();
   m_AvailablePointsCount = 0;
+  int64_t boundaryVoxels = 0;
   for(int64_t i = 0; i < m_TotalPoints; i++)
   {
+    if(i > 0 && m_BoundaryCells[i] != 0)
+    {
+      boundaryVoxels++;
+    }
     if((exclusionZones[i] == 0 && !m_UseMask) || (exclusionZones[i] == 0 && m_UseMask && m_Mask[i]))
     {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
+      m_PointsToAdd.push_back(i);
     }
   }
-  // and clear the pointsToRemove and pointsToAdd vectors from the initial
-  // packing
-  m_PointsToRemove.clear();
-  m_PointsToAdd.clear();
+  update_availablepoints();
 
   size_t key = 0;
   int64_t column = 0, row = 0, plane = 0;
@@ -1044,17 +1051,53 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   m_RowList.resize(numfeatures);
   m_PlaneList.resize(numfeatures);
 
-  int64_t boundaryVoxels = 0;
+  float boundaryFraction = (float)boundaryVoxels / (float)m_TotalPoints;
 
-  for(int64_t i = 1; i < m_TotalPoints; i++)
-  {
-    if(m_BoundaryCells[i] != 0)
+  // Draws the voxel that will hold the centroid of a precipitate, on a Feature
+  // boundary with probability boundaryProbability when there are boundaries
+  auto pickCentroidVoxel = [&](float boundaryProbability) -> size_t {
+    size_t voxel = 0;
+    random = static_cast<float>(rg.genrand_res53());
+    if(boundaryFraction != 0)
     {
-      boundaryVoxels++;
+      bool onBoundary = (random <= boundaryProbability);
+      std::vector<int64_t>& pool = onBoundary ? m_AvailableBoundaryPoints : m_AvailableInteriorPoints;
+      if(!pool.empty())
+      {
+        key = static_cast<size_t>(rg.genrand_res53() * (pool.size() - 1));
+        return static_cast<size_t>(pool[key]);
+      }
+      // Every available point of the wanted kind is taken, so fall back on the whole volume
+      voxel = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+      while((m_BoundaryCells[voxel] != 0) != onBoundary)
+      {
+        voxel = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+      }
+      return voxel;
     }
-  }
 
-  float boundaryFraction = (float)boundaryVoxels / (float)m_TotalPoints;
+    if(boundaryProbability > 0)
+    {
+      QString msg("There are no Feature boundaries on which to place "
+                  "precipitates and the target statistics precipitate "
+                  "fraction is greater than 0. This Filter will run without "
+                  "trying to match the "
+                  "precipitate fraction");
+      setWarningCondition(-5010, msg);
+    }
+
+    if(m_AvailablePointsCount > 0)
+    {
+      key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
+      if(key < m_AvailableBoundaryPoints.size())
+      {
+        return static_cast<size_t>(m_AvailableBoundaryPoints[key]);
+      }
+      return static_cast<size_t>(m_AvailableInteriorPoints[key - m_AvailableBoundaryPoints.size()]);
+    }
+    voxel = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
+    return voxel;
+  };
 
   // boolean used to determine if current placement is acceptable if the
   // precipitates are being treated as "hard"
@@ -1184,7 +1227,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   //    }
   //    if (getCancel() == true) { return; }
   //    update_exclusionZones(i, -1000, exclusionZonesPtr);
-  //    update_availablepoints(availablePoints, availablePointsInv);
+  //    update_availablepoints();
   //    if (iterCount >= 100000)
   //    {
   //      tDims[0] = i + 1;
@@ -1206,78 +1249,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
 
     PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[m_FeaturePhases[i]]);
     precipboundaryfraction = pp->getPrecipBoundaryFraction();
-    random = static_cast<float>(rg.genrand_res53());
-
-    if(boundaryFraction != 0)
-    {
-      if(random <= precipboundaryfraction)
-      {
-        // figure out if we want this to be a boundary centroid voxel or not for
-        // the proposed precipitate
-        if(m_AvailablePointsCount > 0)
-        {
-          key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-          featureOwnersIdx = availablePointsInv[key];
-          while(m_BoundaryCells[featureOwnersIdx] == 0)
-          {
-            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-            featureOwnersIdx = availablePointsInv[key];
-          }
-        }
-        else
-        {
-          featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          while(m_BoundaryCells[featureOwnersIdx] == 0)
-          {
-            featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          }
-        }
-      }
-      else if(random > precipboundaryfraction)
-      {
-        if(m_AvailablePointsCount > 0)
-        {
-          key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-          featureOwnersIdx = availablePointsInv[key];
-          while(m_BoundaryCells[featureOwnersIdx] != 0)
-          {
-            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-            featureOwnersIdx = availablePointsInv[key];
-          }
-        }
-        else
-        {
-          featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          while(m_BoundaryCells[featureOwnersIdx] != 0)
-          {
-            featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          }
-        }
-      }
-    }
-    else
-    {
-
-      if(precipboundaryfraction > 0)
-      {
-        QString msg("There are no Feature boundaries on which to place "
-                    "precipitates and the target statistics precipitate "
-                    "fraction is greater than 0. This Filter will run without "
-                    "trying to match the "
-                    "precipitate fraction");
-        setWarningCondition(-5010, msg);
-      }
-
-      if(m_AvailablePointsCount > 0)
-      {
-        key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-        featureOwnersIdx = availablePointsInv[key];
-      }
-      else
-      {
-        featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-      }
-    }
+    featureOwnersIdx = pickCentroidVoxel(precipboundaryfraction);
 
     column = static_cast<int64_t>(featureOwnersIdx % m_XPoints);
     row = static_cast<int64_t>(featureOwnersIdx / m_XPoints) % m_YPoints;
@@ -1290,7 +1262,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
     m_Centroids[3 * i + 2] = zc;
     insert_precipitate(i);
     update_exclusionZones(i, -1000, exclusionZonesPtr);
-    update_availablepoints(availablePoints, availablePointsInv);
+    update_availablepoints();
   }
 
   notifyStatusMessage("Packing Features - Initial Feature Placement Complete");
@@ -1410,77 +1382,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
         }
 
         precipboundaryfraction = pp->getPrecipBoundaryFraction();
-        random = static_cast<float>(rg.genrand_res53());
-        if(boundaryFraction != 0)
-        {
-          if(random <= precipboundaryfraction)
-          {
-            // figure out if we want this to be a boundary centroid voxel or not
-            // for the proposed precipitate
-            if(m_AvailablePointsCount > 0)
-            {
-              key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-              featureOwnersIdx = availablePointsInv[key];
-              while(m_BoundaryCells[featureOwnersIdx] == 0)
-              {
-                key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-                featureOwnersIdx = availablePointsInv[key];
-              }
-            }
-            else
-            {
-              featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-              while(m_BoundaryCells[featureOwnersIdx] == 0)
-              {
-                featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-              }
-            }
-          }
-          else if(random > precipboundaryfraction)
-          {
-            if(m_AvailablePointsCount > 0)
-            {
-              key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-              featureOwnersIdx = availablePointsInv[key];
-              while(m_BoundaryCells[featureOwnersIdx] != 0)
-              {
-                key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-                featureOwnersIdx = availablePointsInv[key];
-              }
-            }
-            else
-            {
-              featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-              while(m_BoundaryCells[featureOwnersIdx] != 0)
-              {
-                featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-              }
-            }
-          }
-        }
-        else
-        {
-
-          if(precipboundaryfraction > 0)
-          {
-            QString msg("There are no Feature boundaries to place precipitates "
-                        "on and the target statistics precipitate fraction is "
-                        "greater than 0. This Filter will run without trying "
-                        "to match the "
-                        "precipitate fraction");
-            setWarningCondition(-5010, msg);
-          }
-
-          if(m_AvailablePointsCount > 0)
-          {
-            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-            featureOwnersIdx = availablePointsInv[key];
-          }
-          else
-          {
-            featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPoints);
-          }
-        }
+        featureOwnersIdx = pickCentroidVoxel(precipboundaryfraction);
         column = static_cast<int64_t>(featureOwnersIdx % m_XPoints);
         row = static_cast<int64_t>(featureOwnersIdx / m_XPoints) % m_YPoints;
         plane = static_cast<int64_t>(featureOwnersIdx / (m_XPoints * m_YPoints));
@@ -1498,7 +1400,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
         if(m_currentRDFerror >= m_oldRDFerror)
         {
           m_oldRDFerror = m_currentRDFerror;
-          update_availablepoints(availablePoints, availablePointsInv);
+          update_availablepoints();
           acceptedmoves++;
         }
         else
@@ -1916,33 +1818,35 @@ void InsertPrecipitatePhases::update_exclusionZones(int32_t gadd, int32_t gremov
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void InsertPrecipitatePhases::update_availablepoints()
 {
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
-  for(size_t i = 0; i < addSize; i++)
-  {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
-  }
-  for(size_t i = 0; i < removeSize; i++)
-  {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+  // Only the points whose exclusion count just reached or left zero are visited,
+  // each one is pushed onto or swapped out of its pool in constant time
+  for(const size_t& featureOwnersIdx : m_PointsToAdd)
+  {
+    if(m_AvailablePointsKey[featureOwnersIdx] >= 0 || (m_UseMask && !m_Mask[featureOwnersIdx]))
     {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
+      continue;
     }
-    m_AvailablePointsCount--;
+    std::vector<int64_t>& pool = (m_BoundaryCells[featureOwnersIdx] != 0) ? m_AvailableBoundaryPoints : m_AvailableInteriorPoints;
+    m_AvailablePointsKey[featureOwnersIdx] = static_cast<int64_t>(pool.size());
+    pool.push_back(static_cast<int64_t>(featureOwnersIdx));
   }
+  for(const size_t& featureOwnersIdx : m_PointsToRemove)
+  {
+    int64_t key = m_AvailablePointsKey[featureOwnersIdx];
+    if(key < 0)
+    {
+      continue;
+    }
+    std::vector<int64_t>& pool = (m_BoundaryCells[featureOwnersIdx] != 0) ? m_AvailableBoundaryPoints : m_AvailableInteriorPoints;
+    int64_t val = pool.back();
+    pool[key] = val;
+    m_AvailablePointsKey[val] = key;
+    pool.pop_back();
+    m_AvailablePointsKey[featureOwnersIdx] = -1;
+  }
+  m_AvailablePointsCount = m_AvailableBoundaryPoints.size() + m_AvailableInteriorPoints.size();
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
 }
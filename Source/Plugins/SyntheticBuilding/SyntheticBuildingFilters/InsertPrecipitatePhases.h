@@ -358,11 +358,10 @@ protected:
   //    bool check_for_overlap(size_t gNum, Int32ArrayType::Pointer exlusionZonesPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between precipitate owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief update_availablepoints Moves the packing points that entered or left every exclusion zone
+   * since the last call into or out of the boundary and interior pools of available points
    */
-  void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  void update_availablepoints();
 
   /**
    * @brief determine_currentRDF Determines the radial distribution function about a given precipitate
@@ -535,6 +534,9 @@ private:
   std::vector<int64_t> m_GSizes;
 
   size_t m_AvailablePointsCount;
+  std::vector<int64_t> m_AvailablePointsKey;
+  std::vector<int64_t> m_AvailableBoundaryPoints;
+  std::vector<int64_t> m_AvailableInteriorPoints;
   float m_currentRDFerror, m_oldRDFerror;
   float m_CurrentSizeDistError, m_OldSizeDistError;
   float m_rdfMax;
@@ -574,7 +574,7 @@ void MatchCrystallography::determine_boundary_areas()
 // -----------------------------------------------------------------------------
 void MatchCrystallography::assign_eulers(size_t ensem)
 {
-  uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
+  uint64_t m_Seed = SyntheticBuildingConstants::RandomSeed();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   int32_t numbins = 0;
@@ -749,7 +749,7 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
+  uint64_t m_Seed = SyntheticBuildingConstants::RandomSeed();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   int32_t numbins = 0;
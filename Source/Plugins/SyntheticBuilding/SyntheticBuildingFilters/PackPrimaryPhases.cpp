@@ -69,6 +69,7 @@
 #include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
@@ -318,7 +319,7 @@ void PackPrimaryPhases::initialize()
 
   m_PointsToAdd.clear();
   m_PointsToRemove.clear();
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_Seed = SyntheticBuildingConstants::RandomSeed();
   m_FirstPrimaryFeature = 1;
   m_SizeX = m_SizeY = m_SizeZ = m_TotalVol = 0.0f;
   m_TotalVol = 1.0f;
@@ -1080,7 +1081,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     writeErrorFile = outFile.is_open();
   }
 
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_Seed = SyntheticBuildingConstants::RandomSeed();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
@@ -2636,7 +2637,7 @@ void PackPrimaryPhases::assignVoxels()
   };
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(ParallelExecutionContext::Instance()->getNumberOfThreads("PackPrimaryPhases"));
   bool doParallel = true;
 #endif
 
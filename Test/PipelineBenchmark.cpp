@@ -0,0 +1,487 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+// C++ Includes
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+// Qt Includes
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QSysInfo>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+#include <QtCore/QVariantMap>
+
+// DREAM3DLib includes
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/Utilities/ParallelExecutionContext.h"
+
+#include "PipelineBenchmark.h"
+#include "PipelineProfiler.h"
+
+namespace
+{
+const QString k_VolumeDC("SyntheticVolumeDataContainer");
+const QString k_StatsDC("StatsGeneratorDataContainer");
+const QString k_TriangleDC("TriangleDataContainer");
+const QString k_CellData("CellData");
+const QString k_FeatureData("Grain Data");
+const QString k_EnsembleData("CellEnsembleData");
+const QString k_FaceData("FaceData");
+const QString k_VertexData("VertexData");
+
+const QString k_HistoryHeader("Run,Date,Host,Size,Threads,Index,Filter,Wall Time (s),CPU Time (s),Peak RSS Delta (bytes),Elements,Elements Per Second,Speedup,Error Code");
+} // namespace
+
+/**
+ * @brief The BenchmarkResult struct is one filter measured at one volume size and thread count
+ */
+struct BenchmarkResult
+{
+  int size = 0;
+  int threads = 0;
+  double speedup = 1.0;
+  FilterProfile profile;
+};
+
+// -----------------------------------------------------------------------------
+// Creates the filter by class name and sets its properties. Returns a null pointer if the
+// filter is not loaded or one of the properties does not exist.
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer CreateFilter(const QString& className, const QVariantMap& properties)
+{
+  IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryFromClassName(className);
+  if(nullptr == factory.get())
+  {
+    std::cout << "Filter '" << className.toStdString() << "' is not available. Are all the plugins loaded?" << std::endl;
+    return AbstractFilter::NullPointer();
+  }
+  AbstractFilter::Pointer filter = factory->create();
+  for(QVariantMap::const_iterator iter = properties.begin(); iter != properties.end(); ++iter)
+  {
+    if(!filter->setProperty(iter.key().toLatin1().constData(), iter.value()))
+    {
+      std::cout << className.toStdString() << " has no property '" << iter.key().toStdString() << "'" << std::endl;
+      return AbstractFilter::NullPointer();
+    }
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVariant PathVariant(const QString& dc, const QString& am = QString(""), const QString& da = QString(""))
+{
+  return QVariant::fromValue(DataArrayPath(dc, am, da));
+}
+
+// -----------------------------------------------------------------------------
+// Builds the benchmark pipeline: the Synthetic workshop pipeline, without its writer, resized to
+// size^3 voxels, followed by the reconstruction and surface meshing filters working on its output.
+// -----------------------------------------------------------------------------
+FilterPipeline::Pointer CreateBenchmarkPipeline(const QString& syntheticPipelineFile, int size)
+{
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  FilterPipeline::Pointer synthetic = jsonReader->readPipelineFromFile(syntheticPipelineFile);
+  if(nullptr == synthetic.get())
+  {
+    std::cout << "Could not read the pipeline '" << syntheticPipelineFile.toStdString() << "'" << std::endl;
+    return FilterPipeline::NullPointer();
+  }
+
+  FilterPipeline::Pointer pipeline = FilterPipeline::New();
+  for(const AbstractFilter::Pointer& filter : synthetic->getFilterContainer())
+  {
+    if(filter->getNameOfClass() == "DataContainerWriter")
+    {
+      continue;
+    }
+    if(filter->getNameOfClass() == "InitializeSyntheticVolume")
+    {
+      filter->setProperty("Dimensions", QVariant::fromValue(IntVec3Type(size, size, size)));
+    }
+    pipeline->pushBack(filter);
+  }
+
+  QVector<AbstractFilter::Pointer> filters;
+  filters.push_back(CreateFilter("ConvertOrientations", {{"InputType", 0},
+                                                         {"OutputType", 2},
+                                                         {"InputOrientationArrayPath", PathVariant(k_VolumeDC, k_CellData, "EulerAngles")},
+                                                         {"OutputOrientationArrayName", "Quats"}}));
+  filters.push_back(CreateFilter("EBSDSegmentFeatures", {{"CellFeatureAttributeMatrixName", "Segment Data"},
+                                                         {"MisorientationTolerance", 5.0f},
+                                                         {"UseGoodVoxels", false},
+                                                         {"CellPhasesArrayPath", PathVariant(k_VolumeDC, k_CellData, "Phases")},
+                                                         {"CrystalStructuresArrayPath", PathVariant(k_StatsDC, k_EnsembleData, "CrystalStructures")},
+                                                         {"QuatsArrayPath", PathVariant(k_VolumeDC, k_CellData, "Quats")},
+                                                         {"FeatureIdsArrayName", "SegmentIds"},
+                                                         {"ActiveArrayName", "Active"}}));
+  filters.push_back(CreateFilter("FindSizes", {{"FeatureAttributeMatrixName", PathVariant(k_VolumeDC, k_FeatureData)},
+                                               {"FeatureIdsArrayPath", PathVariant(k_VolumeDC, k_CellData, "FeatureIds")},
+                                               {"VolumesArrayName", "SizeVolumes"},
+                                               {"EquivalentDiametersArrayName", "EquivalentDiameters"},
+                                               {"NumElementsArrayName", "NumElements"},
+                                               {"SaveElementSizes", false}}));
+  filters.push_back(CreateFilter("MinSize", {{"MinAllowedFeatureSize", 16},
+                                             {"ApplyToSinglePhase", false},
+                                             {"FeatureIdsArrayPath", PathVariant(k_VolumeDC, k_CellData, "FeatureIds")},
+                                             {"FeaturePhasesArrayPath", PathVariant(k_VolumeDC, k_FeatureData, "Phases")},
+                                             {"NumCellsArrayPath", PathVariant(k_VolumeDC, k_FeatureData, "NumElements")}}));
+  filters.push_back(CreateFilter("FillBadData", {{"MinAllowedDefectSize", 16},
+                                                 {"StoreAsNewPhase", false},
+                                                 {"FeatureIdsArrayPath", PathVariant(k_VolumeDC, k_CellData, "FeatureIds")},
+                                                 {"CellPhasesArrayPath", PathVariant(k_VolumeDC, k_CellData, "Phases")}}));
+  filters.push_back(CreateFilter("FindNeighbors", {{"CellFeatureAttributeMatrixPath", PathVariant(k_VolumeDC, k_FeatureData)},
+                                                   {"FeatureIdsArrayPath", PathVariant(k_VolumeDC, k_CellData, "FeatureIds")},
+                                                   {"NeighborListArrayName", "CleanedNeighborList"},
+                                                   {"NumNeighborsArrayName", "CleanedNumNeighbors"},
+                                                   {"SharedSurfaceAreaListArrayName", "CleanedSharedSurfaceAreaList"},
+                                                   {"SurfaceFeaturesArrayName", "CleanedSurfaceFeatures"},
+                                                   {"BoundaryCellsArrayName", "BoundaryCells"},
+                                                   {"StoreBoundaryCells", false},
+                                                   {"StoreSurfaceFeatures", true}}));
+  filters.push_back(CreateFilter("QuickSurfaceMesh", {{"SurfaceDataContainerName", PathVariant(k_TriangleDC)},
+                                                      {"TripleLineDataContainerName", PathVariant("TripleLineDataContainer")},
+                                                      {"VertexAttributeMatrixName", k_VertexData},
+                                                      {"FaceAttributeMatrixName", k_FaceData},
+                                                      {"FeatureIdsArrayPath", PathVariant(k_VolumeDC, k_CellData, "FeatureIds")},
+                                                      {"FaceLabelsArrayName", "FaceLabels"},
+                                                      {"NodeTypesArrayName", "NodeType"},
+                                                      {"FeatureAttributeMatrixName", "FaceFeatureData"}}));
+  filters.push_back(CreateFilter("LaplacianSmoothing", {{"SurfaceDataContainerName", PathVariant(k_TriangleDC)},
+                                                        {"SurfaceMeshNodeTypeArrayPath", PathVariant(k_TriangleDC, k_VertexData, "NodeType")},
+                                                        {"SurfaceMeshFaceLabelsArrayPath", PathVariant(k_TriangleDC, k_FaceData, "FaceLabels")},
+                                                        {"IterationSteps", 20},
+                                                        {"Lambda", 0.25f},
+                                                        {"TripleLineLambda", 0.1f},
+                                                        {"QuadPointLambda", 0.1f},
+                                                        {"UseTaubinSmoothing", false}}));
+  filters.push_back(CreateFilter("TriangleNormalFilter", {{"SurfaceMeshTriangleNormalsArrayPath", PathVariant(k_TriangleDC, k_FaceData, "FaceNormals")}}));
+  filters.push_back(CreateFilter("TriangleAreaFilter", {{"SurfaceMeshTriangleAreasArrayPath", PathVariant(k_TriangleDC, k_FaceData, "FaceAreas")}}));
+  filters.push_back(CreateFilter("FindGBCD", {{"FaceEnsembleAttributeMatrixName", "FaceEnsembleData"},
+                                              {"GBCDRes", 9.0f},
+                                              {"SurfaceMeshFaceLabelsArrayPath", PathVariant(k_TriangleDC, k_FaceData, "FaceLabels")},
+                                              {"SurfaceMeshFaceNormalsArrayPath", PathVariant(k_TriangleDC, k_FaceData, "FaceNormals")},
+                                              {"SurfaceMeshFaceAreasArrayPath", PathVariant(k_TriangleDC, k_FaceData, "FaceAreas")},
+                                              {"FeatureEulerAnglesArrayPath", PathVariant(k_VolumeDC, k_FeatureData, "EulerAngles")},
+                                              {"FeaturePhasesArrayPath", PathVariant(k_VolumeDC, k_FeatureData, "Phases")},
+                                              {"CrystalStructuresArrayPath", PathVariant(k_StatsDC, k_EnsembleData, "CrystalStructures")},
+                                              {"GBCDArrayName", "GBCD"}}));
+
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(nullptr == filter.get())
+    {
+      return FilterPipeline::NullPointer();
+    }
+    pipeline->pushBack(filter);
+  }
+  return pipeline;
+}
+
+// -----------------------------------------------------------------------------
+// Runs the pipeline once, measuring every filter. Returns the error code of the last filter.
+// -----------------------------------------------------------------------------
+int RunBenchmark(const FilterPipeline::Pointer& pipeline, int size, int threads, std::vector<BenchmarkResult>& results)
+{
+  int err = pipeline->preflightPipeline();
+  if(err < 0)
+  {
+    std::cout << "Errors preflighting the benchmark pipeline: " << err << std::endl;
+    return err;
+  }
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  int index = 0;
+  for(const AbstractFilter::Pointer& filter : pipeline->getFilterContainer())
+  {
+    index++;
+    BenchmarkResult result;
+    result.size = size;
+    result.threads = threads;
+    result.profile = PipelineProfiler::ProfileFilter(filter, dca, index);
+    results.push_back(result);
+
+    err = result.profile.errorCode;
+    if(err < 0)
+    {
+      std::cout << result.profile.className.toStdString() << " failed with error " << err << std::endl;
+      break;
+    }
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+// Reads the wall times of the most recent earlier run from the history file, keyed by
+// "size/threads/filter"
+// -----------------------------------------------------------------------------
+std::map<QString, double> ReadPreviousRun(const QString& historyFile, QString& previousRun)
+{
+  std::map<QString, double> previous;
+  QFile file(historyFile);
+  if(!file.open(QFile::ReadOnly))
+  {
+    return previous;
+  }
+  QStringList lines = QString(file.readAll()).split('\n', QString::SkipEmptyParts);
+  file.close();
+
+  // The runs are appended in order so the last run id in the file is the most recent one
+  for(int i = lines.size() - 1; i > 0; i--)
+  {
+    QStringList tokens = lines[i].split(',');
+    if(tokens.size() < 8)
+    {
+      continue;
+    }
+    if(previousRun.isEmpty())
+    {
+      previousRun = tokens[0];
+    }
+    if(tokens[0] != previousRun)
+    {
+      break;
+    }
+    previous[tokens[3] + "/" + tokens[4] + "/" + tokens[6]] = tokens[7].toDouble();
+  }
+  return previous;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteResults(const QString& resultsDir, const QString& runId, const std::vector<BenchmarkResult>& results)
+{
+  QDir().mkpath(resultsDir);
+  QString date = QDateTime::currentDateTime().toString(Qt::ISODate);
+  QString host = QSysInfo::machineHostName();
+
+  QString historyPath = resultsDir + "BenchmarkHistory.csv";
+  bool writeHeader = !QFileInfo::exists(historyPath);
+  QString runPath = resultsDir + "Benchmark_" + runId + ".csv";
+
+  QFile historyFile(historyPath);
+  QFile runFile(runPath);
+  if(!historyFile.open(QFile::WriteOnly | QFile::Append) || !runFile.open(QFile::WriteOnly))
+  {
+    std::cout << "Could not write the benchmark results to '" << resultsDir.toStdString() << "'" << std::endl;
+    return;
+  }
+  QTextStream history(&historyFile);
+  QTextStream run(&runFile);
+  if(writeHeader)
+  {
+    history << k_HistoryHeader << "\n";
+  }
+  run << k_HistoryHeader << "\n";
+
+  for(const BenchmarkResult& result : results)
+  {
+    const FilterProfile& p = result.profile;
+    QString line = QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10,%11,%12,%13,%14")
+                       .arg(runId)
+                       .arg(date)
+                       .arg(host)
+                       .arg(result.size)
+                       .arg(result.threads)
+                       .arg(p.index)
+                       .arg(p.className)
+                       .arg(p.wallSeconds)
+                       .arg(p.cpuSeconds)
+                       .arg(p.peakRssDelta)
+                       .arg(p.elements)
+                       .arg(p.elementsPerSecond)
+                       .arg(result.speedup)
+                       .arg(p.errorCode);
+    history << line << "\n";
+    run << line << "\n";
+  }
+  std::cout << "Benchmark results written to '" << runPath.toStdString() << "'" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PrintResults(const std::vector<BenchmarkResult>& results, const std::map<QString, double>& previous, const QString& previousRun)
+{
+  std::cout << std::left << std::setw(6) << "Size" << std::setw(9) << "Threads" << std::setw(28) << "Filter" << std::right << std::setw(12) << "Wall (s)" << std::setw(12) << "CPU (s)"
+            << std::setw(16) << "Elements/s" << std::setw(10) << "Speedup" << std::setw(12) << "vs. Last" << std::endl;
+  for(const BenchmarkResult& result : results)
+  {
+    const FilterProfile& p = result.profile;
+    std::cout << std::left << std::setw(6) << result.size << std::setw(9) << result.threads << std::setw(28) << p.className.toStdString() << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << p.wallSeconds << std::setw(12) << p.cpuSeconds << std::setprecision(0) << std::setw(16) << p.elementsPerSecond << std::setprecision(2) << std::setw(10)
+              << result.speedup;
+    std::map<QString, double>::const_iterator last = previous.find(QString("%1/%2/%3").arg(result.size).arg(result.threads).arg(p.className));
+    if(last != previous.end() && p.wallSeconds > 0.0)
+    {
+      std::cout << std::setw(11) << last->second / p.wallSeconds << "x";
+    }
+    std::cout << std::endl;
+  }
+  if(!previousRun.isEmpty())
+  {
+    std::cout << "\"vs. Last\" is the speedup over run " << previousRun.toStdString() << std::endl;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> ParseIntList(const QString& list)
+{
+  QVector<int> values;
+  for(const QString& token : list.split(QRegExp("[,;]"), QString::SkipEmptyParts))
+  {
+    bool ok = false;
+    int value = token.trimmed().toInt(&ok);
+    if(ok)
+    {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("PipelineBenchmark");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Times the hot DREAM.3D filters on synthetic volumes of increasing size and thread count");
+  parser.addHelpOption();
+  QCommandLineOption sizesOption("sizes", "Comma separated edge lengths of the synthetic volumes", "sizes", getBenchmarkSizes());
+  QCommandLineOption threadsOption("threads", "Comma separated thread counts, 0 uses every core", "threads", getBenchmarkThreads());
+  QCommandLineOption seedOption("seed", "Seed of the random number generators", "seed", getBenchmarkSeed());
+  QCommandLineOption resultsOption("results", "Directory that keeps the benchmark history", "directory", getBenchmarkResultsDirectory());
+  QCommandLineOption pipelineOption("pipeline", "Synthetic pipeline that generates the volume", "file", getSyntheticPipelineFile());
+  parser.addOption(sizesOption);
+  parser.addOption(threadsOption);
+  parser.addOption(seedOption);
+  parser.addOption(resultsOption);
+  parser.addOption(pipelineOption);
+  parser.process(app);
+
+  QVector<int> sizes = ParseIntList(parser.value(sizesOption));
+  QVector<int> threadCounts = ParseIntList(parser.value(threadsOption));
+  QString resultsDir = QDir(parser.value(resultsOption)).absolutePath() + "/";
+  QString pipelineFile = parser.value(pipelineOption);
+
+  // PackPrimaryPhases and MatchCrystallography read their seed from the environment
+  qputenv("DREAM3D_RANDOM_SEED", parser.value(seedOption).toLatin1());
+
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+  QMetaObjectUtilities::RegisterMetaTypes();
+
+  QString runId = QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss");
+  QString previousRun;
+  std::map<QString, double> previous = ReadPreviousRun(resultsDir + "BenchmarkHistory.csv", previousRun);
+
+  std::vector<BenchmarkResult> results;
+  int err = 0;
+  for(int size : sizes)
+  {
+    std::map<int, double> baseline;
+    for(int threads : threadCounts)
+    {
+      int numThreads = threads > 0 ? threads : QThread::idealThreadCount();
+      ParallelExecutionContext::Instance()->setMaxThreads(numThreads);
+      std::cout << "Benchmarking " << size << "^3 voxels with " << numThreads << " threads" << std::endl;
+
+      FilterPipeline::Pointer pipeline = CreateBenchmarkPipeline(pipelineFile, size);
+      if(nullptr == pipeline.get())
+      {
+        return EXIT_FAILURE;
+      }
+      size_t first = results.size();
+      err = RunBenchmark(pipeline, size, numThreads, results);
+
+      // The speedup of each filter is relative to the first thread count run at this size
+      for(size_t i = first; i < results.size(); i++)
+      {
+        BenchmarkResult& result = results[i];
+        if(baseline.find(result.profile.index) == baseline.end())
+        {
+          baseline[result.profile.index] = result.profile.wallSeconds;
+        }
+        if(result.profile.wallSeconds > 0.0)
+        {
+          result.speedup = baseline[result.profile.index] / result.profile.wallSeconds;
+        }
+      }
+      if(err < 0)
+      {
+        break;
+      }
+    }
+    if(err < 0)
+    {
+      break;
+    }
+  }
+
+  WriteResults(resultsDir, runId, results);
+  PrintResults(results, previous, previousRun);
+
+  return err < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
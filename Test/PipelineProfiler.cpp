@@ -0,0 +1,246 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineProfiler.h"
+
+#ifdef _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <string>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/Geometry/IGeometry.h"
+
+namespace
+{
+#if defined(__linux__)
+/**
+ * @brief Reads one of the "VmXXX:   1234 kB" lines of /proc/self/status and returns it in bytes, or -1
+ */
+int64_t readProcStatusBytes(const char* key)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  size_t keyLength = std::strlen(key);
+  while(std::getline(status, line))
+  {
+    if(line.compare(0, keyLength, key) == 0 && line.size() > keyLength && line[keyLength] == ':')
+    {
+      return std::strtoll(line.c_str() + keyLength + 1, nullptr, 10) * 1024;
+    }
+  }
+  return -1;
+}
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineProfiler::ResetPeakResidentSetSize()
+{
+#if defined(__linux__)
+  // Writing 5 to clear_refs resets VmHWM to the current resident set size (Linux 4.0 and later)
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  if(!clearRefs)
+  {
+    return false;
+  }
+  clearRefs << "5";
+  clearRefs.close();
+  return !clearRefs.fail();
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t PipelineProfiler::GetResidentSetSize()
+{
+#ifdef _MSC_VER
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+  {
+    return 0;
+  }
+  return static_cast<int64_t>(counters.WorkingSetSize);
+#elif defined(__linux__)
+  return std::max(readProcStatusBytes("VmRSS"), static_cast<int64_t>(0));
+#else
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t PipelineProfiler::GetPeakResidentSetSize()
+{
+#ifdef _MSC_VER
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+  {
+    return 0;
+  }
+  return static_cast<int64_t>(counters.PeakWorkingSetSize);
+#else
+#if defined(__linux__)
+  int64_t hwm = readProcStatusBytes("VmHWM");
+  if(hwm >= 0)
+  {
+    return hwm;
+  }
+#endif
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<int64_t>(usage.ru_maxrss);
+#else
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double PipelineProfiler::GetProcessCpuSeconds()
+{
+#ifdef _MSC_VER
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if(GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime) == 0)
+  {
+    return 0.0;
+  }
+  ULARGE_INTEGER kernel;
+  kernel.LowPart = kernelTime.dwLowDateTime;
+  kernel.HighPart = kernelTime.dwHighDateTime;
+  ULARGE_INTEGER user;
+  user.LowPart = userTime.dwLowDateTime;
+  user.HighPart = userTime.dwHighDateTime;
+  // FILETIME counts 100 ns intervals
+  return static_cast<double>(kernel.QuadPart + user.QuadPart) * 1.0E-7;
+#else
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::MeasureDataContainerArray(const DataContainerArray::Pointer& dca, int64_t& bytes, size_t& elements)
+{
+  bytes = 0;
+  elements = 0;
+  for(const QString& dcName : dca->getDataContainerNames())
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    IGeometry::Pointer geom = dc->getGeometry();
+    if(nullptr != geom.get())
+    {
+      elements = std::max(elements, geom->getNumberOfElements());
+    }
+    for(const QString& amName : dc->getAttributeMatrixNames())
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        IDataArray::Pointer array = am->getAttributeArray(arrayName);
+        bytes += static_cast<int64_t>(array->getSize()) * static_cast<int64_t>(array->getTypeSize());
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterProfile PipelineProfiler::ProfileFilter(const AbstractFilter::Pointer& filter, const DataContainerArray::Pointer& dca, int index)
+{
+  FilterProfile profile;
+  profile.index = index;
+  profile.className = filter->getNameOfClass();
+  profile.humanLabel = filter->getHumanLabel();
+
+  int64_t bytesBefore = 0;
+  size_t elementsBefore = 0;
+  MeasureDataContainerArray(dca, bytesBefore, elementsBefore);
+  // When the high-water mark can be reset the delta is the peak reached by this filter above the memory
+  // it started with; otherwise only growth of the lifetime peak of the process can be seen
+  bool peakReset = ResetPeakResidentSetSize();
+  int64_t rssBefore = peakReset ? GetResidentSetSize() : GetPeakResidentSetSize();
+
+  std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+  double cpuStart = GetProcessCpuSeconds();
+  filter->setDataContainerArray(dca);
+  filter->execute();
+  double cpuEnd = GetProcessCpuSeconds();
+  std::chrono::steady_clock::time_point wallEnd = std::chrono::steady_clock::now();
+
+  int64_t bytesAfter = 0;
+  size_t elementsAfter = 0;
+  MeasureDataContainerArray(dca, bytesAfter, elementsAfter);
+
+  profile.wallSeconds = std::chrono::duration<double>(wallEnd - wallStart).count();
+  profile.cpuSeconds = cpuEnd - cpuStart;
+  profile.peakRssDelta = std::max(GetPeakResidentSetSize() - rssBefore, static_cast<int64_t>(0));
+  profile.dataArrayBytesDelta = bytesAfter - bytesBefore;
+  profile.elements = std::max(elementsBefore, elementsAfter);
+  if(profile.wallSeconds > 0.0)
+  {
+    profile.elementsPerSecond = static_cast<double>(profile.elements) / profile.wallSeconds;
+  }
+  profile.errorCode = filter->getErrorCode();
+  return profile;
+}
@@ -0,0 +1,104 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The FilterProfile struct holds what was measured around one call to AbstractFilter::execute
+ */
+struct FilterProfile
+{
+  int index = 0;
+  QString className;
+  QString humanLabel;
+  double wallSeconds = 0.0;
+  double cpuSeconds = 0.0;
+  int64_t peakRssDelta = 0;
+  int64_t dataArrayBytesDelta = 0;
+  size_t elements = 0;
+  double elementsPerSecond = 0.0;
+  int errorCode = 0;
+};
+
+namespace PipelineProfiler
+{
+/**
+ * @brief Resets the peak resident set size of this process to its current resident set size so the
+ * peak of a single filter can be measured. Only Linux (4.0 and later, through /proc/self/clear_refs)
+ * supports this; on macOS and Windows the peak can not be reset and this returns false.
+ */
+bool ResetPeakResidentSetSize();
+
+/**
+ * @brief Returns the current resident set size of this process in bytes, or 0 where it is not
+ * available (macOS)
+ */
+int64_t GetResidentSetSize();
+
+/**
+ * @brief Returns the peak resident set size of this process in bytes. On Linux this is VmHWM, which
+ * ResetPeakResidentSetSize() can reset; elsewhere it is the peak over the lifetime of the process.
+ */
+int64_t GetPeakResidentSetSize();
+
+/**
+ * @brief Returns the CPU time used so far by every thread of this process in seconds. This uses
+ * GetProcessTimes on Windows, where std::clock returns the wall time, and std::clock elsewhere.
+ */
+double GetProcessCpuSeconds();
+
+/**
+ * @brief Sums the bytes held by every array in the DataContainerArray and finds the largest number
+ * of elements (voxels, triangles, ...) of any geometry
+ */
+void MeasureDataContainerArray(const DataContainerArray::Pointer& dca, int64_t& bytes, size_t& elements);
+
+/**
+ * @brief Executes the filter against the DataContainerArray and measures the wall and CPU time, the
+ * peak resident set size, the growth of the DataArray storage and the elements per second.
+ * On Linux the peak is reset before the filter runs, so peakRssDelta is how far the filter pushed the
+ * resident set size above what it started with. On macOS and Windows the peak can not be reset and
+ * peakRssDelta is only the growth of the lifetime peak of the process, which is 0 for any filter that
+ * stays below the memory an earlier filter already reached.
+ */
+FilterProfile ProfileFilter(const AbstractFilter::Pointer& filter, const DataContainerArray::Pointer& dca, int index);
+} // namespace PipelineProfiler
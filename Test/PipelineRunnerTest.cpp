@@ -45,19 +45,26 @@
 
 // C++ Includes
 #include <iostream>
+#include <vector>
 
 // Qt Includes
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QSettings>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QStringListIterator>
+#include <QtCore/QTextStream>
 #include <QtCore/QtDebug>
 
 // DREAM3DLib includes
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/H5FilterParametersReader.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
 #include "SIMPLib/Filtering/FilterFactory.hpp"
@@ -71,8 +78,107 @@
 #include "SIMPLib/Utilities/TestObserver.h"
 #include "UnitTestSupport.hpp"
 
+#include "PipelineProfiler.h"
 #include "PipelineRunnerTest.h"
 
+// -----------------------------------------------------------------------------
+// Returns "json", "csv" or an empty string if no profile should be written
+// -----------------------------------------------------------------------------
+QString GetPipelineProfileFormat()
+{
+  QString format = QString::fromLocal8Bit(qgetenv("DREAM3D_PIPELINE_PROFILE"));
+  if(format.isEmpty())
+  {
+    format = getPipelineProfileFormat();
+  }
+  format = format.trimmed().toLower();
+  if(format != "json" && format != "csv")
+  {
+    return QString();
+  }
+  return format;
+}
+
+// -----------------------------------------------------------------------------
+// Executes the filters of the pipeline one at a time, the same way FilterPipeline::execute
+// does, and measures each one. Returns the error code of the last executed filter.
+// -----------------------------------------------------------------------------
+int ExecuteProfiledPipeline(const FilterPipeline::Pointer& pipeline, std::vector<FilterProfile>& profiles)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  int err = 0;
+  int index = 0;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    index++;
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+    profiles.push_back(PipelineProfiler::ProfileFilter(filter, dca, index));
+    err = profiles.back().errorCode;
+    if(err < 0)
+    {
+      break;
+    }
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WritePipelineProfile(const QString& pipelineFile, const QString& format, const std::vector<FilterProfile>& profiles)
+{
+  QDir dir;
+  dir.mkpath(getPipelineProfileDirectory());
+  QFileInfo fi(pipelineFile);
+  QString outputPath = getPipelineProfileDirectory() + fi.completeBaseName() + "." + format;
+  QFile outFile(outputPath);
+  if(!outFile.open(QFile::WriteOnly))
+  {
+    std::cout << "\"Profile Error\": \"Could not write the pipeline profile to '" << outputPath.toStdString() << "'\"," << std::endl;
+    return;
+  }
+
+  if(format == "json")
+  {
+    QJsonArray filters;
+    for(const FilterProfile& profile : profiles)
+    {
+      QJsonObject obj;
+      obj["Index"] = profile.index;
+      obj["Filter"] = profile.className;
+      obj["Human Label"] = profile.humanLabel;
+      obj["Wall Time (s)"] = profile.wallSeconds;
+      obj["CPU Time (s)"] = profile.cpuSeconds;
+      obj["Peak RSS Delta (bytes)"] = static_cast<double>(profile.peakRssDelta);
+      obj["DataArray Bytes Delta"] = static_cast<double>(profile.dataArrayBytesDelta);
+      obj["Elements"] = static_cast<double>(profile.elements);
+      obj["Elements Per Second"] = profile.elementsPerSecond;
+      obj["Error Code"] = profile.errorCode;
+      filters.append(obj);
+    }
+    QJsonObject root;
+    root["Pipeline"] = fi.fileName();
+    root["Filters"] = filters;
+    outFile.write(QJsonDocument(root).toJson());
+  }
+  else
+  {
+    QTextStream out(&outFile);
+    out << "Index,Filter,Human Label,Wall Time (s),CPU Time (s),Peak RSS Delta (bytes),DataArray Bytes Delta,Elements,Elements Per Second,Error Code\n";
+    for(const FilterProfile& profile : profiles)
+    {
+      out << profile.index << "," << profile.className << ",\"" << profile.humanLabel << "\"," << profile.wallSeconds << "," << profile.cpuSeconds << "," << profile.peakRssDelta << ","
+          << profile.dataArrayBytesDelta << "," << profile.elements << "," << profile.elementsPerSecond << "," << profile.errorCode << "\n";
+    }
+  }
+  outFile.close();
+  std::cout << "\"Pipeline Profile\": \"" << outputPath.toStdString() << "\"," << std::endl;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -126,8 +232,18 @@ void ExecutePipeline(const QString& pipelineFile)
 
   // Now actually execute the pipeline
   std::cout << "EXECUTING PIPELINE STARTING ============================================" << std::endl;
-  pipeline->execute();
-  err = pipeline->getErrorCode();
+  QString profileFormat = GetPipelineProfileFormat();
+  if(profileFormat.isEmpty())
+  {
+    pipeline->execute();
+    err = pipeline->getErrorCode();
+  }
+  else
+  {
+    std::vector<FilterProfile> profiles;
+    err = ExecuteProfiledPipeline(pipeline, profiles);
+    WritePipelineProfile(pipelineFile, profileFormat, profiles);
+  }
   if(err < 0)
   {
     std::cout << "Error Condition of Pipeline: " << err << std::endl;